@@ -12,6 +12,7 @@ option(AUTHSERVER       "Build authserver"
 option(WORLDSERVER      "Build worldserver"                                           1)
 option(SCRIPTS          "Build core with scripts included"                            1)
 option(TOOLS            "Build map/vmap/mmap extraction/assembler tools"              0)
+option(WORLD_TOOLS      "Build packetreplay and worldbench, tools running the world"  0)
 option(USE_SCRIPTPCH    "Use precompiled headers when compiling scripts"              1)
 option(USE_COREPCH      "Use precompiled headers when compiling servers"              1)
 option(WITH_WARNINGS    "Show all warnings during compile"                            1)
@@ -46,6 +46,12 @@ else()
   message("* Build map/vmap tools   : No  (default)")
 endif()
 
+if( WORLD_TOOLS )
+  message("* Build world tools      : Yes")
+else()
+  message("* Build world tools      : No  (default)")
+endif()
+
 if( USE_COREPCH )
   message("* Build core w/PCH       : Yes (default)")
 else()
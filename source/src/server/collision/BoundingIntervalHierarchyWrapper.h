@@ -105,6 +105,22 @@ public:
         m_tree.intersectRay(ray, temp_cb, maxDist, true);
     }
 
+    // collects the objects whose bounds intersect the box, for tests of many rays against the same few objects
+    void getObjectsInBox(const G3D::AABox& box, G3D::Array<const T*>& objects)
+    {
+        balance();
+        for (int i = 0; i < m_objects.size(); ++i)
+        {
+            if (const T* obj = m_objects[i])
+            {
+                G3D::AABox bounds;
+                BoundsFunc::getBounds2(obj, bounds);
+                if (bounds.intersects(box))
+                    objects.push_back(obj);
+            }
+        }
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
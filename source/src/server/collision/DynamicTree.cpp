@@ -248,6 +248,59 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+void DynamicMapTree::isInLineOfSightMany(const G3D::Vector3& origin, const G3D::Vector3* targets, uint32 count,
+                                         uint32 phasemask, bool* visible) const
+{
+    typedef ParentTree::Cell Cell;
+
+    Cell cell = Cell::ComputeCell(origin.x, origin.y);
+    G3D::AABox bounds(origin, origin);
+    bool sameCell = cell.isValid();
+    for (uint32 i = 0; i < count && sameCell; ++i)
+    {
+        sameCell = Cell::ComputeCell(targets[i].x, targets[i].y) == cell;
+        bounds.merge(targets[i]);
+    }
+
+    // segments leaving the cell visit several nodes, cast them one by one
+    if (!sameCell)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            if (visible[i])
+                visible[i] = isInLineOfSight(origin.x, origin.y, origin.z, targets[i].x, targets[i].y, targets[i].z, phasemask);
+        return;
+    }
+
+    // every segment lies inside the bounds, models outside of them can't block any
+    G3D::Array<const GameObjectModel*> models;
+    if (BIHWrap<GameObjectModel>* node = impl->nodes[cell.x][cell.y])
+        node->getObjectsInBox(bounds, models);
+
+    if (!models.size())
+        return;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (!visible[i])
+            continue;
+
+        float maxDist = (targets[i] - origin).magnitude();
+        if (!G3D::fuzzyGt(maxDist, 0))
+            continue;
+
+        G3D::Ray r(origin, (targets[i] - origin) / maxDist);
+        for (int j = 0; j < models.size(); ++j)
+        {
+            float distance = maxDist;
+            if (models[j]->intersectRay(r, distance, true, phasemask))
+            {
+                visible[i] = false;
+                break;
+            }
+        }
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
@@ -43,6 +43,10 @@ public:
     bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
 
+    // tests the segments from origin to all targets still marked visible, blocked ones are set to false
+    void isInLineOfSightMany(const G3D::Vector3& origin, const G3D::Vector3* targets, uint32 count,
+                             uint32 phasemask, bool* visible) const;
+
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
 
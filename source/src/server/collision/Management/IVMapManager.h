@@ -22,6 +22,11 @@
 #include <string>
 #include "Define.h"
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -61,6 +66,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            test the lines of sight from one origin to count targets, visible[i] is set to false for every blocked one
+            */
+            virtual void isInLineOfSightMany(unsigned int pMapId, float x, float y, float z, const G3D::Vector3* targets, unsigned int count, bool* visible) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -78,6 +78,7 @@ namespace MMAP
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
         mmap_data->mmapLoadedTiles.clear();
+        mmap_data->generation = ++lastGeneration;
 
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
         return true;
@@ -153,6 +154,7 @@ namespace MMAP
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef))) 
         {
             mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            mmap->generation = ++lastGeneration;
             ++loadedTiles;
             TC_LOG_INFO("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -202,6 +204,7 @@ namespace MMAP
         else
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            mmap->generation = ++lastGeneration;
             --loadedTiles;
             TC_LOG_INFO("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -275,6 +278,15 @@ namespace MMAP
         return loadedMMaps[mapId]->navMesh;
     }
 
+    uint32 MMapManager::GetNavMeshGeneration(uint32 mapId) const
+    {
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return 0;
+
+        return itr->second->generation;
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
@@ -24,6 +24,8 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 
+#include <atomic>
+
 //  move map related classes
 namespace MMAP
 {
@@ -33,7 +35,7 @@ namespace MMAP
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), generation(0) {}
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
@@ -48,6 +50,7 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        std::atomic<uint32> generation;     // changes whenever a tile is added or removed, never reused, read by map threads
     };
 
 
@@ -58,7 +61,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), lastGeneration(0) {}
             ~MMapManager();
 
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
@@ -69,6 +72,8 @@ namespace MMAP
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            // poly refs found on an older generation of the navmesh may be invalid, 0 if not loaded
+            uint32 GetNavMeshGeneration(uint32 mapId) const;
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
@@ -78,6 +83,7 @@ namespace MMAP
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            std::atomic<uint32> lastGeneration;             // tiles of different maps are loaded by their map threads
     };
 }
 
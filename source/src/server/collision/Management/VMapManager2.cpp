@@ -153,6 +153,27 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSightMany(unsigned int mapId, float x, float y, float z, const G3D::Vector3* targets, unsigned int count, bool* visible)
+    {
+        if (!isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
+            return;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        Vector3 pos1 = convertPositionToInternalRep(x, y, z);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            if (!visible[i])
+                continue;
+
+            Vector3 pos2 = convertPositionToInternalRep(targets[i].x, targets[i].y, targets[i].z);
+            if (pos1 != pos2)
+                visible[i] = instanceTree->second->isInLineOfSight(pos1, pos2);
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -92,6 +92,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            void isInLineOfSightMany(unsigned int mapId, float x, float y, float z, const G3D::Vector3* targets, unsigned int count, bool* visible);
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -19,6 +19,19 @@ AnticheatData::~AnticheatData()
 {
 }
 
+void AnticheatData::ResetReports()
+{
+	totalReports = 0;
+	average = 0;
+	creationTime = 0;
+	for (uint8 i = 0; i < MAX_REPORT_TYPES; i++)
+	{
+		typeReports[i] = 0;
+		tempReports[i] = 0;
+		tempReportsTimer[i] = 0;
+	}
+}
+
 void AnticheatData::SetDailyReportState(bool b)
 {
 	hasDailyReport = b;
@@ -52,7 +65,7 @@ const MovementInfo& AnticheatData::GetLastMovementInfo() const
 	return lastMovementInfo;
 }
 
-void AnticheatData::SetLastMovementInfo(MovementInfo& moveInfo)
+void AnticheatData::SetLastMovementInfo(MovementInfo const& moveInfo)
 {
 	lastMovementInfo = moveInfo;
 }
@@ -1,10 +1,19 @@
 #ifndef SC_ACDATA_H
 #define SC_ACDATA_H
 
-#include "AnticheatMgr.h"
+#include "Object.h"
 
 #define MAX_REPORT_TYPES 6
 
+// Last known good location, used by the Player:: movement checks to port cheaters back
+struct AnticheatSavedLocation
+{
+	WorldLocation location;
+	float OldZ = 0.f;
+	uint32 WarningsForAirWalking = 0;
+};
+
+// Owned by the Player, only touched from the thread updating the player's map
 class AnticheatData
 {
 public:
@@ -15,7 +24,7 @@ public:
 	uint32 GetLastOpcode() const;
 
 	const MovementInfo& GetLastMovementInfo() const;
-	void SetLastMovementInfo(MovementInfo& moveInfo);
+	void SetLastMovementInfo(MovementInfo const& moveInfo);
 
 	void SetPosition(float x, float y, float z, float o);
 
@@ -45,6 +54,11 @@ public:
 
 	void SetDailyReportState(bool b);
 	bool GetDailyReportState();
+
+	// Clears the report counters, keeps the movement and daily report state
+	void ResetReports();
+
+	AnticheatSavedLocation& GetSavedLocation() { return savedLocation; }
 private:
 	uint32 lastOpcode;
 	MovementInfo lastMovementInfo;
@@ -57,6 +71,7 @@ private:
 	uint32 tempReports[MAX_REPORT_TYPES];
 	uint32 tempReportsTimer[MAX_REPORT_TYPES];
 	bool hasDailyReport;
+	AnticheatSavedLocation savedLocation;
 };
 
 #endif
\ No newline at end of file
@@ -14,41 +14,35 @@ AnticheatMgr::AnticheatMgr()
 
 AnticheatMgr::~AnticheatMgr()
 {
-	m_Players.clear();
 }
 
-struct SavedLocation
+// Both report tables share the same layout
+static void SetReportStatementData(PreparedStatement* stmt, uint32 guidLow, AnticheatData const& data)
 {
-	WorldLocation location;
-	bool exist = false;
-	float OldZ = 0.f;
-	uint32 WarningsForAirWalking = 0;
-};
-
-static std::map<uint64, SavedLocation> AntiHackSave;
-
+	stmt->setUInt32(0, guidLow);
+	stmt->setFloat(1, data.GetAverage());
+	stmt->setUInt32(2, data.GetTotalReports());
+	stmt->setUInt32(3, data.GetTypeReports(SPEED_HACK_REPORT));
+	stmt->setUInt32(4, data.GetTypeReports(FLY_HACK_REPORT));
+	stmt->setUInt32(5, data.GetTypeReports(JUMP_HACK_REPORT));
+	stmt->setUInt32(6, data.GetTypeReports(WALK_WATER_HACK_REPORT));
+	stmt->setUInt32(7, data.GetTypeReports(TELEPORT_PLANE_HACK_REPORT));
+	stmt->setUInt32(8, data.GetTypeReports(CLIMB_HACK_REPORT));
+	stmt->setUInt32(9, data.GetCreationTime());
+}
 
-void AnticheatMgr::JumpHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode)
+void AnticheatMgr::JumpHackDetection(Player* player, AnticheatData& data, uint32 opcode)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & JUMP_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUIDLow();
-
-	if (m_Players[key].GetLastOpcode() == MSG_MOVE_JUMP && opcode == MSG_MOVE_JUMP)
+	if (data.GetLastOpcode() == MSG_MOVE_JUMP && opcode == MSG_MOVE_JUMP)
 	{
-		BuildReport(player, JUMP_HACK_REPORT);
+		BuildReport(player, data, JUMP_HACK_REPORT);
 		//sLog->outError("AnticheatMgr:: Jump-Hack detected player GUID (low) %u",player->GetGUIDLow());
 	}
 }
 
-void AnticheatMgr::WalkOnWaterHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::WalkOnWaterHackDetection(Player* player, AnticheatData& data)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & WALK_WATER_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUIDLow();
-	if (!m_Players[key].GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_WATERWALKING))
+	if (!data.GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_WATERWALKING))
 		return;
 
 	// if we are a ghost we can walk on water
@@ -61,19 +55,14 @@ void AnticheatMgr::WalkOnWaterHackDetection(Player* player, MovementInfo movemen
 		return;
 
 	//sLog->outError("AnticheatMgr:: Walk on Water - Hack detected player GUID (low) %u",player->GetGUIDLow());
-	BuildReport(player, WALK_WATER_HACK_REPORT);
+	BuildReport(player, data, WALK_WATER_HACK_REPORT);
 
 }
 
 
-void AnticheatMgr::TeleportPlaneHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::TeleportPlaneHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & TELEPORT_PLANE_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUIDLow();
-
-	if (m_Players[key].GetLastMovementInfo().pos.GetPositionZ() != 0 ||
+	if (data.GetLastMovementInfo().pos.GetPositionZ() != 0 ||
 		movementInfo.pos.GetPositionZ() != 0)
 		return;
 
@@ -92,11 +81,11 @@ void AnticheatMgr::TeleportPlaneHackDetection(Player* player, MovementInfo movem
 	if (z_diff > 1.0f)
 	{
 		//sLog->outError("AnticheatMgr:: Teleport To Plane - Hack detected player GUID (low) %u",player->GetGUIDLow());
-		BuildReport(player, TELEPORT_PLANE_HACK_REPORT);
+		BuildReport(player, data, TELEPORT_PLANE_HACK_REPORT);
 	}
 }
 
-void AnticheatMgr::StartHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode)
+void AnticheatMgr::StartHackDetection(Player* player, MovementInfo const& movementInfo, uint32 opcode)
 {
 	if (!sWorld->getBoolConfig(CONFIG_ANTICHEAT_ENABLE) || !player)
 		return;
@@ -104,36 +93,36 @@ void AnticheatMgr::StartHackDetection(Player* player, MovementInfo movementInfo,
 	if (player->isGameMaster())
 		return;
 
-	uint32 key = player->GetGUIDLow();
+	// Called from the map thread which owns the player, no locking needed
+	AnticheatData& data = player->GetAnticheatData();
 
-	if (player->isInFlight() || player->GetTransport() || player->GetVehicle())
+	if (!player->isInFlight() && !player->GetTransport() && !player->GetVehicle())
 	{
-		m_Players[key].SetLastMovementInfo(movementInfo);
-		m_Players[key].SetLastOpcode(opcode);
-		return;
+		uint32 detections = sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED);
+
+		if (detections & SPEED_HACK_DETECTION)
+			SpeedHackDetection(player, data, movementInfo);
+		if (detections & FLY_HACK_DETECTION)
+			FlyHackDetection(player, data);
+		if (detections & WALK_WATER_HACK_DETECTION)
+			WalkOnWaterHackDetection(player, data);
+		if (detections & JUMP_HACK_DETECTION)
+			JumpHackDetection(player, data, opcode);
+		if (detections & TELEPORT_PLANE_HACK_DETECTION)
+			TeleportPlaneHackDetection(player, data, movementInfo);
+		if (detections & CLIMB_HACK_DETECTION)
+			ClimbHackDetection(player, data, movementInfo, opcode);
 	}
 
-	SpeedHackDetection(player, movementInfo);
-	FlyHackDetection(player, movementInfo);
-	WalkOnWaterHackDetection(player, movementInfo);
-	JumpHackDetection(player, movementInfo, opcode);
-	TeleportPlaneHackDetection(player, movementInfo);
-	ClimbHackDetection(player, movementInfo, opcode);
-
-	m_Players[key].SetLastMovementInfo(movementInfo);
-	m_Players[key].SetLastOpcode(opcode);
+	data.SetLastMovementInfo(movementInfo);
+	data.SetLastOpcode(opcode);
 }
 
 // basic detection
-void AnticheatMgr::ClimbHackDetection(Player *player, MovementInfo movementInfo, uint32 opcode)
+void AnticheatMgr::ClimbHackDetection(Player *player, AnticheatData& data, MovementInfo const& movementInfo, uint32 opcode)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & CLIMB_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUIDLow();
-
 	if (opcode != MSG_MOVE_HEARTBEAT ||
-		m_Players[key].GetLastOpcode() != MSG_MOVE_HEARTBEAT)
+		data.GetLastOpcode() != MSG_MOVE_HEARTBEAT)
 		return;
 
 	// in this case we don't care if they are "legal" flags, they are handled in another parts of the Anticheat Manager.
@@ -153,7 +142,7 @@ void AnticheatMgr::ClimbHackDetection(Player *player, MovementInfo movementInfo,
 	if (angle > CLIMB_ANGLE)
 	{
 		//sLog->outError("AnticheatMgr:: Climb-Hack detected player GUID (low) %u", player->GetGUIDLow());
-		BuildReport(player, CLIMB_HACK_REPORT);
+		BuildReport(player, data, CLIMB_HACK_REPORT);
 	}
 
 
@@ -161,13 +150,9 @@ void AnticheatMgr::ClimbHackDetection(Player *player, MovementInfo movementInfo,
 
 }
 
-void AnticheatMgr::FlyHackDetection(Player* player, MovementInfo  movementInfo)
+void AnticheatMgr::FlyHackDetection(Player* player, AnticheatData& data)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & FLY_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUID();
-	if (!m_Players[key].GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_FLYING))
+	if (!data.GetLastMovementInfo().HasMovementFlag(MOVEMENTFLAG_FLYING))
 		return;
 
 	if (player->HasAuraType(SPELL_AURA_FLY) ||
@@ -176,17 +161,12 @@ void AnticheatMgr::FlyHackDetection(Player* player, MovementInfo  movementInfo)
 		|| player->IsFalling())
 		return;
 
-	TC_LOG_DEBUG("entities.player.character", "AnticheatMgr:: Fly-Hack detected player GUID (low) %u", player->GetGUID());
-	BuildReport(player, FLY_HACK_REPORT);
+	TC_LOG_DEBUG("entities.player.character", "AnticheatMgr:: Fly-Hack detected player GUID (low) %u", player->GetGUIDLow());
+	BuildReport(player, data, FLY_HACK_REPORT);
 }
 
-void AnticheatMgr::SpeedHackDetection(Player* player, MovementInfo movementInfo)
+void AnticheatMgr::SpeedHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo)
 {
-	if ((sWorld->getIntConfig(CONFIG_ANTICHEAT_DETECTIONS_ENABLED) & SPEED_HACK_DETECTION) == 0 || !player)
-		return;
-
-	uint32 key = player->GetGUIDLow();
-
 	// We also must check the map because the movementFlag can be modified by the client.
 	// If we just check the flag, they could always add that flag and always skip the speed hacking detection.
 	// 369 == DEEPRUN TRAM
@@ -196,7 +176,7 @@ void AnticheatMgr::SpeedHackDetection(Player* player, MovementInfo movementInfo)
 	if (!player->isAlive())
 		return;
 
-	uint32 distance2D = (uint32)movementInfo.pos.GetExactDist2d(&m_Players[key].GetLastMovementInfo().pos);
+	uint32 distance2D = (uint32)movementInfo.pos.GetExactDist2d(&data.GetLastMovementInfo().pos);
 	uint8 moveType = 0;
 
 
@@ -233,7 +213,7 @@ void AnticheatMgr::SpeedHackDetection(Player* player, MovementInfo movementInfo)
 	uint32 speedRate = (uint32)(player->GetSpeed(UnitMoveType(moveType)) + movementInfo.j_xyspeed);
 
 	// how long the player took to move to here.
-	uint32 timeDiff = getMSTimeDiff(m_Players[key].GetLastMovementInfo().time, movementInfo.time);
+	uint32 timeDiff = getMSTimeDiff(data.GetLastMovementInfo().time, movementInfo.time);
 
 	if (!timeDiff)
 		timeDiff = 1;
@@ -246,7 +226,7 @@ void AnticheatMgr::SpeedHackDetection(Player* player, MovementInfo movementInfo)
 	// we did the (uint32) cast to accept a margin of tolerance
 	if (clientSpeedRate > speedRate)
 	{
-		BuildReport(player, SPEED_HACK_REPORT);
+		BuildReport(player, data, SPEED_HACK_REPORT);
 		//sLog->outError("AnticheatMgr:: Speed-Hack detected player GUID (low) %u",player->GetGUIDLow());
 	}
 }
@@ -259,13 +239,13 @@ void AnticheatMgr::StartScripts()
 void AnticheatMgr::HandlePlayerLogin(Player* player)
 {
 	// we must delete this to prevent errors in case of crash
-	CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid=%u", player->GetGUIDLow());
-	// we initialize the pos of lastMovementPosition var.
-	m_Players[player->GetGUIDLow()].SetPosition(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
-	QueryResult resultDB = CharacterDatabase.PQuery("SELECT * FROM daily_players_reports WHERE guid=%u;", player->GetGUIDLow());
+	PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYERS_REPORTS_STATUS);
+	stmt->setUInt32(0, player->GetGUIDLow());
+	CharacterDatabase.Execute(stmt, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, player->GetGUIDLow()));
 
-	if (resultDB)
-		m_Players[player->GetGUIDLow()].SetDailyReportState(true);
+	// we initialize the pos of lastMovementPosition var.
+	// The daily report state was loaded with the other login queries
+	player->GetAnticheatData().SetPosition(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
 }
 
 void AnticheatMgr::HandlePlayerLogout(Player* player)
@@ -273,29 +253,16 @@ void AnticheatMgr::HandlePlayerLogout(Player* player)
 	// TO-DO Make a table that stores the cheaters of the day, with more detailed information.
 
 	// We must also delete it at logout to prevent have data of offline players in the db when we query the database (IE: The GM Command)
-	CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid=%u", player->GetGUIDLow());
-	// Delete not needed data from the memory.
-	m_Players.erase(player->GetGUIDLow());
-}
-
-void AnticheatMgr::SavePlayerData(Player* player)
-{
-	CharacterDatabase.PExecute("REPLACE INTO players_reports_status (guid,average,total_reports,speed_reports,fly_reports,jump_reports,waterwalk_reports,teleportplane_reports,climb_reports,creation_time) VALUES (%u,%f,%u,%u,%u,%u,%u,%u,%u,%u);", player->GetGUIDLow(), m_Players[player->GetGUIDLow()].GetAverage(), m_Players[player->GetGUIDLow()].GetTotalReports(), m_Players[player->GetGUIDLow()].GetTypeReports(SPEED_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(FLY_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(JUMP_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(WALK_WATER_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(TELEPORT_PLANE_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(CLIMB_HACK_REPORT), m_Players[player->GetGUIDLow()].GetCreationTime());
+	PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYERS_REPORTS_STATUS);
+	stmt->setUInt32(0, player->GetGUIDLow());
+	CharacterDatabase.Execute(stmt, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, player->GetGUIDLow()));
 }
 
-uint32 AnticheatMgr::GetTotalReports(uint32 lowGUID)
+void AnticheatMgr::SavePlayerData(Player* player, SQLTransaction& trans)
 {
-	return m_Players[lowGUID].GetTotalReports();
-}
-
-float AnticheatMgr::GetAverage(uint32 lowGUID)
-{
-	return m_Players[lowGUID].GetAverage();
-}
-
-uint32 AnticheatMgr::GetTypeReports(uint32 lowGUID, uint8 type)
-{
-	return m_Players[lowGUID].GetTypeReports(type);
+	PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_PLAYERS_REPORTS_STATUS);
+	SetReportStatementData(stmt, player->GetGUIDLow(), player->GetAnticheatData());
+	trans->Append(stmt);
 }
 
 bool AnticheatMgr::MustCheckTempReports(uint8 type)
@@ -306,57 +273,64 @@ bool AnticheatMgr::MustCheckTempReports(uint8 type)
 	return true;
 }
 
-void AnticheatMgr::BuildReport(Player* player, uint8 reportType)
+void AnticheatMgr::BuildReport(Player* player, AnticheatData& data, uint8 reportType)
 {
-	uint32 key = player->GetGUIDLow();
-
 	if (MustCheckTempReports(reportType))
 	{
 		uint32 actualTime = getMSTime();
 
-		if (!m_Players[key].GetTempReportsTimer(reportType))
-			m_Players[key].SetTempReportsTimer(actualTime, reportType);
+		if (!data.GetTempReportsTimer(reportType))
+			data.SetTempReportsTimer(actualTime, reportType);
 
-		if (getMSTimeDiff(m_Players[key].GetTempReportsTimer(reportType), actualTime) < 3000)
+		if (getMSTimeDiff(data.GetTempReportsTimer(reportType), actualTime) < 3000)
 		{
-			m_Players[key].SetTempReports(m_Players[key].GetTempReports(reportType) + 1, reportType);
+			data.SetTempReports(data.GetTempReports(reportType) + 1, reportType);
 
-			if (m_Players[key].GetTempReports(reportType) < 3)
+			if (data.GetTempReports(reportType) < 3)
 				return;
 		}
 		else
 		{
-			m_Players[key].SetTempReportsTimer(actualTime, reportType);
-			m_Players[key].SetTempReports(1, reportType);
+			data.SetTempReportsTimer(actualTime, reportType);
+			data.SetTempReports(1, reportType);
 			return;
 		}
 	}
 
 	// generating creationTime for average calculation
-	if (!m_Players[key].GetTotalReports())
-		m_Players[key].SetCreationTime(getMSTime());
+	if (!data.GetTotalReports())
+		data.SetCreationTime(getMSTime());
 
 	// increasing total_reports
-	m_Players[key].SetTotalReports(m_Players[key].GetTotalReports() + 1);
+	data.SetTotalReports(data.GetTotalReports() + 1);
 	// increasing specific cheat report
-	m_Players[key].SetTypeReports(reportType, m_Players[key].GetTypeReports(reportType) + 1);
+	data.SetTypeReports(reportType, data.GetTypeReports(reportType) + 1);
 
 	// diff time for average calculation
-	uint32 diffTime = getMSTimeDiff(m_Players[key].GetCreationTime(), getMSTime()) / IN_MILLISECONDS;
+	uint32 diffTime = getMSTimeDiff(data.GetCreationTime(), getMSTime()) / IN_MILLISECONDS;
 
 	if (diffTime > 0)
 	{
 		// Average == Reports per second
-		float average = float(m_Players[key].GetTotalReports()) / float(diffTime);
-		m_Players[key].SetAverage(average);
+		float average = float(data.GetTotalReports()) / float(diffTime);
+		data.SetAverage(average);
 	}
 
-	if (sWorld->getIntConfig(CONFIG_ANTICHEAT_MAX_REPORTS_FOR_DAILY_REPORT) < m_Players[key].GetTotalReports())
+	if (sWorld->getIntConfig(CONFIG_ANTICHEAT_MAX_REPORTS_FOR_DAILY_REPORT) < data.GetTotalReports())
 	{
-		if (!m_Players[key].GetDailyReportState())
+		if (!data.GetDailyReportState())
 		{
-			CharacterDatabase.PExecute("REPLACE INTO daily_players_reports (guid,average,total_reports,speed_reports,fly_reports,jump_reports,waterwalk_reports,teleportplane_reports,climb_reports,creation_time) VALUES (%u,%f,%u,%u,%u,%u,%u,%u,%u,%u);", player->GetGUIDLow(), m_Players[player->GetGUIDLow()].GetAverage(), m_Players[player->GetGUIDLow()].GetTotalReports(), m_Players[player->GetGUIDLow()].GetTypeReports(SPEED_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(FLY_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(JUMP_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(WALK_WATER_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(TELEPORT_PLANE_HACK_REPORT), m_Players[player->GetGUIDLow()].GetTypeReports(CLIMB_HACK_REPORT), m_Players[player->GetGUIDLow()].GetCreationTime());
-			m_Players[key].SetDailyReportState(true);
+			// daily report and current status go out together, the player is kicked right after
+			SQLTransaction trans = CharacterDatabase.BeginTransaction();
+
+			PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_DAILY_PLAYERS_REPORT);
+			SetReportStatementData(stmt, player->GetGUIDLow(), data);
+			trans->Append(stmt);
+
+			SavePlayerData(player, trans);
+			CharacterDatabase.CommitTransaction(trans, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, player->GetGUIDLow()));
+
+			data.SetDailyReportState(true);
 			WorldSession* s = player->GetSession();
 			s->KickPlayer("AnticheatMgr::AnticheatViolation");
 			std::stringstream duration;
@@ -369,14 +343,14 @@ void AnticheatMgr::BuildReport(Player* player, uint8 reportType)
 		}
 	}
 
-	if (m_Players[key].GetTotalReports() > sWorld->getIntConfig(CONFIG_ANTICHEAT_REPORTS_INGAME_NOTIFICATION))
+	if (data.GetTotalReports() > sWorld->getIntConfig(CONFIG_ANTICHEAT_REPORTS_INGAME_NOTIFICATION))
 	{
 		// display warning at the center of the screen, hacky way?
 		std::string str = "";
 		str = "|[[Anticheat]|cFF00FFFF[|cFF60FF00" + std::string(player->GetName()) + "|cFF00FFFF] possible cheater!";
-		WorldPacket data(SMSG_NOTIFICATION, (str.size() + 1));
-		data << str;
-		sWorld->SendGlobalGMMessage(&data);
+		WorldPacket notification(SMSG_NOTIFICATION, (str.size() + 1));
+		notification << str;
+		sWorld->SendGlobalGMMessage(&notification);
 	}
 }
 
@@ -436,43 +410,34 @@ void AnticheatMgr::AnticheatGlobalCommand(ChatHandler* handler)
 	}
 }
 
-void AnticheatMgr::AnticheatDeleteCommand(uint32 guid)
+void AnticheatMgr::AnticheatDeleteCommand(Player* player)
 {
-	if (!guid)
+	// commands run on the world thread while the maps are not updating
+	if (!player)
 	{
-		for (AnticheatPlayersDataMap::iterator it = m_Players.begin(); it != m_Players.end(); ++it)
-		{
-			(*it).second.SetTotalReports(0);
-			(*it).second.SetAverage(0);
-			(*it).second.SetCreationTime(0);
-			for (uint8 i = 0; i < MAX_REPORT_TYPES; i++)
-			{
-				(*it).second.SetTempReports(0, i);
-				(*it).second.SetTempReportsTimer(0, i);
-				(*it).second.SetTypeReports(i, 0);
-			}
-		}
-		CharacterDatabase.PExecute("DELETE FROM players_reports_status;");
+		SessionMap const& sessions = sWorld->GetAllSessions();
+		for (SessionMap::const_iterator itr = sessions.begin(); itr != sessions.end(); ++itr)
+			if (Player* sessionPlayer = itr->second->GetPlayer())
+				sessionPlayer->GetAnticheatData().ResetReports();
+
+		CharacterDatabase.Execute(CharacterDatabase.GetPreparedStatement(CHAR_DEL_ALL_PLAYERS_REPORTS_STATUS));
 	}
 	else
 	{
-		m_Players[guid].SetTotalReports(0);
-		m_Players[guid].SetAverage(0);
-		m_Players[guid].SetCreationTime(0);
-		for (uint8 i = 0; i < MAX_REPORT_TYPES; i++)
-		{
-			m_Players[guid].SetTempReports(0, i);
-			m_Players[guid].SetTempReportsTimer(0, i);
-			m_Players[guid].SetTypeReports(i, 0);
-		}
-		CharacterDatabase.PExecute("DELETE FROM players_reports_status WHERE guid=%u;", guid);
+		player->GetAnticheatData().ResetReports();
+
+		PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYERS_REPORTS_STATUS);
+		stmt->setUInt32(0, player->GetGUIDLow());
+		CharacterDatabase.Execute(stmt, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, player->GetGUIDLow()));
 	}
 }
 
 void AnticheatMgr::ResetDailyReportStates()
 {
-	for (AnticheatPlayersDataMap::iterator it = m_Players.begin(); it != m_Players.end(); ++it)
-		m_Players[(*it).first].SetDailyReportState(false);
+	SessionMap const& sessions = sWorld->GetAllSessions();
+	for (SessionMap::const_iterator itr = sessions.begin(); itr != sessions.end(); ++itr)
+		if (Player* player = itr->second->GetPlayer())
+			player->GetAnticheatData().SetDailyReportState(false);
 }
 
 
@@ -627,7 +592,7 @@ bool Player::CheckOnFlyHack()
 		return true;
 
 
-	AntiHackSave[m_mover->ToPlayer()->GetGUID()].location = m_mover->ToPlayer()->GetWorldLocation();
+	m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location = m_mover->ToPlayer()->GetWorldLocation();
 
 	//Flyhacks are implemented in MovementHandler.cpp, This is just a nuisance preventing punishment for airwalking atm.
 	/*
@@ -650,7 +615,7 @@ bool Player::CheckOnFlyHack()
 			HackReport << " (|cffFF0000has mind control|r), controlled by: " << ChatHandler(m_mover->GetAffectingPlayer()->ToPlayer()->GetSession()).GetNameLink();
 		HackReport << "\n|cffFF0000Additional info [debug]|r: currently flying: |cffFF0000" << isFlying << "|r, can fly: |cffFF0000" << canFly << "|r";
 
-		TeleportTo(AntiHackSave[m_mover->ToPlayer()->GetGUID()].location); //port back
+		TeleportTo(m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location); //port back
 		m_mover->GetMotionMaster()->MoveFall();
 		sWorld->SendAntiCheat(m_mover->ToPlayer()->GetSession()LANG_GM_BROADCAST, HackReport.str().c_str());
 		return false;		
@@ -740,7 +705,7 @@ bool Player::CheckOnFlyHack()
 						if (HasAura(605))
 							HackReport << " (|cffFF0000has mind control|r), controlled by: " << ChatHandler(m_mover->GetAffectingPlayer()->ToPlayer()->GetSession()).GetNameLink();
 						HackReport << "\n|cffFF0000Additional info [debug]|r: previous Z: |cffFF0000" << z << "|r current Z: |cffFF0000" << pz << "|r checking Z: |cffFF0000" << cz;
-						TeleportTo(AntiHackSave[m_mover->ToPlayer()->GetGUID()].location); //port back
+						TeleportTo(m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location); //port back
 						sWorld->SendAntiCheat(m_mover->ToPlayer()->GetSession(), LANG_GM_BROADCAST, HackReport.str().c_str());
 						return false;
 					}
@@ -794,7 +759,7 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 		else
 			return true;
 
-		AntiHackSave[m_mover->ToPlayer()->GetGUID()].location = m_mover->ToPlayer()->GetWorldLocation();
+		m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location = m_mover->ToPlayer()->GetWorldLocation();
 
 		bool transportflag = (/*(movementInfo.GetMovementFlags() & 0x00000200) && */m_mover->ToPlayer()->GetTransport()); /*transport*/
 		float x, y, z;
@@ -865,7 +830,7 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 
 				if (skipchecker)
 				{
-					AntiHackSave[m_mover->ToPlayer()->GetGUID()].location = m_mover->ToPlayer()->GetWorldLocation();
+					m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location = m_mover->ToPlayer()->GetWorldLocation();
 					skipchecker = false;
 					return false;
 				}
@@ -879,7 +844,7 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 					HackReport.str().append(" (has mind control)");
 				HackReport << "\n|cffFF0000Additional info [debug]|r: player's |cffFF0000climbing above 30 degrees|r, impossible without client modification";
 				//HackReport << "\n[temp]: distance: " << distance << ", tan-angle: " << tanangle << " diffz: " << diffz;
-				m_mover->ToPlayer()->TeleportTo(AntiHackSave[m_mover->ToPlayer()->GetGUID()].location);
+				m_mover->ToPlayer()->TeleportTo(m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location);
 				sWorld->SendAntiCheat(m_mover->ToPlayer()->GetSession(), LANG_GM_BROADCAST, HackReport.str().c_str());
 				return false;
 			}
@@ -909,14 +874,14 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 			std::stringstream dadada, possibleAirHacker;
 			dadada << "Angle: |cffFF0000" << angle << "|r, player Z (height): |cffFF0000" << pz << "|r, zLocation: |cffFF0000" << zLocation << "|r deltaXY (distance & speed in YD): |cffFF0000" << deltaXY << "|r distance from ground: |cffFF0000" << dis_f_ground << "|r";
 			dadada << "engl: |cffFF0000 " << engl << "|r engl1: |cffFF0000" << engl1 << "|r";
-			if (AntiHackSave[m_mover->ToPlayer()->GetGUID()].OldZ == 0.f)
-				AntiHackSave[m_mover->ToPlayer()->GetGUID()].OldZ = zLocation; //define the new Z for port-down
-				//dadada << ", last stored Z: |cffFF0000" << AntiHackSave[m_mover->ToPlayer()->GetGUID()].OldZ;
+			if (m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().OldZ == 0.f)
+				m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().OldZ = zLocation; //define the new Z for port-down
+				//dadada << ", last stored Z: |cffFF0000" << m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().OldZ;
 			//ChatHandler(m_mover->ToPlayer()->GetSession()).PSendSysMessage("%s|r\n--------------------\n\n\n", dadada.str().c_str());
 
 			if (movementInfo.t_guid != 0) //(m_mover->ToPlayer()->FindNearestGameObjectOfType(GameobjectTypes::GAMEOBJECT_TYPE_TRANSPORT, 5.f))
 			{
-				AntiHackSave[m_mover->ToPlayer()->GetGUID()].location = m_mover->ToPlayer()->GetWorldLocation();
+				m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location = m_mover->ToPlayer()->GetWorldLocation();
 				m_mover->ToPlayer()->SetUnderACKmountTransport();
 				skipchecker = true;
 			}
@@ -984,10 +949,10 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 					&& (dis_f_ground_W > 5.f && dis_f_ground_W < 2000.f)
 					&& (dis_f_ground_NW > 5.f && dis_f_ground_NW < 2000.f)
 					)
-				AntiHackSave[m_mover->ToPlayer()->GetGUID()].WarningsForAirWalking++;
-				//ChatHandler(m_mover->ToPlayer()->GetSession()).PSendSysMessage("%u", AntiHackSave[m_mover->ToPlayer()->GetGUID()].WarningsForAirWalking);
+				m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().WarningsForAirWalking++;
+				//ChatHandler(m_mover->ToPlayer()->GetSession()).PSendSysMessage("%u", m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().WarningsForAirWalking);
 
-				if (AntiHackSave[m_mover->ToPlayer()->GetGUID()].WarningsForAirWalking >= 10)
+				if (m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().WarningsForAirWalking >= 10)
 				{
 					std::string accusedOf = "air-walking";
 					std::stringstream HackReport;
@@ -995,11 +960,11 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 					if (HasAura(605))
 						HackReport << " (|cffFF0000has mind control|r), controlled by: " << ChatHandler(m_mover->GetAffectingPlayer()->ToPlayer()->GetSession()).GetNameLink();
 					HackReport << "\n|cffFF0000Additional info [debug]|r: player is air-walking (invisible road) - distance from the ground |cffFF0000" << dis_f_ground << "|r without legal fly/flying mount";
-					//m_mover->ToPlayer()->TeleportTo(AntiHackSave[m_mover->ToPlayer()->GetGUID()].location); //todo: port down, not to the last location
+					//m_mover->ToPlayer()->TeleportTo(m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location); //todo: port down, not to the last location
 					sWorld->SendAntiCheat(m_mover->ToPlayer()->GetSession(), LANG_GM_BROADCAST, HackReport.str().c_str());
-					AntiHackSave[m_mover->ToPlayer()->GetGUID()].WarningsForAirWalking = 0;
+					m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().WarningsForAirWalking = 0;
 					m_mover->ToPlayer()->TeleportTo(m_mover->GetWorldLocation().GetMapId(), m_mover->GetWorldLocation().GetPositionX(), m_mover->GetWorldLocation().GetPositionY(), zLocation_N+0.5f, m_mover->GetWorldLocation().GetOrientation());
-					AntiHackSave[m_mover->ToPlayer()->GetGUID()].OldZ = 0.f; //reset
+					m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().OldZ = 0.f; //reset
 
 					m_mover->ToPlayer()->SetCanFlybyServer(false);
 					m_mover->m_movementInfo.RemoveMovementFlag(MOVEMENTFLAG_CAN_FLY);
@@ -1010,7 +975,7 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 				}
 				return false;
 			}
-			//AntiHackSave[m_mover->ToPlayer()->GetGUID()].OldZ = pz; //store it
+			//m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().OldZ = pz; //store it
 
 		}
 
@@ -1123,7 +1088,7 @@ bool Player::CheckMovementInfo(MovementInfo const& movementInfo, bool jump)
 		if (HasAura(605))
 			HackReport << " (|cffFF0000has mind control|r), controlled by: " << ChatHandler(m_mover->GetAffectingPlayer()->ToPlayer()->GetSession()).GetNameLink();
 		HackReport << "\n|cffFF0000Additional info [debug]|r: distance traveled: |cffFF0000" << distance << "|r, distance allowed: |cffFF0000" << normaldistance << "|r, ping: |cffFF0000" << ping;
-		TeleportTo(AntiHackSave[m_mover->ToPlayer()->GetGUID()].location); //port back
+		TeleportTo(m_mover->ToPlayer()->GetAnticheatData().GetSavedLocation().location); //port back
 		sWorld->SendAntiCheat(m_mover->ToPlayer()->GetSession(), LANG_GM_BROADCAST, HackReport.str().c_str());
 		return false;
 	}
@@ -33,9 +33,6 @@ enum DetectionTypes
 	CLIMB_HACK_DETECTION = 32
 };
 
-// GUIDLow is the key.
-typedef std::map<uint32, AnticheatData> AnticheatPlayersDataMap;
-
 class AnticheatMgr
 {
 	friend class ACE_Singleton<AnticheatMgr, ACE_Null_Mutex>;
@@ -44,38 +41,31 @@ class AnticheatMgr
 
 public:
 
-	void StartHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
-	void DeletePlayerReport(Player* player, bool login);
-	void DeletePlayerData(Player* player);
-	void CreatePlayerData(Player* player);
-	void SavePlayerData(Player* player);
+	// Per player state lives in Player::GetAnticheatData(), the manager itself is stateless
+	void StartHackDetection(Player* player, MovementInfo const& movementInfo, uint32 opcode);
+	void SavePlayerData(Player* player, SQLTransaction& trans);
 
 	void StartScripts();
 
 	void HandlePlayerLogin(Player* player);
 	void HandlePlayerLogout(Player* player);
 
-	uint32 GetTotalReports(uint32 lowGUID);
-	float GetAverage(uint32 lowGUID);
-	uint32 GetTypeReports(uint32 lowGUID, uint8 type);
-
 	void AnticheatGlobalCommand(ChatHandler* handler);
-	void AnticheatDeleteCommand(uint32 guid);
+	// NULL resets every online player
+	void AnticheatDeleteCommand(Player* player);
 
 	void ResetDailyReportStates();
 private:
-	void SpeedHackDetection(Player* player, MovementInfo movementInfo);
-	void FlyHackDetection(Player* player, MovementInfo movementInfo);
-	void WalkOnWaterHackDetection(Player* player, MovementInfo movementInfo);
-	void JumpHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
-	void TeleportPlaneHackDetection(Player* player, MovementInfo);
-	void ClimbHackDetection(Player* player, MovementInfo movementInfo, uint32 opcode);
+	void SpeedHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+	void FlyHackDetection(Player* player, AnticheatData& data);
+	void WalkOnWaterHackDetection(Player* player, AnticheatData& data);
+	void JumpHackDetection(Player* player, AnticheatData& data, uint32 opcode);
+	void TeleportPlaneHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo);
+	void ClimbHackDetection(Player* player, AnticheatData& data, MovementInfo const& movementInfo, uint32 opcode);
 
-	void BuildReport(Player* player, uint8 reportType);
+	void BuildReport(Player* player, AnticheatData& data, uint8 reportType);
 
 	bool MustCheckTempReports(uint8 type);
-
-	AnticheatPlayersDataMap m_Players;                        ///< Player data
 };
 
 #define sAnticheatMgr ACE_Singleton<AnticheatMgr, ACE_Null_Mutex>::instance()
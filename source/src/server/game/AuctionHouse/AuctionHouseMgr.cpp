@@ -421,12 +421,14 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    AddToSearchIndex(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    RemoveFromSearchIndex(auction);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -522,232 +524,339 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-struct AuctionsItems{
-    AuctionEntry * Aentry;
-    Item* item;
-    ItemTemplate const* proto;
-};
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry* auction)
+{
+    // items are added to the manager before their auction, an auction without item is never listed
+    Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow);
+    if (!item)
+        return;
+
+    AuctionSearchEntry& entry = _searchAll[auction->Id];
+    entry.Auction = auction;
+    entry.AuctionItem = item;
+    entry.Proto = item->GetTemplate();
+
+    // the indexes point into _searchAll, its nodes stay in place until the auction is removed
+    _searchByClass[entry.Proto->Class][auction->Id] = &entry;
+    _searchBySubClass[(entry.Proto->Class << 16) | entry.Proto->SubClass][auction->Id] = &entry;
+    _searchByInventoryType[entry.Proto->InventoryType][auction->Id] = &entry;
+    _searchByQuality[entry.Proto->Quality][auction->Id] = &entry;
+    _searchByLevel[entry.Proto->RequiredLevel][auction->Id] = &entry;
+}
+
+void AuctionHouseObject::RemoveFromSearchIndex(AuctionEntry* auction)
+{
+    AuctionSearchMap::iterator itr = _searchAll.find(auction->Id);
+    if (itr == _searchAll.end())
+        return;
+
+    ItemTemplate const* proto = itr->second.Proto;
+    _searchByClass[proto->Class].erase(auction->Id);
+    _searchBySubClass[(proto->Class << 16) | proto->SubClass].erase(auction->Id);
+    _searchByInventoryType[proto->InventoryType].erase(auction->Id);
+    _searchByQuality[proto->Quality].erase(auction->Id);
+    _searchByLevel[proto->RequiredLevel].erase(auction->Id);
+    _searchAll.erase(itr);
+}
+
+std::wstring const& AuctionHouseObject::GetSearchName(AuctionSearchEntry const& entry, LocaleConstant dbLocale, LocaleConstant dbcLocale)
+{
+    int32 propRefID = entry.AuctionItem->GetItemRandomPropertyId();
+    uint64 key = (uint64(dbLocale) << 56) | (uint64(entry.Proto->ItemId) << 32) | uint32(propRefID);
+
+    AuctionSearchNameMap::iterator itr = _searchNames[dbcLocale].find(key);
+    if (itr != _searchNames[dbcLocale].end())
+        return itr->second;
+
+    std::string name = entry.Proto->Name1;
+
+    // local name
+    if (ItemLocale const* il = sObjectMgr->GetItemLocale(entry.Proto->ItemId))
+        ObjectMgr::GetLocaleString(il->Name, dbLocale, name);
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    if (propRefID)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID))
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            if (char* temp = itemRandProp->nameSuffix)
+            {
+                name += ' ';
+                name += temp[dbcLocale];
+            }
+        }
+    }
+
+    // an empty or invalid name never matches, same as an empty cached name
+    std::wstring& wname = _searchNames[dbcLocale][key];
+    if (!entry.Proto->Name1.empty() && Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
 
-struct QualityCMP{
+    return wname;
+}
+
+struct AuctionSearchLevelCompare
+{
     bool sort;
-    bool operator() ( const AuctionsItems * s1,const AuctionsItems * s2)
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
     {
-        return ( sort ) ? s1->proto->Quality < s2->proto->Quality : s1->proto->Quality > s2->proto->Quality;
+        if (s1->Proto->RequiredLevel != s2->Proto->RequiredLevel)
+            return sort ? s1->Proto->RequiredLevel < s2->Proto->RequiredLevel : s1->Proto->RequiredLevel > s2->Proto->RequiredLevel;
+        return s1->Auction->Id < s2->Auction->Id;
     }
 };
-struct LevelCMP{
-    
+
+struct AuctionSearchQualityCompare
+{
     bool sort;
-    bool operator() ( const AuctionsItems * s1,const AuctionsItems * s2)
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
     {
-        return ( sort ) ? s1->proto->RequiredLevel < s2->proto->RequiredLevel : s1->proto->RequiredLevel > s2->proto->RequiredLevel;
+        if (s1->Proto->Quality != s2->Proto->Quality)
+            return sort ? s1->Proto->Quality < s2->Proto->Quality : s1->Proto->Quality > s2->Proto->Quality;
+        return s1->Auction->Id < s2->Auction->Id;
     }
 };
-struct ExpireCMP{
-    
+
+struct AuctionSearchExpireCompare
+{
     bool sort;
-    bool operator() ( const AuctionsItems * s1,const AuctionsItems * s2)
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
     {
-        return ( sort ) ? s1->Aentry->expire_time < s2->Aentry->expire_time : s1->Aentry->expire_time > s2->Aentry->expire_time;
+        if (s1->Auction->expire_time != s2->Auction->expire_time)
+            return sort ? s1->Auction->expire_time < s2->Auction->expire_time : s1->Auction->expire_time > s2->Auction->expire_time;
+        return s1->Auction->Id < s2->Auction->Id;
     }
 };
-struct NameCMP{
-    
+
+struct AuctionSearchOwnerCompare
+{
     bool sort;
-    bool operator() ( const AuctionsItems * s1,const AuctionsItems * s2)
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
     {
-        return ( sort ) ? s1->Aentry->owner < s2->Aentry->owner : s1->Aentry->owner > s2->Aentry->owner;
+        if (s1->Auction->owner != s2->Auction->owner)
+            return sort ? s1->Auction->owner < s2->Auction->owner : s1->Auction->owner > s2->Auction->owner;
+        return s1->Auction->Id < s2->Auction->Id;
     }
 };
-struct BidCMD{
-    
+
+struct AuctionSearchBidCompare
+{
     bool sort;
-    bool operator() ( const AuctionsItems * s1,const AuctionsItems * s2)
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
     {
-        return ( sort ) ? s1->Aentry->bid < s2->Aentry->bid : s1->Aentry->bid > s2->Aentry->bid;
+        if (s1->Auction->bid != s2->Auction->bid)
+            return sort ? s1->Auction->bid < s2->Auction->bid : s1->Auction->bid > s2->Auction->bid;
+        return s1->Auction->Id < s2->Auction->Id;
     }
 };
 
+struct AuctionSearchIdCompare
+{
+    bool operator()(AuctionHouseObject::AuctionSearchEntry const* s1, AuctionHouseObject::AuctionSearchEntry const* s2) const
+    {
+        return s1->Auction->Id < s2->Auction->Id;
+    }
+};
 
+// sorts only as far as the requested page reaches, the auction id breaks ties so every page end sees the same order
+template<class Compare>
+static void SortAuctionPage(std::vector<AuctionHouseObject::AuctionSearchEntry const*>& results, uint32 pageEnd, Compare compare)
+{
+    if (pageEnd >= results.size())
+        std::sort(results.begin(), results.end(), compare);
+    else
+        std::partial_sort(results.begin(), results.begin() + pageEnd, results.end(), compare);
+}
 
 void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
                                                std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
                                                uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,uint8 filter,uint8 sort,
                                                uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-    
-    
-    std::vector<AuctionsItems*> items;
-    
-    // Two-dimensional key
-    std::map<uint32,            //[item_id]
-        std::map<uint64,        //[seller_guid]
-            std::map<uint32,    //[stack amount]
-                uint32          //[count]
-                >>> ah_post_count;
-
-    // Two-dimensional key
-    std::map<uint32,            //[item_id]
-        std::map<uint64,        //[seller_guid]
-        uint32          //[count]
-        >> ah_post_combined_count;
-
-
-    /*
-    for (int i = 0; i < 2; i++)
-        for (int j = 0; j < 2; j++)
-            for (int k = 0; k < 2; k++)
-            ah_post_count[i][j][k] = 20;
-    */
+    LocaleConstant loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+    LocaleConstant locdbc_idx = player->GetSession()->GetSessionDbcLocale();
 
+    _searchCandidates.clear();
+    _searchResults.clear();
 
-    for (auto itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    // take the smallest indexed set the query is restricted to, all auctions if there is none
+    AuctionSearchRefMap const* candidates = NULL;
+    bool levelCandidates = false;
+
+    if (itemClass != 0xffffffff)
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
-        
-        ItemTemplate const* proto = item->GetTemplate();
-        
+        AuctionSearchIndex::const_iterator itr = itemSubClass != 0xffffffff ? _searchBySubClass.find((itemClass << 16) | itemSubClass) : _searchByClass.find(itemClass);
+        if (itr == (itemSubClass != 0xffffffff ? _searchBySubClass.end() : _searchByClass.end()))
+            return;
+
+        candidates = &itr->second;
+    }
+
+    if (inventoryType != 0xffffffff)
+    {
+        AuctionSearchIndex::const_iterator itr = _searchByInventoryType.find(inventoryType);
+        if (itr == _searchByInventoryType.end())
+            return;
+
+        if (!candidates || itr->second.size() < candidates->size())
+            candidates = &itr->second;
+    }
+
+    if (quality != 0xffffffff)
+    {
+        AuctionSearchIndex::const_iterator itr = _searchByQuality.find(quality);
+        if (itr == _searchByQuality.end())
+            return;
+
+        if (!candidates || itr->second.size() < candidates->size())
+            candidates = &itr->second;
+    }
+
+    if (levelmin != 0x00)
+    {
+        uint32 levelCount = 0;
+        uint32 levelEnd = levelmax != 0x00 ? levelmax : 0xFF;
+        for (uint32 level = levelmin; level <= levelEnd; ++level)
+        {
+            AuctionSearchIndex::const_iterator itr = _searchByLevel.find(level);
+            if (itr != _searchByLevel.end())
+                levelCount += itr->second.size();
+        }
+
+        if (levelCount < (candidates ? candidates->size() : _searchAll.size()))
+        {
+            levelCandidates = true;
+            for (uint32 level = levelmin; level <= levelEnd; ++level)
+            {
+                AuctionSearchIndex::const_iterator itr = _searchByLevel.find(level);
+                if (itr != _searchByLevel.end())
+                    for (AuctionSearchRefMap::const_iterator entry = itr->second.begin(); entry != itr->second.end(); ++entry)
+                        _searchCandidates.push_back(entry->second);
+            }
+
+            // keep the auction order of the other indexes, flood control keeps the first auctions of a seller
+            std::sort(_searchCandidates.begin(), _searchCandidates.end(), AuctionSearchIdCompare());
+        }
+    }
+
+    if (!levelCandidates && candidates)
+    {
+        for (AuctionSearchRefMap::const_iterator entry = candidates->begin(); entry != candidates->end(); ++entry)
+            _searchCandidates.push_back(entry->second);
+    }
+    else if (!levelCandidates)
+    {
+        for (AuctionSearchMap::const_iterator entry = _searchAll.begin(); entry != _searchAll.end(); ++entry)
+            _searchCandidates.push_back(&entry->second);
+    }
+
+    // item entry and seller, plus stack size when flood control counts stacks separately
+    typedef std::pair<uint64, uint32> AuctionFloodKey;
+    std::map<AuctionFloodKey, uint32> floodCounts;
+    uint32 floodLimit = sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_VALUE);
+    uint32 floodType = sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_TYPE);
+
+    for (std::vector<AuctionSearchEntry const*>::const_iterator itr = _searchCandidates.begin(); itr != _searchCandidates.end(); ++itr)
+    {
+        AuctionSearchEntry const* entry = *itr;
+        ItemTemplate const* proto = entry->Proto;
+
         if (itemClass != 0xffffffff && proto->Class != itemClass)
             continue;
-        
+
         if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
             continue;
-        
+
         if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
             continue;
-        
+
         if (quality != 0xffffffff && proto->Quality != quality)
             continue;
-        
+
         if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
             continue;
-        
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+
+        if (usable != 0x00 && player->CanUseItem(entry->AuctionItem) != EQUIP_ERR_OK)
             continue;
-        
+
         // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-            // No need to do any of this if no search term was entered
-            if (!wsearchedname.empty())
-            {
-                std::string name = proto->Name1;
-                if (name.empty())
-                    continue;
-                
-                // local name
-                    if (loc_idx >= 0)
-                        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                            ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-                        
-                        // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-                            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-                            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-                            int32 propRefID = item->GetItemRandomPropertyId();
-                            
-                            if (propRefID)
-                            {
-                                // Append the suffix to the name (ie: of the Monkey) if one exists
-                                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                                //  even though the DBC names seem misleading
-                                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-                                
-                                if (itemRandProp)
-                                {
-                                    char* temp = itemRandProp->nameSuffix;
-                                    
-                                    // dbc local name
-                                    if (temp)
-                                    {
-                                        // Append the suffix (ie: of the Monkey) to the name using localization
-                                        // or default enUS if localization is invalid
-                                        name += ' ';
-                                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                                    }
-                                }
-                            }
-                            
-                            // Perform the search (with or without suffix)
-                            if (!Utf8FitTo(name, wsearchedname))
-                                continue;
-            }
-            
+        // No need to do any of this if no search term was entered
+        if (!wsearchedname.empty())
+        {
+            std::wstring const& name = GetSearchName(*entry, loc_idx, locdbc_idx);
+            if (name.empty() || name.find(wsearchedname) == std::wstring::npos)
+                continue;
+        }
 
-            if (sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_VALUE))
-            {
-                if (sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_TYPE) == AH_FLOOD_LIMIT_BY_ANY_STACK_OF_ITEM_FROM_PLAYER)
-                {
-                    ah_post_combined_count[item->GetEntry()][uint64(Aentry->owner)] += 0;//initialize if the value hasn't existed yet
-                    ah_post_combined_count[item->GetEntry()][uint64(Aentry->owner)] += 1;//actually adjust the count
-                    if (ah_post_combined_count[item->GetEntry()][uint64(Aentry->owner)] > sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_VALUE))
-                        continue;
-                }
-                else if (sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_TYPE) == AH_FLOOD_LIMIT_BY_SPECIFIC_STACK_OF_ITEM_FROM_PLAYER)
-                {
-                    ah_post_count[item->GetEntry()][uint64(Aentry->owner)][item->GetCount()] += 0;//initialize if the value hasn't existed yet
-                    ah_post_count[item->GetEntry()][uint64(Aentry->owner)][item->GetCount()] += 1;//actually adjust the count
-                    if (ah_post_count[item->GetEntry()][uint64(Aentry->owner)][item->GetCount()] > sWorld->getIntConfig(CONFIG_AUCTION_FLOOD_CONTROL_VALUE))
-                        continue;
-                }
-            }
+        if (floodLimit)
+        {
+            AuctionFloodKey key((uint64(entry->AuctionItem->GetEntry()) << 32) | entry->Auction->owner, 0);
+            if (floodType == AH_FLOOD_LIMIT_BY_SPECIFIC_STACK_OF_ITEM_FROM_PLAYER)
+                key.second = entry->AuctionItem->GetCount();
+
+            if ((floodType == AH_FLOOD_LIMIT_BY_ANY_STACK_OF_ITEM_FROM_PLAYER || floodType == AH_FLOOD_LIMIT_BY_SPECIFIC_STACK_OF_ITEM_FROM_PLAYER)
+                && ++floodCounts[key] > floodLimit)
+                continue;
+        }
 
-            AuctionsItems* temp = new AuctionsItems;
-            temp->Aentry = Aentry;
-            temp->item = item;
-            temp->proto = proto;
-            items.push_back(temp);
-            
+        _searchResults.push_back(entry);
     }
-    
-    switch(filter){
+
+    uint32 pageEnd = listfrom + MAX_AUCTIONS_PER_PAGE;
+    switch (filter)
+    {
         case 0:
         {
-            LevelCMP tmp;
-            tmp.sort = sort;
-            std::sort(items.begin(),items.end(),tmp);
+            AuctionSearchLevelCompare compare;
+            compare.sort = sort;
+            SortAuctionPage(_searchResults, pageEnd, compare);
+            break;
         }
-        break;
-        case 1: 
+        case 1:
         {
-            QualityCMP tmp;
-            tmp.sort = sort;
-            std::sort(items.begin(),items.end(),tmp);
+            AuctionSearchQualityCompare compare;
+            compare.sort = sort;
+            SortAuctionPage(_searchResults, pageEnd, compare);
+            break;
         }
-        break;
         case 3:
         {
-            ExpireCMP tmp;
-            tmp.sort = sort;
-            std::sort(items.begin(),items.end(),tmp);
+            AuctionSearchExpireCompare compare;
+            compare.sort = sort;
+            SortAuctionPage(_searchResults, pageEnd, compare);
+            break;
         }
-        break;
         case 7:
         {
-            NameCMP tmp; //hmm
-            tmp.sort = sort;
-            std::sort(items.begin(),items.end(),tmp);
+            AuctionSearchOwnerCompare compare; //hmm
+            compare.sort = sort;
+            SortAuctionPage(_searchResults, pageEnd, compare);
+            break;
         }
-        break;
         case 8:
         {
-            BidCMD tmp;
-            tmp.sort = sort;
-            std::sort(items.begin(),items.end(),tmp);
+            AuctionSearchBidCompare compare;
+            compare.sort = sort;
+            SortAuctionPage(_searchResults, pageEnd, compare);
+            break;
         }
-        break;
     }
-    
-    totalcount = items.size();
-    
-    for(uint32 i = listfrom; count < 50 && i < items.size(); i++){
+
+    totalcount = _searchResults.size();
+
+    for (uint32 i = listfrom; count < MAX_AUCTIONS_PER_PAGE && i < _searchResults.size(); ++i)
+    {
         ++count;
-        AuctionsItems * h = items.operator[](i);
-        h->Aentry->BuildAuctionInfo(data);
+        _searchResults[i]->Auction->BuildAuctionInfo(data);
     }
-    
 }
 
 //this function inserts to WorldPacket auction's data
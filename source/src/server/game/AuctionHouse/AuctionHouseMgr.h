@@ -28,9 +28,11 @@
 class Item;
 class Player;
 class WorldPacket;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
+#define MAX_AUCTIONS_PER_PAGE 50
 
 enum AuctionError
 {
@@ -133,11 +135,42 @@ class AuctionHouseObject
                                uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,uint8 filter,uint8 sort,
                                uint32& count, uint32& totalcount);
 
+    // cached for searches, item and template of an auction never change
+    struct AuctionSearchEntry
+    {
+        AuctionEntry* Auction;
+        Item* AuctionItem;
+        ItemTemplate const* Proto;
+    };
+
   private:
+    // by auction id, iterates in the same order as AuctionsMap
+    typedef std::map<uint32, AuctionSearchEntry> AuctionSearchMap;
+    typedef std::map<uint32, AuctionSearchEntry const*> AuctionSearchRefMap;
+    typedef UNORDERED_MAP<uint32, AuctionSearchRefMap> AuctionSearchIndex;
+    // lower case item name with random property suffix, by item entry and random property
+    typedef UNORDERED_MAP<uint64, std::wstring> AuctionSearchNameMap;
+
+    void AddToSearchIndex(AuctionEntry* auction);
+    void RemoveFromSearchIndex(AuctionEntry* auction);
+    std::wstring const& GetSearchName(AuctionSearchEntry const& entry, LocaleConstant dbLocale, LocaleConstant dbcLocale);
+
     AuctionEntryMap AuctionsMap;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
+
+    AuctionSearchMap _searchAll;
+    AuctionSearchIndex _searchByClass;
+    AuctionSearchIndex _searchBySubClass;                   // class << 16 | subclass
+    AuctionSearchIndex _searchByInventoryType;
+    AuctionSearchIndex _searchByQuality;
+    AuctionSearchIndex _searchByLevel;                      // required level
+    AuctionSearchNameMap _searchNames[TOTAL_LOCALES];       // by dbc locale of the searching session
+
+    // reused by every search, auction handlers are serialized by LOCK_DOMAIN_AUCTION
+    std::vector<AuctionSearchEntry const*> _searchCandidates;
+    std::vector<AuctionSearchEntry const*> _searchResults;
 };
 
 class AuctionHouseMgr
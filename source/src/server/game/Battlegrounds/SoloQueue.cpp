@@ -48,26 +48,15 @@ void SoloQueue::AddPlayer(Player* player)
             player->soloQueueSpec = player->GetActiveSpec();
             player->AddBattlegroundQueueId(BATTLEGROUND_QUEUE_3v3_SOLO);
 
-            switch (GetPlayerTalentCategory(player))
+            soloInfo->talentCategory = GetPlayerTalentCategory(player);
+            if (SoloQueueMmrMap* queue = GetQueue(soloInfo->talentCategory))
             {
-                case TALENT_CAT_HEALER:
-                    queuedHealers.emplace(soloInfo->ArenaMatchmakerRating, soloInfo);
-                    allPlayersInQueue.emplace(player->GetGUID(), soloInfo);
-                    break;
-                case TALENT_CAT_MELEE:
-                    queuedMelees.emplace(soloInfo->ArenaMatchmakerRating, soloInfo);
-                    allPlayersInQueue.emplace(player->GetGUID(), soloInfo);
-                    break;
-                case TALENT_CAT_RANGE:
-                    queuedRanges.emplace(soloInfo->ArenaMatchmakerRating, soloInfo);
-                    allPlayersInQueue.emplace(player->GetGUID(), soloInfo);
-                    break;
-                case TALENT_CAT_DPS:
-                    queuedDps.emplace(soloInfo->ArenaMatchmakerRating, soloInfo);
-                    allPlayersInQueue.emplace(player->GetGUID(), soloInfo);
-                default:
-                    break;
+                queue->emplace(soloInfo->ArenaMatchmakerRating, soloInfo);
+                allPlayersInQueue.emplace(player->GetGUID(), soloInfo);
             }
+            else
+                delete soloInfo;
+
             ChatHandler(player->GetSession()).PSendSysMessage("You are now listed for random solo arena! The solo queue system will now try to find group members based on your MMR!");
         }
     }
@@ -75,40 +64,47 @@ void SoloQueue::AddPlayer(Player* player)
 
 bool SoloQueue::RemovePlayer(uint64 playerGuid)
 {
-    allPlayersInQueue.erase(playerGuid);
+    auto itr = allPlayersInQueue.find(playerGuid);
+    if (itr == allPlayersInQueue.end())
+        return false;
 
-    for (auto itr = queuedRanges.begin(); itr != queuedRanges.end(); ++itr)
-        if (itr->second->playerGuid == playerGuid)
-        {
-            delete itr->second;
-            queuedRanges.erase(itr);
-            return true;
-        }
+    SoloQueueInfo* soloInfo = itr->second;
+    allPlayersInQueue.erase(itr);
 
-    for (auto itr = queuedHealers.begin(); itr != queuedHealers.end(); ++itr)
-        if (itr->second->playerGuid == playerGuid)
+    // the MMR is fixed while queued, only players with the same MMR have to be compared
+    if (SoloQueueMmrMap* queue = GetQueue(soloInfo->talentCategory))
+    {
+        auto bounds = queue->equal_range(soloInfo->ArenaMatchmakerRating);
+        for (auto queueItr = bounds.first; queueItr != bounds.second; ++queueItr)
         {
-            delete itr->second;
-            queuedHealers.erase(itr);
-            return true;
+            if (queueItr->second == soloInfo)
+            {
+                queue->erase(queueItr);
+                break;
+            }
         }
+    }
 
-    for (auto itr = queuedMelees.begin(); itr != queuedMelees.end(); ++itr)
-        if (itr->second->playerGuid == playerGuid)
-        {
-            delete itr->second;
-            queuedMelees.erase(itr);
-            return true;
-        }
+    delete soloInfo;
+    return true;
+}
 
-    for (auto itr = queuedDps.begin(); itr != queuedDps.end(); ++itr)
-        if (itr->second->playerGuid == playerGuid)
-        {
-            delete itr->second;
-            queuedDps.erase(itr);
-            return true;
-        }
-    return false;
+SoloQueueMmrMap* SoloQueue::GetQueue(uint8 talentCategory)
+{
+    switch (talentCategory)
+    {
+        case TALENT_CAT_HEALER:
+            return &queuedHealers;
+        case TALENT_CAT_MELEE:
+            return &queuedMelees;
+        case TALENT_CAT_RANGE:
+            return &queuedRanges;
+        case TALENT_CAT_DPS:
+            return &queuedDps;
+        default:
+            break;
+    }
+    return NULL;
 }
 
 void SoloQueue::Update(const uint32 diff)
@@ -128,128 +124,189 @@ void SoloQueue::Update(const uint32 diff)
             IncreasePlayerMMrRange(allPlayer.second);
     }
 
+    if (queuedHealers.empty())
+        return;
+
+    // Every healer is matched with the nearest compatible players by MMR. The categories are
+    // snapshotted into vectors sorted by MMR, so a healer only visits the candidates inside
+    // the widest window of its category instead of the whole queue.
     uint32 maxRatingDiff = sBattlegroundMgr->GetMaxRatingDifference();
-    for (auto itr = queuedHealers.begin(); itr != queuedHealers.end();)
-    {
-        std::list<SoloQueueInfo*> playerList;
-        playerList.push_back(itr->second);
+    bool dpsRestriction = sWorld->getBoolConfig(CONFIG_SOLO_QUEUE_DPS_RESTRICTION);
+    uint32 maxHealerRange, maxMeleeRange = 0, maxRangeRange = 0, maxDpsRange = 0;
 
-        uint32 completeRange = maxRatingDiff + itr->second->ratingRange;
-        uint32 minMMRHeal = std::max(0, int32(itr->second->ArenaMatchmakerRating - completeRange));
-        uint32 maxMMRHeal = std::min(int32(itr->second->ArenaMatchmakerRating + completeRange), 4000);
+    BuildCandidates(queuedHealers, healerCandidates, maxHealerRange, maxRatingDiff, false);
+    if (dpsRestriction)
+    {
+        BuildCandidates(queuedMelees, meleeCandidates, maxMeleeRange, maxRatingDiff, false);
+        BuildCandidates(queuedRanges, rangeCandidates, maxRangeRange, maxRatingDiff, false);
+    }
+    else
+        BuildCandidates(queuedDps, dpsCandidates, maxDpsRange, maxRatingDiff, true);
 
-        if (sWorld->getBoolConfig(CONFIG_SOLO_QUEUE_DPS_RESTRICTION))
+    std::vector<uint64> matchedPlayers;
+    std::list<SoloQueueInfo*> playerList;
+    for (SoloQueueCandidate& healer : healerCandidates)
+    {
+        SoloQueueCandidate* first;
+        SoloQueueCandidate* second;
+        if (dpsRestriction)
         {
-            for (auto& ranges : queuedRanges)
-            {
-                uint32 completeRange = maxRatingDiff + ranges.second->ratingRange;
-                uint32 minMMRRange = std::max(0, int32(ranges.second->ArenaMatchmakerRating - completeRange));
-                uint32 maxMMRRange = std::min(int32(ranges.second->ArenaMatchmakerRating + completeRange), 4000);
-
-                if (IsInMmrRange(minMMRRange, maxMMRRange, itr->second->ArenaMatchmakerRating)
-                    || IsInMmrRange(minMMRHeal, maxMMRHeal, ranges.second->ArenaMatchmakerRating))
-                {
-                    playerList.push_back(ranges.second);
-                    break;
-                }
-            }
+            int32 range = FindNearestCandidate(healer, rangeCandidates, maxRangeRange, false);
+            if (range < 0)
+                continue;
 
-            for (auto& melees : queuedMelees)
-            {
-                uint32 completeRange = maxRatingDiff + melees.second->ratingRange;
-                uint32 minMMRMelee = std::max(0, int32(melees.second->ArenaMatchmakerRating - completeRange));
-                uint32 maxMMRMelee = std::min(int32(melees.second->ArenaMatchmakerRating + completeRange), 4000);
-
-                if (IsInMmrRange(minMMRMelee, maxMMRMelee, itr->second->ArenaMatchmakerRating)
-                    || IsInMmrRange(minMMRHeal, maxMMRHeal, melees.second->ArenaMatchmakerRating))
-                {
-                    playerList.push_back(melees.second);
-                    break;
-                }
-            }
+            int32 melee = FindNearestCandidate(healer, meleeCandidates, maxMeleeRange, false);
+            if (melee < 0)
+                continue;
+
+            first = &rangeCandidates[range];
+            second = &meleeCandidates[melee];
         }
         else
         {
-
-            Classes already_teamed_class { Classes(0) };
-            //TalentTree already_teamed_spec{ TalentTree(0) };
-            for (auto& qddps : queuedDps)
-            {
-                if (playerList.size() == 3)
-                    break;
-                
-                uint32 completeRange = maxRatingDiff + qddps.second->ratingRange;
-                uint32 minMMRdps = std::max(0, int32(qddps.second->ArenaMatchmakerRating - completeRange));
-                uint32 maxMMRdps = std::min(int32(qddps.second->ArenaMatchmakerRating + completeRange), 4000);
-
-                if (IsInMmrRange(minMMRdps, maxMMRdps, itr->second->ArenaMatchmakerRating)
-                    || IsInMmrRange(minMMRHeal, maxMMRHeal, qddps.second->ArenaMatchmakerRating))
-                {
-                    for (SoloQueueInfo* check : playerList)
-                    {
-                        if (check->playerGuid != qddps.second->playerGuid)
-                        {
-                            if (auto player_dps = ObjectAccessor::FindPlayer(qddps.second->playerGuid))
-                                if (auto p_class = player_dps->getClass())
-                                    if (auto spec = TalentTree(player_dps->GetPrimaryTalentTree(player_dps->GetActiveSpec())))
-                                        if (Classes(p_class) != already_teamed_class) /*|| ((Classes(p_class) == CLASS_SHAMAN || Classes(p_class) == CLASS_DRUID) && spec != already_teamed_spec))*/
-                                        {
-                                            //already_teamed_spec     = TalentTree(player_dps->GetPrimaryTalentTree(player_dps->GetActiveSpec()));
-                                            already_teamed_class = Classes(p_class);
-                                            playerList.push_back(qddps.second);
-                                            break;
-                                        }
-                        }
-                        else
-                            continue;
-                    }
-                }
-            }
+            // both dps have to be online and of different classes
+            int32 dps = FindNearestCandidate(healer, dpsCandidates, maxDpsRange, true);
+            if (dps < 0)
+                continue;
+
+            first = &dpsCandidates[dps];
+            first->taken = true;
+            int32 otherDps = FindNearestCandidate(healer, dpsCandidates, maxDpsRange, true, first->playerClass);
+            first->taken = false;
+            if (otherDps < 0)
+                continue;
+
+            second = &dpsCandidates[otherDps];
         }
 
-        if (playerList.size() == 3)
+        playerList.clear();
+        playerList.push_back(healer.info);
+        playerList.push_back(first->info);
+        playerList.push_back(second->info);
+        if (!CreateTeam(playerList))
+            continue;
+
+        healer.taken = first->taken = second->taken = true;
+        for (SoloQueueInfo* info : playerList)
+            matchedPlayers.push_back(info->playerGuid);
+    }
+
+    // everything is done - remove players from solo queue, the candidates still point to their infos until here
+    for (uint64 guid : matchedPlayers)
+        RemovePlayer(guid);
+}
+
+void SoloQueue::BuildCandidates(SoloQueueMmrMap const& queue, SoloQueueCandidateList& candidates, uint32& maxRange, uint32 maxRatingDiff, bool needClass)
+{
+    candidates.clear();
+    candidates.reserve(queue.size());
+    maxRange = 0;
+
+    // the multimap is ordered by MMR already
+    for (auto const& itr : queue)
+    {
+        SoloQueueCandidate candidate;
+        candidate.info = itr.second;
+        candidate.mmr = itr.second->ArenaMatchmakerRating;
+        candidate.range = maxRatingDiff + itr.second->ratingRange;
+        candidate.minMmr = std::max(0, int32(candidate.mmr - candidate.range));
+        candidate.maxMmr = std::min(int32(candidate.mmr + candidate.range), 4000);
+        candidate.playerClass = 0;
+        candidate.taken = false;
+
+        if (needClass)
+            if (Player* player = ObjectAccessor::FindPlayer(itr.second->playerGuid))
+                if (player->GetPrimaryTalentTree(player->GetActiveSpec()))
+                    candidate.playerClass = player->getClass();
+
+        maxRange = std::max(maxRange, candidate.range);
+        candidates.push_back(candidate);
+    }
+}
+
+int32 SoloQueue::FindNearestCandidate(SoloQueueCandidate const& healer, SoloQueueCandidateList const& candidates, uint32 maxRange, bool needClass, uint8 excludedClass)
+{
+    // Two players are compatible if either MMR lies in the window of the other one, so no
+    // compatible candidate is farther away than the wider of both ranges.
+    uint32 searchRange = std::max(healer.range, maxRange);
+    int32 size = int32(candidates.size());
+    int32 up = int32(std::lower_bound(candidates.begin(), candidates.end(), healer.mmr,
+        [](SoloQueueCandidate const& candidate, uint32 mmr) { return candidate.mmr < mmr; }) - candidates.begin());
+    int32 down = up - 1;
+
+    while (true)
+    {
+        bool hasUp = up < size && candidates[up].mmr - healer.mmr <= searchRange;
+        bool hasDown = down >= 0 && healer.mmr - candidates[down].mmr <= searchRange;
+        if (!hasUp && !hasDown)
+            return -1;
+
+        int32 index;
+        if (hasUp && (!hasDown || candidates[up].mmr - healer.mmr <= healer.mmr - candidates[down].mmr))
+            index = up++;
+        else
+            index = down--;
+
+        SoloQueueCandidate const& candidate = candidates[index];
+        if (candidate.taken)
+            continue;
+
+        if (needClass && (!candidate.playerClass || candidate.playerClass == excludedClass))
+            continue;
+
+        if (IsInMmrRange(candidate.minMmr, candidate.maxMmr, healer.mmr)
+            || IsInMmrRange(healer.minMmr, healer.maxMmr, candidate.mmr))
+            return index;
+    }
+}
+
+bool SoloQueue::CreateTeam(std::list<SoloQueueInfo*>& playerList)
+{
+    Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(BATTLEGROUND_AA);
+    if (!bg)
+        return false;
+
+    bg->SetRated(true);
+    BattlegroundTypeId bgTypeId = bg->GetTypeID();
+    BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, ARENA_TYPE_3v3_SOLO);
+    PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketByLevel(bg->GetMapId(), 85);
+    if (!bracketEntry)
+        return false;
+
+    BattlegroundQueue &bgQueue = sBattlegroundMgr->GetBattlegroundQueue(bgQueueTypeId);
+    GroupQueueInfo* ginfo = bgQueue.AddSoloQueueGroup(playerList, bracketEntry->GetBracketId(), ALLIANCE);
+
+    uint32 minMmr = 0xFFFFFFFF;
+    uint32 maxMmr = 0;
+    uint32 maxWaitTime = 0;
+    for (SoloQueueInfo* info : playerList)
+    {
+        if (Player* player = ObjectAccessor::FindPlayer(info->playerGuid))
         {
-            if (Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(BATTLEGROUND_AA))
-            {
-                bg->SetRated(true);
-                BattlegroundTypeId bgTypeId = bg->GetTypeID();
-                BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, ARENA_TYPE_3v3_SOLO);
-                if (PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketByLevel(bg->GetMapId(), 85))
-                {
-                    BattlegroundQueue &bgQueue = sBattlegroundMgr->GetBattlegroundQueue(bgQueueTypeId);
-                    GroupQueueInfo* ginfo = bgQueue.AddSoloQueueGroup(playerList, bracketEntry->GetBracketId(), ALLIANCE);
-
-                    for (SoloQueueInfo* info : playerList)
-                    {
-                        if (Player* player = ObjectAccessor::FindPlayer(info->playerGuid))
-                        {
-                            player->AddBattlegroundQueueJoinTime(bgTypeId, ginfo->JoinTime);
-                            uint32 avgTime = bgQueue.GetAverageQueueWaitTime(ginfo, bracketEntry->GetBracketId());
-                            uint32 queueSlot = player->GetBattlegroundQueueIndex(BATTLEGROUND_QUEUE_3v3_SOLO);
-                            WorldPacket data;
-                            sBattlegroundMgr->BuildBattlegroundStatusPacket(&data, bg, player, queueSlot, STATUS_WAIT_QUEUE, avgTime, ginfo->JoinTime, ARENA_TYPE_3v3_SOLO);
-                            player->GetSession()->SendPacket(&data);
-                        }
-                    }
-                    sBattlegroundMgr->ScheduleQueueUpdate(ginfo->ArenaMatchmakerRating, ARENA_TYPE_3v3_SOLO, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
-
-                    // everything is done - remove players from solo queue 
-                    for (SoloQueueInfo* soloInfo : playerList)
-                    {
-                        if (soloInfo->playerGuid == itr->second->playerGuid)
-                            continue;
-                        RemovePlayer(soloInfo->playerGuid);
-                    }
-                    // we cant remove the heal with RemovePlayer because we still using the itr here
-                    allPlayersInQueue.erase(itr->second->playerGuid);
-                    delete itr->second;
-                    itr = queuedHealers.erase(itr);
-                    continue;
-                }
-            }
+            player->AddBattlegroundQueueJoinTime(bgTypeId, ginfo->JoinTime);
+            uint32 avgTime = bgQueue.GetAverageQueueWaitTime(ginfo, bracketEntry->GetBracketId());
+            uint32 queueSlot = player->GetBattlegroundQueueIndex(BATTLEGROUND_QUEUE_3v3_SOLO);
+            WorldPacket data;
+            sBattlegroundMgr->BuildBattlegroundStatusPacket(&data, bg, player, queueSlot, STATUS_WAIT_QUEUE, avgTime, ginfo->JoinTime, ARENA_TYPE_3v3_SOLO);
+            player->GetSession()->SendPacket(&data);
         }
-        itr++;
+
+        uint32 waitTime = GetMSTimeDiffToNow(info->joinTime);
+        matchStats.TotalWaitTime += waitTime;
+        maxWaitTime = std::max(maxWaitTime, waitTime);
+        minMmr = std::min(minMmr, info->ArenaMatchmakerRating);
+        maxMmr = std::max(maxMmr, info->ArenaMatchmakerRating);
     }
+    sBattlegroundMgr->ScheduleQueueUpdate(ginfo->ArenaMatchmakerRating, ARENA_TYPE_3v3_SOLO, bgQueueTypeId, bgTypeId, bracketEntry->GetBracketId());
+
+    uint32 mmrSpread = maxMmr - minMmr;
+    ++matchStats.Matches;
+    matchStats.MaxWaitTime = std::max(matchStats.MaxWaitTime, maxWaitTime);
+    matchStats.TotalMmrSpread += mmrSpread;
+    matchStats.MaxMmrSpread = std::max(matchStats.MaxMmrSpread, mmrSpread);
+
+    TC_LOG_DEBUG("bg.arena", "SoloQueue: team formed around MMR %u, MMR spread %u, longest wait %u ms", ginfo->ArenaMatchmakerRating, mmrSpread, maxWaitTime);
+    return true;
 }
 
 uint32 SoloQueue::GetPlayerCountInQueue(SoloQueueTalentCategory talentCategory, bool allPlayers)
@@ -257,19 +314,8 @@ uint32 SoloQueue::GetPlayerCountInQueue(SoloQueueTalentCategory talentCategory,
     if (allPlayers)
         return allPlayersInQueue.size();
 
-    switch (talentCategory)
-    {
-        case TALENT_CAT_HEALER:
-            return queuedHealers.size();
-        case TALENT_CAT_MELEE:
-            return queuedMelees.size();
-        case TALENT_CAT_RANGE:
-            return queuedRanges.size();
-        case TALENT_CAT_DPS:
-            return queuedDps.size();
-        default:
-            break;
-    }
+    if (SoloQueueMmrMap* queue = GetQueue(talentCategory))
+        return queue->size();
     return 0;
 }
 
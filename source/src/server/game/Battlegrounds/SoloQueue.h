@@ -22,6 +22,33 @@ struct SoloQueueInfo
     uint32  ratingRangeIncreaseCounter = 0;                                         // Rating increase counter for team forming
     uint32  lastMmrUpdate = getMSTime();                                            // Rating update timer
     uint32  team;                                                                   // ALLIANCE or HORDE
+    uint32  joinTime = getMSTime();                                                 // Queue join time, for pop latency
+    uint8   talentCategory = TALENT_CAT_UNKNOWN;                                    // SoloQueueTalentCategory the player is queued as
+};
+
+// Queued player as seen by one matching pass, the candidates of a category are sorted by MMR
+struct SoloQueueCandidate
+{
+    SoloQueueInfo* info;
+    uint32 mmr;
+    uint32 range;                                                                   // max rating difference plus the widened range
+    uint32 minMmr;                                                                  // MMR window of the player, range clamped to 0..4000
+    uint32 maxMmr;
+    uint8 playerClass;                                                              // 0 if the player is offline
+    bool taken;                                                                     // already in a team of this pass
+};
+
+typedef std::vector<SoloQueueCandidate> SoloQueueCandidateList;
+typedef std::multimap<uint32/* mmr */, SoloQueueInfo*> SoloQueueMmrMap;
+
+// Matching statistics since startup
+struct SoloQueueMatchStats
+{
+    uint32 Matches = 0;
+    uint64 TotalWaitTime = 0;                                                       // ms, over every matched player
+    uint32 MaxWaitTime = 0;
+    uint64 TotalMmrSpread = 0;                                                      // highest minus lowest MMR of a team
+    uint32 MaxMmrSpread = 0;
 };
 
 #define sSoloQueueMgr SoloQueue::instance()
@@ -37,17 +64,32 @@ class SoloQueue
         bool RemovePlayer(uint64 guid);
         bool IsPlayerInSoloQueue(Player* player);
         bool CheckRequirements(Player* player);
+        SoloQueueMatchStats const& GetMatchStats() const { return matchStats; }
         static SoloQueue* instance();
     private:
         void IncreasePlayerMMrRange(SoloQueueInfo* playerInfo);
         bool IsInMmrRange(uint32 min, uint32 max, uint32 mmr) { return mmr >= min && mmr <= max; };
         uint8 GetPlayerTalentCategory(Player* player);
-        std::multimap<uint32/* mmr */, SoloQueueInfo*> queuedHealers;
-        std::multimap<uint32/* mmr */, SoloQueueInfo*> queuedMelees;
-        std::multimap<uint32/* mmr */, SoloQueueInfo*> queuedRanges;
-        std::multimap<uint32/* mmr */, SoloQueueInfo*> queuedDps;
+        SoloQueueMmrMap* GetQueue(uint8 talentCategory);
+
+        // Matching pass, see Update()
+        void BuildCandidates(SoloQueueMmrMap const& queue, SoloQueueCandidateList& candidates, uint32& maxRange, uint32 maxRatingDiff, bool needClass);
+        int32 FindNearestCandidate(SoloQueueCandidate const& healer, SoloQueueCandidateList const& candidates, uint32 maxRange, bool needClass, uint8 excludedClass = 0);
+        bool CreateTeam(std::list<SoloQueueInfo*>& playerList);
+
+        SoloQueueMmrMap queuedHealers;
+        SoloQueueMmrMap queuedMelees;
+        SoloQueueMmrMap queuedRanges;
+        SoloQueueMmrMap queuedDps;
         std::map<uint64, SoloQueueInfo*> allPlayersInQueue;
         uint32 lastUpdateTime;
+
+        // Kept between passes so matching does not allocate once the queue reached its size
+        SoloQueueCandidateList healerCandidates;
+        SoloQueueCandidateList meleeCandidates;
+        SoloQueueCandidateList rangeCandidates;
+        SoloQueueCandidateList dpsCandidates;
+        SoloQueueMatchStats matchStats;
 };
 
 #endif
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "DatabaseEnv.h"
 #include "AccountMgr.h"
 #include "Player.h"
+#include "PreparedPacket.h"
 
 Channel::Channel(std::string const& name, uint32 channelId, uint32 team):
     _announce(true),
@@ -777,18 +778,20 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, uint64 guid)
 {
+    PreparedPacket prepared(data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (Player* player = ObjectAccessor::FindPlayer(i->first))
             if (!guid || !player->GetSocial()->HasIgnore(GUID_LOPART(guid)))
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendPacket(&prepared);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
+    PreparedPacket prepared(data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (i->first != who)
             if (Player* player = ObjectAccessor::FindPlayer(i->first))
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendPacket(&prepared);
 }
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
@@ -226,6 +226,13 @@ void LFGMgr::LoadLFGDungeons(bool reload /* = false */)
         LFGDungeonEntry const* dungeon = sLFGDungeonStore.LookupEntry(i);
         if (!dungeon)
             continue;
+
+        // queues match dungeons by bit
+        if (dungeon->ID >= LFG_DUNGEON_MASK_SIZE)
+        {
+            TC_LOG_ERROR("lfg", "LFGMgr::LoadLFGDungeons: Dungeon %u is above the queue dungeon mask size %u, skipped", dungeon->ID, LFG_DUNGEON_MASK_SIZE);
+            continue;
+        }
         
         switch (dungeon->type)
         {
@@ -717,7 +724,7 @@ void LFGMgr::JoinLfg(Player* player, uint8 roles, LfgDungeonSet& dungeons, const
         debugNames.append(player->GetName());
     }
 
-    if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
+    if (TC_LOG_ENABLED("lfg", LOG_LEVEL_DEBUG))
     {
         std::ostringstream o;
         o << "LFGMgr::Join: [" << guid << "] joined (" << (grp ? "group" : "player") << ") Members: " << debugNames.c_str()
@@ -1837,7 +1844,7 @@ void LFGMgr::RestoreState(uint64 guid, char const* debugMsg)
     if (IS_GROUP_GUID(guid))
     {
         LfgGroupData& data = GroupsStore[guid];
-        if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
+        if (TC_LOG_ENABLED("lfg", LOG_LEVEL_DEBUG))
         {
             std::string const& ps = GetStateString(data.GetState());
             std::string const& os = GetStateString(data.GetOldState());
@@ -1850,7 +1857,7 @@ void LFGMgr::RestoreState(uint64 guid, char const* debugMsg)
     else
     {
         LfgPlayerData& data = PlayersStore[guid];
-        if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
+        if (TC_LOG_ENABLED("lfg", LOG_LEVEL_DEBUG))
         {
             std::string const& ps = GetStateString(data.GetState());
             std::string const& os = GetStateString(data.GetOldState());
@@ -1866,7 +1873,7 @@ void LFGMgr::SetState(uint64 guid, LfgState state)
     if (IS_GROUP_GUID(guid))
     {
         LfgGroupData& data = GroupsStore[guid];
-        if (sLog->ShouldLog("lfg", LOG_LEVEL_TRACE))
+        if (TC_LOG_ENABLED("lfg", LOG_LEVEL_TRACE))
         {
             std::string const& ns = GetStateString(state);
             std::string const& ps = GetStateString(data.GetState());
@@ -1879,7 +1886,7 @@ void LFGMgr::SetState(uint64 guid, LfgState state)
     else
     {
         LfgPlayerData& data = PlayersStore[guid];
-        if (sLog->ShouldLog("lfg", LOG_LEVEL_TRACE))
+        if (TC_LOG_ENABLED("lfg", LOG_LEVEL_TRACE))
         {
             std::string const& ns = GetStateString(state);
             std::string const& ps = GetStateString(data.GetState());
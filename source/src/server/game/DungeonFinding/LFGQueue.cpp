@@ -83,6 +83,28 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
     }
 }
 
+/// splitmix64 finalizer, spreads the low guid bits over the whole value
+inline uint64 MixGuid(uint64 guid)
+{
+    guid = (guid ^ (guid >> 30)) * UI64LIT(0xBF58476D1CE4E5B9);
+    guid = (guid ^ (guid >> 27)) * UI64LIT(0x94D049BB133111EB);
+    return guid ^ (guid >> 31);
+}
+
+void LfgCompatibilityKey::Add(uint64 guid)
+{
+    sum += MixGuid(guid);
+    mix ^= MixGuid(guid ^ UI64LIT(0x9E3779B97F4A7C15));
+    ++size;
+}
+
+void LfgCompatibilityKey::Remove(uint64 guid)
+{
+    sum -= MixGuid(guid);
+    mix ^= MixGuid(guid ^ UI64LIT(0x9E3779B97F4A7C15));
+    --size;
+}
+
 void LfgQueueData::InitializeGroupSetup()
 {
     tanks = uint8(-1);
@@ -100,6 +122,35 @@ void LfgQueueData::InitializeGroupSetup()
     }
 }
 
+void LfgQueueData::InitializeMasks()
+{
+    dungeonMask.reset();
+    for (LfgDungeonSet::const_iterator itr = dungeons.begin(); itr != dungeons.end(); ++itr)
+        if (*itr < LFG_DUNGEON_MASK_SIZE)
+            dungeonMask.set(*itr);
+
+    onlyTanks = 0;
+    onlyHealers = 0;
+    onlyDps = 0;
+    for (LfgRolesMap::const_iterator itr = roles.begin(); itr != roles.end(); ++itr)
+    {
+        switch (itr->second & ~PLAYER_ROLE_LEADER)
+        {
+            case PLAYER_ROLE_TANK:
+                ++onlyTanks;
+                break;
+            case PLAYER_ROLE_HEALER:
+                ++onlyHealers;
+                break;
+            case PLAYER_ROLE_DAMAGE:
+                ++onlyDps;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 void LFGQueue::AddToQueue(uint64 guid)
 {
     LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
@@ -118,17 +169,14 @@ void LFGQueue::RemoveFromQueue(uint64 guid)
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::ostringstream o;
-    o << guid;
-    std::string sguid = o.str();
-
+    // Every cached combination with the guid is gone, so best compatibles which are no longer cached included it
     LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
         if (itr->first != guid)
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
+            if (itr->second.bestCompatible.size && CompatibleMapStore.find(itr->second.bestCompatible) == CompatibleMapStore.end())
             {
-                itr->second.bestCompatible.clear();
+                itr->second.bestCompatible = LfgCompatibilityKey();
                 FindBestCompatibleInQueue(itr);
             }
         }
@@ -207,15 +255,11 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(uint64 guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     TC_LOG_DEBUG("lfg", "LFGQueue::RemoveFromCompatibles: Removing [" UI64FMTD "]", guid);
     for (auto itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
     {
         LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
+        if (std::binary_search(it->second.guids.begin(), it->second.guids.end(), guid))
             CompatibleMapStore.erase(it);
     }
 }
@@ -223,27 +267,40 @@ void LFGQueue::RemoveFromCompatibles(uint64 guid)
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Key of the guids
+   @param[in]     check List of guids, stored sorted with new entries
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgGuidList const& check, LfgCompatibility compatibles)
 {
     LfgCompatibilityData& data = CompatibleMapStore[key];
     data.compatibility = compatibles;
+    if (data.guids.empty())
+    {
+        data.guids.assign(check.begin(), check.end());
+        std::sort(data.guids.begin(), data.guids.end());
+    }
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgGuidList const& check, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    LfgCompatibilityData& stored = CompatibleMapStore[key];
+    stored.compatibility = data.compatibility;
+    stored.roles = data.roles;
+    if (stored.guids.empty())
+    {
+        stored.guids.assign(check.begin(), check.end());
+        std::sort(stored.guids.begin(), stored.guids.end());
+    }
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Key of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     auto itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -252,29 +309,16 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
-{
-    auto itr = CompatibleMapStore.find(key);
-    if (itr != CompatibleMapStore.end())
-        return &(itr->second);
-
-    return NULL;
-}
-
 uint8 LFGQueue::FindGroups()
 {
     uint8 proposals = 0;
-    LfgGuidList firstNew;
     while (!newToQueueStore.empty())
     {
         uint64 frontguid = newToQueueStore.front();
         TC_LOG_DEBUG("lfg", "LFGQueue::FindGroups: checking [" UI64FMTD "] newToQueue(%u), currentQueue(%u)", frontguid, uint32(newToQueueStore.size()), uint32(currentQueueStore.size()));
-        firstNew.clear();
-        firstNew.push_back(frontguid);
         RemoveFromNewQueue(frontguid);
 
-        LfgGuidList temporalList = currentQueueStore;
-        LfgCompatibility compatibles = FindNewGroups(firstNew, temporalList);
+        LfgCompatibility compatibles = FindNewGroups(frontguid);
 
         if (compatibles == LFG_COMPATIBLES_MATCH)
             ++proposals;
@@ -285,62 +329,110 @@ uint8 LFGQueue::FindGroups()
 }
 
 /**
-   Checks que main queue to try to form a Lfg group. Returns first match found (if any)
+   Checks the main queue to try to form a Lfg group with a new entry. Returns first match found (if any)
 
-   @param[in]     check List of guids trying to match with other groups
-   @param[in]     all List of all other guids in main queue to match against
-   @return LfgCompatibility type of compatibility between groups
+   Queued entries are walked once in queue order. Every entry compatible with the
+   combination built so far joins it, so only combinations with the new entry are
+   checked and each of them extends an already compatible one.
+
+   @param[in]     newGuid Guid of the new queue entry
+   @return LfgCompatibility type of compatibility of the new entry
 */
-LfgCompatibility LFGQueue::FindNewGroups(LfgGuidList& check, LfgGuidList& all)
+LfgCompatibility LFGQueue::FindNewGroups(uint64 newGuid)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
-
-    TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
-    if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
-        compatibles = CheckCompatibility(check);
+    LfgGuidList check;
+    check.push_back(newGuid);
+    LfgCompatibilityKey key;
+    key.Add(newGuid);
 
-    if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
+    LfgQueueDataContainer::const_iterator itNew = QueueDataStore.find(newGuid);
+    if (itNew == QueueDataStore.end())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
-        return LFG_COMPATIBLES_MATCH;
+        TC_LOG_ERROR("lfg", "LFGQueue::FindNewGroups: [" UI64FMTD "] is not queued but listed as queued!", newGuid);
+        return LFG_COMPATIBILITY_PENDING;
     }
 
+    LfgDungeonMask dungeonMask = itNew->second.dungeonMask;
+    LfgCompatibility compatibles = TryCompatibility(check, key);
     if (compatibles != LFG_COMPATIBLES_WITH_LESS_PLAYERS)
         return compatibles;
 
-    // Try to match with queued groups
-    while (!all.empty())
+    for (LfgGuidList::const_iterator itr = currentQueueStore.begin(); itr != currentQueueStore.end(); ++itr)
     {
-        check.push_back(all.front());
-        all.pop_front();
-        LfgCompatibility subcompatibility = FindNewGroups(check, all);
-        if (subcompatibility == LFG_COMPATIBLES_MATCH)
-            return LFG_COMPATIBLES_MATCH;
+        uint64 guid = *itr;
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end())
+            continue;
+
+        // No common dungeon, no need to build the combination
+        LfgDungeonMask combinedMask = dungeonMask & itQueue->second.dungeonMask;
+        if (combinedMask.none())
+            continue;
+
+        check.push_back(guid);
+        key.Add(guid);
+
+        // the queue may change while a proposal is created or a stale entry is removed, stop walking it
+        LfgCompatibility subcompatibility = TryCompatibility(check, key);
+        if (subcompatibility == LFG_COMPATIBLES_MATCH || subcompatibility == LFG_COMPATIBILITY_PENDING)
+            return subcompatibility;
+
+        if (subcompatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
+        {
+            dungeonMask = combinedMask;
+            continue;
+        }
+
         check.pop_back();
+        key.Remove(guid);
     }
+
     return compatibles;
 }
 
 /**
-   Check compatibilities between groups. If group is Matched proposal will be created
+   Returns the cached compatibility of a list of guids, checks it if not cached yet
 
    @param[in]     check List of guids to check compatibilities
+   @param[in]     key Key of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
+LfgCompatibility LFGQueue::TryCompatibility(LfgGuidList& check, LfgCompatibilityKey const& key)
+{
+    LfgCompatibility compatibles = GetCompatibles(key);
+
+    TC_LOG_DEBUG("lfg", "LFGQueue::TryCompatibility: (%s): %s", ConcatenateGuids(check).c_str(), GetCompatibleString(compatibles));
+
+    // A match which could not be proposed before is checked again once everyone is queued
+    if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
+    {
+        TC_LOG_DEBUG("lfg", "LFGQueue::TryCompatibility: (%s) compatibles (cached) changed from bad states to match", ConcatenateGuids(check).c_str());
+        compatibles = LFG_COMPATIBILITY_PENDING;
+    }
+
+    if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
+        compatibles = CheckCompatibility(check, key);
+
+    return compatibles;
+}
+
+/**
+   Check compatibilities between groups. If group is Matched proposal will be created
+
+   @param[in]     check List of guids to check compatibilities, restored before returning
+   @param[in]     key Key of the guids
+   @return LfgCompatibility type of compatibility
+*/
+LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList& check, LfgCompatibilityKey const& key)
 {
-    std::string strGuids = ConcatenateGuids(check);
     LfgProposal proposal;
-    LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
     LfgRolesMap proposalRoles;
 
     // Check for correct size
     if (check.empty())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (): Size wrong - Not compatibles");
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
@@ -349,58 +441,64 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     {
         uint64 frontGuid = check.front();
         check.pop_front();
+        LfgCompatibilityKey childKey = key;
+        childKey.Remove(frontGuid);
 
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        LfgCompatibility child_compatibles = CheckCompatibility(check);
+        LfgCompatibility child_compatibles = GetCompatibles(childKey);
+        if (child_compatibles == LFG_COMPATIBILITY_PENDING)
+            child_compatibles = CheckCompatibility(check, childKey);
+
+        check.push_front(frontGuid);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child not compatibles", ConcatenateGuids(check).c_str());
+            SetCompatibles(key, check, child_compatibles);
             return child_compatibles;
         }
-        check.push_front(frontGuid);
     }
 
-    std::ostringstream o;
-
-    // find compatible dungeons
-    if (check.size() > 1)
+    // find compatible dungeons, every queue entry keeps its dungeons as bits
+    LfgDungeonMask proposalDungeons;
+    proposalDungeons.set();
+    uint8 onlyTanks = 0;
+    uint8 onlyHealers = 0;
+    uint8 onlyDps = 0;
+    for (LfgGuidList::const_iterator itguid = check.begin(); itguid != check.end(); ++itguid)
     {
-        LfgGuidList::iterator itguid = check.begin();
-        proposalDungeons = QueueDataStore[*itguid].dungeons;
-
-        if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
-            o << ", " << *itguid << ": (" << ConcatenateDungeons(proposalDungeons) << ")";
-
-        for (++itguid; itguid != check.end(); ++itguid)
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(*itguid);
+        if (itQueue == QueueDataStore.end())
         {
-            LfgDungeonSet temporal;
-            LfgDungeonSet& dungeons = QueueDataStore[*itguid].dungeons;
-
-            if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
-                o << ", " << *itguid << ": (" << ConcatenateDungeons(dungeons) << ")";
-
-            std::set_intersection(proposalDungeons.begin(), proposalDungeons.end(), dungeons.begin(), dungeons.end(), std::inserter(temporal, temporal.begin()));
-            proposalDungeons = temporal;
+            TC_LOG_ERROR("lfg", "LFGQueue::CheckCompatibility: [" UI64FMTD "] is not queued but listed as queued!", *itguid);
+            RemoveFromQueue(*itguid);
+            return LFG_COMPATIBILITY_PENDING;
         }
-    }
-    else
-    {
-        proposalDungeons = QueueDataStore[check.front()].dungeons;
+
+        proposalDungeons &= itQueue->second.dungeonMask;
+        onlyTanks += itQueue->second.onlyTanks;
+        onlyHealers += itQueue->second.onlyHealers;
+        onlyDps += itQueue->second.onlyDps;
     }
 
     LFGDungeonData const* dungeon = nullptr;
     do
     {
-        if (proposalDungeons.empty())
+        size_t count = proposalDungeons.count();
+        if (!count)
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons", ConcatenateGuids(check).c_str());
+            SetCompatibles(key, check, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
 
-        proposal.dungeonId = Trinity::Containers::SelectRandomContainerElement(proposalDungeons);
-        proposalDungeons.erase(proposal.dungeonId);
+        // pick a random common dungeon
+        size_t dungeonId = 0;
+        for (size_t selected = urand(0, count - 1); ; ++dungeonId)
+            if (proposalDungeons.test(dungeonId) && !selected--)
+                break;
+
+        proposal.dungeonId = uint32(dungeonId);
+        proposalDungeons.reset(dungeonId);
         dungeon = sLFGMgr->GetLFGDungeon(proposal.dungeonId);
     }
     while (!dungeon);
@@ -408,7 +506,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // Check for correct size
     if (check.size() > dungeon->GetMaxGroupSize())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", ConcatenateGuids(check).c_str());
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
@@ -442,15 +540,15 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
     if (numLfgGroups > 1)
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", ConcatenateGuids(check).c_str(), numLfgGroups);
+        SetCompatibles(key, check, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > dungeon->GetMaxGroupSize())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", ConcatenateGuids(check).c_str(), numPlayers);
+        SetCompatibles(key, check, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -458,6 +556,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // If it's single group no need to check for duplicate players, ignores, bad roles or bad dungeons as it's been checked before joining
     if (check.size() > 1)
     {
+        // more players with a single role than the dungeon needs can never fit
+        if (onlyTanks > dungeon->requiredTanks || onlyHealers > dungeon->requiredHeals || onlyDps > dungeon->requiredDamagedealers)
+        {
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible, single role players T: %u H: %u D: %u", ConcatenateGuids(check).c_str(), onlyTanks, onlyHealers, onlyDps);
+            SetCompatibles(key, check, LFG_INCOMPATIBLES_NO_ROLES);
+            return LFG_INCOMPATIBLES_NO_ROLES;
+        }
+
         for (auto it = check.begin(); it != check.end(); ++it)
         {
             const LfgRolesMap &roles = QueueDataStore[(*it)].roles;
@@ -478,23 +584,23 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", strGuids.c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", ConcatenateGuids(check).c_str(), playersize);
+            SetCompatibles(key, check, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
         LfgRolesMap debugRoles = proposalRoles;
         if (!LFGMgr::CheckGroupRoles(proposalRoles, dungeon))
         {
-            if (sLog->ShouldLog("lfg", LOG_LEVEL_DEBUG))
+            std::ostringstream o;
+            if (TC_LOG_ENABLED("lfg", LOG_LEVEL_DEBUG))
             {
-                o.clear();
                 for (auto it = debugRoles.begin(); it != debugRoles.end(); ++it)
                     o << ", " << it->first << ": " << GetRolesString(it->second);
             }
 
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", ConcatenateGuids(check).c_str(), o.str().c_str());
+            SetCompatibles(key, check, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
     }
@@ -507,14 +613,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
     // Enough players?
     if (numPlayers != dungeon->GetMaxGroupSize())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u)", strGuids.c_str(), numPlayers);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u)", ConcatenateGuids(check).c_str(), numPlayers);
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
         data.roles = proposalRoles;
 
         for (auto itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, check, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -524,8 +630,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
     if (!sLFGMgr->AllQueued(check))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", ConcatenateGuids(check).c_str());
+        SetCompatibles(key, check, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -565,8 +671,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(LfgGuidList check)
 
     sLFGMgr->AddProposal(proposal);
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", ConcatenateGuids(check).c_str());
+    SetCompatibles(key, check, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -617,7 +723,7 @@ void LFGQueue::UpdateQueueTimers(uint8 queueId, time_t currTime, uint32 &tankCou
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (!queueinfo.bestCompatible.size)
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(queueId, dungeonId, queueinfo.joinTime, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
@@ -684,7 +790,12 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+        {
+            o << "(";
+            for (LfgGuidVector::const_iterator itGuid = itr->second.guids.begin(); itGuid != itr->second.guids.end(); ++itGuid)
+                o << (itGuid != itr->second.guids.begin() ? "|" : "") << *itGuid;
+            o << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+        }
 
     return o.str();
 }
@@ -692,32 +803,24 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg", "LFGQueue::FindBestCompatibleInQueue: " UI64FMTD, itrQueue->first);
-    std::ostringstream o;
-    o << itrQueue->first;
-    std::string sguid = o.str();
 
     for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
+            std::binary_search(itr->second.guids.begin(), itr->second.guids.end(), itrQueue->first))
         {
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
         }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size <= queueData.bestCompatible.size)
         return;
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::UpdateBestCompatibleInQueue: Changed (%s) to (%s) as best compatible group for " UI64FMTD,
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first);
+    TC_LOG_DEBUG("lfg", "LFGQueue::UpdateBestCompatibleInQueue: Changed best compatible group size from %u to %u for " UI64FMTD,
+        queueData.bestCompatible.size, key.size, itrQueue->first);
 
     queueData.bestCompatible = key;
     queueData.InitializeGroupSetup();
@@ -19,10 +19,17 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <bitset>
 
 namespace lfg
 {
 
+/// Dungeon ids are mapped straight to bits, LFGMgr skips dungeons above this
+#define LFG_DUNGEON_MASK_SIZE 1024
+
+typedef std::bitset<LFG_DUNGEON_MASK_SIZE> LfgDungeonMask;
+typedef std::vector<uint64> LfgGuidVector;
+
 enum LfgCompatibility
 {
     LFG_COMPATIBILITY_PENDING,
@@ -37,6 +44,33 @@ enum LfgCompatibility
     LFG_COMPATIBLES_MATCH                                  // Must be the last one
 };
 
+/**
+    Order independent key of a combination of queued guids.
+
+    Built by adding and removing guids while the matcher walks the queue, so no
+    sorting or string building is needed per checked combination. Two independent
+    64 bit mixes of every guid are combined by sum and xor.
+*/
+struct LfgCompatibilityKey
+{
+    LfgCompatibilityKey() : sum(0), mix(0), size(0) { }
+
+    void Add(uint64 guid);
+    void Remove(uint64 guid);
+
+    bool operator==(LfgCompatibilityKey const& right) const { return sum == right.sum && mix == right.mix && size == right.size; }
+    bool operator!=(LfgCompatibilityKey const& right) const { return !(*this == right); }
+
+    uint64 sum;
+    uint64 mix;
+    uint8 size;                                            ///< Number of queue entries
+};
+
+struct LfgCompatibilityKeyHash
+{
+    size_t operator()(LfgCompatibilityKey const& key) const { return size_t(key.sum ^ (key.mix << 1) ^ key.size); }
+};
+
 struct LfgCompatibilityData
 {
     LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
@@ -46,6 +80,7 @@ struct LfgCompatibilityData
 
     LfgCompatibility compatibility;
     LfgRolesMap roles;
+    LfgGuidVector guids;                                   ///< Sorted queue entries of the combination
 };
 
 /// Stores player or group queue info
@@ -54,12 +89,14 @@ struct LfgQueueData
     LfgQueueData() : joinTime(time_t(time(NULL)))
     {
         InitializeGroupSetup();
+        InitializeMasks();
     }
 
     LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, LfgRolesMap const& _roles) :
         joinTime(_joinTime), dungeons(_dungeons), roles(_roles)
     {
         InitializeGroupSetup();
+        InitializeMasks();
     }
 
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
@@ -68,9 +105,14 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgDungeonMask dungeonMask;                            ///< Selected dungeons as bits, for fast intersections
+    uint8 onlyTanks;                                       ///< Players which can only tank
+    uint8 onlyHealers;                                     ///< Players which can only heal
+    uint8 onlyDps;                                         ///< Players which can only deal damage
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued (size 0 if none)
 
     void InitializeGroupSetup();
+    void InitializeMasks();
 };
 
 struct LfgWaitTime
@@ -81,7 +123,7 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef UNORDERED_MAP<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> LfgCompatibleContainer;
 typedef std::map<uint64, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -115,25 +157,22 @@ class LFGQueue
         std::string DumpCompatibleInfo(bool full = false) const;
 
     private:
-        void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
-        LfgRolesMap const& RemoveFromQueueUpdateData(uint64 guid);
-
         void AddToNewQueue(uint64 guid);
         void AddToCurrentQueue(uint64 guid);
         void RemoveFromNewQueue(uint64 guid);
         void RemoveFromCurrentQueue(uint64 guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgGuidList const& check, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(uint64 guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgGuidList const& check, LfgCompatibilityData const& compatibles);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
-        LfgCompatibility FindNewGroups(LfgGuidList& check, LfgGuidList& all);
-        LfgCompatibility CheckCompatibility(LfgGuidList check);
+        LfgCompatibility FindNewGroups(uint64 newGuid);
+        LfgCompatibility TryCompatibility(LfgGuidList& check, LfgCompatibilityKey const& key);
+        LfgCompatibility CheckCompatibility(LfgGuidList& check, LfgCompatibilityKey const& key);
 
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
@@ -2344,6 +2344,9 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable ? GetPhaseMask() : 0);
+
+    if (IsInWorld())
+        GetMap()->InvalidateCollisionCache();
 }
 
 void GameObject::UpdateModel()
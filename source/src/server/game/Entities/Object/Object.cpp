@@ -326,6 +326,7 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_objectUpdateMap   = NULL;
 
     m_PackGUID.appendPackGUID(0);
 }
@@ -360,7 +361,10 @@ Object::~Object()
     {
         TC_LOG_FATAL("misc", "Object::~Object - guid=" UI64FMTD ", typeid=%d, entry=%u deleted but still in update list!!", GetGUID(), GetTypeId(), GetEntry());
         //        ASSERT(false);
-        sObjectAccessor->RemoveUpdateObject(this);
+        if (m_objectUpdateMap)
+            m_objectUpdateMap->RemoveUpdateObject(this);
+        else
+            sObjectAccessor->RemoveUpdateObject(this);
     }
 
     delete [] m_uint32Values;
@@ -966,437 +970,425 @@ void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask*
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                               // unit (creature/player) case
     {
-        for (uint16 index = 0; index < valCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < valCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == UNIT_NPC_FLAGS)
             {
-                if (index == UNIT_NPC_FLAGS)
+                // remove custom flag before sending
+                uint32 appendValue = m_uint32Values[index];
+
+                if (GetTypeId() == TYPEID_UNIT)
                 {
-                    // remove custom flag before sending
-                    uint32 appendValue = m_uint32Values[index];
+                    if (!target->canSeeSpellClickOn(this->ToCreature()))
+                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (!target->canSeeSpellClickOn(this->ToCreature()))
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!this->ToCreature()->isCanTrainingOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
+                        if (!this->ToCreature()->isCanTrainingOf(target, false))
+                            appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
                     }
-
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    // Check per caster aura states to not enable using a pell in client if specified aura is not by target
-                    *data << ((Unit*)this)->BuildAuraStateUpdateForTarget(target);
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                    (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS)
-                {
-                    if (target->isGameMaster())
-                        *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                    else
-                        *data << m_uint32Values[index];
-                }
-                else if (index == ITEM_FIELD_FLAGS)
-                {
-                    //Let's not reveal that we're using a flag to hide enchants.
-                    *data << (m_uint32Values[index] & ~ITEM_FLAG_ENCHANT_HIDDEN);
                 }
-                else if (
-                    index == PLAYER_VISIBLE_ITEM_15_ENCHANTMENT
-                    || index == PLAYER_VISIBLE_ITEM_16_ENCHANTMENT
-                    || index == PLAYER_VISIBLE_ITEM_17_ENCHANTMENT
-                    )
-                {
-                    uint32 item_slot  { 0     };
-                    bool hide       { false };
 
+                *data << uint32(appendValue);
+            }
+            else if (index == UNIT_FIELD_AURASTATE)
+            {
+                // Check per caster aura states to not enable using a pell in client if specified aura is not by target
+                *data << ((Unit*)this)->BuildAuraStateUpdateForTarget(target);
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
+            // Gamemasters should be always able to select units - remove not selectable flag
+            else if (index == UNIT_FIELD_FLAGS)
+            {
+                if (target->isGameMaster())
+                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
+                else
+                    *data << m_uint32Values[index];
+            }
+            else if (index == ITEM_FIELD_FLAGS)
+            {
+                //Let's not reveal that we're using a flag to hide enchants.
+                *data << (m_uint32Values[index] & ~ITEM_FLAG_ENCHANT_HIDDEN);
+            }
+            else if (
+                index == PLAYER_VISIBLE_ITEM_15_ENCHANTMENT
+                || index == PLAYER_VISIBLE_ITEM_16_ENCHANTMENT
+                || index == PLAYER_VISIBLE_ITEM_17_ENCHANTMENT
+                )
+            {
+                uint32 item_slot  { 0     };
+                bool hide       { false };
 
 
-                    switch (index)
-                    {
-                        case PLAYER_VISIBLE_ITEM_15_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_MAINHAND-1);    break;
-                        case PLAYER_VISIBLE_ITEM_16_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_OFFHAND-1);     break;
-                        case PLAYER_VISIBLE_ITEM_17_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_RANGED-1);      break;
-                        default:                                                                                      break;
-                    }
 
-                    //TC_LOG_ERROR("sql.sql", "beginning check at index %u, slot set to %u", index, item_slot);
+                switch (index)
+                {
+                    case PLAYER_VISIBLE_ITEM_15_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_MAINHAND-1);    break;
+                    case PLAYER_VISIBLE_ITEM_16_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_OFFHAND-1);     break;
+                    case PLAYER_VISIBLE_ITEM_17_ENCHANTMENT:    item_slot = uint32(EQUIPMENT_SLOT_RANGED-1);      break;
+                    default:                                                                                      break;
+                }
 
-                    if (item_slot > 0)
-                        if (auto p = ToPlayer())
-                        {
-                            if (Item* item = p->GetItemByPos(INVENTORY_SLOT_BAG_0, item_slot))
-                                if (item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_ENCHANT_HIDDEN))
-                                {
-                                    hide = true;
-                                    //TC_LOG_ERROR("sql.sql", "hide at index %u checking item slot %u", index, item_slot);
-                                }
-                                //else TC_LOG_ERROR("sql.sql", "else 1 at index %u checking item slot %u", index, item_slot);
-                            //else TC_LOG_ERROR("sql.sql", "else 2 at index %u checking item slot %u", index, item_slot);
-                        }   //else TC_LOG_ERROR("sql.sql", "else 3 at index %u checking item slot %u", index, item_slot);
-                   // else TC_LOG_ERROR("sql.sql", "else 4 at index %u checking item slot %u", index, item_slot);
+                //TC_LOG_ERROR("sql.sql", "beginning check at index %u, slot set to %u", index, item_slot);
 
-                    if (hide)
-                        *data << 0;
-                    else
-                        *data << m_uint32Values[index];
+                if (item_slot > 0)
+                    if (auto p = ToPlayer())
+                    {
+                        if (Item* item = p->GetItemByPos(INVENTORY_SLOT_BAG_0, item_slot))
+                            if (item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_ENCHANT_HIDDEN))
+                            {
+                                hide = true;
+                                //TC_LOG_ERROR("sql.sql", "hide at index %u checking item slot %u", index, item_slot);
+                            }
+                            //else TC_LOG_ERROR("sql.sql", "else 1 at index %u checking item slot %u", index, item_slot);
+                        //else TC_LOG_ERROR("sql.sql", "else 2 at index %u checking item slot %u", index, item_slot);
+                    }   //else TC_LOG_ERROR("sql.sql", "else 3 at index %u checking item slot %u", index, item_slot);
+               // else TC_LOG_ERROR("sql.sql", "else 4 at index %u checking item slot %u", index, item_slot);
 
-                }
-                else if (index == OBJECT_FIELD_SCALE_X)
+                if (hide)
+                    *data << 0;
+                else
+                    *data << m_uint32Values[index];
+
+            }
+            else if (index == OBJECT_FIELD_SCALE_X)
+            {
+                if (GetGUID() == target->GetGUID())//self
                 {
-                    if (GetGUID() == target->GetGUID())//self
+                    if (target->player_is_previewing_morph_model && target->preview_morph.scale != 0.f)
                     {
-                        if (target->player_is_previewing_morph_model && target->preview_morph.scale != 0.f)
-                        {
-                            *data << target->preview_morph.scale;
-                        }
-                        /*
-                            THERE IS A SMALL POTENTIAL FOR SCALE TO BE ABUSED TO CLIMB TERRAIN EASIER.
-                            On Warsong gulch, there is a barricade that becomes easier to climb with a higher scale value.
-                            If someone runs flags through illegal routes using this as the tool, we need to act.
-                            We need to watch this closely.
-                        */
-                        else if (target->fakeSelfMorph.scale != 0.f/* && !target->InBattleground()*/)
-                        {
-                            *data << target->fakeSelfMorph.scale;
-                        }
-                        else *data << m_uint32Values[index];
+                        *data << target->preview_morph.scale;
+                    }
+                    /*
+                        THERE IS A SMALL POTENTIAL FOR SCALE TO BE ABUSED TO CLIMB TERRAIN EASIER.
+                        On Warsong gulch, there is a barricade that becomes easier to climb with a higher scale value.
+                        If someone runs flags through illegal routes using this as the tool, we need to act.
+                        We need to watch this closely.
+                    */
+                    else if (target->fakeSelfMorph.scale != 0.f/* && !target->InBattleground()*/)
+                    {
+                        *data << target->fakeSelfMorph.scale;
                     }
                     else *data << m_uint32Values[index];
                 }
-                else if (index == UNIT_FIELD_DISPLAYID || index == UNIT_FIELD_NATIVEDISPLAYID)
-                {
-                    
-                if (GetTypeId() == TYPEID_PLAYER
-                        && (target->fakeSelfMorph.displayid || (target->player_is_previewing_morph_model && target->preview_morph.displayid))
-                        && (index == UNIT_FIELD_DISPLAYID || index == UNIT_FIELD_NATIVEDISPLAYID && target->fakeSelfMorph.category == 2)
-                        && GetGUID() == target->GetGUID()
-                        && (target->GetDisplayId() == target->GetNativeDisplayId()))  //Do not morph over a polymorph.
-                        {
-                            *data << (target->player_is_previewing_morph_model ? target->preview_morph.displayid : target->fakeSelfMorph.displayid);
-                        }
-                else
+                else *data << m_uint32Values[index];
+            }
+            else if (index == UNIT_FIELD_DISPLAYID || index == UNIT_FIELD_NATIVEDISPLAYID)
+            {
+                
+            if (GetTypeId() == TYPEID_PLAYER
+                    && (target->fakeSelfMorph.displayid || (target->player_is_previewing_morph_model && target->preview_morph.displayid))
+                    && (index == UNIT_FIELD_DISPLAYID || index == UNIT_FIELD_NATIVEDISPLAYID && target->fakeSelfMorph.category == 2)
+                    && GetGUID() == target->GetGUID()
+                    && (target->GetDisplayId() == target->GetNativeDisplayId()))  //Do not morph over a polymorph.
+                    {
+                        *data << (target->player_is_previewing_morph_model ? target->preview_morph.displayid : target->fakeSelfMorph.displayid);
+                    }
+            else
+            {
+                if (GetTypeId() == TYPEID_UNIT)
                 {
-                    if (GetTypeId() == TYPEID_UNIT)
+                    CreatureTemplate const* cinfo = ToCreature()->GetCreatureTemplate();
+
+                    // this also applies for transform auras
+                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(ToUnit()->getTransForm()))
+                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                                {
+                                    cinfo = transformInfo;
+                                    break;
+                                }
+                    // Some creatures have different displayids depending on reaction
+                    // TODO: General implementation
+                    if (GetEntry() == 44199)
                     {
-                        CreatureTemplate const* cinfo = ToCreature()->GetCreatureTemplate();
-
-                        // this also applies for transform auras
-                        if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(ToUnit()->getTransForm()))
-                            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                                if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                    if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                    {
-                                        cinfo = transformInfo;
-                                        break;
-                                    }
-                        // Some creatures have different displayids depending on reaction
-                        // TODO: General implementation
-                        if (GetEntry() == 44199)
+                        if (!ToCreature()->IsFriendlyTo(target))
+                            *data << 34997;
+                        else
+                            *data << m_uint32Values[index];
+                    }
+                    else if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                    {
+                        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+
+                        if (target->isGameMaster() && !target->isMovieMaker())
                         {
-                            if (!ToCreature()->IsFriendlyTo(target))
-                                *data << 34997;
+                            if (cinfo->Modelid1)
+                                *data << cinfo->Modelid1;//Modelid1 is a visible model for gms
                             else
-                                *data << m_uint32Values[index];
+                                *data << 1126; // world invisible trigger's model
                         }
-                        else if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                        else
                         {
-                            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-
-                            if (target->isGameMaster() && !target->isMovieMaker())
-                            {
-                                if (cinfo->Modelid1)
-                                    *data << cinfo->Modelid1;//Modelid1 is a visible model for gms
-                                else
-                                    *data << 1126; // world invisible trigger's model
-                            }
+                            if (cinfo->Modelid2)
+                                *data << cinfo->Modelid2;//Modelid2 is an invisible model for players
                             else
-                            {
-                                if (cinfo->Modelid2)
-                                    *data << cinfo->Modelid2;//Modelid2 is an invisible model for players
-                                else
-                                    *data << 11686; // world invisible trigger's model
-                            }
+                                *data << 11686; // world invisible trigger's model
                         }
-                        else
-                            *data << m_uint32Values[index];
                     }
                     else
                         *data << m_uint32Values[index];
                 }
-                }
-                // hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS)
-                {
-                    uint32 dynamicFlags = m_uint32Values[index];
+                else
+                    *data << m_uint32Values[index];
+            }
+            }
+            // hide lootable animation for unallowed players
+            else if (index == UNIT_DYNAMIC_FLAGS)
+            {
+                uint32 dynamicFlags = m_uint32Values[index];
 
-                    if (Creature const* creature = ToCreature())
+                if (Creature const* creature = ToCreature())
+                {
+                    if (creature->hasLootRecipient())
                     {
-                        if (creature->hasLootRecipient())
+                        if (creature->isTappedBy(target))
                         {
-                            if (creature->isTappedBy(target))
-                            {
-                                dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                            }
-                            else
-                            {
-                                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                                dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                            }
+                            dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
                         }
                         else
                         {
-                            dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
+                            dynamicFlags |= UNIT_DYNFLAG_TAPPED;
                             dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                         }
-
-                        if (!target->isAllowedToLoot(creature))
-                            dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
                     }
-                    else if (target == this)
-                        dynamicFlags &= ~UNIT_DYNFLAG_DEAD;
-
-                    // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                    if (Unit const* unit = ToUnit())
-                        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                            if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-                    *data << dynamicFlags;
+                    else
+                    {
+                        dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
+                        dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                    }
+
+                    if (!target->isAllowedToLoot(creature))
+                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
                 }
-                // FG: pretend that OTHER players in own group are friendly ("blue")
-                else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+                else if (target == this)
+                    dynamicFlags &= ~UNIT_DYNFLAG_DEAD;
+
+                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+                if (Unit const* unit = ToUnit())
+                    if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                        if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                            dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                *data << dynamicFlags;
+            }
+            // FG: pretend that OTHER players in own group are friendly ("blue")
+            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+            {
+                Unit const* unit = ToUnit();
+                bool isLfgOrSoloQueueException = false;
+                if (unit->IsInRaidWith(target))
+                    if (const Player* player = unit->GetCharmerOrOwnerPlayerOrPlayerItself())
+                        if (const Group* group = player->GetGroup())
+                            if ((group->isLFGGroup() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_LFG))
+                                || (group->isBGGroup() && sWorld->getBoolConfig(BATTLEGROUND_CROSSFACTION_ENABLED)))
+                                isLfgOrSoloQueueException = true;
+
+                if (unit->IsControlledByPlayer() && target != this && (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) || isLfgOrSoloQueueException) && unit->IsInRaidWith(target))
                 {
-                    Unit const* unit = ToUnit();
-                    bool isLfgOrSoloQueueException = false;
-                    if (unit->IsInRaidWith(target))
-                        if (const Player* player = unit->GetCharmerOrOwnerPlayerOrPlayerItself())
-                            if (const Group* group = player->GetGroup())
-                                if ((group->isLFGGroup() && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_LFG))
-                                    || (group->isBGGroup() && sWorld->getBoolConfig(BATTLEGROUND_CROSSFACTION_ENABLED)))
-                                    isLfgOrSoloQueueException = true;
-
-                    if (unit->IsControlledByPlayer() && target != this && (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) || isLfgOrSoloQueueException) && unit->IsInRaidWith(target))
+                    FactionTemplateEntry const* ft1 = unit->getFactionTemplateEntry();
+                    FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
+                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
                     {
-                        FactionTemplateEntry const* ft1 = unit->getFactionTemplateEntry();
-                        FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
-                        if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+                        if (index == UNIT_FIELD_BYTES_2)
                         {
-                            if (index == UNIT_FIELD_BYTES_2)
-                            {
-                                // Allow targetting opposite faction in party when enabled in config
-                                *data << (m_uint32Values[index] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                            }
-                            else
-                            {
-                                // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                                uint32 faction = target->getFaction();
-                                *data << uint32(faction);
-                            }
+                            // Allow targetting opposite faction in party when enabled in config
+                            *data << (m_uint32Values[index] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
                         }
                         else
-                            *data << m_uint32Values[index];
+                        {
+                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                            uint32 faction = target->getFaction();
+                            *data << uint32(faction);
+                        }
                     }
                     else
                         *data << m_uint32Values[index];
                 }
-                else if (index == PLAYER_BYTES && target->fakeSelfMorph.displayid && GetGUID() == target->GetGUID())
-				{
-					uint32 pb = m_uint32Values[index];
-					
-					pb &= ~uint32(uint32(0xFF) << (0 * 8));
-					pb &= ~uint32(uint32(0xFF) << (1 * 8));
-					pb &= ~uint32(uint32(0xFF) << (2 * 8));
-					pb &= ~uint32(uint32(0xFF) << (3 * 8));
-					
-					pb |= uint32(uint32(target->fakeSelfMorph.skin) << (0 * 8));
-					pb |= uint32(uint32(target->fakeSelfMorph.face) << (1 * 8));
-					pb |= uint32(uint32(target->fakeSelfMorph.hairstyle) << (2 * 8));
-					pb |= uint32(uint32(target->fakeSelfMorph.haircolor) << (3 * 8));
-					
-					*data << pb;
-				}
-				else if (index == PLAYER_BYTES_2 && target->fakeSelfMorph.displayid && GetGUID() == target->GetGUID())
-				{
-					uint32 pb = m_uint32Values[index];
-					pb &= ~uint32(uint32(0xFF) << (0 * 8));
-					pb |= uint32(uint32(target->fakeSelfMorph.facialhair) << (0 * 8));
-					
-					*data << pb;
-				}
-                else if (index == OBJECT_FIELD_ENTRY)
-                {
-                    /*
-                        Incorporeal affix illusion
-                        The incorporeal npc is supposed to be able to take every type of CC.
-                        This is an issue for the cataclysm client. It blocks creature type-specific spells from being used on other creature types.
-                        Our solution is to fake the entry of the NPC client-side. We have entries designed to take any class's crowd control and we'll use those to trick clients into allowing the spell.
-                        Server-side, we'll allow the exception also. If all goes well, this should allow players to all use their cc on the npc.
-                    */
-
-                        if (GetTypeId() == TYPEID_UNIT && GetEntry() == 75979)
-                        {
-                                switch (target->getClass())
-                                {
-                                case CLASS_HUNTER:
-                                case CLASS_DRUID:
-                                    *data << uint32(GetEntry() + CREATURE_TYPE_BEAST);
-                                    break;
-                                case CLASS_WARLOCK:
-                                    *data << uint32(GetEntry() + CREATURE_TYPE_DEMON);
-                                    break;
-                                case CLASS_SHAMAN:
-                                    *data << uint32(GetEntry() + CREATURE_TYPE_ELEMENTAL);
-                                    break;
-                                case CLASS_PALADIN:
-                                    *data << uint32(GetEntry() + CREATURE_TYPE_UNDEAD);
-                                    break;
-                                case CLASS_MAGE:
-                                default:
-                                    *data << uint32(GetEntry());
-                                    break;
-                                }
-                        }
-                        else
-                            *data << m_uint32Values[index];
-                }
                 else
-                {
-                    // send in current format (float as float, uint32 as uint32)
                     *data << m_uint32Values[index];
-                }
             }
-        }
-    }
-    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
-    {
-        for (uint16 index = 0; index < valCount; ++index)
-        {
-            if (updateMask->GetBit(index))
+            else if (index == PLAYER_BYTES && target->fakeSelfMorph.displayid && GetGUID() == target->GetGUID())
+			{
+				uint32 pb = m_uint32Values[index];
+				
+				pb &= ~uint32(uint32(0xFF) << (0 * 8));
+				pb &= ~uint32(uint32(0xFF) << (1 * 8));
+				pb &= ~uint32(uint32(0xFF) << (2 * 8));
+				pb &= ~uint32(uint32(0xFF) << (3 * 8));
+				
+				pb |= uint32(uint32(target->fakeSelfMorph.skin) << (0 * 8));
+				pb |= uint32(uint32(target->fakeSelfMorph.face) << (1 * 8));
+				pb |= uint32(uint32(target->fakeSelfMorph.hairstyle) << (2 * 8));
+				pb |= uint32(uint32(target->fakeSelfMorph.haircolor) << (3 * 8));
+				
+				*data << pb;
+			}
+			else if (index == PLAYER_BYTES_2 && target->fakeSelfMorph.displayid && GetGUID() == target->GetGUID())
+			{
+				uint32 pb = m_uint32Values[index];
+				pb &= ~uint32(uint32(0xFF) << (0 * 8));
+				pb |= uint32(uint32(target->fakeSelfMorph.facialhair) << (0 * 8));
+				
+				*data << pb;
+			}
+            else if (index == OBJECT_FIELD_ENTRY)
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
-                {
-                    int16 pathProgress = -1;
-                    if (ToGameObject()->IsControlableTransport())
+                /*
+                    Incorporeal affix illusion
+                    The incorporeal npc is supposed to be able to take every type of CC.
+                    This is an issue for the cataclysm client. It blocks creature type-specific spells from being used on other creature types.
+                    Our solution is to fake the entry of the NPC client-side. We have entries designed to take any class's crowd control and we'll use those to trick clients into allowing the spell.
+                    Server-side, we'll allow the exception also. If all goes well, this should allow players to all use their cc on the npc.
+                */
+
+                    if (GetTypeId() == TYPEID_UNIT && GetEntry() == 75979)
                     {
-                        *data << uint16(0);
-                        *data << uint16(0); // seems to be time sync for visual movement
-                    }
-                    else
-                    {
-                        if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_MO_TRANSPORT)
-                            pathProgress = int16(float(ToGameObject()->GetGOValue()->Transport.PathProgress) / float(GetUInt32Value(GAMEOBJECT_LEVEL)) * 65535.0f);
-                        if (IsActivateToQuest)
-                        {
-                            switch (ToGameObject()->GetGoType())
+                            switch (target->getClass())
                             {
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (target->isGameMaster())
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            case CLASS_HUNTER:
+                            case CLASS_DRUID:
+                                *data << uint32(GetEntry() + CREATURE_TYPE_BEAST);
+                                break;
+                            case CLASS_WARLOCK:
+                                *data << uint32(GetEntry() + CREATURE_TYPE_DEMON);
                                 break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                                if (target->isGameMaster())
-                                    *data << uint16(0);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_SPARKLE);
+                            case CLASS_SHAMAN:
+                                *data << uint32(GetEntry() + CREATURE_TYPE_ELEMENTAL);
                                 break;
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                if (target->isGameMaster())
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            case CLASS_PALADIN:
+                                *data << uint32(GetEntry() + CREATURE_TYPE_UNDEAD);
                                 break;
+                            case CLASS_MAGE:
                             default:
-                                *data << uint16(0); // unknown, not happen.
+                                *data << uint32(GetEntry());
                                 break;
                             }
-                        }
-                        else
-                            *data << uint16(0);         // disable quest object
-
-                        *data << uint16(pathProgress); // synch for visual movements
                     }
+                    else
+                        *data << m_uint32Values[index];
+            }
+            else
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
+            }
+        }
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
+    {
+        for (uint16 index = updateMask->GetNextBit(0); index < valCount; index = updateMask->GetNextBit(index + 1))
+        {
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYNAMIC)
+            {
+                int16 pathProgress = -1;
+                if (ToGameObject()->IsControlableTransport())
+                {
+                    *data << uint16(0);
+                    *data << uint16(0); // seems to be time sync for visual movement
                 }
-                else if (index == GAMEOBJECT_FLAGS)
+                else
                 {
-                    uint32 flags = m_uint32Values[index];
-                    if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                        if (ToGameObject()->GetGOInfo()->chest.groupLootRules && !ToGameObject()->IsLootAllowedFor(target))
-                            flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+                    if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_MO_TRANSPORT)
+                        pathProgress = int16(float(ToGameObject()->GetGOValue()->Transport.PathProgress) / float(GetUInt32Value(GAMEOBJECT_LEVEL)) * 65535.0f);
+                    if (IsActivateToQuest)
+                    {
+                        switch (ToGameObject()->GetGoType())
+                        {
+                        case GAMEOBJECT_TYPE_CHEST:
+                            if (target->isGameMaster())
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            else
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            break;
+                        case GAMEOBJECT_TYPE_GENERIC:
+                            if (target->isGameMaster())
+                                *data << uint16(0);
+                            else
+                                *data << uint16(GO_DYNFLAG_LO_SPARKLE);
+                            break;
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            if (target->isGameMaster())
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            else
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            break;
+                        default:
+                            *data << uint16(0); // unknown, not happen.
+                            break;
+                        }
+                    }
+                    else
+                        *data << uint16(0);         // disable quest object
 
-                    *data << flags;
+                    *data << uint16(pathProgress); // synch for visual movements
                 }
-                else
-                    *data << m_uint32Values[index];                // other cases
             }
+            else if (index == GAMEOBJECT_FLAGS)
+            {
+                uint32 flags = m_uint32Values[index];
+                if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                    if (ToGameObject()->GetGOInfo()->chest.groupLootRules && !ToGameObject()->IsLootAllowedFor(target))
+                        flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+                *data << flags;
+            }
+            else
+                *data << m_uint32Values[index];                // other cases
         }
     }
     else if (isType(TYPEMASK_CORPSE))                        // corpse case
     {
-        for (uint16 index = 0; index < valCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < valCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == CORPSE_FIELD_DYNAMIC_FLAGS)
             {
-                if (index == CORPSE_FIELD_DYNAMIC_FLAGS)
-                {
-                    uint32 dynamicFlags = m_uint32Values[index];
-                    if (ToCorpse()->lootRecipient != target)
-                        dynamicFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
+                uint32 dynamicFlags = m_uint32Values[index];
+                if (ToCorpse()->lootRecipient != target)
+                    dynamicFlags &= ~CORPSE_DYNFLAG_LOOTABLE;
 
-                    *data << dynamicFlags;
-                }
-                else
-                    *data << m_uint32Values[index];
+                *data << dynamicFlags;
             }
+            else
+                *data << m_uint32Values[index];
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for (uint16 index = 0; index < valCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < valCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            // Some spells need to send different spell visual if unfriendly
+            if (isType(TYPEMASK_DYNAMICOBJECT) && index == DYNAMICOBJECT_BYTES && ToDynObject()->GetCaster())
             {
-                // Some spells need to send different spell visual if unfriendly
-                if (isType(TYPEMASK_DYNAMICOBJECT) && index == DYNAMICOBJECT_BYTES && ToDynObject()->GetCaster())
+                SpellInfo const* info = sSpellMgr->GetSpellInfo(GetUInt32Value(DYNAMICOBJECT_SPELLID));
+                if (info && info->SpellVisual)
                 {
-                    SpellInfo const* info = sSpellMgr->GetSpellInfo(GetUInt32Value(DYNAMICOBJECT_SPELLID));
-                    if (info && info->SpellVisual)
-                    {
-                        uint32 alternativeVisual = GetAlternativeVisual(info->SpellVisual[0]);
-                        if (alternativeVisual && !ToDynObject()->GetCaster()->IsFriendlyTo(target))
-                            *data << (alternativeVisual | (DYNAMIC_OBJECT_AREA_SPELL << 28));
-                        else
-                            *data << m_uint32Values[index];
-                    }
+                    uint32 alternativeVisual = GetAlternativeVisual(info->SpellVisual[0]);
+                    if (alternativeVisual && !ToDynObject()->GetCaster()->IsFriendlyTo(target))
+                        *data << (alternativeVisual | (DYNAMIC_OBJECT_AREA_SPELL << 28));
                     else
                         *data << m_uint32Values[index];
                 }
                 else
-                    // send in current format (float as float, uint32 as uint32)
                     *data << m_uint32Values[index];
             }
+            else
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
         }
     }
 }
@@ -1408,11 +1400,35 @@ void Object::ClearUpdateMask(bool remove)
     if (m_objectUpdated)
     {
         if (remove)
-            sObjectAccessor->RemoveUpdateObject(this);
+        {
+            if (m_objectUpdateMap)
+                m_objectUpdateMap->RemoveUpdateObject(this);
+            else
+                sObjectAccessor->RemoveUpdateObject(this);
+        }
         m_objectUpdated = false;
+        m_objectUpdateMap = NULL;
     }
 }
 
+void Object::AddToObjectUpdateIfNeeded()
+{
+    if (!m_inWorld || m_objectUpdated)
+        return;
+
+    // objects living on a map are flushed by that map's own update, anything else by the global pass.
+    // Changes made while updating another map go to the global pass as well, it runs once all maps are done
+    m_objectUpdateMap = GetObjectUpdateMap();
+    if (m_objectUpdateMap && Map::GetUpdatingMap() && Map::GetUpdatingMap() != m_objectUpdateMap)
+        m_objectUpdateMap = NULL;
+
+    if (m_objectUpdateMap)
+        m_objectUpdateMap->AddUpdateObject(this);
+    else
+        sObjectAccessor->AddUpdateObject(this);
+    m_objectUpdated = true;
+}
+
 void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
@@ -1427,7 +1443,7 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
-uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
+uint32 Object::GetUpdateFieldData(Player const* target, UpdateFieldFlagMasks const*& masks) const
 {
     uint32 visibleFlag = UF_FLAG_PUBLIC;
 
@@ -1438,7 +1454,7 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
     {
         case TYPEID_ITEM:
         case TYPEID_CONTAINER:
-            flags = ItemUpdateFieldFlags;
+            masks = &ItemUpdateFieldMasks;
             if (((Item*)this)->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER | UF_FLAG_ITEM_OWNER;
             break;
@@ -1446,7 +1462,7 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
         case TYPEID_PLAYER:
         {
             Player* plr = ToUnit()->GetCharmerOrOwnerPlayerOrPlayerItself();
-            flags = UnitUpdateFieldFlags;
+            masks = &UnitUpdateFieldMasks;
             if (ToUnit()->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
 
@@ -1459,22 +1475,22 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
             break;
         }
         case TYPEID_GAMEOBJECT:
-            flags = GameObjectUpdateFieldFlags;
+            masks = &GameObjectUpdateFieldMasks;
             if (ToGameObject()->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
             break;
         case TYPEID_DYNAMICOBJECT:
-            flags = DynamicObjectUpdateFieldFlags;
+            masks = &DynamicObjectUpdateFieldMasks;
             if (((DynamicObject*)this)->GetCasterGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
             break;
         case TYPEID_CORPSE:
-            flags = CorpseUpdateFieldFlags;
+            masks = &CorpseUpdateFieldMasks;
             if (ToCorpse()->GetOwnerGUID() == target->GetGUID())
                 visibleFlag |= UF_FLAG_OWNER;
             break;
         case TYPEID_AREATRIGGER:
-            flags = AreaTriggerUpdateFieldFlags;
+            masks = &AreaTriggerUpdateFieldMasks;
             break;
         case TYPEID_OBJECT:
             break;
@@ -1502,23 +1518,44 @@ void Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uin
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* target) const
 {
-    uint32* flags = NULL;
-    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    UpdateFieldFlagMasks const* masks = NULL;
+    uint32 visibleFlag = GetUpdateFieldData(target, masks);
+    if (!masks)
+        return;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (_fieldNotifyFlags & flags[index] || ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) || (_changesMask.GetBit(index) && (flags[index] & visibleFlag)))
-            updateMask->SetBit(index);
+    uint32 forced[UF_MAX_BLOCK_COUNT];
+    uint32 visible[UF_MAX_BLOCK_COUNT];
+    masks->GetMasks(visibleFlag, _fieldNotifyFlags, updateMask->GetCount(), forced, visible);
+
+    UpdateMask::ClientUpdateMaskType* bits = updateMask->GetBlocks();
+    UpdateMask::ClientUpdateMaskType const* changes = _changesMask.GetBlocks();
+    for (uint32 i = 0; i < updateMask->GetBlockCount(); ++i)
+        bits[i] |= forced[i] | (changes[i] & visible[i]);
 }
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* target) const
 {
-    uint32* value = m_uint32Values;
-    uint32* flags = NULL;
-    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    UpdateFieldFlagMasks const* masks = NULL;
+    uint32 visibleFlag = GetUpdateFieldData(target, masks);
+    if (!masks)
+        return;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index, ++value)
-        if (_fieldNotifyFlags & flags[index] || ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) || (*value && (flags[index] & visibleFlag)))
-            updateMask->SetBit(index);
+    uint32 forced[UF_MAX_BLOCK_COUNT];
+    uint32 visible[UF_MAX_BLOCK_COUNT];
+    masks->GetMasks(visibleFlag, _fieldNotifyFlags, updateMask->GetCount(), forced, visible);
+
+    UpdateMask::ClientUpdateMaskType* bits = updateMask->GetBlocks();
+    for (uint32 i = 0; i < updateMask->GetBlockCount(); ++i)
+    {
+        uint32 const* value = &m_uint32Values[i * UpdateMask::CLIENT_UPDATE_MASK_BITS];
+        uint32 count = std::min<uint32>(UpdateMask::CLIENT_UPDATE_MASK_BITS, m_valuesCount - i * UpdateMask::CLIENT_UPDATE_MASK_BITS);
+
+        UpdateMask::ClientUpdateMaskType nonZero = 0;
+        for (uint32 j = 0; j < count; ++j)
+            nonZero |= UpdateMask::ClientUpdateMaskType(value[j] != 0) << j;
+
+        bits[i] |= forced[i] | (nonZero & visible[i]);
+    }
 }
 
 void Object::SetInt32Value(uint16 index, int32 value)
@@ -1530,11 +1567,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
         m_int32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1547,11 +1580,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
         m_uint32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1573,11 +1602,7 @@ void Object::SetUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1591,11 +1616,7 @@ bool Object::AddUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -1613,11 +1634,7 @@ bool Object::RemoveUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -1634,11 +1651,7 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1658,11 +1671,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1682,11 +1691,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1749,11 +1754,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1765,11 +1766,7 @@ void Object::SetFlag_Force(uint16 index, uint32 newFlag)
         m_uint32Values[index] = newFlag;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 }
 
 void Object::RemoveFlag(uint16 index, uint32 oldFlag)
@@ -1785,11 +1782,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1808,11 +1801,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1831,11 +1820,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -2926,11 +2911,7 @@ void WorldObject::SendPlaySound(uint32 Sound, bool OnlySelf)
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
     _changesMask.SetBit(i);
-    if (m_inWorld && !m_objectUpdated)
-    {
-        sObjectAccessor->AddUpdateObject(this);
-        m_objectUpdated = true;
-    }
+    AddToObjectUpdateIfNeeded();
 }
 
 namespace Trinity
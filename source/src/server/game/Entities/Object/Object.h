@@ -107,6 +107,7 @@ enum NotifyFlags
 class WorldPacket;
 class UpdateData;
 class ByteBuffer;
+class UpdateFieldFlagMasks;
 class WorldSession;
 class Creature;
 class Player;
@@ -119,6 +120,7 @@ class ZoneScript;
 class Unit;
 class Item;
 class Transport;
+class Map;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
@@ -454,6 +456,9 @@ class Object
 
         void ClearUpdateMask(bool remove);
 
+        // map whose update list receives this object's field changes, NULL means the global ObjectAccessor list
+        virtual Map* GetObjectUpdateMap() const { return NULL; }
+
         uint16 GetValuesCount() const { return m_valuesCount; }
 
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
@@ -509,7 +514,7 @@ class Object
         std::string _ConcatFields(uint16 startIndex, uint16 size) const;
         void _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
-        uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+        uint32 GetUpdateFieldData(Player const* target, UpdateFieldFlagMasks const*& masks) const;
 
         void _SetUpdateBits(UpdateMask* updateMask, Player* target) const;
         void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
@@ -534,7 +539,10 @@ class Object
 
         uint16 _fieldNotifyFlags;
 
+        void AddToObjectUpdateIfNeeded();
+
         bool m_objectUpdated;
+        Map* m_objectUpdateMap;                             // update list the object was queued in, valid while m_objectUpdated is set
 
     private:
         bool m_inWorld;
@@ -1014,6 +1022,7 @@ class WorldObject : public Object, public WorldLocation
         virtual void ResetMap();
         Map* GetMap() const { ASSERT(m_currMap); return m_currMap; }
         Map* FindMap() const { return m_currMap; }
+        Map* GetObjectUpdateMap() const { return m_currMap; }
 
 
         virtual void SetLayeringMap(Map* map);
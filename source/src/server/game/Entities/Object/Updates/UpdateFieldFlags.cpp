@@ -16,6 +16,8 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "Errors.h"
+#include <cstring>
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -1656,3 +1658,50 @@ uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END] =
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+1
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+2
 };
+
+UpdateFieldFlagMasks::UpdateFieldFlagMasks(uint32 const* flags, uint32 fieldCount)
+{
+    _blockCount = (fieldCount + 31) / 32;
+    memset(_masks, 0, sizeof(_masks));
+
+    for (uint32 index = 0; index < fieldCount; ++index)
+        for (uint8 bit = 0; bit < UF_FLAG_BIT_COUNT; ++bit)
+            if (flags[index] & (1 << bit))
+                _masks[bit][index / 32] |= 1u << (index % 32);
+}
+
+void UpdateFieldFlagMasks::GetMasks(uint32 visibleFlag, uint32 notifyFlags, uint32 fieldCount, uint32* forced, uint32* visible) const
+{
+    uint32 blockCount = (fieldCount + 31) / 32;
+    ASSERT(blockCount <= _blockCount);
+
+    memset(forced, 0, sizeof(uint32) * blockCount);
+    memset(visible, 0, sizeof(uint32) * blockCount);
+
+    uint32 forcedFlag = notifyFlags | (visibleFlag & UF_FLAG_SPECIAL_INFO);
+    for (uint8 bit = 0; bit < UF_FLAG_BIT_COUNT; ++bit)
+    {
+        uint32 const* mask = _masks[bit];
+        if (forcedFlag & (1 << bit))
+            for (uint32 i = 0; i < blockCount; ++i)
+                forced[i] |= mask[i];
+
+        if (visibleFlag & (1 << bit))
+            for (uint32 i = 0; i < blockCount; ++i)
+                visible[i] |= mask[i];
+    }
+
+    // the last word may cover fields past fieldCount (players seen by others)
+    if (uint32 tail = fieldCount % 32)
+    {
+        forced[blockCount - 1] &= (1u << tail) - 1;
+        visible[blockCount - 1] &= (1u << tail) - 1;
+    }
+}
+
+UpdateFieldFlagMasks const ItemUpdateFieldMasks(ItemUpdateFieldFlags, CONTAINER_END);
+UpdateFieldFlagMasks const UnitUpdateFieldMasks(UnitUpdateFieldFlags, PLAYER_END);
+UpdateFieldFlagMasks const GameObjectUpdateFieldMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+UpdateFieldFlagMasks const DynamicObjectUpdateFieldMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+UpdateFieldFlagMasks const CorpseUpdateFieldMasks(CorpseUpdateFieldFlags, CORPSE_END);
+UpdateFieldFlagMasks const AreaTriggerUpdateFieldMasks(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
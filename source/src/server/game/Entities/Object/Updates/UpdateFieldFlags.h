@@ -35,6 +35,9 @@ enum UpdatefieldFlags
     UF_FLAG_DYNAMIC      = 0x100
 };
 
+#define UF_FLAG_BIT_COUNT       9
+#define UF_MAX_BLOCK_COUNT      ((PLAYER_END + 31) / 32)
+
 extern uint32 ItemUpdateFieldFlags[CONTAINER_END];
 extern uint32 UnitUpdateFieldFlags[PLAYER_END];
 extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
@@ -42,4 +45,29 @@ extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 extern uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END];
 
+// Update mask words of one flags table, split by flag so a viewer's field set is a few word ORs
+class UpdateFieldFlagMasks
+{
+    public:
+        UpdateFieldFlagMasks(uint32 const* flags, uint32 fieldCount);
+
+        /**
+         * Fills the masks of the first fieldCount fields.
+         * forced: fields sent in any update, having one of notifyFlags or special info visible to the viewer
+         * visible: fields the viewer may see, sent when they are changed (or set, on create)
+         */
+        void GetMasks(uint32 visibleFlag, uint32 notifyFlags, uint32 fieldCount, uint32* forced, uint32* visible) const;
+
+    private:
+        uint32 _blockCount;
+        uint32 _masks[UF_FLAG_BIT_COUNT][UF_MAX_BLOCK_COUNT];
+};
+
+extern UpdateFieldFlagMasks const ItemUpdateFieldMasks;
+extern UpdateFieldFlagMasks const UnitUpdateFieldMasks;
+extern UpdateFieldFlagMasks const GameObjectUpdateFieldMasks;
+extern UpdateFieldFlagMasks const DynamicObjectUpdateFieldMasks;
+extern UpdateFieldFlagMasks const CorpseUpdateFieldMasks;
+extern UpdateFieldFlagMasks const AreaTriggerUpdateFieldMasks;
+
 #endif // _UPDATEFIELDFLAGS_H
@@ -23,6 +23,10 @@
 #include "Errors.h"
 #include "ByteBuffer.h"
 
+#if COMPILER == COMPILER_MICROSOFT
+#include <intrin.h>
+#endif
+
 class UpdateMask
 {
     public:
@@ -36,29 +40,45 @@ class UpdateMask
 
         UpdateMask() : _fieldCount(0), _blockCount(0), _bits(NULL) { }
 
-        UpdateMask(UpdateMask const& right)
+        UpdateMask(UpdateMask const& right) : _fieldCount(0), _blockCount(0), _bits(NULL)
         {
             SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
+            memcpy(_bits, right._bits, sizeof(ClientUpdateMaskType) * _blockCount);
         }
 
         ~UpdateMask() { delete[] _bits; }
 
-        void SetBit(uint32 index) { _bits[index] = 1; }
-        void UnsetBit(uint32 index) { _bits[index] = 0; }
-        bool GetBit(uint32 index) const { return _bits[index] != 0; }
+        void SetBit(uint32 index) { _bits[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS); }
+        void UnsetBit(uint32 index) { _bits[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+        bool GetBit(uint32 index) const { return (_bits[index / CLIENT_UPDATE_MASK_BITS] & (ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS))) != 0; }
 
-        void AppendToPacket(ByteBuffer* data)
+        /// Index of the first set bit at or after index, GetCount() if there is none
+        uint32 GetNextBit(uint32 index) const
         {
-            for (uint32 i = 0; i < GetBlockCount(); ++i)
+            uint32 block = index / CLIENT_UPDATE_MASK_BITS;
+            if (block >= _blockCount)
+                return _fieldCount;
+
+            ClientUpdateMaskType bits = _bits[block] & (~ClientUpdateMaskType(0) << (index % CLIENT_UPDATE_MASK_BITS));
+            while (!bits)
             {
-                ClientUpdateMaskType maskPart = 0;
-                for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                    if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                        maskPart |= 1 << j;
+                if (++block >= _blockCount)
+                    return _fieldCount;
 
-                *data << maskPart;
+                bits = _bits[block];
             }
+
+            return block * CLIENT_UPDATE_MASK_BITS + CountTrailingZeros(bits);
+        }
+
+        /// Raw mask words, in the order the client reads them
+        ClientUpdateMaskType* GetBlocks() { return _bits; }
+        ClientUpdateMaskType const* GetBlocks() const { return _bits; }
+
+        void AppendToPacket(ByteBuffer* data)
+        {
+            for (uint32 i = 0; i < GetBlockCount(); ++i)
+                *data << _bits[i];
         }
 
         uint32 GetBlockCount() const { return _blockCount; }
@@ -71,14 +91,14 @@ class UpdateMask
             _fieldCount = valuesCount;
             _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
 
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            _bits = new ClientUpdateMaskType[_blockCount];
+            memset(_bits, 0, sizeof(ClientUpdateMaskType) * _blockCount);
         }
 
         void Clear()
         {
             if (_bits)
-                memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+                memset(_bits, 0, sizeof(ClientUpdateMaskType) * _blockCount);
         }
 
         UpdateMask& operator=(UpdateMask const& right)
@@ -87,23 +107,27 @@ class UpdateMask
                 return *this;
 
             SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            memcpy(_bits, right._bits, sizeof(ClientUpdateMaskType) * _blockCount);
             return *this;
         }
 
         UpdateMask& operator&=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
+            for (uint32 i = 0; i < right._blockCount; ++i)
                 _bits[i] &= right._bits[i];
 
+            // fields the right mask does not cover are dropped, same as a zero bit
+            for (uint32 i = right._blockCount; i < _blockCount; ++i)
+                _bits[i] = 0;
+
             return *this;
         }
 
         UpdateMask& operator|=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
+            for (uint32 i = 0; i < right._blockCount; ++i)
                 _bits[i] |= right._bits[i];
 
             return *this;
@@ -116,10 +140,21 @@ class UpdateMask
             return ret;
         }
 
+        static uint32 CountTrailingZeros(ClientUpdateMaskType bits)
+        {
+#if COMPILER == COMPILER_MICROSOFT
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return __builtin_ctz(bits);
+#endif
+        }
+
     private:
         uint32 _fieldCount;
         uint32 _blockCount;
-        uint8* _bits;
+        ClientUpdateMaskType* _bits;
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "ArcheologyMgr.h"
 #include "ArenaTeam.h"
 #include "ArenaTeamMgr.h"
+#include "BatchStatement.h"
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "BattlefieldWG.h"
@@ -951,6 +952,8 @@ Player::Player(WorldSession* session): Unit(true), phaseMgr(this)
 
     m_mailsLoaded = false;
     m_mailsUpdated = false;
+    m_aurasUpdated = true;
+    m_glyphsUpdated = true;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -20358,6 +20361,9 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
 
     _LoadArenaReward(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_ARENA_REWARD));
 
+    if (holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_ANTICHEAT_DAILY_REPORT))
+        m_anticheatData.SetDailyReportState(true);
+
     InitTaxiNodesForLevel();
     return true;
 }
@@ -22261,14 +22267,17 @@ void Player::SaveToDB(bool create /*=false*/)
     _SaveSpells(trans);
     _SaveSpellCooldowns(trans);
     _SaveActions(trans);
-    _SaveAuras(trans);
+    // durations of unchanged auras are only written on logout
+    if (m_aurasUpdated || m_session->isLogingOut())
+        _SaveAuras(trans);
     _SaveSkills(trans);
     m_achievementMgr->SaveToDB(trans);
     m_reputationMgr->SaveToDB(trans);
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
    //GetSession()->SaveClientConfigValuesToDB();
-    _SaveGlyphs(trans);
+    if (m_glyphsUpdated)
+        _SaveGlyphs(trans);
     _SaveInstanceTimeRestrictions(trans);
     _SaveCurrency(trans);
     _SaveCUFProfiles(trans);
@@ -22286,10 +22295,10 @@ void Player::SaveToDB(bool create /*=false*/)
     if (Guild* guild = GetGuild())
         guild->SaveProfession(this, trans);
 
-    CharacterDatabase.CommitTransaction(trans);
-    GetArcheologyMgr().SaveArcheology();
+    sAnticheatMgr->SavePlayerData(this, trans);
 
-	sAnticheatMgr->SavePlayerData(this);
+    CharacterDatabase.CommitTransaction(trans, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, GetGUIDLow()));
+    GetArcheologyMgr().SaveArcheology();
 }
 
 // fast save function for item/money cheating preventing - save only inventory and money state
@@ -22311,19 +22320,14 @@ void Player::SaveGoldToDB(SQLTransaction& trans)
 void Player::_SaveActions(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
+    BatchInsertStatement inserts(trans, "INSERT INTO character_action (guid, spec, button, action, type) VALUES ");
 
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
     {
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACTION);
-                stmt->setUInt32(0, GetGUIDLow());
-                stmt->setUInt8(1, GetActiveSpec());
-                stmt->setUInt8(2, itr->first);
-                stmt->setUInt32(3, itr->second.GetAction());
-                stmt->setUInt8(4, uint8(itr->second.GetType()));
-                trans->Append(stmt);
+                inserts.NewRow() << GetGUIDLow() << GetActiveSpec() << itr->first << itr->second.GetAction() << uint8(itr->second.GetType());
 
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
@@ -22354,6 +22358,8 @@ void Player::_SaveActions(SQLTransaction& trans)
                 break;
         }
     }
+
+    inserts.Flush();
 }
 
 void Player::_SaveAuras(SQLTransaction& trans)
@@ -22362,6 +22368,9 @@ void Player::_SaveAuras(SQLTransaction& trans)
     stmt->setUInt32(0, GetGUIDLow());
     trans->Append(stmt);
 
+    BatchInsertStatement inserts(trans, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, effect_mask, recalculate_mask, stackcount, "
+        "amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxduration, remaintime, remaincharges) VALUES ");
+
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -22390,26 +22399,14 @@ void Player::_SaveAuras(SQLTransaction& trans)
             }
         }
 
-        uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->setUInt32(index++, GetGUIDLow());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
-        trans->Append(stmt);
+        inserts.NewRow() << GetGUIDLow() << itr->second->GetCasterGUID() << itr->second->GetCastItemGUID() << itr->second->GetId()
+            << effMask << recalculateMask << uint8(itr->second->GetStackAmount())
+            << damage[0] << damage[1] << damage[2] << baseDamage[0] << baseDamage[1] << baseDamage[2]
+            << itr->second->GetMaxDuration() << itr->second->GetDuration() << itr->second->GetCharges();
     }
+
+    inserts.Flush();
+    m_aurasUpdated = false;
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -22940,28 +22937,25 @@ void Player::_SaveSkills(SQLTransaction& trans)
 
 void Player::_SaveSpells(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = NULL;
+    std::ostringstream deleteHead;
+    deleteHead << "DELETE FROM character_spell WHERE guid = " << GetGUIDLow() << " AND spell IN ";
+    BatchDeleteStatement deletes(trans, deleteHead.str());
 
-    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
-    {
+    // deletes go first, changed spells are deleted and inserted again. The inserts flush
+    // themselves every MAX_BATCH_STATEMENT_ROWS rows, so all deletes are appended before them
+    for (PlayerSpellMap::const_iterator itr = m_spells.begin(); itr != m_spells.end(); ++itr)
         if (itr->second->state == PLAYERSPELL_REMOVED || itr->second->state == PLAYERSPELL_CHANGED)
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_BY_SPELL);
-            stmt->setUInt32(0, itr->first);
-            stmt->setUInt32(1, GetGUIDLow());
-            trans->Append(stmt);
-        }
+            deletes.AddKey(itr->first);
+
+    deletes.Flush();
 
+    BatchInsertStatement inserts(trans, "INSERT INTO character_spell (guid, spell, active, disabled) VALUES ");
+
+    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
+    {
         // add only changed/new not dependent spells
         if (!itr->second->dependent && (itr->second->state == PLAYERSPELL_NEW || itr->second->state == PLAYERSPELL_CHANGED))
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SPELL);
-            stmt->setUInt32(0, GetGUIDLow());
-            stmt->setUInt32(1, itr->first);
-            stmt->setBool(2, itr->second->active);
-            stmt->setBool(3, itr->second->disabled);
-            trans->Append(stmt);
-        }
+            inserts.NewRow() << GetGUIDLow() << itr->first << itr->second->active << itr->second->disabled;
 
         if (itr->second->state == PLAYERSPELL_REMOVED)
         {
@@ -22974,6 +22968,8 @@ void Player::_SaveSpells(SQLTransaction& trans)
             ++itr;
         }
     }
+
+    inserts.Flush();
 }
 
 // save player stats -- only for external usage
@@ -23025,7 +23021,7 @@ void Player::_SaveStats(SQLTransaction& trans)
 
 void Player::outDebugValues() const
 {
-    if (!sLog->ShouldLog("entities.unit", LOG_LEVEL_DEBUG))
+    if (!TC_LOG_ENABLED("entities.unit", LOG_LEVEL_DEBUG))
         return;
 
     TC_LOG_DEBUG("entities.unit", "HP is: \t\t\t%u\t\tMP is: \t\t\t%u", GetMaxHealth(), GetMaxPower(POWER_MANA));
@@ -29677,21 +29673,17 @@ void Player::_SaveGlyphs(SQLTransaction& trans)
     stmt->setUInt32(0, GetGUIDLow());
     trans->Append(stmt);
 
-
+    BatchInsertStatement inserts(trans, "INSERT INTO character_glyphs (guid, spec, glyph1, glyph2, glyph3, glyph4, glyph5, glyph6, glyph7, glyph8, glyph9) VALUES ");
     for (uint8 spec = 0; spec < GetSpecsCount(); ++spec)
     {
-        uint8 index = 0;
-
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_GLYPHS);
-        stmt->setUInt32(index++, GetGUIDLow());
-
-        stmt->setUInt8(index++, spec);
+        inserts.NewRow() << GetGUIDLow() << spec;
 
         for (uint8 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
-            stmt->setUInt16(index++, uint16(GetGlyph(spec, i)));
-
-        trans->Append(stmt);
+            inserts << uint16(GetGlyph(spec, i));
     }
+
+    inserts.Flush();
+    m_glyphsUpdated = false;
 }
 
 void Player::_LoadTalents(PreparedQueryResult result)
@@ -29708,6 +29700,7 @@ void Player::_LoadTalents(PreparedQueryResult result)
 void Player::_SaveTalents(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
+    BatchInsertStatement inserts(trans, "INSERT INTO character_talent (guid, spell, spec) VALUES ");
 
     for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
     {
@@ -29723,13 +29716,7 @@ void Player::_SaveTalents(SQLTransaction& trans)
             }
 
             if (itr->second->state == PLAYERSPELL_NEW || itr->second->state == PLAYERSPELL_CHANGED)
-            {
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT);
-                stmt->setUInt32(0, GetGUIDLow());
-                stmt->setUInt32(1, itr->first);
-                stmt->setUInt8(2, itr->second->spec);
-                trans->Append(stmt);
-            }
+                inserts.NewRow() << GetGUIDLow() << itr->first << itr->second->spec;
 
             if (itr->second->state == PLAYERSPELL_REMOVED)
             {
@@ -29743,6 +29730,8 @@ void Player::_SaveTalents(SQLTransaction& trans)
             }
         }
     }
+
+    inserts.Flush();
 }
 
 void Player::UpdateSpecCount(uint8 count)
@@ -29787,6 +29776,7 @@ void Player::UpdateSpecCount(uint8 count)
     CharacterDatabase.CommitTransaction(trans);
 
     SetSpecsCount(count);
+    m_glyphsUpdated = true;
 
     SendTalentsInfoData(false);
 }
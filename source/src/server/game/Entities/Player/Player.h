@@ -33,6 +33,7 @@
 #include "WorldSession.h"
 #include "ArcheologyMgr.h"
 #include "Battleground.h"
+#include "AnticheatData.h"
 #include "../scripts/Custom/Template/Template.h"
 #include "../game/Movement/Spline/MoveSpline.h"
 
@@ -952,6 +953,7 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_KEYSTONES               = 47,
     PLAYER_LOGIN_QUERY_LOAD_ARENA_REWARD            = 48,
     PLAYER_LOGIN_QUERY_LOAD_CLIENT_CONFIGS          = 49,
+    PLAYER_LOGIN_QUERY_LOAD_ANTICHEAT_DAILY_REPORT  = 50,
     MAX_PLAYER_LOGIN_QUERY
 };
 
@@ -1930,6 +1932,8 @@ class Player : public Unit, public GridObject<Player>
 
         bool m_mailsLoaded;
         bool m_mailsUpdated;
+        bool m_aurasUpdated;                                // owned auras changed since the last save
+        bool m_glyphsUpdated;
 
         void SetBindPoint(uint64 guid);
         void SendTalentWipeConfirm(uint64 guid);
@@ -2102,6 +2106,7 @@ class Player : public Unit, public GridObject<Player>
         {
             _talentMgr->SpecInfo[GetActiveSpec()].Glyphs[slot] = glyph;
             SetUInt32Value(PLAYER_FIELD_GLYPHS_1 + slot, glyph);
+            m_glyphsUpdated = true;
         }
         uint32 GetGlyph(uint8 spec, uint8 slot) const { return _talentMgr->SpecInfo[spec].Glyphs[slot]; }
 
@@ -2195,6 +2200,7 @@ class Player : public Unit, public GridObject<Player>
         void UpdatePvPState(bool onlyFFA = false);
         void UpdatePvP(bool state, bool force_skip_five_minutes=false);
         void UpdateZone(uint32 newZone, uint32 newArea);
+        uint32 GetCachedZoneId() const { return m_zoneUpdateId; }
         bool IsPVPForceFlaggedZone(uint32 zone);
         void UpdateArea(uint32 newArea);
 
@@ -2413,6 +2419,9 @@ class Player : public Unit, public GridObject<Player>
         bool IsWaitingLandOrSwimOpcode() const { return m_antiNoFallDmg; }
         bool IsUnderLastChanceForLandOrSwimOpcode() const { return m_antiNoFallDmgLastChance; }
         void SetSuccessfullyLanded() { m_antiNoFallDmgLastChance = false; m_AllowedToFall = false; }
+
+        AnticheatData& GetAnticheatData() { return m_anticheatData; }
+        AnticheatData const& GetAnticheatData() const { return m_anticheatData; }
         // END AntiCheat system
 
         // Walking data from move packets
@@ -3541,6 +3550,8 @@ class Player : public Unit, public GridObject<Player>
         uint32 lastMoveClientTimestamp;
         // Timestamp on server clock of the moment the most recently processed movement packet was RECEIVED from the client
         uint32 lastMoveServerTimestamp;
+        // Report state of the AnticheatMgr detections
+        AnticheatData m_anticheatData;
         // END Anticheat feautures
 
         bool m_walking;             // Player walking
@@ -3850,6 +3850,9 @@ void Unit::_AddAura(UnitAura* aura, Unit* caster)
     ASSERT(!m_cleanupDone);
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
 
+    if (Player* player = ToPlayer())
+        player->m_aurasUpdated = true;
+
     _RemoveNoStackAurasDueToAura(aura);
 
     if (aura->IsRemoved())
@@ -4109,6 +4112,47 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierAggregate(aurEff->GetAuraType());
+}
+
+void Unit::InvalidateAuraModifierAggregate(AuraType auratype)
+{
+    AuraModifierAggregateMap::iterator itr = m_auraModifierAggregates.find(auratype);
+    if (itr != m_auraModifierAggregates.end())
+        itr->second.Generation = 0;
+}
+
+AuraModifierAggregate const& Unit::GetAuraModifierAggregate(AuraType auratype) const
+{
+    AuraModifierAggregate& aggregate = m_auraModifierAggregates[auratype];
+    uint32 generation = sSpellMgr->GetSpellGroupGeneration();
+    if (aggregate.Generation == generation)
+        return aggregate;
+
+    std::map<SpellGroup, int32> SameEffectSpellGroup;
+    aggregate.Total = 0;
+    aggregate.MaxPositive = 0;
+    aggregate.MaxNegative = 0;
+
+    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    {
+        int32 amount = (*i)->GetAmount();
+        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), amount, SameEffectSpellGroup))
+            aggregate.Total += amount;
+
+        if (amount > aggregate.MaxPositive)
+            aggregate.MaxPositive = amount;
+        if (amount < aggregate.MaxNegative)
+            aggregate.MaxNegative = amount;
+    }
+
+    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+        aggregate.Total += itr->second;
+
+    aggregate.Generation = generation;
+    return aggregate;
 }
 
 // All aura base removes should go threw this function!
@@ -4124,6 +4168,9 @@ void Unit::RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode)
     m_ownedAuras.erase(i);
     m_removedAuras.push_back(aura);
 
+    if (Player* player = ToPlayer())
+        player->m_aurasUpdated = true;
+
     // Unregister single target aura
     if (aura->IsSingleTarget())
         aura->UnregisterSingleTarget();
@@ -5252,16 +5299,9 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     if (mTotalAuraList.empty())
         return 0;
 
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
-
-    for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-            modifier += (*i)->GetAmount();
-
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+    int32 modifier = GetAuraModifierAggregate(auratype).Total;
 
+    // depends on the equipped weapon, not part of the aggregate
     if (auratype == SPELL_AURA_MOD_HIT_CHANCE && getClass() == CLASS_DEATH_KNIGHT && GetTypeId() == TYPEID_PLAYER)
     {
         for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
@@ -5276,47 +5316,29 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
     float multiplier = 1.0f;
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float tempMod = 0.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-            tempMod += (*i)->GetAmount();
+    if (GetAuraEffectsByType(auratype).empty())
+        return multiplier;
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        tempMod += itr->second;
-
-    if (tempMod)
+    if (int32 tempMod = GetAuraModifierAggregate(auratype).Total)
         AddPct(multiplier, tempMod);
 
     return multiplier;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+    if (GetAuraEffectsByType(auratype).empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+    if (GetAuraEffectsByType(auratype).empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
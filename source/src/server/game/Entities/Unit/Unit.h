@@ -1277,6 +1277,19 @@ enum SpellCooldownFlags
 
 typedef UNORDERED_MAP<uint32, uint32> PacketCooldowns;
 
+// Unfiltered modifiers of one aura type, rebuilt on first query after an effect of that type or the spell groups changed
+struct AuraModifierAggregate
+{
+    AuraModifierAggregate() : Total(0), MaxPositive(0), MaxNegative(0), Generation(0) { }
+
+    int32 Total;                                            // same effect stack rule groups only add their strongest amount
+    int32 MaxPositive;
+    int32 MaxNegative;
+    uint32 Generation;                                      // SpellMgr::GetSpellGroupGeneration() it was built with, 0 if invalid
+};
+
+typedef UNORDERED_MAP<uint32 /*AuraType*/, AuraModifierAggregate> AuraModifierAggregateMap;
+
 struct PositionUpdateInfo
 {
     void Reset()
@@ -1904,6 +1917,7 @@ class Unit : public WorldObject
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        void InvalidateAuraModifierAggregate(AuraType auratype);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
@@ -1997,7 +2011,7 @@ class Unit : public WorldObject
 
         int32 GetTotalAuraModifier(AuraType auratype) const;
         float GetTotalAuraMultiplier(AuraType auratype) const;
-        int32 GetMaxPositiveAuraModifier(AuraType auratype);
+        int32 GetMaxPositiveAuraModifier(AuraType auratype) const;
         int32 GetMaxNegativeAuraModifier(AuraType auratype) const;
 
         int32 GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const;
@@ -2534,6 +2548,8 @@ class Unit : public WorldObject
         uint32 m_removedAurasCount;
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+        mutable AuraModifierAggregateMap m_auraModifierAggregates;  // only holds the aura types which were queried
+        AuraModifierAggregate const& GetAuraModifierAggregate(AuraType auratype) const;
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -219,6 +219,7 @@ class ObjectAccessor
         static void SaveAllPlayers();
 
         //non-static functions
+        // objects that are not on a map or were changed while another map was updated, see Object::AddToObjectUpdateIfNeeded
         void AddUpdateObject(Object* obj)
         {
             TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
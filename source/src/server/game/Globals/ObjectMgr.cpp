@@ -45,11 +45,13 @@
 #include "SpellMgr.h"
 #include "SpellScript.h"
 #include "Transport.h"
+#include "UnorderedSet.h"
 #include "UpdateMask.h"
 #include "Util.h"
 #include "Vehicle.h"
 #include "WaypointManager.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 #include "InfoMgr.h"
 
 ScriptMapMap sSpellScripts;
@@ -245,8 +247,7 @@ ObjectMgr::ObjectMgr():
     _hiDoGuid(1),
     _hiCorpseGuid(1),
     _hiAreaTriggerGuid(1),
-    _hiMoTransGuid(1),
-    m_reportQuestTimer(1)
+    _hiMoTransGuid(1)
 {
     for (uint8 i = 0; i < MAX_CLASSES; ++i)
         for (uint8 j = 0; j < MAX_RACES; ++j)
@@ -1516,10 +1517,39 @@ void ObjectMgr::LoadTempSummons()
     TC_LOG_INFO("server.loading", ">> Loaded %u temp summons in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
+// Processed creature spawn as stored in the snapshot
+struct CreatureSnapshotRecord
+{
+    uint32 Guid;
+    bool OnGrid;
+    CreatureData Data;
+};
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    // the zone and area correction changes the table while loading it
+    WorldSnapshot::Key snapshotKey;
+    bool useSnapshot = !sWorld->getBoolConfig(CONFIG_ALLOW_ZONE_AND_AREA_VALUES_CORRECTION_AT_STARTUP)
+        && WorldSnapshot::GetKey({ "creature", "creature_template", "creature_equip_template", "game_event_creature", "pool_creature" }, sizeof(CreatureSnapshotRecord), snapshotKey);
+
+    std::vector<CreatureSnapshotRecord> snapshot;
+    if (useSnapshot && WorldSnapshot::Load("creature", snapshotKey, snapshot))
+    {
+        _creatureDataStore.rehash(snapshot.size());
+        for (CreatureSnapshotRecord const& record : snapshot)
+        {
+            CreatureData& data = _creatureDataStore[record.Guid];
+            data = record.Data;
+            if (record.OnGrid)
+                AddCreatureToGrid(record.Guid, &data);
+        }
+
+        TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " creatures from snapshot in %u ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        return;
+    }
+
     //                                               0              1   2    3        4             5           6           7           8            9              10              11
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, corpsetimesecs, spawndist, "
     //   12               13         14       15            16         17         18          19          20                21                   22                     23    24
@@ -1543,6 +1573,7 @@ void ObjectMgr::LoadCreatures()
                     spawnMasks[i] |= (1 << k);
 
     _creatureDataStore.rehash(result->GetRowCount());
+    UNORDERED_SET<uint32> gridGuids;
 
     do
     {
@@ -1666,10 +1697,28 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(guid, &data);
+            gridGuids.insert(guid);
+        }
     }
     while (result->NextRow());
 
+    if (useSnapshot)
+    {
+        snapshot.reserve(_creatureDataStore.size());
+        for (CreatureDataContainer::const_iterator itr = _creatureDataStore.begin(); itr != _creatureDataStore.end(); ++itr)
+        {
+            CreatureSnapshotRecord record;
+            record.Guid = itr->first;
+            record.OnGrid = gridGuids.find(itr->first) != gridGuids.end();
+            record.Data = itr->second;
+            snapshot.push_back(record);
+        }
+
+        WorldSnapshot::Save("creature", snapshotKey, snapshot);
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " creatures in %u ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1930,10 +1979,39 @@ uint32 ObjectMgr::AddCreData(uint32 entry, uint32 /*team*/, uint32 mapId, float
     return guid;
 }
 
+// Processed gameobject spawn as stored in the snapshot
+struct GameObjectSnapshotRecord
+{
+    uint32 Guid;
+    bool OnGrid;
+    GameObjectData Data;
+};
+
 void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    // the zone and area correction changes the table while loading it
+    WorldSnapshot::Key snapshotKey;
+    bool useSnapshot = !sWorld->getBoolConfig(CONFIG_ALLOW_ZONE_AND_AREA_VALUES_CORRECTION_AT_STARTUP)
+        && WorldSnapshot::GetKey({ "gameobject", "gameobject_template", "game_event_gameobject", "pool_gameobject" }, sizeof(GameObjectSnapshotRecord), snapshotKey);
+
+    std::vector<GameObjectSnapshotRecord> snapshot;
+    if (useSnapshot && WorldSnapshot::Load("gameobject", snapshotKey, snapshot))
+    {
+        _gameObjectDataStore.rehash(snapshot.size());
+        for (GameObjectSnapshotRecord const& record : snapshot)
+        {
+            GameObjectData& data = _gameObjectDataStore[record.Guid];
+            data = record.Data;
+            if (record.OnGrid)
+                AddGameobjectToGrid(record.Guid, &data);
+        }
+
+        TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gameobjects from snapshot in %u ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        return;
+    }
+
     //                                                0                1   2    3           4           5           6
     QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14         15         16          17          18    19
@@ -1956,6 +2034,7 @@ void ObjectMgr::LoadGameobjects()
                     spawnMasks[i] |= (1 << k);
 
     _gameObjectDataStore.rehash(result->GetRowCount());
+    UNORDERED_SET<uint32> gridGuids;
 
     do
     {
@@ -2076,10 +2155,28 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        {
             AddGameobjectToGrid(guid, &data);
+            gridGuids.insert(guid);
+        }
     }
     while (result->NextRow());
 
+    if (useSnapshot)
+    {
+        snapshot.reserve(_gameObjectDataStore.size());
+        for (GameObjectDataContainer::const_iterator itr = _gameObjectDataStore.begin(); itr != _gameObjectDataStore.end(); ++itr)
+        {
+            GameObjectSnapshotRecord record;
+            record.Guid = itr->first;
+            record.OnGrid = gridGuids.find(itr->first) != gridGuids.end();
+            record.Data = itr->second;
+            snapshot.push_back(record);
+        }
+
+        WorldSnapshot::Save("gameobject", snapshotKey, snapshot);
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded " SZFMTD " gameobjects in %u ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -9662,32 +9759,26 @@ void ObjectMgr::LoadReportQuestData()
     TC_LOG_INFO("server.loading", ">> Loaded %u report quest info entries in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
-void ObjectMgr::UpdateReportQuestData(uint32 diff)
+void ObjectMgr::SaveReportQuestData()
 {
-    if (m_reportQuestTimer <= diff)
+    if (_ReportQuestData.empty())
+        return;
+
+    SQLTransaction trans = WorldDatabase.BeginTransaction();
+    for (unsigned int i = 0; i < _ReportQuestData.size(); i++)
     {
-        if (!_ReportQuestData.empty())
+        if (_ReportQuestData[i]->needSave)
         {
-            SQLTransaction trans = WorldDatabase.BeginTransaction();
-            for (unsigned int i = 0; i < _ReportQuestData.size(); i++)
-            {
-                if (_ReportQuestData[i]->needSave)
-                {
-                    _ReportQuestData[i]->needSave = false;
-                    uint8 index = 0;
-                    PreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_UPD_REPORT_QUESTS);
-                    stmt->setUInt32(index, _ReportQuestData[i]->questId);
-                    stmt->setUInt32(++index, _ReportQuestData[i]->status);
-                    stmt->setUInt32(++index, _ReportQuestData[i]->count);
-                    trans->Append(stmt);
-                }
-            }
-            WorldDatabase.CommitTransaction(trans);
+            _ReportQuestData[i]->needSave = false;
+            uint8 index = 0;
+            PreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_UPD_REPORT_QUESTS);
+            stmt->setUInt32(index, _ReportQuestData[i]->questId);
+            stmt->setUInt32(++index, _ReportQuestData[i]->status);
+            stmt->setUInt32(++index, _ReportQuestData[i]->count);
+            trans->Append(stmt);
         }
-        m_reportQuestTimer = sWorld->getIntConfig(CONFIG_REPORTQUEST_UPDATETIMER);
     }
-    else
-        m_reportQuestTimer -= diff;
+    WorldDatabase.CommitTransaction(trans);
 }
 
 void ObjectMgr::ModifyReportQuestData(uint32 questId, uint32 status, uint32 count)
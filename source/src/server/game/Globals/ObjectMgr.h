@@ -1409,7 +1409,7 @@ class ObjectMgr
 
         void LoadReportQuestData();
         ReportQuestData const & GetReportQuestData() const { return _ReportQuestData; }
-        void UpdateReportQuestData(uint32 diff);
+        void SaveReportQuestData();
         void ModifyReportQuestData(uint32 questId, uint32 status, uint32 count);
         void GetReportQuestStatuCount(uint32 entry, uint32 &status, uint32 &count);
 
@@ -1570,7 +1570,6 @@ class ObjectMgr
         HotfixData _hotfixData;
         std::queue<uint32 > _freeItemGuid;
         ReportQuestData _ReportQuestData;
-        uint32 m_reportQuestTimer;
 
         struct BroadcastTextHelper
         {
@@ -0,0 +1,136 @@
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "SHA1.h"
+#include "SystemConfig.h"
+#include "World.h"
+
+#include <cstdio>
+
+namespace WorldSnapshot
+{
+
+struct Header
+{
+    char Magic[4];
+    uint32 Version;
+    uint32 RecordSize;
+    uint32 RecordCount;
+    uint8 Key[WORLD_SNAPSHOT_KEY_SIZE];
+    uint8 Checksum[WORLD_SNAPSHOT_KEY_SIZE];                    // SHA1 of the records
+};
+
+static char const SnapshotMagic[4] = { 'W', 'S', 'N', 'P' };
+
+static std::string GetFileName(char const* name)
+{
+    return sWorld->GetSnapshotPath() + name + ".snapshot";
+}
+
+static void GetChecksum(uint8 const* data, size_t size, uint8* checksum)
+{
+    SHA1Hash sha;
+    if (size)
+        sha.UpdateData(data, int(size));
+    sha.Finalize();
+    memcpy(checksum, sha.GetDigest(), WORLD_SNAPSHOT_KEY_SIZE);
+}
+
+bool GetKey(std::initializer_list<char const*> tables, uint32 recordSize, Key& key)
+{
+    if (sWorld->GetSnapshotPath().empty())
+        return false;
+
+    SHA1Hash sha;
+    uint32 layout[2] = { WORLD_SNAPSHOT_VERSION, recordSize };
+    sha.UpdateData(reinterpret_cast<uint8 const*>(layout), sizeof(layout));
+    sha.UpdateData(_FULLVERSION);                               // validation code changes with the core
+
+    for (char const* table : tables)
+    {
+        QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE `%s`", table);
+        if (!result || result->Fetch()[1].IsNull())
+        {
+            TC_LOG_ERROR("server.loading", "Can't checksum table `%s`, snapshot not used.", table);
+            return false;
+        }
+
+        sha.UpdateData(table);
+        sha.UpdateData(result->Fetch()[1].GetString());
+    }
+
+    sha.Finalize();
+    memcpy(key.Digest, sha.GetDigest(), WORLD_SNAPSHOT_KEY_SIZE);
+    return true;
+}
+
+bool Read(char const* name, Key const& key, uint32 recordSize, std::vector<uint8>& data)
+{
+    std::string fileName = GetFileName(name);
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    Header header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+        && !memcmp(header.Magic, SnapshotMagic, sizeof(SnapshotMagic))
+        && header.Version == WORLD_SNAPSHOT_VERSION
+        && header.RecordSize == recordSize
+        && !memcmp(header.Key, key.Digest, WORLD_SNAPSHOT_KEY_SIZE);
+
+    if (valid)
+    {
+        data.resize(size_t(header.RecordCount) * recordSize);
+        valid = data.empty() || fread(&data[0], data.size(), 1, file) == 1;
+    }
+
+    fclose(file);
+
+    if (!valid)
+    {
+        TC_LOG_INFO("server.loading", "Snapshot %s is outdated, loading from the database.", fileName.c_str());
+        return false;
+    }
+
+    uint8 checksum[WORLD_SNAPSHOT_KEY_SIZE];
+    GetChecksum(data.empty() ? NULL : &data[0], data.size(), checksum);
+    if (memcmp(checksum, header.Checksum, WORLD_SNAPSHOT_KEY_SIZE))
+    {
+        TC_LOG_ERROR("server.loading", "Snapshot %s is corrupted, loading from the database.", fileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void Write(char const* name, Key const& key, uint32 recordSize, uint8 const* data, size_t size)
+{
+    Header header;
+    memcpy(header.Magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.Version = WORLD_SNAPSHOT_VERSION;
+    header.RecordSize = recordSize;
+    header.RecordCount = uint32(size / recordSize);
+    memcpy(header.Key, key.Digest, WORLD_SNAPSHOT_KEY_SIZE);
+    GetChecksum(data, size, header.Checksum);
+
+    // written aside and renamed, a crash never leaves a truncated snapshot behind
+    std::string fileName = GetFileName(name);
+    std::string tempName = fileName + ".tmp";
+    FILE* file = fopen(tempName.c_str(), "wb");
+    if (!file)
+    {
+        TC_LOG_ERROR("server.loading", "Can't create snapshot %s.", tempName.c_str());
+        return;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && (!size || fwrite(data, size, 1, file) == 1);
+
+    if (fclose(file) || !written || rename(tempName.c_str(), fileName.c_str()))
+    {
+        TC_LOG_ERROR("server.loading", "Can't write snapshot %s.", fileName.c_str());
+        remove(tempName.c_str());
+    }
+}
+
+}
@@ -0,0 +1,61 @@
+#ifndef TRINITY_WORLDSNAPSHOT_H
+#define TRINITY_WORLDSNAPSHOT_H
+
+#include "Define.h"
+
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#define WORLD_SNAPSHOT_VERSION  1
+#define WORLD_SNAPSHOT_KEY_SIZE 20
+
+/**
+ * On-disk copies of processed world database stores.
+ *
+ * A snapshot is an array of fixed size records behind a header, written after a
+ * store was loaded and validated from the database. It is keyed by the
+ * CHECKSUM TABLE values of every table the store is built from, the record size
+ * and the core version, and carries a checksum of its records. A store loads
+ * from its snapshot only while all of them match, otherwise it queries the
+ * database as usual and writes a new snapshot.
+ *
+ * Rows skipped during validation are not in the snapshot, their errors are only
+ * logged by the load which wrote it.
+ */
+namespace WorldSnapshot
+{
+    struct Key
+    {
+        uint8 Digest[WORLD_SNAPSHOT_KEY_SIZE];
+    };
+
+    // false if snapshots are disabled or a table can't be checksummed
+    bool GetKey(std::initializer_list<char const*> tables, uint32 recordSize, Key& key);
+
+    bool Read(char const* name, Key const& key, uint32 recordSize, std::vector<uint8>& data);
+    void Write(char const* name, Key const& key, uint32 recordSize, uint8 const* data, size_t size);
+
+    // records have to be trivially copyable
+    template<class T>
+    bool Load(char const* name, Key const& key, std::vector<T>& records)
+    {
+        std::vector<uint8> data;
+        if (!Read(name, key, sizeof(T), data))
+            return false;
+
+        records.resize(data.size() / sizeof(T));
+        if (!data.empty())
+            memcpy(&records[0], &data[0], data.size());
+        return true;
+    }
+
+    template<class T>
+    void Save(char const* name, Key const& key, std::vector<T> const& records)
+    {
+        Write(name, key, sizeof(T), records.empty() ? NULL : reinterpret_cast<uint8 const*>(&records[0]), records.size() * sizeof(T));
+    }
+}
+
+#endif
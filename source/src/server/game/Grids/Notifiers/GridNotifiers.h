@@ -33,6 +33,7 @@
 #include "CreatureAI.h"
 #include "Spell.h"
 #include "WorldSession.h"
+#include "PreparedPacket.h"
 
 class Player;
 //class Map;
@@ -125,7 +126,7 @@ namespace Trinity
     struct MessageDistDeliverer
     {
         WorldObject* i_source;
-        WorldPacket* i_message;
+        PreparedPacket i_message;                           // compressed once for all receivers
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
@@ -151,7 +152,7 @@ namespace Trinity
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+                session->SendPacket(&i_message);
         }
     };
 
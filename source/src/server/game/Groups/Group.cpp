@@ -39,6 +39,7 @@
 #include "InfoMgr.h"
 #include "InstanceScript.h"
 #include "SoloQueue.h"
+#include "PreparedPacket.h"
 
 Roll::Roll(uint64 _guid, LootItem const& li) : itemGUID(_guid), itemid(li.itemid),
 itemRandomPropId(li.randomPropertyId), itemRandomSuffix(li.randomSuffix), itemCount(li.count),
@@ -1747,6 +1748,7 @@ void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string&
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    PreparedPacket prepared(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->getSource();
@@ -1754,7 +1756,7 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(&prepared);
     }
 }
 
@@ -35,6 +35,7 @@
 #include "Battleground.h"
 #include "ReputationMgr.h"
 #include "InfoMgr.h"
+#include "PreparedPacket.h"
 
 #define MAX_GUILD_BANK_TAB_TEXT_LEN 500
 #define EMBLEM_PRICE 10 * GOLD
@@ -1797,10 +1798,11 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string const& motd)
 
 void Guild::BroadcastPacketIfTrackingAchievement(WorldPacket* packet, uint32 criteriaId) const
 {
+    PreparedPacket prepared(packet);
     for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (itr->second->IsTrackingCriteriaId(criteriaId))
             if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(&prepared);
 }
 
 void Guild::HandleSetInfo(WorldSession* session, std::string const& info)
@@ -2288,7 +2290,7 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint64 amount, bool
         stmt->setUInt64(0, m_cashFlowContribution);
         stmt->setUInt32(1, m_id);
         trans->Append(stmt);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_GUILD, m_id));
         return;
     }
 
@@ -2297,7 +2299,7 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint64 amount, bool
     player->SaveGoldToDB(trans);
 
     _LogBankEvent(trans, cashFlow ? GUILD_BANK_LOG_CASH_FLOW_DEPOSIT : GUILD_BANK_LOG_DEPOSIT_MONEY, uint8(0), player->GetGUIDLow(), amount);
-    CharacterDatabase.CommitTransaction(trans);
+    _CommitMemberMoneyTransaction(trans, player);
 
     std::string aux = ByteArrayToHexStr(reinterpret_cast<uint8*>(&m_bankMoney), 8, true);
     _BroadcastEvent(GE_BANK_MONEY_SET, 0, aux.c_str());
@@ -2310,6 +2312,12 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint64 amount, bool
     }
 }
 
+// The bank money and the money of the character are written together, ordered with the saves of both
+void Guild::_CommitMemberMoneyTransaction(SQLTransaction& trans, Player* player)
+{
+    CharacterDatabase.CommitTransaction(trans, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_GUILD, m_id), MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, player->GetGUIDLow()));
+}
+
 bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint64 amount, bool repair)
 {
     if (m_bankMoney < amount)                               // Not enough money in bank
@@ -2342,7 +2350,7 @@ bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint64 amount, bool
     _ModifyBankMoney(trans, amount, false);
     // Log guild bank event
     _LogBankEvent(trans, repair ? GUILD_BANK_LOG_REPAIR_MONEY : GUILD_BANK_LOG_WITHDRAW_MONEY, uint8(0), player->GetGUIDLow(), amount);
-    CharacterDatabase.CommitTransaction(trans);
+    _CommitMemberMoneyTransaction(trans, player);
 
     std::string aux = ByteArrayToHexStr(reinterpret_cast<uint8*>(&m_bankMoney), 8, true);
     _BroadcastEvent(GE_BANK_MONEY_SET, 0, aux.c_str());
@@ -2919,17 +2927,19 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, bool officerOnly, std::
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 {
+    PreparedPacket prepared(packet);
     for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (itr->second->IsRank(rankId))
             if (Player* player = itr->second->FindPlayer())
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(&prepared);
 }
 
 void Guild::BroadcastPacket(WorldPacket* packet) const
 {
+    PreparedPacket prepared(packet);
     for (auto itr = m_members.begin(); itr != m_members.end(); ++itr)
         if (Player* player = itr->second->FindPlayer())
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(&prepared);
 }
 
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
@@ -3780,7 +3790,7 @@ void Guild::_BroadcastEvent(GuildEvents guildEvent, uint64 guid, const char* par
 
     BroadcastPacket(&data);
 
-    if (sLog->ShouldLog("guild", LOG_LEVEL_DEBUG))
+    if (TC_LOG_ENABLED("guild", LOG_LEVEL_DEBUG))
         TC_LOG_DEBUG("guild", "SMSG_GUILD_EVENT [Broadcast] Event: %s (%u)", _GetGuildEventString(guildEvent).c_str(), guildEvent);
 }
 
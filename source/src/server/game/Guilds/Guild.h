@@ -1047,6 +1047,7 @@ private:
     bool _IsLeader(Player* player) const;
     void _DeleteBankItems(SQLTransaction& trans, bool removeItemsFromDB = false);
     bool _ModifyBankMoney(SQLTransaction& trans, uint64 amount, bool add);
+    void _CommitMemberMoneyTransaction(SQLTransaction& trans, Player* player);
     void _SetLeaderGUID(Member* pLeader);
     void _SwitchRank(uint8 rankId, bool up);
 
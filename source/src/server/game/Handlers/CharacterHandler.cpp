@@ -270,6 +270,10 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt32(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_ARENA_REWARD, stmt);
 
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_DAILY_PLAYERS_REPORT);
+    stmt->setUInt32(0, lowGuid);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_ANTICHEAT_DAILY_REPORT, stmt);
+
     return res;
 }
 
@@ -863,7 +867,7 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket& recvData)
     TC_LOG_INFO("entities.player.character", "Account: %d, IP: %s deleted character: %s, GUID: %u, Level: %u", accountId, GetRemoteAddress().c_str(), name.c_str(), GUID_LOPART(guid), level);
     sScriptMgr->OnPlayerDelete(guid);
 
-    if (sLog->ShouldLog("entities.player.dump", LOG_LEVEL_INFO)) // optimize GetPlayerDump call
+    if (TC_LOG_ENABLED("entities.player.dump", LOG_LEVEL_INFO)) // optimize GetPlayerDump call
     {
         std::string dump;
         if (PlayerDumpWriter().GetDump(GUID_LOPART(guid), dump))
@@ -934,7 +938,8 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    // Same shard as the saves of this character, a relog can not read data older than the logout save
+    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, GUID_LOPART(playerGuid)));
 }
 
 void WorldSession::HandleLoadScreenOpcode(WorldPacket& recvPacket)
@@ -1139,7 +1144,8 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_ONLINE);
     stmt->setUInt32(0, pCurrChar->GetGUIDLow());
-    CharacterDatabase.Execute(stmt);
+    // ordered with the logout update of the account, a quick relog must not end offline
+    CharacterDatabase.Execute(stmt, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_ACCOUNT, GetAccountId()));
 
     stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_ACCOUNT_ONLINE);
     stmt->setUInt32(0, GetAccountId());
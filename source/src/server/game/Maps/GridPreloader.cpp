@@ -0,0 +1,160 @@
+#include "GridPreloader.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "World.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+class GridPreloadRequest : public ACE_Method_Request
+{
+    private:
+
+        GridPreloader& m_preloader;
+        uint32 m_mapId;
+        int m_gx;
+        int m_gy;
+
+        // reads a file to get it into the page cache, the blocking load on the map thread then only copies memory
+        static void WarmFile(std::string const& fileName)
+        {
+            FILE* file = fopen(fileName.c_str(), "rb");
+            if (!file)
+                return;
+
+            char buffer[0x10000];
+            while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+                ;
+
+            fclose(file);
+        }
+
+    public:
+
+        GridPreloadRequest(GridPreloader& preloader, uint32 mapId, int gx, int gy)
+            : m_preloader(preloader), m_mapId(mapId), m_gx(gx), m_gy(gy)
+        {
+        }
+
+        virtual int call()
+        {
+            char fileName[64];
+            snprintf(fileName, sizeof(fileName), "maps/%03u%02u%02u.map", m_mapId, m_gx, m_gy);
+
+            GridMap* terrain = new GridMap();
+            if (!terrain->loadData(const_cast<char*>((sWorld->GetDataPath() + fileName).c_str())))
+            {
+                // let the map report it when it loads the grid itself
+                delete terrain;
+                terrain = NULL;
+            }
+
+            WarmFile(sWorld->GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(m_mapId, m_gx, m_gy));
+
+            snprintf(fileName, sizeof(fileName), "mmaps/%03u%02u%02u.mmtile", m_mapId, m_gx, m_gy);
+            WarmFile(sWorld->GetDataPath() + fileName);
+
+            m_preloader.preload_finished(m_mapId, m_gx, m_gy, terrain);
+            return 0;
+        }
+};
+
+GridPreloader::GridPreloader()
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    deactivate();
+}
+
+int GridPreloader::activate(size_t num_threads)
+{
+    return m_executor.start((int)num_threads);
+}
+
+int GridPreloader::deactivate()
+{
+    int result = m_executor.deactivate();
+    clear();
+    return result;
+}
+
+bool GridPreloader::activated()
+{
+    return m_executor.activated();
+}
+
+void GridPreloader::Preload(uint32 mapId, int gx, int gy)
+{
+    if (!activated())
+        return;
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+        if (!m_grids.insert(PreloadedGridContainer::value_type(MakeKey(mapId, gx, gy), PreloadedGrid())).second)
+            return;
+    }
+
+    if (m_executor.execute(new GridPreloadRequest(*this, mapId, gx, gy)) == -1)
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        m_grids.erase(MakeKey(mapId, gx, gy));
+    }
+}
+
+GridMap* GridPreloader::TakeGridMap(uint32 mapId, int gx, int gy)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, NULL);
+
+    PreloadedGridContainer::iterator itr = m_grids.find(MakeKey(mapId, gx, gy));
+    if (itr == m_grids.end())
+        return NULL;
+
+    // a grid still in flight is dropped when it arrives, the map loads it itself
+    GridMap* terrain = itr->second.Terrain;
+    m_grids.erase(itr);
+    return terrain;
+}
+
+void GridPreloader::Update(uint32 diff)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    for (PreloadedGridContainer::iterator itr = m_grids.begin(); itr != m_grids.end();)
+    {
+        if (itr->second.Ready && (itr->second.Age += diff) >= GRID_PRELOAD_EXPIRY)
+        {
+            delete itr->second.Terrain;
+            m_grids.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+void GridPreloader::preload_finished(uint32 mapId, int gx, int gy, GridMap* terrain)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    PreloadedGridContainer::iterator itr = m_grids.find(MakeKey(mapId, gx, gy));
+    if (itr == m_grids.end() || itr->second.Ready)
+    {
+        delete terrain;
+        return;
+    }
+
+    itr->second.Terrain = terrain;
+    itr->second.Ready = true;
+}
+
+void GridPreloader::clear()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    for (PreloadedGridContainer::iterator itr = m_grids.begin(); itr != m_grids.end(); ++itr)
+        delete itr->second.Terrain;
+
+    m_grids.clear();
+}
@@ -0,0 +1,73 @@
+#ifndef _GRID_PRELOADER_H_INCLUDED
+#define _GRID_PRELOADER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+
+#include "DelayExecutor.h"
+#include "UnorderedMap.h"
+
+class GridMap;
+
+// Preloaded grids nobody claimed are dropped after this time
+#define GRID_PRELOAD_EXPIRY     30000
+// How often maps predict the grids of their players
+#define GRID_PRELOAD_INTERVAL   1000
+// Seconds of movement ahead of a player that are preloaded
+#define GRID_PRELOAD_LOOKAHEAD  5
+
+/**
+ * Loads grid terrain off the map update threads.
+ *
+ * Maps queue the grids their players are heading to, a worker thread reads the
+ * GridMap and pulls the vmap and mmap tiles of the grid into the page cache.
+ * The map takes the GridMap over when it creates the grid, on a miss it still
+ * loads it blocking.
+ */
+class GridPreloader
+{
+    public:
+
+        GridPreloader();
+        virtual ~GridPreloader();
+
+        friend class GridPreloadRequest;
+
+        int activate(size_t num_threads);
+
+        int deactivate();
+
+        bool activated();
+
+        // no-op if the grid is already queued or preloaded
+        void Preload(uint32 mapId, int gx, int gy);
+
+        // preloaded terrain of the grid, NULL on a miss, the caller takes ownership
+        GridMap* TakeGridMap(uint32 mapId, int gx, int gy);
+
+        void Update(uint32 diff);
+
+    private:
+
+        struct PreloadedGrid
+        {
+            PreloadedGrid() : Terrain(NULL), Age(0), Ready(false) { }
+
+            GridMap* Terrain;
+            uint32 Age;
+            bool Ready;
+        };
+
+        typedef UNORDERED_MAP<uint32, PreloadedGrid> PreloadedGridContainer;
+
+        static uint32 MakeKey(uint32 mapId, int gx, int gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+        void preload_finished(uint32 mapId, int gx, int gy, GridMap* terrain);
+
+        void clear();
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        PreloadedGridContainer m_grids;
+};
+
+#endif //_GRID_PRELOADER_H_INCLUDED
@@ -18,6 +18,7 @@
 
 #include "Map.h"
 #include "Battleground.h"
+#include "BattlefieldMgr.h"
 #include "MMapFactory.h"
 #include "CellImpl.h"
 #include "DynamicTree.h"
@@ -31,12 +32,16 @@
 #include "MapManager.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "ScriptMgr.h"
+#include "TickProfiler.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
 
+#include <ace/TSS_T.h>
+
 union u_map_magic
 {
     char asChar[4];
@@ -55,6 +60,86 @@ u_map_magic MapLiquidMagic  = { {'M','L','I','Q'} };
 
 GridState* si_GridStates[MAX_GRID_STATE];
 
+// Line of sight and height results are reused within a tick, see Map::InvalidateCollisionCache()
+#define COLLISION_CACHE_SIZE        1024
+#define COLLISION_CACHE_PRECISION   8.0f                    // positions are compared in steps of 1/8 yard
+
+static std::atomic<uint64> lastCollisionCacheStamp(0);
+
+struct LineOfSightCacheEntry
+{
+    uint64 Stamp;                                           // 0 while the slot is unused
+    int32 Key[6];
+    uint32 PhaseMask;
+    bool Result;
+};
+
+struct HeightCacheEntry
+{
+    uint64 Stamp;
+    int32 Key[3];
+    uint32 PhaseMask;
+    float MaxSearchDist;
+    bool CheckVMap;
+    float Height;
+};
+
+// region updates query a map from several threads, every thread keeps its own results
+struct CollisionCache
+{
+    CollisionCache() { memset(this, 0, sizeof(*this)); }
+
+    LineOfSightCacheEntry LineOfSight[COLLISION_CACHE_SIZE];
+    HeightCacheEntry Height[COLLISION_CACHE_SIZE];
+};
+
+typedef ACE_TSS<CollisionCache> CollisionCacheTSS;
+static CollisionCacheTSS collisionCache;
+
+struct UpdatingMapSlot
+{
+    UpdatingMapSlot() : Current(NULL) { }
+
+    Map* Current;
+};
+
+typedef ACE_TSS<UpdatingMapSlot> UpdatingMapTSS;
+static UpdatingMapTSS updatingMap;
+
+// marks the calling thread as updating the map, nested updates restore the previous one
+class UpdatingMapScope
+{
+    public:
+        explicit UpdatingMapScope(Map* map) : _previous(updatingMap->Current) { updatingMap->Current = map; }
+        ~UpdatingMapScope() { updatingMap->Current = _previous; }
+
+    private:
+        Map* _previous;
+};
+
+static inline int32 GetCollisionCacheCoord(float value)
+{
+    return int32(floorf(value * COLLISION_CACHE_PRECISION));
+}
+
+static uint32 GetCollisionCacheSlot(int32 const* key, uint32 keySize, uint32 phasemask)
+{
+    uint32 hash = 2166136261u ^ phasemask;
+    for (uint32 i = 0; i < keySize; ++i)
+        hash = (hash ^ uint32(key[i])) * 16777619u;
+    return hash % COLLISION_CACHE_SIZE;
+}
+
+// both directions of a segment are tested the same way and share their entry
+static void GetLineOfSightCacheKey(float x1, float y1, float z1, float x2, float y2, float z2, int32* key)
+{
+    int32 start[3] = { GetCollisionCacheCoord(x1), GetCollisionCacheCoord(y1), GetCollisionCacheCoord(z1) };
+    int32 end[3] = { GetCollisionCacheCoord(x2), GetCollisionCacheCoord(y2), GetCollisionCacheCoord(z2) };
+    bool swap = std::lexicographical_compare(end, end + 3, start, start + 3);
+    memcpy(key, swap ? end : start, sizeof(start));
+    memcpy(key + 3, swap ? start : end, sizeof(end));
+}
+
 Map::~Map()
 {
     sScriptMgr->OnDestroyMap(this);
@@ -184,11 +269,20 @@ void Map::LoadMap(int gx, int gy, bool reload)
     int len = sWorld->GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
     tmp = new char[len];
     snprintf(tmp, len, (char *)(sWorld->GetDataPath() + "maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
-    TC_LOG_INFO("maps", "Loading map %s", tmp);
-    // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
-        TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
+    // terrain read ahead by the grid preloader, loaded here on a miss
+    if (!reload)
+        GridMaps[gx][gy] = sMapMgr->GetGridPreloader()->TakeGridMap(GetId(), gx, gy);
+
+    if (GridMaps[gx][gy])
+        TC_LOG_INFO("maps", "Using preloaded map %s", tmp);
+    else
+    {
+        TC_LOG_INFO("maps", "Loading map %s", tmp);
+        // loading data
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(tmp))
+            TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
+    }
     delete[] tmp;
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
@@ -203,6 +297,48 @@ void Map::LoadMapAndVMap(int gx, int gy)
         LoadVMap(gx, gy);
         LoadMMap(gx, gy);
     }
+
+    InvalidateCollisionCache();
+}
+
+void Map::PreloadGrids(uint32 diff)
+{
+    // instances share the terrain of their base map
+    if (Instanceable() || !sMapMgr->GetGridPreloader()->activated())
+        return;
+
+    if (_gridPreloadTimer > diff)
+    {
+        _gridPreloadTimer -= diff;
+        return;
+    }
+    _gridPreloadTimer = GRID_PRELOAD_INTERVAL;
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->getSource();
+        if (!player->IsInWorld() || (!player->isMoving() && !player->isInFlight()))
+            continue;
+
+        float speed = player->GetSpeed(player->IsFlying() || player->isInFlight() ? MOVE_FLIGHT : MOVE_RUN);
+        float dx = std::cos(player->GetOrientation()) * speed;
+        float dy = std::sin(player->GetOrientation()) * speed;
+
+        // one sample per second is far below the grid size even on the fastest mounts
+        for (uint32 i = 1; i <= GRID_PRELOAD_LOOKAHEAD; ++i)
+        {
+            float x = player->GetPositionX() + dx * i;
+            float y = player->GetPositionY() + dy * i;
+            if (!Trinity::IsValidMapCoord(x, y))
+                break;
+
+            GridCoord p = Trinity::ComputeGridCoord(x, y);
+            int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+            int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+            if (!GridMaps[gx][gy])
+                sMapMgr->GetGridPreloader()->Preload(GetId(), gx, gy);
+        }
+    }
 }
 
 void Map::InitStateMachine()
@@ -227,7 +363,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
     m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
-    i_scriptLock(false)
+    i_scriptLock(false), _regionUpdateInProgress(false), _collisionCacheStamp(++lastCollisionCacheStamp), _gridPreloadTimer(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -430,7 +566,7 @@ void Map::DeleteFromWorld(Player* player)
         ModifyLayerCount(player->GetLayerMask(), false);
 
     sObjectAccessor->RemoveObject(player);
-    sObjectAccessor->RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
+    player->ClearUpdateMask(true); //TODO: I do not know why we need this, it should be removed in ~Object anyway
 
     delete player;
 }
@@ -488,6 +624,7 @@ void Map::EnsureGridLoadedForActiveObject(const Cell &cell, WorldObject* object)
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell &cell)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -517,6 +654,7 @@ void Map::LoadGrid(float x, float y)
 
 bool Map::AddPlayerToMap(Player* player)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     CellCoord cellCoord = Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
     if (!cellCoord.IsCoordValid())
     {
@@ -568,6 +706,7 @@ void Map::InitializeObject(DynamicObject* obj)
 template<class T>
 bool Map::AddToMap(T *obj)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -649,21 +788,18 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 
 void Map::Update(const uint32 t_diff)
 {
-    _dynamicTree.update(t_diff);
-    /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    ProfileScope profileScope(sTickProfiler->GetMapSectionId(GetId()));
+    UpdatingMapScope updatingScope(this);
+
     {
-        Player* player = m_mapRefIter->getSource();
-        if (player && player->IsInWorld())
-        {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(t_diff, updater);
-        }
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
+        _dynamicTree.update(t_diff);
     }
-    /// update active cells around players and active objects
-    resetMarkedCells();
+
+    // units moved since the last tick
+    InvalidateCollisionCache();
+
+    PreloadGrids(t_diff);
 
     Trinity::ObjectUpdater updater(t_diff);
     // for creature
@@ -671,19 +807,61 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    if (BuildUpdateRegions())
     {
-        Player* player = m_mapRefIter->getSource();
+        /// update sessions and players of independent regions in parallel
+        _regionUpdateInProgress = true;
+        sMapMgr->GetMapRegionUpdater()->update_regions(*this, _updateRegions, t_diff);
+        _regionUpdateInProgress = false;
 
-        if (!player || !player->IsInWorld())
-            continue;
+        /// merge phase: move players that left their region
+        _playerUpdateRegions.clear();
+        RelocateDeferredPlayers();
 
-        // update players at tick
-        player->Update(t_diff);
+        /// update active cells around players, creature movement, AI and spell searches may reach into other regions
+        resetMarkedCells();
+
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
+
+            if (!player || !player->IsInWorld())
+                continue;
+
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        }
+    }
+    else
+    {
+        /// update worldsessions for existing players
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
+            if (player && player->IsInWorld())
+            {
+                //player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(t_diff, updater);
+            }
+        }
+        /// update active cells around players and active objects
+        resetMarkedCells();
+
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+            if (!player || !player->IsInWorld())
+                continue;
+
+            // update players at tick
+            player->Update(t_diff);
+
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        }
     }
 
     // non-player active objects, increasing iterator in the loop in case of object removal
@@ -716,6 +894,260 @@ void Map::Update(const uint32 t_diff)
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
+void Map::UpdateRegion(MapUpdateRegion& region, const uint32 t_diff)
+{
+    UpdatingMapScope updatingScope(this);
+
+    // players are only removed from the region list at the next BuildUpdateRegions(), skip those that left meanwhile
+    for (std::vector<Player*>::const_iterator itr = region.players.begin(); itr != region.players.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (!player->IsInWorld() || player->FindMap() != this)
+            continue;
+
+        WorldSession* session = player->GetSession();
+        MapSessionFilter updater(session);
+        session->Update(t_diff, updater);
+    }
+
+    for (std::vector<Player*>::const_iterator itr = region.players.begin(); itr != region.players.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (!player->IsInWorld() || player->FindMap() != this)
+            continue;
+
+        player->Update(t_diff);
+    }
+}
+
+bool Map::BuildUpdateRegions()
+{
+    // only continents are big enough to be worth splitting, instances and battlegrounds keep one job per map
+    if (Instanceable() || !sMapMgr->GetMapRegionUpdater()->activated() || m_mapRefManager.getSize() < 2)
+        return false;
+
+    // cells around a player its update may reach, and the visibility buffer kept between two regions
+    int32 const activationCells = int32(GetVisibilityRange() / SIZE_OF_GRID_CELL) + 1;
+    int32 const bufferCells = int32(GetVisibilityRange() / SIZE_OF_GRID_CELL) + 1;
+    int32 const linkDistance = 2 * activationCells + bufferCells;
+
+    std::vector<Player*> players;
+    std::vector<CellCoord> cells;
+    std::vector<uint32> parents;
+    players.reserve(m_mapRefManager.getSize());
+    cells.reserve(m_mapRefManager.getSize());
+
+    for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+    {
+        Player* player = itr->getSource();
+        if (!player || !player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        players.push_back(player);
+        cells.push_back(Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY()));
+    }
+
+    if (players.size() < 2)
+        return false;
+
+    // union-find over players, every player starts as its own region
+    parents.resize(players.size());
+    for (uint32 i = 0; i < parents.size(); ++i)
+        parents[i] = i;
+
+    struct RegionRoot
+    {
+        static uint32 Find(std::vector<uint32>& parents, uint32 i)
+        {
+            while (parents[i] != i)
+            {
+                parents[i] = parents[parents[i]];
+                i = parents[i];
+            }
+            return i;
+        }
+
+        static void Link(std::vector<uint32>& parents, uint32 a, uint32 b)
+        {
+            a = Find(parents, a);
+            b = Find(parents, b);
+            if (a != b)
+                parents[std::max(a, b)] = std::min(a, b);
+        }
+    };
+
+    // bucket players into blocks of linkDistance cells, only the 3x3 neighbouring blocks can be in reach
+    UNORDERED_MAP<uint32, std::vector<uint32> > blocks;
+    for (uint32 i = 0; i < players.size(); ++i)
+        blocks[(cells[i].x_coord / linkDistance) * TOTAL_NUMBER_OF_CELLS_PER_MAP + cells[i].y_coord / linkDistance].push_back(i);
+
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        int32 bx = int32(cells[i].x_coord / linkDistance);
+        int32 by = int32(cells[i].y_coord / linkDistance);
+        for (int32 x = bx - 1; x <= bx + 1; ++x)
+        {
+            for (int32 y = by - 1; y <= by + 1; ++y)
+            {
+                if (x < 0 || y < 0)
+                    continue;
+
+                UNORDERED_MAP<uint32, std::vector<uint32> >::const_iterator block = blocks.find(uint32(x) * TOTAL_NUMBER_OF_CELLS_PER_MAP + uint32(y));
+                if (block == blocks.end())
+                    continue;
+
+                for (std::vector<uint32>::const_iterator other = block->second.begin(); other != block->second.end(); ++other)
+                {
+                    if (*other <= i)
+                        continue;
+
+                    int32 dx = std::abs(int32(cells[i].x_coord) - int32(cells[*other].x_coord));
+                    int32 dy = std::abs(int32(cells[i].y_coord) - int32(cells[*other].y_coord));
+                    if (std::max(dx, dy) <= linkDistance)
+                        RegionRoot::Link(parents, i, *other);
+                }
+            }
+        }
+    }
+
+    // a viewpoint far from its player (farsight, mind control) is visited as well, keep both in one region
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        WorldObject* viewpoint = players[i]->GetViewpoint();
+        if (!viewpoint || viewpoint == players[i])
+            continue;
+
+        CellCoord viewCell = Trinity::ComputeCellCoord(viewpoint->GetPositionX(), viewpoint->GetPositionY());
+        for (uint32 j = 0; j < players.size(); ++j)
+        {
+            int32 dx = std::abs(int32(viewCell.x_coord) - int32(cells[j].x_coord));
+            int32 dy = std::abs(int32(viewCell.y_coord) - int32(cells[j].y_coord));
+            if (std::max(dx, dy) <= linkDistance)
+                RegionRoot::Link(parents, i, j);
+        }
+    }
+
+    // outdoor pvp and battlefield zone scripts keep zone wide state, a zone with one must stay in one region
+    UNORDERED_MAP<uint32, uint32> scriptedZones;
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        uint32 zoneId = players[i]->GetCachedZoneId();
+        if (!sBattlefieldMgr->GetBattlefieldToZoneId(zoneId) && !sOutdoorPvPMgr->GetOutdoorPvPToZoneId(zoneId))
+            continue;
+
+        UNORDERED_MAP<uint32, uint32>::const_iterator zone = scriptedZones.find(zoneId);
+        if (zone == scriptedZones.end())
+            scriptedZones[zoneId] = i;
+        else
+            RegionRoot::Link(parents, i, zone->second);
+    }
+
+    UNORDERED_MAP<uint32, uint32> regionIndexes;
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        uint32 root = RegionRoot::Find(parents, i);
+        if (regionIndexes.find(root) == regionIndexes.end())
+        {
+            uint32 index = regionIndexes.size();
+            regionIndexes[root] = index;
+        }
+    }
+
+    if (regionIndexes.size() < 2)
+        return false;
+
+    // regions are kept between ticks so their player vectors are not reallocated every update
+    _updateRegions.resize(regionIndexes.size());
+    for (MapUpdateRegionList::iterator itr = _updateRegions.begin(); itr != _updateRegions.end(); ++itr)
+    {
+        itr->players.clear();
+        itr->bounds = CellArea(CellCoord(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1), CellCoord(0, 0));
+    }
+
+    for (uint32 i = 0; i < players.size(); ++i)
+    {
+        MapUpdateRegion& region = _updateRegions[regionIndexes[RegionRoot::Find(parents, i)]];
+        region.players.push_back(players[i]);
+        region.bounds.low_bound.x_coord = std::min(region.bounds.low_bound.x_coord, cells[i].x_coord);
+        region.bounds.low_bound.y_coord = std::min(region.bounds.low_bound.y_coord, cells[i].y_coord);
+        region.bounds.high_bound.x_coord = std::max(region.bounds.high_bound.x_coord, cells[i].x_coord);
+        region.bounds.high_bound.y_coord = std::max(region.bounds.high_bound.y_coord, cells[i].y_coord);
+    }
+
+    // half of the buffer belongs to each side, moving inside it can never reach cells visited by another region
+    uint32 const margin = uint32(bufferCells / 2);
+    for (MapUpdateRegionList::iterator itr = _updateRegions.begin(); itr != _updateRegions.end(); ++itr)
+    {
+        CellArea& bounds = itr->bounds;
+        bounds.low_bound.x_coord = bounds.low_bound.x_coord > margin ? bounds.low_bound.x_coord - margin : 0;
+        bounds.low_bound.y_coord = bounds.low_bound.y_coord > margin ? bounds.low_bound.y_coord - margin : 0;
+        bounds.high_bound.x_coord = std::min<uint32>(bounds.high_bound.x_coord + margin, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+        bounds.high_bound.y_coord = std::min<uint32>(bounds.high_bound.y_coord + margin, TOTAL_NUMBER_OF_CELLS_PER_MAP - 1);
+
+        for (std::vector<Player*>::const_iterator player = itr->players.begin(); player != itr->players.end(); ++player)
+            _playerUpdateRegions[*player] = &(*itr);
+    }
+
+    return true;
+}
+
+bool Map::IsInUpdateRegion(Player const* player, CellCoord const& cell) const
+{
+    UNORDERED_MAP<Player const*, MapUpdateRegion const*>::const_iterator itr = _playerUpdateRegions.find(player);
+    if (itr == _playerUpdateRegions.end())
+        return false;
+
+    CellArea const& bounds = itr->second->bounds;
+    return cell.x_coord >= bounds.low_bound.x_coord && cell.x_coord <= bounds.high_bound.x_coord
+        && cell.y_coord >= bounds.low_bound.y_coord && cell.y_coord <= bounds.high_bound.y_coord;
+}
+
+void Map::RelocateDeferredPlayers()
+{
+    std::vector<DeferredPlayerRelocation> relocations;
+    relocations.swap(_deferredPlayerRelocations);
+
+    for (std::vector<DeferredPlayerRelocation>::const_iterator itr = relocations.begin(); itr != relocations.end(); ++itr)
+        if (itr->player->IsInWorld() && itr->player->FindMap() == this)
+            PlayerRelocation(itr->player, itr->x, itr->y, itr->z, itr->orientation);
+}
+
+Map* Map::GetUpdatingMap()
+{
+    return updatingMap->Current;
+}
+
+void Map::SendObjectUpdates()
+{
+    UpdatingMapScope updatingScope(this);
+    UpdateDataMapType update_players;
+
+    for (;;)
+    {
+        Object* obj;
+        {
+            // objects changed outside of map updates are queued here as well
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            if (_updateObjects.empty())
+                break;
+
+            obj = *_updateObjects.begin();
+            _updateObjects.erase(_updateObjects.begin());
+        }
+
+        ASSERT(obj && obj->IsInWorld());
+        obj->BuildUpdate(update_players);
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
+}
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T> &m)
@@ -807,6 +1239,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
 
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (!player)
         return;
 
@@ -832,6 +1265,7 @@ void Map::RemovePlayerFromMap(Player* player, bool remove)
 template<class T>
 void Map::RemoveFromMap(T *obj, bool remove)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     obj->RemoveFromWorld();
     if (obj->isActiveObject())
         RemoveFromActive(obj);
@@ -850,6 +1284,7 @@ void Map::RemoveFromMap(T *obj, bool remove)
 template<>
 void Map::RemoveFromMap(Transport* obj, bool remove)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     obj->ToGameObject()->RemoveFromWorld();
     obj->UpdateObjectVisibility(true);
 
@@ -881,6 +1316,15 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 {
     ASSERT(player);
 
+    // cells outside the player's own region may be in use by another region job, move there in the merge phase
+    if (_regionUpdateInProgress && !IsInUpdateRegion(player, Trinity::ComputeCellCoord(x, y)))
+    {
+        TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
+        DeferredPlayerRelocation relocation = { player, x, y, z, orientation };
+        _deferredPlayerRelocations.push_back(relocation);
+        return;
+    }
+
     Cell old_cell(player->GetPositionX(), player->GetPositionY());
     Cell new_cell(x, y);
 
@@ -1013,6 +1457,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1023,6 +1468,7 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1032,6 +1478,7 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1042,6 +1489,7 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1051,6 +1499,7 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, float z, float ang)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1061,6 +1510,7 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1520,6 +1970,8 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         GridMaps[gx][gy] = NULL;
     }
+
+    InvalidateCollisionCache();
     TC_LOG_DEBUG("maps", "Unloading grid[%u, %u] for map %u finished", x, y, GetId());
     return true;
 }
@@ -2126,18 +2578,21 @@ inline GridMap* Map::GetGrid(float x, float y)
 
 void Map::AddWorldObject(WorldObject* obj) 
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     i_worldObjects.insert(obj);
 
     obj->SetLayerMask(obj->GetProperLayerMask(), true, this);
 }
 void Map::RemoveWorldObject(WorldObject* obj) 
 { 
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     i_worldObjects.erase(obj);
     obj->SetLayerMask(obj->GetProperLayerMask(), true, this);
 }
 
 uint32 Map::GetLayerCount(uint8 layer)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     return layerCountContainer[layer];
 }
 
@@ -2471,9 +2926,100 @@ void Map::GetZoneAndAreaIdByAreaFlag(uint32& zoneid, uint32& areaid, uint16 area
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
 {
     if (GetId() == 720 && GetAreaId(x1, y1, z1) == 5766)
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
         return _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
-        && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+    }
+
+    uint64 stamp = _collisionCacheStamp.load(std::memory_order_acquire);
+    int32 key[6];
+    GetLineOfSightCacheKey(x1, y1, z1, x2, y2, z2, key);
+
+    LineOfSightCacheEntry& entry = collisionCache->LineOfSight[GetCollisionCacheSlot(key, 6, phasemask)];
+    if (entry.Stamp == stamp && entry.PhaseMask == phasemask && !memcmp(entry.Key, key, sizeof(key)))
+        return entry.Result;
+
+    bool result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2);
+    if (result)
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
+        result = _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+    }
+
+    entry.Stamp = stamp;
+    memcpy(entry.Key, key, sizeof(key));
+    entry.PhaseMask = phasemask;
+    entry.Result = result;
+    return result;
+}
+
+void Map::isInLineOfSightMany(float x, float y, float z, std::vector<G3D::Vector3> const& targets, uint32 phasemask, std::vector<bool>& results) const
+{
+    results.assign(targets.size(), true);
+    if (targets.empty())
+        return;
+
+    // the special case depends on the ray direction, it isn't cached
+    if (GetId() == 720 && GetAreaId(x, y, z) == 5766)
+    {
+        for (size_t i = 0; i < targets.size(); ++i)
+            results[i] = isInLineOfSight(x, y, z, targets[i].x, targets[i].y, targets[i].z, phasemask);
+        return;
+    }
+
+    uint64 stamp = _collisionCacheStamp.load(std::memory_order_acquire);
+
+    // only the segments without cached result are cast, all of them within one traversal of the dynamic tree
+    std::vector<G3D::Vector3> uncachedTargets;
+    std::vector<uint32> uncachedSlots;
+    std::vector<size_t> uncachedIndexes;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        int32 key[6];
+        GetLineOfSightCacheKey(x, y, z, targets[i].x, targets[i].y, targets[i].z, key);
+
+        uint32 slot = GetCollisionCacheSlot(key, 6, phasemask);
+        LineOfSightCacheEntry const& entry = collisionCache->LineOfSight[slot];
+        if (entry.Stamp == stamp && entry.PhaseMask == phasemask && !memcmp(entry.Key, key, sizeof(key)))
+        {
+            results[i] = entry.Result;
+            continue;
+        }
+
+        uncachedTargets.push_back(targets[i]);
+        uncachedSlots.push_back(slot);
+        uncachedIndexes.push_back(i);
+    }
+
+    if (uncachedTargets.empty())
+        return;
+
+    bool* visible = new bool[uncachedTargets.size()];
+    std::fill(visible, visible + uncachedTargets.size(), true);
+
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSightMany(GetId(), x, y, z, &uncachedTargets[0], uncachedTargets.size(), visible);
+
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
+        _dynamicTree.isInLineOfSightMany(G3D::Vector3(x, y, z), &uncachedTargets[0], uncachedTargets.size(), phasemask, visible);
+    }
+
+    for (size_t i = 0; i < uncachedTargets.size(); ++i)
+    {
+        LineOfSightCacheEntry& entry = collisionCache->LineOfSight[uncachedSlots[i]];
+        entry.Stamp = stamp;
+        GetLineOfSightCacheKey(x, y, z, uncachedTargets[i].x, uncachedTargets[i].y, uncachedTargets[i].z, entry.Key);
+        entry.PhaseMask = phasemask;
+        entry.Result = visible[i];
+        results[uncachedIndexes[i]] = visible[i];
+    }
+
+    delete[] visible;
+}
+
+void Map::InvalidateCollisionCache()
+{
+    _collisionCacheStamp.store(++lastCollisionCacheStamp, std::memory_order_release);
 }
 
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -2482,7 +3028,11 @@ bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
-    bool result = _dynamicTree.getObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
+    bool result;
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
+        result = _dynamicTree.getObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
+    }
 
     rx = resultPos.x;
     ry = resultPos.y;
@@ -2492,7 +3042,28 @@ bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
 
 float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
-    return std::max<float>(GetHeight(x, y, z + 0.5f, vmap, maxSearchDist), _dynamicTree.getHeight(x, y, z + 0.5f, maxSearchDist, phasemask));
+    uint64 stamp = _collisionCacheStamp.load(std::memory_order_acquire);
+    int32 key[3] = { GetCollisionCacheCoord(x), GetCollisionCacheCoord(y), GetCollisionCacheCoord(z) };
+
+    HeightCacheEntry& entry = collisionCache->Height[GetCollisionCacheSlot(key, 3, phasemask)];
+    if (entry.Stamp == stamp && entry.PhaseMask == phasemask && !memcmp(entry.Key, key, sizeof(key)) &&
+        entry.MaxSearchDist == maxSearchDist && entry.CheckVMap == vmap)
+        return entry.Height;
+
+    float staticHeight = GetHeight(x, y, z + 0.5f, vmap, maxSearchDist);
+    float height;
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock);
+        height = std::max<float>(staticHeight, _dynamicTree.getHeight(x, y, z + 0.5f, maxSearchDist, phasemask));
+    }
+
+    entry.Stamp = stamp;
+    memcpy(entry.Key, key, sizeof(key));
+    entry.PhaseMask = phasemask;
+    entry.MaxSearchDist = maxSearchDist;
+    entry.CheckVMap = vmap;
+    entry.Height = height;
+    return height;
 }
 
 float Map::GetStaticHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
@@ -2722,6 +3293,7 @@ void Map::DelayedUpdate(const uint32 t_diff)
 
 void Map::AddObjectToRemoveList(WorldObject* obj)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
@@ -2732,6 +3304,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
 void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
     // i_objectsToSwitch is iterated only in Map::RemoveAllObjectsInRemoveList() and it uses
     // the contained objects only if GetTypeId() == TYPEID_UNIT , so we can return in all other cases
@@ -2836,6 +3409,7 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::ModifyLayerCount(uint32 layer, bool add)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     //if (layer >= 32) TC_LOG_ERROR("sql.sql", "layer: %u", layer);
 
     ASSERT(layer < 32);
@@ -2924,6 +3498,7 @@ void Map::AddToActive(GameObject* obj)
 template <>
 void Map::AddToActive(Creature* c)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     AddToActiveHelper(c);
 
     // also not allow unloading spawn grid to prevent creating creature clone at load
@@ -2955,6 +3530,7 @@ void Map::RemoveFromActive(T* /*obj*/) { }
 template<>
 void Map::RemoveFromActive(Creature* c)
 {
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     RemoveFromActiveHelper(c);
 
     // also allow unloading spawn grid
@@ -3509,7 +4085,10 @@ void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime)
         return;
     }
 
-    _creatureRespawnTimes[dbGuid] = respawnTime;
+    {
+        TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
+        _creatureRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3521,7 +4100,10 @@ void Map::SaveCreatureRespawnTime(uint32 dbGuid, time_t respawnTime)
 
 void Map::RemoveCreatureRespawnTime(uint32 dbGuid)
 {
-    _creatureRespawnTimes.erase(dbGuid);
+    {
+        TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
+        _creatureRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3539,7 +4121,10 @@ void Map::SaveGORespawnTime(uint32 dbGuid, time_t respawnTime)
         return;
     }
 
-    _goRespawnTimes[dbGuid] = respawnTime;
+    {
+        TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
+        _goRespawnTimes[dbGuid] = respawnTime;
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->setUInt32(0, dbGuid);
@@ -3551,7 +4136,10 @@ void Map::SaveGORespawnTime(uint32 dbGuid, time_t respawnTime)
 
 void Map::RemoveGORespawnTime(uint32 dbGuid)
 {
-    _goRespawnTimes.erase(dbGuid);
+    {
+        TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
+        _goRespawnTimes.erase(dbGuid);
+    }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->setUInt32(0, dbGuid);
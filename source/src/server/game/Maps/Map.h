@@ -22,6 +22,7 @@
 #include "Define.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/Recursive_Thread_Mutex.h>
 
 #include "DBCStructure.h"
 #include "GridDefines.h"
@@ -34,8 +35,10 @@
 #include "GameObjectModel.h"
 #include "World.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
+#include <vector>
 
 class Unit;
 class WorldPacket;
@@ -236,6 +239,17 @@ enum LevelRequirementVsMode
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
 
+typedef std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> MarkedCellsType;
+
+// Part of a continent that is far enough from every other part to be updated on its own thread
+struct MapUpdateRegion
+{
+    std::vector<Player*> players;
+    CellArea bounds;                                        // cells players may move into without leaving the region
+};
+
+typedef std::vector<MapUpdateRegion> MapUpdateRegionList;
+
 class Map : public GridRefManager<NGridType>
 {
     friend class MapReference;
@@ -265,6 +279,7 @@ class Map : public GridRefManager<NGridType>
 
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
+        void UpdateRegion(MapUpdateRegion& region, const uint32 t_diff);
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
         float GetVisibilityRange(uint32 cellId) const;
@@ -400,6 +415,8 @@ class Map : public GridRefManager<NGridType>
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        bool IsRegionUpdateInProgress() const { return _regionUpdateInProgress; }
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         uint32 GetAlivePlayerCountExceptGMs() const;
@@ -408,6 +425,24 @@ class Map : public GridRefManager<NGridType>
         void AddWorldObject(WorldObject* obj);
         void RemoveWorldObject(WorldObject* obj);
 
+        // objects with pending update fields, flushed by SendObjectUpdates() right after Update() on the map's own thread
+        void AddUpdateObject(Object* obj)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            _updateObjects.insert(obj);
+        }
+
+        void RemoveUpdateObject(Object* obj)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            _updateObjects.erase(obj);
+        }
+
+        void SendObjectUpdates();
+
+        // map updated by the calling thread, NULL outside of Update(), UpdateRegion() and SendObjectUpdates()
+        static Map* GetUpdatingMap();
+
         void SendToPlayers(WorldPacket const* data) const;
 
         typedef MapRefManager PlayerList;
@@ -450,10 +485,14 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetStaticHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
-        void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-        bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+        // line of sight from one origin to every target, same results as isInLineOfSight() for each of them
+        void isInLineOfSightMany(float x, float y, float z, std::vector<G3D::Vector3> const& targets, uint32 phasemask, std::vector<bool>& results) const;
+        // drops the cached line of sight and height results, done every tick and when collision changes
+        void InvalidateCollisionCache();
+        void Balance() { TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock); _dynamicTree.balance(); }
+        void RemoveGameObjectModel(const GameObjectModel& model) { TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock); _dynamicTree.remove(model); InvalidateCollisionCache(); }
+        void InsertGameObjectModel(const GameObjectModel& model) { TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock); _dynamicTree.insert(model); InvalidateCollisionCache(); }
+        bool ContainsGameObjectModel(const GameObjectModel& model) const { TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, _dynamicTreeLock); return _dynamicTree.contains(model);}
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         virtual uint32 GetOwnerGuildId(uint32 /*team*/ = TEAM_OTHER) const { return 0; }
@@ -463,6 +502,7 @@ class Map : public GridRefManager<NGridType>
         time_t GetLinkedRespawnTime(uint64 guid) const;
         time_t GetCreatureRespawnTime(uint32 dbGuid) const
         {
+            TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
             UNORDERED_MAP<uint32 /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
             if (itr != _creatureRespawnTimes.end())
                 return itr->second;
@@ -472,6 +512,7 @@ class Map : public GridRefManager<NGridType>
 
         time_t GetGORespawnTime(uint32 dbGuid) const
         {
+            TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
             UNORDERED_MAP<uint32 /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
             if (itr != _goRespawnTimes.end())
                 return itr->second;
@@ -502,6 +543,8 @@ class Map : public GridRefManager<NGridType>
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
         void LoadMMap(int gx, int gy);
+        // queues the terrain of grids moving players will reach soon, see MapUpdate.PreloadThreads
+        void PreloadGrids(uint32 diff);
         GridMap* GetGrid(float x, float y);
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
@@ -562,6 +605,10 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateActiveCells(const float &x, const float &y, const uint32 t_diff);
 
+        bool BuildUpdateRegions();
+        bool IsInUpdateRegion(Player const* player, CellCoord const& cell) const;
+        void RelocateDeferredPlayers();
+
     protected:
         void SetUnloadReferenceLock(const GridCoord &p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
 
@@ -602,7 +649,7 @@ class Map : public GridRefManager<NGridType>
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        MarkedCellsType marked_cells;
 
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
@@ -613,6 +660,27 @@ class Map : public GridRefManager<NGridType>
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
 
+        std::set<Object*> _updateObjects;
+        ACE_Thread_Mutex _updateObjectsLock;
+
+        // continent region update, see MapUpdate.RegionThreads
+        struct DeferredPlayerRelocation
+        {
+            Player* player;
+            float x, y, z, orientation;
+        };
+
+        bool _regionUpdateInProgress;
+        MapUpdateRegionList _updateRegions;
+        UNORDERED_MAP<Player const*, MapUpdateRegion const*> _playerUpdateRegions;
+        std::vector<DeferredPlayerRelocation> _deferredPlayerRelocations;
+        // guards map-wide containers while regions are updated in parallel
+        mutable ACE_Recursive_Thread_Mutex _regionLock;
+        mutable ACE_RW_Thread_Mutex _dynamicTreeLock;
+        std::atomic<uint64> _collisionCacheStamp;       // identifies valid entries of the thread local collision caches
+
+        uint32 _gridPreloadTimer;
+
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
 
@@ -625,11 +693,13 @@ class Map : public GridRefManager<NGridType>
 
         void AddToActiveHelper(WorldObject* obj)
         {
+            TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
             m_activeNonPlayers.insert(obj);
         }
 
         void RemoveFromActiveHelper(WorldObject* obj)
         {
+            TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
             // Map::Update for active object in proccess
             if (m_activeNonPlayersIter != m_activeNonPlayers.end())
             {
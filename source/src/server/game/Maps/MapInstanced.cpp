@@ -70,7 +70,10 @@ void MapInstanced::Update(const uint32 t)
             if (sMapMgr->GetMapUpdater()->activated())
                 sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
             else
+            {
                 i->second->Update(t);
+                i->second->SendObjectUpdates();
+            }
             ++i;
         }
     }
@@ -64,6 +64,15 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0 && m_updater.activate(num_threads) == -1)
         abort();
+
+    // Separate pool for continent regions, map update threads wait on it and must not share their own pool
+    int region_threads(sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_THREADS));
+    if (region_threads > 0 && m_regionUpdater.activate(region_threads) == -1)
+        abort();
+
+    int preload_threads(sWorld->getIntConfig(CONFIG_MAP_UPDATE_PRELOAD_THREADS));
+    if (preload_threads > 0 && m_gridPreloader.activate(preload_threads) == -1)
+        abort();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -347,13 +356,18 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    m_gridPreloader.Update(uint32(i_timer.GetCurrent()));
+
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
         if (m_updater.activated())
             m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
         else
+        {
             iter->second->Update(uint32(i_timer.GetCurrent()));
+            iter->second->SendObjectUpdates();
+        }
     }
     if (m_updater.activated())
         m_updater.wait();
@@ -361,6 +375,8 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    // map objects were already flushed by their own map update, this sends items, objects outside any map and
+    // changes made to an object while another map was updated
     sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
     for (TransportSet::iterator itr = m_Transports.begin(); itr != m_Transports.end(); )
     {
@@ -418,6 +434,12 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (m_regionUpdater.activated())
+        m_regionUpdater.deactivate();
+
+    if (m_gridPreloader.activated())
+        m_gridPreloader.deactivate();
+
     Map::DeleteStateMachine();
 }
 
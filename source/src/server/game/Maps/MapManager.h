@@ -26,6 +26,7 @@
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
+#include "GridPreloader.h"
 
 class Transport;
 struct TransportCreatureProto;
@@ -143,6 +144,8 @@ class MapManager
         void SetNextInstanceId(uint32 nextInstanceId) { _nextInstanceId = nextInstanceId; };
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        MapUpdater * GetMapRegionUpdater() { return &m_regionUpdater; }
+        GridPreloader * GetGridPreloader() { return &m_gridPreloader; }
 
         Map* FindBaseMap(uint32 mapId) const
         {
@@ -174,6 +177,8 @@ class MapManager
         InstanceIds _instanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        MapUpdater m_regionUpdater;
+        GridPreloader m_gridPreloader;
 };
 #define sMapMgr ACE_Singleton<MapManager, ACE_Thread_Mutex>::instance()
 #endif
@@ -52,6 +52,31 @@ class MapUpdateRequest : public ACE_Method_Request
         virtual int call()
         {
             m_map.Update (m_diff);
+            m_map.SendObjectUpdates();
+            m_updater.update_finished();
+            return 0;
+        }
+};
+
+class MapRegionUpdateRequest : public ACE_Method_Request
+{
+    private:
+
+        Map& m_map;
+        MapUpdateRegion& m_region;
+        MapUpdater& m_updater;
+        ACE_UINT32 m_diff;
+
+    public:
+
+        MapRegionUpdateRequest(Map& m, MapUpdateRegion& r, MapUpdater& u, ACE_UINT32 d)
+            : m_map(m), m_region(r), m_updater(u), m_diff(d)
+        {
+        }
+
+        virtual int call()
+        {
+            m_map.UpdateRegion(m_region, m_diff);
             m_updater.update_finished();
             return 0;
         }
@@ -106,6 +131,39 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
     return 0;
 }
 
+int MapUpdater::update_regions(Map& map, std::vector<MapUpdateRegion>& regions, ACE_UINT32 diff)
+{
+    if (regions.empty())
+        return 0;
+
+    for (size_t i = 1; i < regions.size(); ++i)
+    {
+        bool scheduled = true;
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            ++pending_requests;
+
+            if (m_executor.execute(new MapRegionUpdateRequest(map, regions[i], *this, diff)) == -1)
+            {
+                ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Region Update")));
+
+                --pending_requests;
+                scheduled = false;
+            }
+        }
+
+        // the region still has to be updated this tick
+        if (!scheduled)
+            map.UpdateRegion(regions[i], diff);
+    }
+
+    map.UpdateRegion(regions[0], diff);
+
+    // regions of other continents share this pool, waiting for them as well only costs the idle time of this thread
+    return wait();
+}
+
 bool MapUpdater::activated()
 {
     return m_executor.activated();
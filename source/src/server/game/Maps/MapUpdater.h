@@ -6,7 +6,10 @@
 
 #include "DelayExecutor.h"
 
+#include <vector>
+
 class Map;
+struct MapUpdateRegion;
 
 class MapUpdater
 {
@@ -16,9 +19,13 @@ class MapUpdater
         virtual ~MapUpdater();
 
         friend class MapUpdateRequest;
+        friend class MapRegionUpdateRequest;
 
         int schedule_update(Map& map, ACE_UINT32 diff);
 
+        // updates all regions of one map, the calling thread takes the first region itself
+        int update_regions(Map& map, std::vector<MapUpdateRegion>& regions, ACE_UINT32 diff);
+
         int wait();
 
         int activate(size_t num_threads);
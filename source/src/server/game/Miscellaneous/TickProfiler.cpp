@@ -0,0 +1,353 @@
+#include "TickProfiler.h"
+#include "Config.h"
+#include "DBCStores.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "World.h"
+#include <ace/TSS_T.h>
+
+namespace
+{
+    uint32 GetBucketIndex(uint32 time)
+    {
+        if (time < 4)
+            return time;
+
+        uint32 power = 2;
+        while (power < 31 && (time >> (power + 1)))
+            ++power;
+
+        uint32 bucket = (power - 1) * 4 + ((time >> (power - 2)) & 3);
+        return bucket < PROFILER_HISTOGRAM_BUCKETS ? bucket : PROFILER_HISTOGRAM_BUCKETS - 1;
+    }
+
+    uint32 GetBucketLowerBound(uint32 bucket)
+    {
+        if (bucket < 4)
+            return bucket;
+
+        uint32 power = bucket / 4 + 1;
+        return (4 + bucket % 4) << (power - 2);
+    }
+
+    // Upper bound of the bucket holding the given percentile, never above the observed maximum
+    uint32 GetPercentile(uint32 const* buckets, uint32 count, uint32 maxTime, uint32 percent)
+    {
+        uint64 rank = (uint64(count) * percent + 99) / 100;
+        uint64 seen = 0;
+        for (uint32 i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+            {
+                if (i + 1 == PROFILER_HISTOGRAM_BUCKETS)
+                    return maxTime;
+
+                return std::min(GetBucketLowerBound(i + 1) - 1, maxTime);
+            }
+        }
+
+        return maxTime;
+    }
+
+    bool SortStatsByTotalTime(ProfileSectionStats const& left, ProfileSectionStats const& right)
+    {
+        return left.TotalTime > right.TotalTime;
+    }
+}
+
+// Binds a ThreadProfile to the current thread, handed back to the pool when the thread exits
+struct ThreadProfileSlot
+{
+    ThreadProfileSlot() : Profile(sTickProfiler->AcquireThreadProfile()) { }
+    ~ThreadProfileSlot() { Profile->InUse.store(false, std::memory_order_release); }
+
+    ThreadProfile* Profile;
+};
+
+typedef ACE_TSS<ThreadProfileSlot> ThreadProfileTSS;
+static ThreadProfileTSS threadProfileSlot;
+
+ProfileHistogram::ProfileHistogram()
+{
+    Clear();
+}
+
+void ProfileHistogram::Clear()
+{
+    for (uint32 i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i)
+        Buckets[i].store(0, std::memory_order_relaxed);
+
+    Count.store(0, std::memory_order_relaxed);
+    TotalTime.store(0, std::memory_order_relaxed);
+    MaxTime.store(0, std::memory_order_relaxed);
+}
+
+ThreadProfile::ThreadProfile()
+{
+    Epoch.store(0, std::memory_order_relaxed);
+    InUse.store(false, std::memory_order_relaxed);
+    for (uint32 i = 0; i < MAX_PROFILER_SECTIONS; ++i)
+        Histograms[i].store(NULL, std::memory_order_relaxed);
+}
+
+void ThreadProfile::Reset(uint32 epoch)
+{
+    for (uint32 i = 0; i < MAX_PROFILER_SECTIONS; ++i)
+        if (ProfileHistogram* histogram = Histograms[i].load(std::memory_order_relaxed))
+            histogram->Clear();
+
+    Epoch.store(epoch, std::memory_order_release);
+}
+
+TickProfiler::TickProfiler() : _dumpInterval(0), _dumpTimer(0), _windowTime(0)
+{
+    _enabled.store(false, std::memory_order_relaxed);
+    _spikeThreshold.store(0, std::memory_order_relaxed);
+    _epoch.store(1, std::memory_order_relaxed);
+
+    for (uint32 i = 0; i < MAX_PROFILER_KEYS; ++i)
+    {
+        _opcodeSections[i].store(0, std::memory_order_relaxed);
+        _mapSections[i].store(0, std::memory_order_relaxed);
+    }
+
+    _sectionNames[PROFILER_OVERFLOW_SECTION] = "(overflow)";
+    _sectionIds[_sectionNames[PROFILER_OVERFLOW_SECTION]] = PROFILER_OVERFLOW_SECTION;
+    _sectionCount.store(1, std::memory_order_relaxed);
+}
+
+TickProfiler::~TickProfiler()
+{
+    // thread profiles may still be referenced by exiting threads, they live as long as the process
+}
+
+void TickProfiler::LoadConfig()
+{
+    _enabled.store(sConfigMgr->GetBoolDefault("Profiler.Enable", true), std::memory_order_relaxed);
+    _spikeThreshold.store(uint32(sConfigMgr->GetIntDefault("Profiler.SpikeThreshold", 200)) * IN_MILLISECONDS, std::memory_order_relaxed);
+    _dumpInterval = uint32(sConfigMgr->GetIntDefault("Profiler.DumpInterval", 60)) * IN_MILLISECONDS;
+
+    std::string logsDir = sConfigMgr->GetStringDefault("LogsDir", "");
+    if (!logsDir.empty())
+        if ((logsDir.at(logsDir.length() - 1) != '/') && (logsDir.at(logsDir.length() - 1) != '\\'))
+            logsDir.push_back('/');
+
+    std::string dumpFile = sConfigMgr->GetStringDefault("Profiler.DumpFile", "");
+    _dumpFile = dumpFile.empty() ? dumpFile : logsDir + dumpFile;
+}
+
+void TickProfiler::Update(uint32 diff)
+{
+    _windowTime += diff;
+
+    if (!_dumpInterval || !IsEnabled())
+        return;
+
+    _dumpTimer += diff;
+    if (_dumpTimer < _dumpInterval)
+        return;
+
+    _dumpTimer = 0;
+    Dump();
+    Reset();
+}
+
+uint32 TickProfiler::GetSectionId(std::string const& name)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    UNORDERED_MAP<std::string, uint32>::const_iterator itr = _sectionIds.find(name);
+    if (itr != _sectionIds.end())
+        return itr->second;
+
+    uint32 id = _sectionCount.load(std::memory_order_relaxed);
+    if (id >= MAX_PROFILER_SECTIONS)
+    {
+        TC_LOG_ERROR("misc", "TickProfiler: section limit reached, samples of '%s' are counted as overflow", name.c_str());
+        _sectionIds[name] = PROFILER_OVERFLOW_SECTION;
+        return PROFILER_OVERFLOW_SECTION;
+    }
+
+    _sectionNames[id] = name;
+    _sectionIds[name] = id;
+    _sectionCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+uint32 TickProfiler::GetOpcodeSectionId(uint16 opcode)
+{
+    if (opcode >= MAX_PROFILER_KEYS)
+        return PROFILER_OVERFLOW_SECTION;
+
+    if (uint32 id = _opcodeSections[opcode].load(std::memory_order_acquire))
+        return id;
+
+    uint32 id = GetSectionId("Opcode " + GetOpcodeNameForLogging(Opcodes(opcode)));
+    _opcodeSections[opcode].store(id, std::memory_order_release);
+    return id;
+}
+
+uint32 TickProfiler::GetMapSectionId(uint32 mapId)
+{
+    if (mapId >= MAX_PROFILER_KEYS)
+        return PROFILER_OVERFLOW_SECTION;
+
+    if (uint32 id = _mapSections[mapId].load(std::memory_order_acquire))
+        return id;
+
+    std::ostringstream name;
+    name << "Map::Update " << mapId;
+    if (MapEntry const* entry = sMapStore.LookupEntry(mapId))
+        name << " (" << entry->name << ')';
+
+    uint32 id = GetSectionId(name.str());
+    _mapSections[mapId].store(id, std::memory_order_release);
+    return id;
+}
+
+ThreadProfile* TickProfiler::AcquireThreadProfile()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    ThreadProfile* profile = NULL;
+    for (std::vector<ThreadProfile*>::const_iterator itr = _threadProfiles.begin(); itr != _threadProfiles.end(); ++itr)
+    {
+        if (!(*itr)->InUse.load(std::memory_order_acquire))
+        {
+            profile = *itr;
+            break;
+        }
+    }
+
+    if (!profile)
+    {
+        profile = new ThreadProfile();
+        _threadProfiles.push_back(profile);
+    }
+
+    // samples of the previous owner must not leak into this thread
+    profile->Reset(0);
+    profile->InUse.store(true, std::memory_order_release);
+    return profile;
+}
+
+ThreadProfile* TickProfiler::GetThreadProfile()
+{
+    return threadProfileSlot->Profile;
+}
+
+void TickProfiler::Record(uint32 sectionId, uint32 microseconds)
+{
+    ThreadProfile* profile = GetThreadProfile();
+
+    uint32 epoch = _epoch.load(std::memory_order_relaxed);
+    if (profile->Epoch.load(std::memory_order_relaxed) != epoch)
+        profile->Reset(epoch);
+
+    ProfileHistogram* histogram = profile->Histograms[sectionId].load(std::memory_order_relaxed);
+    if (!histogram)
+    {
+        histogram = new ProfileHistogram();
+        profile->Histograms[sectionId].store(histogram, std::memory_order_release);
+    }
+
+    // single writer: plain load/store pairs are enough, readers only need untorn values
+    std::atomic<uint32>& bucket = histogram->Buckets[GetBucketIndex(microseconds)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    histogram->Count.store(histogram->Count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    histogram->TotalTime.store(histogram->TotalTime.load(std::memory_order_relaxed) + microseconds, std::memory_order_relaxed);
+    if (microseconds > histogram->MaxTime.load(std::memory_order_relaxed))
+        histogram->MaxTime.store(microseconds, std::memory_order_relaxed);
+
+    uint32 spikeThreshold = _spikeThreshold.load(std::memory_order_relaxed);
+    if (spikeThreshold && microseconds >= spikeThreshold)
+        TC_LOG_INFO("misc", "TickProfiler: spike in %s: %u ms", _sectionNames[sectionId].c_str(), microseconds / IN_MILLISECONDS);
+}
+
+void TickProfiler::GetStats(ProfileSectionStatsList& stats)
+{
+    stats.clear();
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    uint32 epoch = _epoch.load(std::memory_order_relaxed);
+    uint32 sectionCount = _sectionCount.load(std::memory_order_acquire);
+
+    uint32 buckets[PROFILER_HISTOGRAM_BUCKETS];
+    for (uint32 section = 0; section < sectionCount; ++section)
+    {
+        memset(buckets, 0, sizeof(buckets));
+        uint32 count = 0;
+        uint64 totalTime = 0;
+        uint32 maxTime = 0;
+
+        for (std::vector<ThreadProfile*>::const_iterator itr = _threadProfiles.begin(); itr != _threadProfiles.end(); ++itr)
+        {
+            // threads that did not record anything since the reset still hold the old window
+            if ((*itr)->Epoch.load(std::memory_order_acquire) != epoch)
+                continue;
+
+            ProfileHistogram const* histogram = (*itr)->Histograms[section].load(std::memory_order_acquire);
+            if (!histogram)
+                continue;
+
+            for (uint32 i = 0; i < PROFILER_HISTOGRAM_BUCKETS; ++i)
+                buckets[i] += histogram->Buckets[i].load(std::memory_order_relaxed);
+
+            count += histogram->Count.load(std::memory_order_relaxed);
+            totalTime += histogram->TotalTime.load(std::memory_order_relaxed);
+            maxTime = std::max(maxTime, histogram->MaxTime.load(std::memory_order_relaxed));
+        }
+
+        if (!count)
+            continue;
+
+        ProfileSectionStats entry;
+        entry.Name = _sectionNames[section];
+        entry.Count = count;
+        entry.TotalTime = totalTime;
+        entry.P50 = GetPercentile(buckets, count, maxTime, 50);
+        entry.P99 = GetPercentile(buckets, count, maxTime, 99);
+        entry.MaxTime = maxTime;
+        stats.push_back(entry);
+    }
+
+    std::sort(stats.begin(), stats.end(), SortStatsByTotalTime);
+}
+
+void TickProfiler::Reset()
+{
+    // every thread clears its own histograms on its next sample
+    _epoch.fetch_add(1, std::memory_order_relaxed);
+    _windowTime = 0;
+}
+
+bool TickProfiler::Dump()
+{
+    if (_dumpFile.empty())
+        return false;
+
+    FILE* file = fopen(_dumpFile.c_str(), "a");
+    if (!file)
+    {
+        TC_LOG_ERROR("misc", "TickProfiler: unable to open dump file %s", _dumpFile.c_str());
+        return false;
+    }
+
+    ProfileSectionStatsList stats;
+    GetStats(stats);
+
+    fseek(file, 0, SEEK_END);
+    if (!ftell(file))
+        fprintf(file, "time,window_ms,players,section,count,total_us,avg_us,p50_us,p99_us,max_us\n");
+
+    uint32 now = uint32(time(NULL));
+    uint32 players = sWorld->GetPlayerCount();
+    for (ProfileSectionStatsList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+        fprintf(file, "%u,%u,%u,\"%s\",%u," UI64FMTD ",%u,%u,%u,%u\n", now, _windowTime, players, itr->Name.c_str(), itr->Count,
+            itr->TotalTime, uint32(itr->TotalTime / itr->Count), itr->P50, itr->P99, itr->MaxTime);
+
+    fclose(file);
+    return true;
+}
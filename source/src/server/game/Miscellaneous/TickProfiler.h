@@ -0,0 +1,137 @@
+#ifndef _TICK_PROFILER_H_
+#define _TICK_PROFILER_H_
+
+#include "Common.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <atomic>
+#include <chrono>
+
+#define MAX_PROFILER_SECTIONS       4096
+#define MAX_PROFILER_KEYS           0x8000
+// 4 buckets per power of two, covers 0 us .. ~16 s
+#define PROFILER_HISTOGRAM_BUCKETS  96
+
+// Section 0 collects samples of sections registered after the table is full
+#define PROFILER_OVERFLOW_SECTION   0
+
+struct ProfileHistogram
+{
+    ProfileHistogram();
+    void Clear();
+
+    std::atomic<uint32> Buckets[PROFILER_HISTOGRAM_BUCKETS];
+    std::atomic<uint32> Count;
+    std::atomic<uint64> TotalTime;
+    std::atomic<uint32> MaxTime;
+};
+
+// Samples of one thread, written only by its owner so recording needs no locks or RMW atomics
+struct ThreadProfile
+{
+    ThreadProfile();
+    void Reset(uint32 epoch);
+
+    std::atomic<uint32> Epoch;
+    std::atomic<bool> InUse;
+    std::atomic<ProfileHistogram*> Histograms[MAX_PROFILER_SECTIONS];
+};
+
+struct ProfileSectionStats
+{
+    std::string Name;
+    uint32 Count;
+    uint64 TotalTime;                                       // all times in microseconds
+    uint32 P50;
+    uint32 P99;
+    uint32 MaxTime;
+};
+
+typedef std::vector<ProfileSectionStats> ProfileSectionStatsList;
+
+class TickProfiler
+{
+    friend class ACE_Singleton<TickProfiler, ACE_Null_Mutex>;
+    friend struct ThreadProfileSlot;
+
+    TickProfiler();
+    ~TickProfiler();
+
+public:
+    void LoadConfig();
+    void Update(uint32 diff);
+
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    // 0 keeps the window open until Reset(), for tools collecting stats over a whole run
+    void SetDumpInterval(uint32 interval) { _dumpInterval = interval; }
+
+    uint32 GetSectionId(std::string const& name);
+    uint32 GetOpcodeSectionId(uint16 opcode);
+    uint32 GetMapSectionId(uint32 mapId);
+
+    void Record(uint32 sectionId, uint32 microseconds);
+
+    // Aggregates all threads, samples are counted since the last Reset()
+    void GetStats(ProfileSectionStatsList& stats);
+    void Reset();
+    bool Dump();
+
+    uint32 GetWindowTime() const { return _windowTime; }
+
+private:
+    ThreadProfile* AcquireThreadProfile();
+    ThreadProfile* GetThreadProfile();
+
+    std::atomic<bool> _enabled;
+    std::atomic<uint32> _spikeThreshold;
+    std::atomic<uint32> _epoch;
+
+    uint32 _dumpInterval;
+    uint32 _dumpTimer;
+    uint32 _windowTime;
+    std::string _dumpFile;
+
+    ACE_Thread_Mutex _lock;
+    UNORDERED_MAP<std::string, uint32> _sectionIds;
+    std::string _sectionNames[MAX_PROFILER_SECTIONS];
+    std::atomic<uint32> _sectionCount;
+    std::atomic<uint32> _opcodeSections[MAX_PROFILER_KEYS];
+    std::atomic<uint32> _mapSections[MAX_PROFILER_KEYS];
+    std::vector<ThreadProfile*> _threadProfiles;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Null_Mutex>::instance()
+
+// Measures the lifetime of the scope and records it into the given section
+class ProfileScope
+{
+public:
+    explicit ProfileScope(uint32 sectionId) : _sectionId(sectionId), _active(sTickProfiler->IsEnabled())
+    {
+        if (_active)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    ~ProfileScope()
+    {
+        if (_active)
+            sTickProfiler->Record(_sectionId, uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count()));
+    }
+
+private:
+    uint32 _sectionId;
+    bool _active;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+// Profiles the rest of the enclosing scope under a fixed section name
+#define PROFILE_SCOPE(name) \
+    static uint32 const PROFILE_CONCAT(_profileSection, __LINE__) = sTickProfiler->GetSectionId(name); \
+    ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(PROFILE_CONCAT(_profileSection, __LINE__))
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef _MOVEMENT_CODEC_H_
+#define _MOVEMENT_CODEC_H_
+
+#include "MovementStructures.h"
+
+/**
+ * Reader and writer of the movement block of one opcode.
+ *
+ * The MovementStatusElements sequences stay the description of the packet
+ * layouts, every sequence is unrolled into a straight list of reads and
+ * writes at compile time. The checks of the element kinds fold away, only
+ * the checks of the optional fields remain.
+ *
+ * MovementInfo::Read_OLD and Write_OLD interpret the same sequences at run
+ * time and are kept as reference (.debug movementcodecs).
+ */
+struct MovementCodec
+{
+    typedef void (*ReadFunction)(MovementInfo& info, ByteBuffer& data);
+    typedef void (*WriteFunction)(MovementInfo const& info, ByteBuffer& data);
+
+    ReadFunction Read;
+    WriteFunction Write;
+};
+
+/// NULL if the opcode has no movement sequence
+MovementCodec const* GetMovementCodec(Opcodes opcode);
+
+/// Compares the codecs with the interpreter on random movement blocks, returns the number of mismatches
+uint32 CheckMovementCodecs(uint32 iterations, std::string& firstMismatch);
+
+namespace Movement
+{
+    struct CodecReadState
+    {
+        CodecReadState() : HasMovementFlags(false), HasMovementFlags2(false), HasTimestamp(false), HasOrientation(false), HasTransportData(false),
+            HasTransportTime2(false), HasTransportTime3(false), HasPitch(false), HasFallData(false), HasFallDirection(false), HasSplineElevation(false) { }
+
+        ObjectGuid Guid;
+        ObjectGuid TransportGuid;
+        bool HasMovementFlags;
+        bool HasMovementFlags2;
+        bool HasTimestamp;
+        bool HasOrientation;
+        bool HasTransportData;
+        bool HasTransportTime2;
+        bool HasTransportTime3;
+        bool HasPitch;
+        bool HasFallData;
+        bool HasFallDirection;
+        bool HasSplineElevation;
+    };
+
+    struct CodecWriteState
+    {
+        explicit CodecWriteState(MovementInfo const& info) : Guid(info.guid), TransportGuid(info.t_guid),
+            HasOrientation(!G3D::fuzzyEq(info.pos.m_orientation, 0.0f)),
+            HasSplineElevation(!G3D::fuzzyEq(info.splineElevation, 0.0f)),
+            HasFallData(info.fallTime || info.j_zspeed),
+            HasFallDirection(HasFallData && (info.j_cosAngle || info.j_sinAngle || info.j_xyspeed)),
+            HasPitch(!G3D::fuzzyEq(info.pitch, 0.0f)) { }
+
+        ObjectGuid Guid;
+        ObjectGuid TransportGuid;
+        bool HasOrientation;
+        bool HasSplineElevation;
+        bool HasFallData;
+        bool HasFallDirection;
+        bool HasPitch;
+    };
+
+    // Same cases as MovementInfo::Read_OLD, Element is a constant so only one branch is compiled in
+    template <MovementStatusElements Element>
+    inline void ReadElement(MovementInfo& info, CodecReadState& state, ByteBuffer& data)
+    {
+        if (Element >= MSEHasGuidByte0 && Element <= MSEHasGuidByte7)
+            state.Guid[Element - MSEHasGuidByte0] = data.ReadBit();
+        else if (Element >= MSEHasTransportGuidByte0 && Element <= MSEHasTransportGuidByte7)
+        {
+            if (state.HasTransportData)
+                state.TransportGuid[Element - MSEHasTransportGuidByte0] = data.ReadBit();
+        }
+        else if (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
+            data.ReadByteSeq(state.Guid[Element - MSEGuidByte0]);
+        else if (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+        {
+            if (state.HasTransportData)
+                data.ReadByteSeq(state.TransportGuid[Element - MSETransportGuidByte0]);
+        }
+        else if (Element >= MSESpeedWalk && Element <= MSESpeedPitchRate)
+            data >> info.ackSpeed;
+        else
+        {
+            switch (Element)
+            {
+                case MSEHasMovementFlags:
+                    state.HasMovementFlags = !data.ReadBit();
+                    break;
+                case MSEHasMovementFlags2:
+                    state.HasMovementFlags2 = !data.ReadBit();
+                    break;
+                case MSEHasTimestamp:
+                    state.HasTimestamp = !data.ReadBit();
+                    break;
+                case MSEHasOrientation:
+                    state.HasOrientation = !data.ReadBit();
+                    break;
+                case MSEHasTransportData:
+                    state.HasTransportData = data.ReadBit();
+                    break;
+                case MSEHasTransportTime2:
+                    if (state.HasTransportData)
+                        state.HasTransportTime2 = data.ReadBit();
+                    break;
+                case MSEHasTransportTime3:
+                    if (state.HasTransportData)
+                        state.HasTransportTime3 = data.ReadBit();
+                    break;
+                case MSEHasPitch:
+                    state.HasPitch = !data.ReadBit();
+                    break;
+                case MSEHasFallData:
+                    state.HasFallData = data.ReadBit();
+                    break;
+                case MSEHasFallDirection:
+                    if (state.HasFallData)
+                        state.HasFallDirection = data.ReadBit();
+                    break;
+                case MSEHasSplineElevation:
+                    state.HasSplineElevation = !data.ReadBit();
+                    break;
+                case MSEHasSpline:
+                    info.hasSpline = data.ReadBit();
+                    break;
+                case MSEMovementFlags:
+                    if (state.HasMovementFlags)
+                        info.flags = data.ReadBits(30);
+                    break;
+                case MSEMovementFlags2:
+                    if (state.HasMovementFlags2)
+                        info.flags2 = data.ReadBits(12);
+                    break;
+                case MSETimestamp:
+                    if (state.HasTimestamp)
+                        data >> info.time;
+                    break;
+                case MSEPositionX:
+                    data >> info.pos.m_positionX;
+                    break;
+                case MSEPositionY:
+                    data >> info.pos.m_positionY;
+                    break;
+                case MSEPositionZ:
+                    data >> info.pos.m_positionZ;
+                    break;
+                case MSEOrientation:
+                    if (state.HasOrientation)
+                        info.pos.SetOrientation(data.read<float>());
+                    break;
+                case MSETransportPositionX:
+                    if (state.HasTransportData)
+                        data >> info.t_pos.m_positionX;
+                    break;
+                case MSETransportPositionY:
+                    if (state.HasTransportData)
+                        data >> info.t_pos.m_positionY;
+                    break;
+                case MSETransportPositionZ:
+                    if (state.HasTransportData)
+                        data >> info.t_pos.m_positionZ;
+                    break;
+                case MSETransportOrientation:
+                    if (state.HasTransportData)
+                        info.t_pos.SetOrientation(data.read<float>());
+                    break;
+                case MSETransportSeat:
+                    if (state.HasTransportData)
+                        data >> info.t_seat;
+                    break;
+                case MSETransportTime:
+                    if (state.HasTransportData)
+                        data >> info.t_time;
+                    break;
+                case MSETransportTime2:
+                    if (state.HasTransportData && state.HasTransportTime2)
+                        data >> info.t_time2;
+                    break;
+                case MSETransportTime3:
+                    if (state.HasTransportData && state.HasTransportTime3)
+                        data >> info.t_time3;
+                    break;
+                case MSEPitch:
+                    if (state.HasPitch)
+                        data >> info.pitch;
+                    break;
+                case MSEFallTime:
+                    if (state.HasFallData)
+                        data >> info.fallTime;
+                    break;
+                case MSEFallVerticalSpeed:
+                    if (state.HasFallData)
+                        data >> info.j_zspeed;
+                    break;
+                case MSEFallCosAngle:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data >> info.j_cosAngle;
+                    break;
+                case MSEFallSinAngle:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data >> info.j_sinAngle;
+                    break;
+                case MSEFallHorizontalSpeed:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data >> info.j_xyspeed;
+                    break;
+                case MSESplineElevation:
+                    if (state.HasSplineElevation)
+                        data >> info.splineElevation;
+                    break;
+                case MSECounter:
+                    data >> info.ackCount;
+                    break;
+                case MSEHeight:
+                    data >> info.height;
+                    break;
+                case MSEZeroBit:
+                case MSEOneBit:
+                    data.ReadBit();
+                    break;
+                default:
+                    ASSERT(false && "Incorrect sequence element detected at ReadMovementInfo");
+                    break;
+            }
+        }
+    }
+
+    // Same cases as MovementInfo::Write_OLD
+    template <MovementStatusElements Element>
+    inline void WriteElement(MovementInfo const& info, CodecWriteState const& state, ByteBuffer& data)
+    {
+        if (Element >= MSEHasGuidByte0 && Element <= MSEHasGuidByte7)
+            data.WriteBit(state.Guid[Element - MSEHasGuidByte0]);
+        else if (Element >= MSEHasTransportGuidByte0 && Element <= MSEHasTransportGuidByte7)
+        {
+            if (info.t_guid)
+                data.WriteBit(state.TransportGuid[Element - MSEHasTransportGuidByte0]);
+        }
+        else if (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
+            data.WriteByteSeq(state.Guid[Element - MSEGuidByte0]);
+        else if (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+        {
+            if (info.t_guid)
+                data.WriteByteSeq(state.TransportGuid[Element - MSETransportGuidByte0]);
+        }
+        else if (Element >= MSESpeedWalk && Element <= MSESpeedPitchRate)
+            data << info.ackSpeed;
+        else
+        {
+            switch (Element)
+            {
+                case MSEHasMovementFlags:
+                    data.WriteBit(!info.flags);
+                    break;
+                case MSEHasMovementFlags2:
+                    data.WriteBit(!info.flags2);
+                    break;
+                case MSEHasTimestamp:
+                    data.WriteBit(!info.time);
+                    break;
+                case MSEHasOrientation:
+                    data.WriteBit(!state.HasOrientation);
+                    break;
+                case MSEHasTransportData:
+                    data.WriteBit(info.t_guid);
+                    break;
+                case MSEHasTransportTime2:
+                    if (info.t_guid)
+                        data.WriteBit(info.t_time2);
+                    break;
+                case MSEHasTransportTime3:
+                    if (info.t_guid)
+                        data.WriteBit(info.t_time3);
+                    break;
+                case MSEHasPitch:
+                    data.WriteBit(!state.HasPitch);
+                    break;
+                case MSEHasFallData:
+                    data.WriteBit(state.HasFallData);
+                    break;
+                case MSEHasFallDirection:
+                    if (state.HasFallData)
+                        data.WriteBit(state.HasFallDirection);
+                    break;
+                case MSEHasSplineElevation:
+                    data.WriteBit(!state.HasSplineElevation);
+                    break;
+                case MSEHasSpline:
+                    data.WriteBit(info.hasSpline);
+                    break;
+                case MSEMovementFlags:
+                    if (info.flags)
+                        data.WriteBits(info.flags, 30);
+                    break;
+                case MSEMovementFlags2:
+                    if (info.flags2)
+                        data.WriteBits(info.flags2, 12);
+                    break;
+                case MSETimestamp:
+                    if (info.time)
+                        data << info.time;
+                    break;
+                case MSEPositionX:
+                    data << info.pos.m_positionX;
+                    break;
+                case MSEPositionY:
+                    data << info.pos.m_positionY;
+                    break;
+                case MSEPositionZ:
+                    data << info.pos.m_positionZ;
+                    break;
+                case MSEOrientation:
+                    if (state.HasOrientation)
+                        data << info.pos.m_orientation;
+                    break;
+                case MSETransportPositionX:
+                    if (info.t_guid)
+                        data << info.t_pos.m_positionX;
+                    break;
+                case MSETransportPositionY:
+                    if (info.t_guid)
+                        data << info.t_pos.m_positionY;
+                    break;
+                case MSETransportPositionZ:
+                    if (info.t_guid)
+                        data << info.t_pos.m_positionZ;
+                    break;
+                case MSETransportOrientation:
+                    if (info.t_guid)
+                        data << info.t_pos.m_orientation;
+                    break;
+                case MSETransportSeat:
+                    if (info.t_guid)
+                        data << info.t_seat;
+                    break;
+                case MSETransportTime:
+                    if (info.t_guid)
+                        data << info.t_time;
+                    break;
+                case MSETransportTime2:
+                    if (info.t_guid && info.t_time2)
+                        data << info.t_time2;
+                    break;
+                case MSETransportTime3:
+                    if (info.t_guid && info.t_time3)
+                        data << info.t_time3;
+                    break;
+                case MSEPitch:
+                    if (state.HasPitch)
+                        data << info.pitch;
+                    break;
+                case MSEFallTime:
+                    if (state.HasFallData)
+                        data << info.fallTime;
+                    break;
+                case MSEFallVerticalSpeed:
+                    if (state.HasFallData)
+                        data << info.j_zspeed;
+                    break;
+                case MSEFallCosAngle:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data << info.j_cosAngle;
+                    break;
+                case MSEFallSinAngle:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data << info.j_sinAngle;
+                    break;
+                case MSEFallHorizontalSpeed:
+                    if (state.HasFallData && state.HasFallDirection)
+                        data << info.j_xyspeed;
+                    break;
+                case MSESplineElevation:
+                    if (state.HasSplineElevation)
+                        data << info.splineElevation;
+                    break;
+                case MSECounter:
+                    data << info.ackCount;
+                    break;
+                case MSEHeight:
+                    data << info.height;
+                    break;
+                case MSEZeroBit:
+                    data.WriteBit(0);
+                    break;
+                case MSEOneBit:
+                    data.WriteBit(1);
+                    break;
+                default:
+                    ASSERT(false && "Incorrect sequence element detected at WriteMovementInfo");
+                    break;
+            }
+        }
+    }
+
+    // Unrolls Sequence from Index up to its MSEEnd
+    template <MovementStatusElements const* Sequence, uint32 Index, bool End = Sequence[Index] == MSEEnd>
+    struct SequenceCodec
+    {
+        static inline void Read(MovementInfo& info, CodecReadState& state, ByteBuffer& data)
+        {
+            ReadElement<Sequence[Index]>(info, state, data);
+            SequenceCodec<Sequence, Index + 1>::Read(info, state, data);
+        }
+
+        static inline void Write(MovementInfo const& info, CodecWriteState const& state, ByteBuffer& data)
+        {
+            WriteElement<Sequence[Index]>(info, state, data);
+            SequenceCodec<Sequence, Index + 1>::Write(info, state, data);
+        }
+    };
+
+    template <MovementStatusElements const* Sequence, uint32 Index>
+    struct SequenceCodec<Sequence, Index, true>
+    {
+        static inline void Read(MovementInfo& /*info*/, CodecReadState& /*state*/, ByteBuffer& /*data*/) { }
+        static inline void Write(MovementInfo const& /*info*/, CodecWriteState const& /*state*/, ByteBuffer& /*data*/) { }
+    };
+
+    template <MovementStatusElements const* Sequence>
+    void ReadMovement(MovementInfo& info, ByteBuffer& data)
+    {
+        CodecReadState state;
+        SequenceCodec<Sequence, 0>::Read(info, state, data);
+        info.guid = state.Guid;
+        info.t_guid = state.TransportGuid;
+    }
+
+    template <MovementStatusElements const* Sequence>
+    void WriteMovement(MovementInfo const& info, ByteBuffer& data)
+    {
+        CodecWriteState state(info);
+        SequenceCodec<Sequence, 0>::Write(info, state, data);
+    }
+}
+
+#endif
@@ -1,5 +1,6 @@
 
 #include "MovementInfo.h"
+#include "MovementCodec.h"
 #include "MovementStructures.h"
 #include "Object.h"
 #include "Player.h"
@@ -296,7 +297,10 @@ void MovementInfo::ReadFromPacket(WorldPacket &packet)
         Read_CMSG_MOVE_KNOCK_BACK_ACK(packet);
         break;
     default:
-        Read_OLD(packet);
+        if (MovementCodec const* codec = GetMovementCodec(Opcodes(packet.GetOpcode())))
+            codec->Read(*this, packet);
+        else
+            Read_OLD(packet);                               // reports the missing sequence
         break;
     }
 }
@@ -624,7 +628,10 @@ void MovementInfo::WriteToPacket(WorldPacket &packet)
         Write_SMSG_MOVE_TELEPORT(packet);
         break;
     default:
-        Write_OLD(packet);
+        if (MovementCodec const* codec = GetMovementCodec(Opcodes(packet.GetOpcode())))
+            codec->Write(*this, packet);
+        else
+            Write_OLD(packet);                              // reports the missing sequence
         break;
     }
 }
@@ -17,11 +17,13 @@
  */
 
 #include "MovementStructures.h"
+#include "MovementCodec.h"
 #include "Player.h"
 #include "Opcodes.h"
+#include "Util.h"
 
 //4.3.4
-MovementStatusElements PlayerMoveSequence[] =
+constexpr MovementStatusElements PlayerMoveSequence[] =
 {
     MSEHasFallData,
     MSEHasGuidByte3,
@@ -94,7 +96,7 @@ MovementStatusElements PlayerMoveSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementFallLandSequence[] =
+constexpr MovementStatusElements MovementFallLandSequence[] =
 {
     MSEPositionX,
     MSEPositionY,
@@ -167,7 +169,7 @@ MovementStatusElements MovementFallLandSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementHeartBeatSequence[] =
+constexpr MovementStatusElements MovementHeartBeatSequence[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -240,7 +242,7 @@ MovementStatusElements MovementHeartBeatSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementJumpSequence[] =
+constexpr MovementStatusElements MovementJumpSequence[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -313,7 +315,7 @@ MovementStatusElements MovementJumpSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetFacingSequence[] =
+constexpr MovementStatusElements MovementSetFacingSequence[] =
 {
     MSEPositionX,
     MSEPositionY,
@@ -386,7 +388,7 @@ MovementStatusElements MovementSetFacingSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetPitchSequence[] =
+constexpr MovementStatusElements MovementSetPitchSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -459,7 +461,7 @@ MovementStatusElements MovementSetPitchSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartBackwardSequence[] =
+constexpr MovementStatusElements MovementStartBackwardSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -532,7 +534,7 @@ MovementStatusElements MovementStartBackwardSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartForwardSequence[] =
+constexpr MovementStatusElements MovementStartForwardSequence[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -606,7 +608,7 @@ MovementStatusElements MovementStartForwardSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartStrafeLeftSequence[] =
+constexpr MovementStatusElements MovementStartStrafeLeftSequence[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -679,7 +681,7 @@ MovementStatusElements MovementStartStrafeLeftSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartStrafeRightSequence[] =
+constexpr MovementStatusElements MovementStartStrafeRightSequence[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -752,7 +754,7 @@ MovementStatusElements MovementStartStrafeRightSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartTurnLeftSequence[] =
+constexpr MovementStatusElements MovementStartTurnLeftSequence[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -825,7 +827,7 @@ MovementStatusElements MovementStartTurnLeftSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartTurnRightSequence[] =
+constexpr MovementStatusElements MovementStartTurnRightSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -898,7 +900,7 @@ MovementStatusElements MovementStartTurnRightSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopSequence[] =
+constexpr MovementStatusElements MovementStopSequence[] =
 {
     MSEPositionX,
     MSEPositionY,
@@ -971,7 +973,7 @@ MovementStatusElements MovementStopSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopStrafeSequence[] =
+constexpr MovementStatusElements MovementStopStrafeSequence[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -1044,7 +1046,7 @@ MovementStatusElements MovementStopStrafeSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopTurnSequence[] =
+constexpr MovementStatusElements MovementStopTurnSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -1117,7 +1119,7 @@ MovementStatusElements MovementStopTurnSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartAscendSequence[] =
+constexpr MovementStatusElements MovementStartAscendSequence[] =
 {
     MSEPositionX,
     MSEPositionY,
@@ -1190,7 +1192,7 @@ MovementStatusElements MovementStartAscendSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartDescendSequence[] =
+constexpr MovementStatusElements MovementStartDescendSequence[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -1263,7 +1265,7 @@ MovementStatusElements MovementStartDescendSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartSwimSequence[] =
+constexpr MovementStatusElements MovementStartSwimSequence[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -1336,7 +1338,7 @@ MovementStatusElements MovementStartSwimSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopSwimSequence[] =
+constexpr MovementStatusElements MovementStopSwimSequence[] =
 {
     MSEPositionX,
     MSEPositionY,
@@ -1409,7 +1411,7 @@ MovementStatusElements MovementStopSwimSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopAscendSequence[] =
+constexpr MovementStatusElements MovementStopAscendSequence[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -1482,7 +1484,7 @@ MovementStatusElements MovementStopAscendSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStopPitchSequence[] =
+constexpr MovementStatusElements MovementStopPitchSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -1555,7 +1557,7 @@ MovementStatusElements MovementStopPitchSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartPitchDownSequence[] =
+constexpr MovementStatusElements MovementStartPitchDownSequence[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -1628,7 +1630,7 @@ MovementStatusElements MovementStartPitchDownSequence[] =
 };
 
 //4.3.4
-MovementStatusElements MovementStartPitchUpSequence[] =
+constexpr MovementStatusElements MovementStartPitchUpSequence[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -1700,7 +1702,7 @@ MovementStatusElements MovementStartPitchUpSequence[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveChngTransport[]=
+constexpr MovementStatusElements MoveChngTransport[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -1779,7 +1781,7 @@ MovementStatusElements MoveChngTransport[]=
 };
 
 // 4.3.4
-MovementStatusElements MoveSplineDone[] =
+constexpr MovementStatusElements MoveSplineDone[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -1859,7 +1861,7 @@ MovementStatusElements MoveSplineDone[] =
 };
 
 // 4.3.4
-MovementStatusElements MoveNotActiveMover[] =
+constexpr MovementStatusElements MoveNotActiveMover[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -1939,7 +1941,7 @@ MovementStatusElements MoveNotActiveMover[] =
 };
 
 // 4.3.4
-MovementStatusElements DismissControlledVehicle[] =
+constexpr MovementStatusElements DismissControlledVehicle[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -2019,7 +2021,7 @@ MovementStatusElements DismissControlledVehicle[] =
 };
 
 // 4.3.4
-MovementStatusElements MoveUpdateTeleport[] =
+constexpr MovementStatusElements MoveUpdateTeleport[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -2102,7 +2104,7 @@ MovementStatusElements MoveUpdateTeleport[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetRunMode[] =
+constexpr MovementStatusElements MovementSetRunMode[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -2175,7 +2177,7 @@ MovementStatusElements MovementSetRunMode[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetWalkMode[] =
+constexpr MovementStatusElements MovementSetWalkMode[] =
 {
     MSEPositionY,
     MSEPositionX,
@@ -2252,7 +2254,7 @@ MovementStatusElements MovementSetWalkMode[] =
 // MovementStatusElements MovementSetCanTransitionBetweenSwimAndFlyAck[] =
 
 //4.3.4
-MovementStatusElements MovementUpdateSwimSpeed[] =
+constexpr MovementStatusElements MovementUpdateSwimSpeed[] =
 {
     MSEHasMovementFlags,
     MSEHasGuidByte2,
@@ -2337,7 +2339,7 @@ MovementStatusElements MovementUpdateSwimSpeed[] =
 };
 
 //4.3.4
-MovementStatusElements MovementUpdateRunSpeed[] =
+constexpr MovementStatusElements MovementUpdateRunSpeed[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -2419,7 +2421,7 @@ MovementStatusElements MovementUpdateRunSpeed[] =
 };
 
 //4.3.4
-MovementStatusElements MovementUpdateFlightSpeed[] =
+constexpr MovementStatusElements MovementUpdateFlightSpeed[] =
 {
     MSEPositionY,
     MSESpeedFlight,
@@ -2503,7 +2505,7 @@ MovementStatusElements MovementUpdateFlightSpeed[] =
 };
 
 //4.3.4
-MovementStatusElements MovementUpdateCollisionHeight[] =
+constexpr MovementStatusElements MovementUpdateCollisionHeight[] =
 {
     MSEPositionZ,
     MSEHeight,
@@ -2564,7 +2566,7 @@ MovementStatusElements MovementUpdateCollisionHeight[] =
 };
 
 //4.3.4
-MovementStatusElements MovementForceRunSpeedChangeAck[] =
+constexpr MovementStatusElements MovementForceRunSpeedChangeAck[] =
 {
     MSECounter,
     MSEPositionX,
@@ -2647,7 +2649,7 @@ MovementStatusElements MovementForceRunSpeedChangeAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetCollisionHeightAck[] =
+constexpr MovementStatusElements MovementSetCollisionHeightAck[] =
 {
     MSEHeight,
     MSEPositionX,
@@ -2724,7 +2726,7 @@ MovementStatusElements MovementSetCollisionHeightAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementForceFlightSpeedChangeAck[] =
+constexpr MovementStatusElements MovementForceFlightSpeedChangeAck[] =
 {
     MSECounter,
     MSEPositionZ,
@@ -2808,7 +2810,7 @@ MovementStatusElements MovementForceFlightSpeedChangeAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementSetCanFlyAck[] =
+constexpr MovementStatusElements MovementSetCanFlyAck[] =
 {
     MSEPositionY,
     MSECounter,
@@ -2882,7 +2884,7 @@ MovementStatusElements MovementSetCanFlyAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementForceSwimSpeedChangeAck[] =
+constexpr MovementStatusElements MovementForceSwimSpeedChangeAck[] =
 {
     MSEPositionX,
     MSECounter,
@@ -2966,7 +2968,7 @@ MovementStatusElements MovementForceSwimSpeedChangeAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementForceWalkSpeedChangeAck[] =
+constexpr MovementStatusElements MovementForceWalkSpeedChangeAck[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -3050,7 +3052,7 @@ MovementStatusElements MovementForceWalkSpeedChangeAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementForceRunBackSpeedChangeAck[] =
+constexpr MovementStatusElements MovementForceRunBackSpeedChangeAck[] =
 {
     MSESpeedRunBack,
     MSECounter,
@@ -3134,7 +3136,7 @@ MovementStatusElements MovementForceRunBackSpeedChangeAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementUpdateRunBackSpeed[] =
+constexpr MovementStatusElements MovementUpdateRunBackSpeed[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte2,
@@ -3219,7 +3221,7 @@ MovementStatusElements MovementUpdateRunBackSpeed[] =
 };
 
 //4.3.4
-MovementStatusElements MovementUpdateWalkSpeed[] =
+constexpr MovementStatusElements MovementUpdateWalkSpeed[] =
 {
     MSEHasPitch,
     MSEHasOrientation,
@@ -3305,7 +3307,7 @@ MovementStatusElements MovementUpdateWalkSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements ForceMoveRootAck[] =
+constexpr MovementStatusElements ForceMoveRootAck[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -3385,7 +3387,7 @@ MovementStatusElements ForceMoveRootAck[] =
     MSEEnd,
 };
 
-MovementStatusElements ForceMoveUnrootAck[] =
+constexpr MovementStatusElements ForceMoveUnrootAck[] =
 {
     MSECounter,
     MSEPositionZ,
@@ -3468,7 +3470,7 @@ MovementStatusElements ForceMoveUnrootAck[] =
 // MovementStatusElements MovementFallReset[] =
 
 //4.3.4
-MovementStatusElements MovementFeatherFallAck[] =
+constexpr MovementStatusElements MovementFeatherFallAck[] =
 {
     MSEPositionZ,
     MSECounter,
@@ -3542,7 +3544,7 @@ MovementStatusElements MovementFeatherFallAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementGravityDisableAck[] =
+constexpr MovementStatusElements MovementGravityDisableAck[] =
 {
     MSEPositionZ,
     MSEPositionY,
@@ -3616,7 +3618,7 @@ MovementStatusElements MovementGravityDisableAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementGravityEnableAck[] =
+constexpr MovementStatusElements MovementGravityEnableAck[] =
 {
     MSEPositionZ,
     MSEPositionX,
@@ -3690,7 +3692,7 @@ MovementStatusElements MovementGravityEnableAck[] =
 };
 
 //4.3.4
-MovementStatusElements MovementHoverAck[] =
+constexpr MovementStatusElements MovementHoverAck[] =
 {
     MSECounter,
     MSEPositionZ,
@@ -3766,7 +3768,7 @@ MovementStatusElements MovementHoverAck[] =
 // MovementStatusElements MovementKnockBackAck[] =
 
 //4.3.4
-MovementStatusElements MovementWaterWalkAck[] =
+constexpr MovementStatusElements MovementWaterWalkAck[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -3841,7 +3843,7 @@ MovementStatusElements MovementWaterWalkAck[] =
 
 // MovementStatusElements MovementUpdateKnockBack[] =
 
-MovementStatusElements SplineMoveSetWalkSpeed[] =
+constexpr MovementStatusElements SplineMoveSetWalkSpeed[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte6,
@@ -3863,7 +3865,7 @@ MovementStatusElements SplineMoveSetWalkSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetRunSpeed[] =
+constexpr MovementStatusElements SplineMoveSetRunSpeed[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte0,
@@ -3885,7 +3887,7 @@ MovementStatusElements SplineMoveSetRunSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetRunBackSpeed[] =
+constexpr MovementStatusElements SplineMoveSetRunBackSpeed[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte2,
@@ -3907,7 +3909,7 @@ MovementStatusElements SplineMoveSetRunBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetSwimSpeed[] =
+constexpr MovementStatusElements SplineMoveSetSwimSpeed[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte2,
@@ -3929,7 +3931,7 @@ MovementStatusElements SplineMoveSetSwimSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetSwimBackSpeed[] =
+constexpr MovementStatusElements SplineMoveSetSwimBackSpeed[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte1,
@@ -3951,7 +3953,7 @@ MovementStatusElements SplineMoveSetSwimBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetTurnRate[] =
+constexpr MovementStatusElements SplineMoveSetTurnRate[] =
 {
     MSEHasGuidByte2,
     MSEHasGuidByte4,
@@ -3973,7 +3975,7 @@ MovementStatusElements SplineMoveSetTurnRate[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetFlightSpeed[] =
+constexpr MovementStatusElements SplineMoveSetFlightSpeed[] =
 {
     MSEHasGuidByte7,
     MSEHasGuidByte4,
@@ -3995,7 +3997,7 @@ MovementStatusElements SplineMoveSetFlightSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetFlightBackSpeed[] =
+constexpr MovementStatusElements SplineMoveSetFlightBackSpeed[] =
 {
     MSEHasGuidByte2,
     MSEHasGuidByte1,
@@ -4017,7 +4019,7 @@ MovementStatusElements SplineMoveSetFlightBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetPitchRate[] =
+constexpr MovementStatusElements SplineMoveSetPitchRate[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte5,
@@ -4039,7 +4041,7 @@ MovementStatusElements SplineMoveSetPitchRate[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetWalkSpeed[] =
+constexpr MovementStatusElements MoveSetWalkSpeed[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte4,
@@ -4062,7 +4064,7 @@ MovementStatusElements MoveSetWalkSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetRunSpeed[] =
+constexpr MovementStatusElements MoveSetRunSpeed[] =
 {
     MSEHasGuidByte6,
     MSEHasGuidByte1,
@@ -4085,7 +4087,7 @@ MovementStatusElements MoveSetRunSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetRunBackSpeed[] =
+constexpr MovementStatusElements MoveSetRunBackSpeed[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte6,
@@ -4108,7 +4110,7 @@ MovementStatusElements MoveSetRunBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetSwimSpeed[] =
+constexpr MovementStatusElements MoveSetSwimSpeed[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte4,
@@ -4131,7 +4133,7 @@ MovementStatusElements MoveSetSwimSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetSwimBackSpeed[] =
+constexpr MovementStatusElements MoveSetSwimBackSpeed[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte2,
@@ -4154,7 +4156,7 @@ MovementStatusElements MoveSetSwimBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetTurnRate[] =
+constexpr MovementStatusElements MoveSetTurnRate[] =
 {
     MSEHasGuidByte7,
     MSEHasGuidByte2,
@@ -4177,7 +4179,7 @@ MovementStatusElements MoveSetTurnRate[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetFlightSpeed[] =
+constexpr MovementStatusElements MoveSetFlightSpeed[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte5,
@@ -4200,7 +4202,7 @@ MovementStatusElements MoveSetFlightSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetFlightBackSpeed[] =
+constexpr MovementStatusElements MoveSetFlightBackSpeed[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte2,
@@ -4223,7 +4225,7 @@ MovementStatusElements MoveSetFlightBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetPitchRate[] =
+constexpr MovementStatusElements MoveSetPitchRate[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte2,
@@ -4246,7 +4248,7 @@ MovementStatusElements MoveSetPitchRate[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetCollisionHeight[] =
+constexpr MovementStatusElements MoveSetCollisionHeight[] =
 {
     MSEZeroBit,
     MSEZeroBit,
@@ -4272,7 +4274,7 @@ MovementStatusElements MoveSetCollisionHeight[] =
 };
 
 // 4.3.4
-MovementStatusElements SplineMoveSetWalkMode[] =
+constexpr MovementStatusElements SplineMoveSetWalkMode[] =
 {
     MSEHasGuidByte7,
     MSEHasGuidByte6,
@@ -4294,7 +4296,7 @@ MovementStatusElements SplineMoveSetWalkMode[] =
 };
 
 // 4.3.4
-MovementStatusElements SplineMoveSetRunMode[] =
+constexpr MovementStatusElements SplineMoveSetRunMode[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte6,
@@ -4315,7 +4317,7 @@ MovementStatusElements SplineMoveSetRunMode[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveGravityDisable[] =
+constexpr MovementStatusElements SplineMoveGravityDisable[] =
 {
     MSEHasGuidByte7,
     MSEHasGuidByte3,
@@ -4336,7 +4338,7 @@ MovementStatusElements SplineMoveGravityDisable[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveGravityEnable[] =
+constexpr MovementStatusElements SplineMoveGravityEnable[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte4,
@@ -4357,7 +4359,7 @@ MovementStatusElements SplineMoveGravityEnable[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveSetHover[] =
+constexpr MovementStatusElements SplineMoveSetHover[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte7,
@@ -4378,7 +4380,7 @@ MovementStatusElements SplineMoveSetHover[] =
     MSEEnd,
 };
 
-MovementStatusElements SplineMoveUnsetHover[] =
+constexpr MovementStatusElements SplineMoveUnsetHover[] =
 {
     MSEHasGuidByte6,
     MSEHasGuidByte7,
@@ -4399,7 +4401,7 @@ MovementStatusElements SplineMoveUnsetHover[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveStartSwim[] =
+constexpr MovementStatusElements SplineMoveStartSwim[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte6,
@@ -4420,7 +4422,7 @@ MovementStatusElements const SplineMoveStartSwim[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveStopSwim[] =
+constexpr MovementStatusElements SplineMoveStopSwim[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte1,
@@ -4441,7 +4443,7 @@ MovementStatusElements const SplineMoveStopSwim[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFlying[] =
+constexpr MovementStatusElements SplineMoveSetFlying[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte4,
@@ -4462,7 +4464,7 @@ MovementStatusElements const SplineMoveSetFlying[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveUnsetFlying[] =
+constexpr MovementStatusElements SplineMoveUnsetFlying[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte0,
@@ -4483,7 +4485,7 @@ MovementStatusElements const SplineMoveUnsetFlying[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetWaterWalk[] =
+constexpr MovementStatusElements SplineMoveSetWaterWalk[] =
 {
     MSEHasGuidByte6,
     MSEHasGuidByte1,
@@ -4504,7 +4506,7 @@ MovementStatusElements const SplineMoveSetWaterWalk[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetLandWalk[] =
+constexpr MovementStatusElements SplineMoveSetLandWalk[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte0,
@@ -4525,7 +4527,7 @@ MovementStatusElements const SplineMoveSetLandWalk[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetFeatherFall[] =
+constexpr MovementStatusElements SplineMoveSetFeatherFall[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte2,
@@ -4546,7 +4548,7 @@ MovementStatusElements const SplineMoveSetFeatherFall[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveSetNormalFall[] =
+constexpr MovementStatusElements SplineMoveSetNormalFall[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte5,
@@ -4567,7 +4569,7 @@ MovementStatusElements const SplineMoveSetNormalFall[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveRoot[] =
+constexpr MovementStatusElements SplineMoveRoot[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte4,
@@ -4588,7 +4590,7 @@ MovementStatusElements const SplineMoveRoot[] =
     MSEEnd,
 };
 
-MovementStatusElements const SplineMoveUnRoot[] =
+constexpr MovementStatusElements SplineMoveUnRoot[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte1,
@@ -4609,7 +4611,7 @@ MovementStatusElements const SplineMoveUnRoot[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetCanFly[] =
+constexpr MovementStatusElements MoveSetCanFly[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte6,
@@ -4631,7 +4633,7 @@ MovementStatusElements MoveSetCanFly[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveUnsetCanFly[] =
+constexpr MovementStatusElements MoveUnsetCanFly[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte4,
@@ -4653,7 +4655,7 @@ MovementStatusElements MoveUnsetCanFly[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveSetHover[] =
+constexpr MovementStatusElements MoveSetHover[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte4,
@@ -4675,7 +4677,7 @@ MovementStatusElements MoveSetHover[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveUnsetHover[] =
+constexpr MovementStatusElements MoveUnsetHover[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte6,
@@ -4697,7 +4699,7 @@ MovementStatusElements MoveUnsetHover[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveWaterWalk[] =
+constexpr MovementStatusElements MoveWaterWalk[] =
 {
     MSEHasGuidByte4,
     MSEHasGuidByte7,
@@ -4719,7 +4721,7 @@ MovementStatusElements MoveWaterWalk[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveLandWalk[] =
+constexpr MovementStatusElements MoveLandWalk[] =
 {
     MSEHasGuidByte5,
     MSEHasGuidByte1,
@@ -4741,7 +4743,7 @@ MovementStatusElements MoveLandWalk[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveFeatherFall[] =
+constexpr MovementStatusElements MoveFeatherFall[] =
 {
     MSEHasGuidByte3,
     MSEHasGuidByte1,
@@ -4763,7 +4765,7 @@ MovementStatusElements MoveFeatherFall[] =
     MSEEnd,
 };
 
-MovementStatusElements MoveNormalFall[] =
+constexpr MovementStatusElements MoveNormalFall[] =
 {
     MSECounter,
     MSEHasGuidByte3,
@@ -4785,7 +4787,7 @@ MovementStatusElements MoveNormalFall[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveRoot[] =
+constexpr MovementStatusElements MoveRoot[] =
 {
     MSEHasGuidByte2,
     MSEHasGuidByte7,
@@ -4807,7 +4809,7 @@ MovementStatusElements const MoveRoot[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveUnRoot[] =
+constexpr MovementStatusElements MoveUnRoot[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte1,
@@ -4835,7 +4837,7 @@ MovementStatusElements const MoveUnRoot[] =
 
 // NOT TC FROM HERE
 
-MovementStatusElements const MoveGravityDisable[] =
+constexpr MovementStatusElements MoveGravityDisable[] =
 {
     MSEHasGuidByte0,
     MSEHasGuidByte1,
@@ -4857,7 +4859,7 @@ MovementStatusElements const MoveGravityDisable[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveGravityEnable[] =
+constexpr MovementStatusElements MoveGravityEnable[] =
 {
     MSEHasGuidByte1,
     MSEHasGuidByte4,
@@ -4879,7 +4881,7 @@ MovementStatusElements const MoveGravityEnable[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveUpdateSwimBackSpeed[] =
+constexpr MovementStatusElements MoveUpdateSwimBackSpeed[] =
 {
     MSEHasGuidByte7,
     MSEHasGuidByte2,
@@ -4962,7 +4964,7 @@ MovementStatusElements const MoveUpdateSwimBackSpeed[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveForcePitchRateChangeAck[] =
+constexpr MovementStatusElements MoveForcePitchRateChangeAck[] =
 {
     MSEPositionX,
     MSECounter,
@@ -5045,7 +5047,7 @@ MovementStatusElements const MoveForcePitchRateChangeAck[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveForceFlightBackSpeedChangeAck[] =
+constexpr MovementStatusElements MoveForceFlightBackSpeedChangeAck[] =
 {
     MSEPositionY,
     MSEPositionZ,
@@ -5127,7 +5129,7 @@ MovementStatusElements const MoveForceFlightBackSpeedChangeAck[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveForceTurnRateSpeedChangeAck[] =
+constexpr MovementStatusElements MoveForceTurnRateSpeedChangeAck[] =
 {
     MSEPositionX,
     MSEPositionZ,
@@ -5210,7 +5212,7 @@ MovementStatusElements const MoveForceTurnRateSpeedChangeAck[] =
     MSEEnd,
 };
 
-MovementStatusElements const MoveForceSwimBackSpeedChangeAck[] =
+constexpr MovementStatusElements MoveForceSwimBackSpeedChangeAck[] =
 {
     MSESpeedSwimBack,
     MSEPositionX,
@@ -5324,234 +5326,236 @@ void Movement::PacketSender::Send() const
         _unit->SendMessageToSet(&data, (_unit->GetTypeId() == TYPEID_PLAYER) ? true : false);
 }
 
+// Opcodes with a movement block and its layout. Not described yet: CMSG_MOVE_FALL_RESET,
+// CMSG_MOVE_KNOCK_BACK_ACK and SMSG_MOVE_UPDATE_KNOCK_BACK (hand written in MovementInfo),
+// CMSG_MOVE_SET_CAN_FLY, CMSG_MOVE_SET_CAN_TRANSITION_BETWEEN_SWIM_AND_FLY_ACK,
+// CMSG_CHANGE_SEATS_ON_CONTROLLED_VEHICLE and the movement embedded in spell casts
+#define MOVEMENT_SEQUENCES(SEQUENCE) \
+    SEQUENCE(MSG_MOVE_FALL_LAND, MovementFallLandSequence) \
+    SEQUENCE(MSG_MOVE_HEARTBEAT, MovementHeartBeatSequence) \
+    SEQUENCE(MSG_MOVE_JUMP, MovementJumpSequence) \
+    SEQUENCE(MSG_MOVE_SET_FACING, MovementSetFacingSequence) \
+    SEQUENCE(MSG_MOVE_SET_PITCH, MovementSetPitchSequence) \
+    SEQUENCE(MSG_MOVE_START_ASCEND, MovementStartAscendSequence) \
+    SEQUENCE(MSG_MOVE_START_BACKWARD, MovementStartBackwardSequence) \
+    SEQUENCE(MSG_MOVE_START_DESCEND, MovementStartDescendSequence) \
+    SEQUENCE(MSG_MOVE_START_FORWARD, MovementStartForwardSequence) \
+    SEQUENCE(MSG_MOVE_START_PITCH_DOWN, MovementStartPitchDownSequence) \
+    SEQUENCE(MSG_MOVE_START_PITCH_UP, MovementStartPitchUpSequence) \
+    SEQUENCE(MSG_MOVE_START_STRAFE_LEFT, MovementStartStrafeLeftSequence) \
+    SEQUENCE(MSG_MOVE_START_STRAFE_RIGHT, MovementStartStrafeRightSequence) \
+    SEQUENCE(SMSG_MOVE_START_SWIM, MovementStartSwimSequence) \
+    SEQUENCE(MSG_MOVE_START_TURN_LEFT, MovementStartTurnLeftSequence) \
+    SEQUENCE(MSG_MOVE_START_TURN_RIGHT, MovementStartTurnRightSequence) \
+    SEQUENCE(MSG_MOVE_STOP, MovementStopSequence) \
+    SEQUENCE(MSG_MOVE_STOP_ASCEND, MovementStopAscendSequence) \
+    SEQUENCE(MSG_MOVE_STOP_PITCH, MovementStopPitchSequence) \
+    SEQUENCE(MSG_MOVE_STOP_STRAFE, MovementStopStrafeSequence) \
+    SEQUENCE(SMSG_MOVE_STOP_SWIM, MovementStopSwimSequence) \
+    SEQUENCE(MSG_MOVE_STOP_TURN, MovementStopTurnSequence) \
+    SEQUENCE(SMSG_PLAYER_MOVE, PlayerMoveSequence) \
+    SEQUENCE(CMSG_MOVE_CHNG_TRANSPORT, MoveChngTransport) \
+    SEQUENCE(CMSG_MOVE_SPLINE_DONE, MoveSplineDone) \
+    SEQUENCE(CMSG_MOVE_NOT_ACTIVE_MOVER, MoveNotActiveMover) \
+    SEQUENCE(CMSG_DISMISS_CONTROLLED_VEHICLE, DismissControlledVehicle) \
+    SEQUENCE(SMSG_MOVE_UPDATE_TELEPORT, MoveUpdateTeleport) \
+    SEQUENCE(CMSG_FORCE_MOVE_ROOT_ACK, ForceMoveRootAck) \
+    SEQUENCE(CMSG_FORCE_MOVE_UNROOT_ACK, ForceMoveUnrootAck) \
+    SEQUENCE(CMSG_MOVE_FEATHER_FALL_ACK, MovementFeatherFallAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_FLIGHT_SPEED_CHANGE_ACK, MovementForceFlightSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_RUN_BACK_SPEED_CHANGE_ACK, MovementForceRunBackSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_RUN_SPEED_CHANGE_ACK, MovementForceRunSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_SWIM_SPEED_CHANGE_ACK, MovementForceSwimSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_WALK_SPEED_CHANGE_ACK, MovementForceWalkSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_GRAVITY_DISABLE_ACK, MovementGravityDisableAck) \
+    SEQUENCE(CMSG_MOVE_GRAVITY_ENABLE_ACK, MovementGravityEnableAck) \
+    SEQUENCE(CMSG_MOVE_HOVER_ACK, MovementHoverAck) \
+    SEQUENCE(CMSG_MOVE_SET_CAN_FLY_ACK, MovementSetCanFlyAck) \
+    SEQUENCE(SMSG_MOVE_SET_COLLISION_HEIGHT, MoveSetCollisionHeight) \
+    SEQUENCE(CMSG_MOVE_SET_COLLISION_HEIGHT_ACK, MovementSetCollisionHeightAck) \
+    SEQUENCE(SMSG_MOVE_UPDATE_COLLISION_HEIGHT, MovementUpdateCollisionHeight) \
+    SEQUENCE(CMSG_MOVE_WATER_WALK_ACK, MovementWaterWalkAck) \
+    SEQUENCE(SMSG_MOVE_SET_RUN_MODE, MovementSetRunMode) \
+    SEQUENCE(SMSG_MOVE_SET_WALK_MODE, MovementSetWalkMode) \
+    SEQUENCE(SMSG_MOVE_UPDATE_FLIGHT_SPEED, MovementUpdateFlightSpeed) \
+    SEQUENCE(SMSG_MOVE_UPDATE_RUN_SPEED, MovementUpdateRunSpeed) \
+    SEQUENCE(SMSG_MOVE_UPDATE_RUN_BACK_SPEED, MovementUpdateRunBackSpeed) \
+    SEQUENCE(SMSG_MOVE_UPDATE_SWIM_SPEED, MovementUpdateSwimSpeed) \
+    SEQUENCE(SMSG_MOVE_UPDATE_WALK_SPEED, MovementUpdateWalkSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_WALK_SPEED, SplineMoveSetWalkSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_RUN_SPEED, SplineMoveSetRunSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_RUN_BACK_SPEED, SplineMoveSetRunBackSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_SWIM_SPEED, SplineMoveSetSwimSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_SWIM_BACK_SPEED, SplineMoveSetSwimBackSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_TURN_RATE, SplineMoveSetTurnRate) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_FLIGHT_SPEED, SplineMoveSetFlightSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_FLIGHT_BACK_SPEED, SplineMoveSetFlightBackSpeed) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_PITCH_RATE, SplineMoveSetPitchRate) \
+    SEQUENCE(SMSG_MOVE_SET_WALK_SPEED, MoveSetWalkSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_RUN_SPEED, MoveSetRunSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_RUN_BACK_SPEED, MoveSetRunBackSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_SWIM_SPEED, MoveSetSwimSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_SWIM_BACK_SPEED, MoveSetSwimBackSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_TURN_RATE, MoveSetTurnRate) \
+    SEQUENCE(SMSG_MOVE_SET_FLIGHT_SPEED, MoveSetFlightSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_FLIGHT_BACK_SPEED, MoveSetFlightBackSpeed) \
+    SEQUENCE(SMSG_MOVE_SET_PITCH_RATE, MoveSetPitchRate) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_WALK_MODE, SplineMoveSetWalkMode) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_RUN_MODE, SplineMoveSetRunMode) \
+    SEQUENCE(SMSG_SPLINE_MOVE_GRAVITY_DISABLE, SplineMoveGravityDisable) \
+    SEQUENCE(SMSG_SPLINE_MOVE_GRAVITY_ENABLE, SplineMoveGravityEnable) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_HOVER, SplineMoveSetHover) \
+    SEQUENCE(SMSG_SPLINE_MOVE_UNSET_HOVER, SplineMoveUnsetHover) \
+    SEQUENCE(SMSG_SPLINE_MOVE_START_SWIM, SplineMoveStartSwim) \
+    SEQUENCE(SMSG_SPLINE_MOVE_STOP_SWIM, SplineMoveStopSwim) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_FLYING, SplineMoveSetFlying) \
+    SEQUENCE(SMSG_SPLINE_MOVE_UNSET_FLYING, SplineMoveUnsetFlying) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_WATER_WALK, SplineMoveSetWaterWalk) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_LAND_WALK, SplineMoveSetLandWalk) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_FEATHER_FALL, SplineMoveSetFeatherFall) \
+    SEQUENCE(SMSG_SPLINE_MOVE_SET_NORMAL_FALL, SplineMoveSetNormalFall) \
+    SEQUENCE(SMSG_SPLINE_MOVE_ROOT, SplineMoveRoot) \
+    SEQUENCE(SMSG_SPLINE_MOVE_UNROOT, SplineMoveUnRoot) \
+    SEQUENCE(SMSG_MOVE_SET_CAN_FLY, MoveSetCanFly) \
+    SEQUENCE(SMSG_MOVE_UNSET_CAN_FLY, MoveUnsetCanFly) \
+    SEQUENCE(SMSG_MOVE_SET_HOVER, MoveSetHover) \
+    SEQUENCE(SMSG_MOVE_UNSET_HOVER, MoveUnsetHover) \
+    SEQUENCE(SMSG_MOVE_WATER_WALK, MoveWaterWalk) \
+    SEQUENCE(SMSG_MOVE_LAND_WALK, MoveLandWalk) \
+    SEQUENCE(SMSG_MOVE_FEATHER_FALL, MoveFeatherFall) \
+    SEQUENCE(SMSG_MOVE_NORMAL_FALL, MoveNormalFall) \
+    SEQUENCE(SMSG_MOVE_ROOT, MoveRoot) \
+    SEQUENCE(SMSG_MOVE_UNROOT, MoveUnRoot) \
+    SEQUENCE(CMSG_MOVE_FORCE_SWIM_BACK_SPEED_CHANGE_ACK, MoveForceSwimBackSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_TURN_RATE_CHANGE_ACK, MoveForceTurnRateSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_FLIGHT_BACK_SPEED_CHANGE_ACK, MoveForceFlightBackSpeedChangeAck) \
+    SEQUENCE(CMSG_MOVE_FORCE_PITCH_RATE_CHANGE_ACK, MoveForcePitchRateChangeAck) \
+    SEQUENCE(SMSG_MOVE_UPDATE_SWIM_BACK_SPEED, MoveUpdateSwimBackSpeed) \
+    SEQUENCE(SMSG_MOVE_GRAVITY_DISABLE, MoveGravityDisable) \
+    SEQUENCE(SMSG_MOVE_GRAVITY_ENABLE, MoveGravityEnable)
+
 MovementStatusElements const* GetMovementStatusElementsSequence(Opcodes opcode)
 {
     switch (opcode)
     {
-        case MSG_MOVE_FALL_LAND:
-            return MovementFallLandSequence;
-        case MSG_MOVE_HEARTBEAT:
-            return MovementHeartBeatSequence;
-        case MSG_MOVE_JUMP:
-            return MovementJumpSequence;
-        case MSG_MOVE_SET_FACING:
-            return MovementSetFacingSequence;
-        case MSG_MOVE_SET_PITCH:
-            return MovementSetPitchSequence;
-        case MSG_MOVE_START_ASCEND:
-            return MovementStartAscendSequence;
-        case MSG_MOVE_START_BACKWARD:
-            return MovementStartBackwardSequence;
-        case MSG_MOVE_START_DESCEND:
-            return MovementStartDescendSequence;
-        case MSG_MOVE_START_FORWARD:
-            return MovementStartForwardSequence;
-        case MSG_MOVE_START_PITCH_DOWN:
-            return MovementStartPitchDownSequence;
-        case MSG_MOVE_START_PITCH_UP:
-            return MovementStartPitchUpSequence;
-        case MSG_MOVE_START_STRAFE_LEFT:
-            return MovementStartStrafeLeftSequence;
-        case MSG_MOVE_START_STRAFE_RIGHT:
-            return MovementStartStrafeRightSequence;
-        case SMSG_MOVE_START_SWIM:
-            return MovementStartSwimSequence;
-        case MSG_MOVE_START_TURN_LEFT:
-            return MovementStartTurnLeftSequence;
-        case MSG_MOVE_START_TURN_RIGHT:
-            return MovementStartTurnRightSequence;
-        case MSG_MOVE_STOP:
-            return MovementStopSequence;
-        case MSG_MOVE_STOP_ASCEND:
-            return MovementStopAscendSequence;
-        case MSG_MOVE_STOP_PITCH:
-            return MovementStopPitchSequence;
-        case MSG_MOVE_STOP_STRAFE:
-            return MovementStopStrafeSequence;
-        case SMSG_MOVE_STOP_SWIM:
-            return MovementStopSwimSequence;
-        case MSG_MOVE_STOP_TURN:
-            return MovementStopTurnSequence;
-        case SMSG_PLAYER_MOVE:
-            return PlayerMoveSequence;
-        case CMSG_MOVE_CHNG_TRANSPORT:
-            return MoveChngTransport;
-        case CMSG_MOVE_SPLINE_DONE:
-            return MoveSplineDone;
-        case CMSG_MOVE_NOT_ACTIVE_MOVER:
-            return MoveNotActiveMover;
-        case CMSG_DISMISS_CONTROLLED_VEHICLE:
-            return DismissControlledVehicle;
-        case SMSG_MOVE_UPDATE_TELEPORT:
-            return MoveUpdateTeleport;
-        case CMSG_FORCE_MOVE_ROOT_ACK:
-            return ForceMoveRootAck;
-        case CMSG_FORCE_MOVE_UNROOT_ACK:
-            return ForceMoveUnrootAck;
-        // case CMSG_MOVE_FALL_RESET:
-        //     return MovementFallReset;
-        case CMSG_MOVE_FEATHER_FALL_ACK:
-            return MovementFeatherFallAck;
-        case CMSG_MOVE_FORCE_FLIGHT_SPEED_CHANGE_ACK:
-            return MovementForceFlightSpeedChangeAck;
-        case CMSG_MOVE_FORCE_RUN_BACK_SPEED_CHANGE_ACK:
-            return MovementForceRunBackSpeedChangeAck;
-        case CMSG_MOVE_FORCE_RUN_SPEED_CHANGE_ACK:
-            return MovementForceRunSpeedChangeAck;
-        case CMSG_MOVE_FORCE_SWIM_SPEED_CHANGE_ACK:
-            return MovementForceSwimSpeedChangeAck;
-        case CMSG_MOVE_FORCE_WALK_SPEED_CHANGE_ACK:
-            return MovementForceWalkSpeedChangeAck;
-        case CMSG_MOVE_GRAVITY_DISABLE_ACK:
-            return MovementGravityDisableAck;
-        case CMSG_MOVE_GRAVITY_ENABLE_ACK:
-            return MovementGravityEnableAck;
-        case CMSG_MOVE_HOVER_ACK:
-            return MovementHoverAck;
-        // case CMSG_MOVE_KNOCK_BACK_ACK:
-        //     return MovementKnockBackAck;
-        // case CMSG_MOVE_SET_CAN_FLY:
-        //     return MovementSetCanFly;
-        case CMSG_MOVE_SET_CAN_FLY_ACK:
-            return MovementSetCanFlyAck;
-        // case CMSG_MOVE_SET_CAN_TRANSITION_BETWEEN_SWIM_AND_FLY_ACK:
-        //     return MovementSetCanTransitionBetweenSwimAndFlyAck;
-        case SMSG_MOVE_SET_COLLISION_HEIGHT:
-            return MoveSetCollisionHeight;
-        case CMSG_MOVE_SET_COLLISION_HEIGHT_ACK:
-            return MovementSetCollisionHeightAck;
-        case SMSG_MOVE_UPDATE_COLLISION_HEIGHT:
-            return MovementUpdateCollisionHeight;
-        case CMSG_MOVE_WATER_WALK_ACK:
-            return MovementWaterWalkAck;
-        case SMSG_MOVE_SET_RUN_MODE:
-            return MovementSetRunMode;
-        case SMSG_MOVE_SET_WALK_MODE:
-            return MovementSetWalkMode;
-        case SMSG_MOVE_UPDATE_FLIGHT_SPEED:
-            return MovementUpdateFlightSpeed;
-        case SMSG_MOVE_UPDATE_RUN_SPEED:
-            return MovementUpdateRunSpeed;
-        // case SMSG_MOVE_UPDATE_KNOCK_BACK:
-        //     return MovementUpdateKnockBack;
-        case SMSG_MOVE_UPDATE_RUN_BACK_SPEED:
-            return MovementUpdateRunBackSpeed;
-        case SMSG_MOVE_UPDATE_SWIM_SPEED:
-            return MovementUpdateSwimSpeed;
-        case SMSG_MOVE_UPDATE_WALK_SPEED:
-            return MovementUpdateWalkSpeed;
-        case SMSG_SPLINE_MOVE_SET_WALK_SPEED:
-            return SplineMoveSetWalkSpeed;
-        case SMSG_SPLINE_MOVE_SET_RUN_SPEED:
-            return SplineMoveSetRunSpeed;
-        case SMSG_SPLINE_MOVE_SET_RUN_BACK_SPEED:
-            return SplineMoveSetRunBackSpeed;
-        case SMSG_SPLINE_MOVE_SET_SWIM_SPEED:
-            return SplineMoveSetSwimSpeed;
-        case SMSG_SPLINE_MOVE_SET_SWIM_BACK_SPEED:
-            return SplineMoveSetSwimBackSpeed;
-        case SMSG_SPLINE_MOVE_SET_TURN_RATE:
-            return SplineMoveSetTurnRate;
-        case SMSG_SPLINE_MOVE_SET_FLIGHT_SPEED:
-            return SplineMoveSetFlightSpeed;
-        case SMSG_SPLINE_MOVE_SET_FLIGHT_BACK_SPEED:
-            return SplineMoveSetFlightBackSpeed;
-        case SMSG_SPLINE_MOVE_SET_PITCH_RATE:
-            return SplineMoveSetPitchRate;
-        case SMSG_MOVE_SET_WALK_SPEED:
-            return MoveSetWalkSpeed;
-        case SMSG_MOVE_SET_RUN_SPEED:
-            return MoveSetRunSpeed;
-        case SMSG_MOVE_SET_RUN_BACK_SPEED:
-            return MoveSetRunBackSpeed;
-        case SMSG_MOVE_SET_SWIM_SPEED:
-            return MoveSetSwimSpeed;
-        case SMSG_MOVE_SET_SWIM_BACK_SPEED:
-            return MoveSetSwimBackSpeed;
-        case SMSG_MOVE_SET_TURN_RATE:
-            return MoveSetTurnRate;
-        case SMSG_MOVE_SET_FLIGHT_SPEED:
-            return MoveSetFlightSpeed;
-        case SMSG_MOVE_SET_FLIGHT_BACK_SPEED:
-            return MoveSetFlightBackSpeed;
-        case SMSG_MOVE_SET_PITCH_RATE:
-            return MoveSetPitchRate;
-        case SMSG_SPLINE_MOVE_SET_WALK_MODE:
-            return SplineMoveSetWalkMode;
-        case SMSG_SPLINE_MOVE_SET_RUN_MODE:
-            return SplineMoveSetRunMode;
-        case SMSG_SPLINE_MOVE_GRAVITY_DISABLE:
-            return SplineMoveGravityDisable;
-        case SMSG_SPLINE_MOVE_GRAVITY_ENABLE:
-            return SplineMoveGravityEnable;
-        case SMSG_SPLINE_MOVE_SET_HOVER:
-            return SplineMoveSetHover;
-        case SMSG_SPLINE_MOVE_UNSET_HOVER:
-            return SplineMoveUnsetHover;
-        case SMSG_SPLINE_MOVE_START_SWIM:
-            return SplineMoveStartSwim;
-        case SMSG_SPLINE_MOVE_STOP_SWIM:
-            return SplineMoveStopSwim;
-        case SMSG_SPLINE_MOVE_SET_FLYING:
-            return SplineMoveSetFlying;
-        case SMSG_SPLINE_MOVE_UNSET_FLYING:
-            return SplineMoveUnsetFlying;
-        case SMSG_SPLINE_MOVE_SET_WATER_WALK:
-            return SplineMoveSetWaterWalk;
-        case SMSG_SPLINE_MOVE_SET_LAND_WALK:
-            return SplineMoveSetLandWalk;
-        case SMSG_SPLINE_MOVE_SET_FEATHER_FALL:
-            return SplineMoveSetFeatherFall;
-        case SMSG_SPLINE_MOVE_SET_NORMAL_FALL:
-            return SplineMoveSetNormalFall;
-        case SMSG_SPLINE_MOVE_ROOT:
-            return SplineMoveRoot;
-        case SMSG_SPLINE_MOVE_UNROOT:
-            return SplineMoveUnRoot;
-        case SMSG_MOVE_SET_CAN_FLY:
-            return MoveSetCanFly;
-        case SMSG_MOVE_UNSET_CAN_FLY:
-            return MoveUnsetCanFly;
-        case SMSG_MOVE_SET_HOVER:
-            return MoveSetHover;
-        case SMSG_MOVE_UNSET_HOVER:
-            return MoveUnsetHover;
-        case SMSG_MOVE_WATER_WALK:
-            return MoveWaterWalk;
-        case SMSG_MOVE_LAND_WALK:
-            return MoveLandWalk;
-        case SMSG_MOVE_FEATHER_FALL:
-            return MoveFeatherFall;
-        case SMSG_MOVE_NORMAL_FALL:
-            return MoveNormalFall;
-        case SMSG_MOVE_ROOT:
-            return MoveRoot;
-        case SMSG_MOVE_UNROOT:
-            return MoveUnRoot;
-        // case CMSG_CHANGE_SEATS_ON_CONTROLLED_VEHICLE:
-        //     return ChangeSeatsOnControlledVehicle;
-        // case CMSG_CAST_SPELL:
-        // case CMSG_PET_CAST_SPELL:
-        // case CMSG_USE_ITEM:
-        //     return CastSpellEmbeddedMovement;
-
-        case CMSG_MOVE_FORCE_SWIM_BACK_SPEED_CHANGE_ACK:
-            return MoveForceSwimBackSpeedChangeAck;
-        case CMSG_MOVE_FORCE_TURN_RATE_CHANGE_ACK:
-            return MoveForceTurnRateSpeedChangeAck;
-        case CMSG_MOVE_FORCE_FLIGHT_BACK_SPEED_CHANGE_ACK:
-            return MoveForceFlightBackSpeedChangeAck;
-        case CMSG_MOVE_FORCE_PITCH_RATE_CHANGE_ACK:
-            return MoveForcePitchRateChangeAck;
-        case SMSG_MOVE_UPDATE_SWIM_BACK_SPEED:
-            return MoveUpdateSwimBackSpeed;
-        case SMSG_MOVE_GRAVITY_DISABLE:
-            return MoveGravityDisable;
-        case SMSG_MOVE_GRAVITY_ENABLE:
-            return MoveGravityEnable;
+#define MOVEMENT_SEQUENCE_CASE(opcode, sequence) \
+        case opcode: \
+            return sequence;
+        MOVEMENT_SEQUENCES(MOVEMENT_SEQUENCE_CASE)
+#undef MOVEMENT_SEQUENCE_CASE
+        default:
+            break;
+    }
+
+    return NULL;
+}
+
+MovementCodec const* GetMovementCodec(Opcodes opcode)
+{
+    switch (opcode)
+    {
+#define MOVEMENT_CODEC_CASE(opcode, sequence) \
+        case opcode: \
+        { \
+            static MovementCodec const codec = { &Movement::ReadMovement<sequence>, &Movement::WriteMovement<sequence> }; \
+            return &codec; \
+        }
+        MOVEMENT_SEQUENCES(MOVEMENT_CODEC_CASE)
+#undef MOVEMENT_CODEC_CASE
         default:
             break;
     }
 
     return NULL;
-}
\ No newline at end of file
+}
+
+static uint64 RandomGuid()
+{
+    // zero bytes are skipped by the packed guid, both cases have to be covered
+    uint64 guid = 0;
+    for (uint8 i = 0; i < 8; ++i)
+        if (urand(0, 1))
+            guid |= uint64(urand(1, 0xFF)) << (i * 8);
+    return guid;
+}
+
+static float RandomOptional()
+{
+    return urand(0, 1) ? frand(-100.0f, 100.0f) : 0.0f;
+}
+
+static void RandomizeMovement(MovementInfo& info)
+{
+    info.guid = RandomGuid();
+    info.flags = urand(0, 1) ? urand(0, (1 << 30) - 1) : 0;
+    info.flags2 = urand(0, 1) ? uint16(urand(0, (1 << 12) - 1)) : 0;
+    info.time = urand(0, 1) ? urand(1, 0xFFFFFFF) : 0;
+    info.pos.Relocate(frand(-10000.0f, 10000.0f), frand(-10000.0f, 10000.0f), frand(-500.0f, 500.0f));
+    info.pos.m_orientation = urand(0, 1) ? frand(0.0f, 6.0f) : 0.0f;
+    info.t_guid = urand(0, 1) ? RandomGuid() : 0;
+    info.t_pos.Relocate(frand(-50.0f, 50.0f), frand(-50.0f, 50.0f), frand(-50.0f, 50.0f), frand(0.0f, 6.0f));
+    info.t_seat = int8(urand(0, 7));
+    info.t_time = urand(0, 0xFFFFFFF);
+    info.t_time2 = urand(0, 1) ? urand(1, 0xFFFFFFF) : 0;
+    info.t_time3 = urand(0, 1) ? urand(1, 0xFFFFFFF) : 0;
+    info.pitch = RandomOptional();
+    info.fallTime = urand(0, 1) ? urand(1, 10000) : 0;
+    info.j_zspeed = RandomOptional();
+    info.j_cosAngle = RandomOptional();
+    info.j_sinAngle = RandomOptional();
+    info.j_xyspeed = RandomOptional();
+    info.hasSpline = urand(0, 1);
+    info.splineElevation = RandomOptional();
+    info.ackCount = urand(0, 1000);
+    info.ackSpeed = frand(0.0f, 50.0f);
+    info.height = frand(0.0f, 5.0f);
+}
+
+static bool IsSameMovement(MovementInfo const& a, MovementInfo const& b)
+{
+    return a.guid == b.guid && a.flags == b.flags && a.flags2 == b.flags2 && a.time == b.time &&
+        a.pos.m_positionX == b.pos.m_positionX && a.pos.m_positionY == b.pos.m_positionY && a.pos.m_positionZ == b.pos.m_positionZ && a.pos.m_orientation == b.pos.m_orientation &&
+        a.t_guid == b.t_guid && a.t_pos.m_positionX == b.t_pos.m_positionX && a.t_pos.m_positionY == b.t_pos.m_positionY && a.t_pos.m_positionZ == b.t_pos.m_positionZ &&
+        a.t_pos.m_orientation == b.t_pos.m_orientation && a.t_seat == b.t_seat && a.t_time == b.t_time && a.t_time2 == b.t_time2 && a.t_time3 == b.t_time3 &&
+        a.pitch == b.pitch && a.fallTime == b.fallTime && a.j_zspeed == b.j_zspeed && a.j_cosAngle == b.j_cosAngle && a.j_sinAngle == b.j_sinAngle &&
+        a.j_xyspeed == b.j_xyspeed && a.hasSpline == b.hasSpline && a.splineElevation == b.splineElevation && a.ackCount == b.ackCount &&
+        a.ackSpeed == b.ackSpeed && a.height == b.height;
+}
+
+static bool CheckMovementCodec(Opcodes opcode, MovementCodec const* codec, MovementInfo& info)
+{
+    WorldPacket expected(opcode);
+    info.Write_OLD(expected);
+
+    WorldPacket written(opcode);
+    codec->Write(info, written);
+
+    if (written.size() != expected.size() || (expected.size() && memcmp(written.contents(), expected.contents(), expected.size())))
+        return false;
+
+    MovementInfo expectedInfo;
+    expectedInfo.Read_OLD(expected);
+
+    MovementInfo readInfo;
+    codec->Read(readInfo, written);
+
+    return written.rpos() == expected.rpos() && IsSameMovement(readInfo, expectedInfo);
+}
+
+uint32 CheckMovementCodecs(uint32 iterations, std::string& firstMismatch)
+{
+    uint32 mismatches = 0;
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        MovementInfo info;
+        RandomizeMovement(info);
+
+#define MOVEMENT_CHECK_CASE(opcode, sequence) \
+        if (!CheckMovementCodec(opcode, GetMovementCodec(opcode), info) && !mismatches++) \
+            firstMismatch = GetOpcodeNameForLogging(opcode);
+        MOVEMENT_SEQUENCES(MOVEMENT_CHECK_CASE)
+#undef MOVEMENT_CHECK_CASE
+    }
+
+    return mismatches;
+}
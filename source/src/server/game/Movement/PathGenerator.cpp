@@ -26,12 +26,107 @@
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
 
+#include <ace/TSS_T.h>
+#include <atomic>
+
+////////////////// Path cache //////////////////
+// Corridors are cached per thread by their start and end poly, chasing units
+// of one map mostly search the same few polys. Cached corridors belong to a
+// navmesh generation and are dropped once a tile of the map is (un)loaded.
+#define PATH_CACHE_SIZE 512
+
+struct PathCacheEntry
+{
+    uint32 MapId;
+    uint32 Generation;                                      // 0 while the slot is unused
+    dtPolyRef StartPoly;
+    dtPolyRef EndPoly;
+    uint16 IncludeFlags;
+    uint16 ExcludeFlags;
+    uint32 MaxLength;                                       // limit of the search, a corridor may have been cut there
+    dtStatus Status;
+    uint32 Length;
+    dtPolyRef Path[MAX_PATH_LENGTH];
+};
+
+struct NavMeshQuerySlot
+{
+    dtNavMesh const* NavMesh;
+    dtNavMeshQuery* Query;
+};
+
+static std::atomic<uint64> pathCacheHits(0);
+static std::atomic<uint64> pathCacheMisses(0);
+static std::atomic<uint64> pathRepairs(0);
+static std::atomic<uint32> navMeshQueriesCreated(0);
+
+// dtNavMeshQuery is not thread safe, every map update thread keeps one per map
+class PathfindingContext
+{
+    public:
+        PathfindingContext() : _paths(PATH_CACHE_SIZE) { }
+
+        ~PathfindingContext()
+        {
+            for (UNORDERED_MAP<uint32, NavMeshQuerySlot>::iterator itr = _queries.begin(); itr != _queries.end(); ++itr)
+                dtFreeNavMeshQuery(itr->second.Query);
+        }
+
+        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, dtNavMesh const* navMesh)
+        {
+            NavMeshQuerySlot& slot = _queries[mapId];
+            if (slot.NavMesh == navMesh)
+                return slot.Query;
+
+            if (!slot.Query)
+            {
+                slot.Query = dtAllocNavMeshQuery();
+                ASSERT(slot.Query);
+                ++navMeshQueriesCreated;
+            }
+
+            // the map was reloaded, the query is bound to the new navmesh
+            if (dtStatusFailed(slot.Query->init(navMesh, 1024)))
+            {
+                TC_LOG_ERROR("maps", "PathGenerator: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+                slot.NavMesh = NULL;
+                return NULL;
+            }
+
+            slot.NavMesh = navMesh;
+            return slot.Query;
+        }
+
+        PathCacheEntry& GetPath(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly)
+        {
+            uint64 hash = (startPoly * UI64LIT(0x9E3779B97F4A7C15)) ^ (endPoly * UI64LIT(0xC2B2AE3D27D4EB4F)) ^ mapId;
+            return _paths[(hash ^ (hash >> 32)) % PATH_CACHE_SIZE];
+        }
+
+    private:
+        UNORDERED_MAP<uint32, NavMeshQuerySlot> _queries;   // mapId to query
+        std::vector<PathCacheEntry> _paths;
+};
+
+typedef ACE_TSS<PathfindingContext> PathfindingContextTSS;
+static PathfindingContextTSS pathfindingContext;
+
+PathCacheStats PathGenerator::GetCacheStats()
+{
+    PathCacheStats stats;
+    stats.Hits = pathCacheHits.load(std::memory_order_relaxed);
+    stats.Misses = pathCacheMisses.load(std::memory_order_relaxed);
+    stats.Repairs = pathRepairs.load(std::memory_order_relaxed);
+    stats.Queries = navMeshQueriesCreated.load(std::memory_order_relaxed);
+    return stats;
+}
+
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(const Unit* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
     _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
-    _navMeshQuery(NULL)
+    _navMeshQuery(NULL), _navMeshGeneration(0)
 {
     TC_LOG_DEBUG("maps", "++ PathGenerator::PathGenerator for %u \n", _sourceUnit->GetGUIDLow());
 
@@ -51,7 +146,6 @@ PathGenerator::PathGenerator(const Unit* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _sourceUnit->GetInstanceId());
     }
 
     CreateFilter();
@@ -88,6 +182,21 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     TC_LOG_DEBUG("maps", "++ PathGenerator::CalculatePath() for %u \n", _sourceUnit->GetGUIDLow());
 
+    // a generator may be used by different map threads over its lifetime, the query is picked per call
+    if (_navMesh)
+    {
+        uint32 mapId = _sourceUnit->GetMapId();
+        _navMeshQuery = pathfindingContext->GetNavMeshQuery(mapId, _navMesh);
+
+        uint32 generation = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshGeneration(mapId);
+        if (generation != _navMeshGeneration)
+        {
+            // tiles were (un)loaded, poly refs of the previous path may be gone
+            _navMeshGeneration = generation;
+            _polyLength = 0;
+        }
+    }
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     if (!_navMesh || !_navMeshQuery || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) ||
@@ -393,17 +502,18 @@ void PathGenerator::BuildPolyPath(Vector3 const& startPos, Vector3 const& endPos
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             suffixStartPoly,    // start polygon
                             endPoly,            // end polygon
                             suffixEndPoint,     // start position
                             endPoint,           // end position
-                            &_filter,            // polygon search filter
                             _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
+                            &suffixPolyLength,
                             MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
         }
 
+        ++pathRepairs;
+
         if (!suffixPolyLength || dtStatusFailed(dtResult))
         {
             // this is probably an error state, but we'll leave it
@@ -456,14 +566,13 @@ void PathGenerator::BuildPolyPath(Vector3 const& startPos, Vector3 const& endPos
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                             startPoly,          // start polygon
                             endPoly,            // end polygon
                             startPoint,         // start position
                             endPoint,           // end position
-                            &_filter,           // polygon search filter
                             _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
+                            &_polyLength,
                             MAX_PATH_LENGTH);   // max number of polygons in output path
         }
 
@@ -487,6 +596,45 @@ void PathGenerator::BuildPolyPath(Vector3 const& startPos, Vector3 const& endPos
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                                     dtPolyRef* path, uint32* pathSize, uint32 maxPathSize)
+{
+    uint32 mapId = _sourceUnit->GetMapId();
+    PathCacheEntry& entry = pathfindingContext->GetPath(mapId, startPoly, endPoly);
+
+    // any corridor between both polys will do, the point path is smoothed from the actual positions.
+    // One cut at its limit only serves searches with the same limit
+    bool truncated = dtStatusDetail(entry.Status, DT_BUFFER_TOO_SMALL);
+    if (entry.Generation == _navMeshGeneration && entry.MapId == mapId && entry.StartPoly == startPoly && entry.EndPoly == endPoly &&
+        entry.IncludeFlags == _filter.getIncludeFlags() && entry.ExcludeFlags == _filter.getExcludeFlags() && entry.Length <= maxPathSize &&
+        (!truncated || entry.MaxLength == maxPathSize))
+    {
+        ++pathCacheHits;
+        memcpy(path, entry.Path, entry.Length * sizeof(dtPolyRef));
+        *pathSize = entry.Length;
+        return entry.Status;
+    }
+
+    ++pathCacheMisses;
+
+    dtStatus dtResult = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, (int*)pathSize, maxPathSize);
+    if (dtStatusSucceed(dtResult) && *pathSize)
+    {
+        entry.MapId = mapId;
+        entry.Generation = _navMeshGeneration;
+        entry.StartPoly = startPoly;
+        entry.EndPoly = endPoly;
+        entry.IncludeFlags = _filter.getIncludeFlags();
+        entry.ExcludeFlags = _filter.getExcludeFlags();
+        entry.MaxLength = maxPathSize;
+        entry.Status = dtResult;
+        entry.Length = *pathSize;
+        memcpy(entry.Path, path, *pathSize * sizeof(dtPolyRef));
+    }
+
+    return dtResult;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
@@ -52,6 +52,14 @@ enum PathType
     PATHFIND_SHORT          = 0x20,   // path is longer or equal to its limited path length
 };
 
+struct PathCacheStats
+{
+    uint64 Hits;
+    uint64 Misses;
+    uint64 Repairs;         // corridors extended from the previous path instead of searched again
+    uint32 Queries;         // dtNavMeshQuery objects allocated by all threads
+};
+
 class PathGenerator
 {
     public:
@@ -91,6 +99,8 @@ class PathGenerator
 
         void ReducePathLenghtByDist(float dist); // path must be already built
 
+        static PathCacheStats GetCacheStats();
+
     private:
 
         dtPolyRef      _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
@@ -110,7 +120,8 @@ class PathGenerator
 
         Unit const* const       _sourceUnit;       // the unit that is moving
         dtNavMesh const*        _navMesh;          // the nav mesh
-        dtNavMeshQuery const*   _navMeshQuery;     // the nav mesh query used to find the path
+        dtNavMeshQuery const*   _navMeshQuery;     // the nav mesh query of the calculating thread
+        uint32                  _navMeshGeneration;
 
         dtQueryFilter _filter;                     // use single filter for all movements, update it when needed
 
@@ -134,6 +145,8 @@ class PathGenerator
         bool HaveTile(Vector3 const& p) const;
 
         void BuildPolyPath(Vector3 const& startPos, Vector3 const& endPos);
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint,
+                              dtPolyRef* path, uint32* pathSize, uint32 maxPathSize);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
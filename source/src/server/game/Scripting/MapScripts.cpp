@@ -45,6 +45,7 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
     uint64 ownerGUID  = (source && source->GetTypeId() == TYPEID_ITEM) ? ((Item*)source)->GetOwnerGUID() : uint64(0);
 
     ///- Schedule script execution for all scripts in the script map
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     ScriptMap const* s2 = &(s->second);
     bool immedScript = false;
     for (ScriptMap::const_iterator iter = s2->begin(); iter != s2->end(); ++iter)
@@ -62,7 +63,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sScriptMgr->IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !i_scriptLock)
+    ///- while regions update in parallel they wait for the serialized script step of Map::Update
+    if (/*start &&*/ immedScript && !i_scriptLock && !_regionUpdateInProgress)
     {
         i_scriptLock = true;
         ScriptsProcess();
@@ -85,12 +87,13 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID  = ownerGUID;
 
     sa.script = &script;
+    TRINITY_GUARD(ACE_Recursive_Thread_Mutex, _regionLock);
     m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld->GetGameTime() + delay), sa));
 
     sScriptMgr->IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !i_scriptLock)
+    if (delay == 0 && !i_scriptLock && !_regionUpdateInProgress)
     {
         i_scriptLock = true;
         ScriptsProcess();
@@ -33,6 +33,7 @@
 #include "Player.h"
 #include "WorldPacket.h"
 #include "Chat.h"
+#include "TickProfiler.h"
 
 // This is the global static registry of scripts.
 template<class TScript>
@@ -163,7 +164,7 @@ class ScriptRegistry
 
 
 ScriptMgr::ScriptMgr()
-    : _scriptCount(0), _scheduledScripts(0)
+    : _scriptCount(0), _scheduledScripts(0), _serverPacketHooks(SERVER_HOOK_PACKET_ALL)
 {
 }
 
@@ -401,25 +402,53 @@ void ScriptMgr::OnSocketClose(WorldSocket* socket, bool wasNew)
     FOREACH_SCRIPT(ServerScript)->OnSocketClose(socket, wasNew);
 }
 
-void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketReceive(socket, packet);
+    if (!(_serverPacketHooks.value() & SERVER_HOOK_PACKET_RECEIVE))
+        return;
+
+    PROFILE_SCOPE("ScriptMgr::OnPacketReceive");
+    FOR_SCRIPTS(ServerScript, itr, end)
+        if (itr->second->IsPacketHookUsed(SERVER_HOOK_PACKET_RECEIVE))
+            itr->second->OnPacketReceive(socket, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, packet);
+    if (!(_serverPacketHooks.value() & SERVER_HOOK_PACKET_SEND))
+        return;
+
+    PROFILE_SCOPE("ScriptMgr::OnPacketSend");
+    FOR_SCRIPTS(ServerScript, itr, end)
+        if (itr->second->IsPacketHookUsed(SERVER_HOOK_PACKET_SEND))
+            itr->second->OnPacketSend(socket, packet);
 }
 
-void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnUnknownPacketReceive(socket, packet);
+    if (!(_serverPacketHooks.value() & SERVER_HOOK_UNKNOWN_PACKET_RECEIVE))
+        return;
+
+    FOR_SCRIPTS(ServerScript, itr, end)
+        if (itr->second->IsPacketHookUsed(SERVER_HOOK_UNKNOWN_PACKET_RECEIVE))
+            itr->second->OnUnknownPacketReceive(socket, packet);
+}
+
+void ScriptMgr::UpdateServerPacketHooks()
+{
+    long hooks = 0;
+    for (SCR_REG_ITR(ServerScript) itr = SCR_REG_LST(ServerScript).begin(); itr != SCR_REG_LST(ServerScript).end(); ++itr)
+        for (long hook = SERVER_HOOK_PACKET_SEND; hook <= SERVER_HOOK_UNKNOWN_PACKET_RECEIVE; hook <<= 1)
+            if (itr->second->IsPacketHookUsed(ServerPacketHook(hook)))
+                hooks |= hook;
+
+    _serverPacketHooks = hooks;
 }
 
 void ScriptMgr::OnOpenStateChange(bool open)
@@ -449,6 +478,7 @@ void ScriptMgr::OnShutdownCancel()
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
+    PROFILE_SCOPE("ScriptMgr::OnWorldUpdate");
     FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
 }
 
@@ -617,6 +647,8 @@ void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 {
     ASSERT(map);
 
+    PROFILE_SCOPE("ScriptMgr::OnMapUpdate");
+
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
         itr->second->OnUpdate(map, diff);
     SCR_MAP_END;
@@ -871,6 +903,7 @@ void ScriptMgr::OnCreatureUpdate(Creature* creature, uint32 diff)
     ASSERT(creature);
 
     GET_SCRIPT(CreatureScript, creature->GetScriptId(), tmpscript);
+    PROFILE_SCOPE("ScriptMgr::OnCreatureUpdate");
     tmpscript->OnUpdate(creature, diff);
 }
 
@@ -1000,6 +1033,7 @@ void ScriptMgr::OnGameObjectUpdate(GameObject* go, uint32 diff)
     ASSERT(go);
 
     GET_SCRIPT(GameObjectScript, go->GetScriptId(), tmpscript);
+    PROFILE_SCOPE("ScriptMgr::OnGameObjectUpdate");
     tmpscript->OnUpdate(go, diff);
 }
 
@@ -1524,11 +1558,24 @@ SpellScriptLoader::SpellScriptLoader(const char* name)
 }
 
 ServerScript::ServerScript(const char* name)
-    : ScriptObject(name)
+    : ScriptObject(name), _unusedPacketHooks(0)
 {
     ScriptRegistry<ServerScript>::AddScript(this);
 }
 
+void ServerScript::SetPacketHookUnused(ServerPacketHook hook)
+{
+    // packet hooks run on network and map threads at once
+    static ACE_Thread_Mutex lock;
+    TRINITY_GUARD(ACE_Thread_Mutex, lock);
+
+    if (_unusedPacketHooks.value() & hook)
+        return;
+
+    _unusedPacketHooks = _unusedPacketHooks.value() | hook;
+    sScriptMgr->UpdateServerPacketHooks();
+}
+
 WorldScript::WorldScript(const char* name)
     : ScriptObject(name)
 {
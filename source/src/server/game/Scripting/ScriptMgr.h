@@ -205,6 +205,16 @@ class SpellScriptLoader : public ScriptObject
         virtual AuraScript* GetAuraScript() const { return NULL; }
 };
 
+// Packet hooks of ServerScript, dispatch of a hook is skipped while no script overrides it
+enum ServerPacketHook
+{
+    SERVER_HOOK_PACKET_SEND             = 0x01,
+    SERVER_HOOK_PACKET_RECEIVE          = 0x02,
+    SERVER_HOOK_UNKNOWN_PACKET_RECEIVE  = 0x04,
+
+    SERVER_HOOK_PACKET_ALL              = SERVER_HOOK_PACKET_SEND | SERVER_HOOK_PACKET_RECEIVE | SERVER_HOOK_UNKNOWN_PACKET_RECEIVE
+};
+
 class ServerScript : public ScriptObject
 {
     protected:
@@ -226,17 +236,26 @@ class ServerScript : public ScriptObject
         // being open; it is not.
         virtual void OnSocketClose(WorldSocket* /*socket*/, bool /*wasNew*/) { }
 
-        // Called when a packet is sent to a client. The packet object is a copy of the original packet, so reading
-        // and modifying it is safe.
-        virtual void OnPacketSend(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+        // Called when a packet is sent to a client. The packet is the original packet, not a copy; copy it to read
+        // from it, and do not store the reference.
+        virtual void OnPacketSend(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { SetPacketHookUnused(SERVER_HOOK_PACKET_SEND); }
+
+        // Called when a (valid) packet is received by a client. The packet is the original packet, not a copy; copy it
+        // to read from it, and do not store the reference.
+        virtual void OnPacketReceive(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { SetPacketHookUnused(SERVER_HOOK_PACKET_RECEIVE); }
+
+        // Called when an invalid (unknown opcode) packet is received by a client. The packet is the original packet,
+        // not a copy.
+        virtual void OnUnknownPacketReceive(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { SetPacketHookUnused(SERVER_HOOK_UNKNOWN_PACKET_RECEIVE); }
 
-        // Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so
-        // reading and modifying it is safe.
-        virtual void OnPacketReceive(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+        bool IsPacketHookUsed(ServerPacketHook hook) const { return !(_unusedPacketHooks.value() & hook); }
 
-        // Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the orignal
-        // packet; not a copy. This allows you to actually handle unknown packets (for whatever purpose).
-        virtual void OnUnknownPacketReceive(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+    private:
+
+        // The default implementations mark their hook as unused, so a hook is only dispatched to scripts overriding it
+        void SetPacketHookUnused(ServerPacketHook hook);
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _unusedPacketHooks;
 };
 
 class WorldScript : public ScriptObject
@@ -926,9 +945,12 @@ class ScriptMgr
         void OnNetworkStop();
         void OnSocketOpen(WorldSocket* socket);
         void OnSocketClose(WorldSocket* socket, bool wasNew);
-        void OnPacketReceive(WorldSocket* socket, WorldPacket packet);
-        void OnPacketSend(WorldSocket* socket, WorldPacket packet);
-        void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet);
+        void OnPacketReceive(WorldSocket* socket, WorldPacket const& packet);
+        void OnPacketSend(WorldSocket* socket, WorldPacket const& packet);
+        void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket const& packet);
+
+        // Recomputes which packet hooks are overridden by any ServerScript
+        void UpdateServerPacketHooks();
 
     public: /* WorldScript */
 
@@ -1150,6 +1172,9 @@ class ScriptMgr
 
         //atomic op counter for active scripts amount
         ACE_Atomic_Op<ACE_Thread_Mutex, long> _scheduledScripts;
+
+        // ServerPacketHook mask of hooks which may still be overridden by a script
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _serverPacketHooks;
 };
 
 template <class S>
@@ -0,0 +1,83 @@
+#include "LockDomain.h"
+#include "TickProfiler.h"
+
+#include <ace/Thread_Mutex.h>
+
+static char const* const lockDomainNames[MAX_LOCK_DOMAINS] =
+{
+    "Guild",
+    "ArenaTeam",
+    "Auction",
+    "Mail",
+    "Channel",
+    "Calendar",
+    "LFG",
+    "Social",
+    "Item"
+};
+
+static ACE_Thread_Mutex lockDomainMutexes[MAX_LOCK_DOMAINS];
+
+struct LockDomainSections
+{
+    LockDomainSections()
+    {
+        for (uint32 i = 0; i < MAX_LOCK_DOMAINS; ++i)
+        {
+            Hold[i] = sTickProfiler->GetSectionId(std::string("LockDomain::") + lockDomainNames[i]);
+            Wait[i] = sTickProfiler->GetSectionId(std::string("LockDomain::") + lockDomainNames[i] + "::Wait");
+        }
+    }
+
+    uint32 Hold[MAX_LOCK_DOMAINS];
+    uint32 Wait[MAX_LOCK_DOMAINS];
+};
+
+static LockDomainSections const& GetLockDomainSections()
+{
+    static LockDomainSections const sections;
+    return sections;
+}
+
+static inline uint64 GetLockDomainTime()
+{
+    return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+char const* GetLockDomainName(uint32 index)
+{
+    return index < MAX_LOCK_DOMAINS ? lockDomainNames[index] : "";
+}
+
+LockDomainGuard::LockDomainGuard(uint32 domains) : _domains(domains), _lockTime(0)
+{
+    bool profile = sTickProfiler->IsEnabled();
+    for (uint32 i = 0; i < MAX_LOCK_DOMAINS; ++i)
+    {
+        if (!(_domains & (1 << i)))
+            continue;
+
+        // the fixed order keeps handlers with several domains from deadlocking
+        uint64 waitStart = profile ? GetLockDomainTime() : 0;
+        lockDomainMutexes[i].acquire();
+        if (profile)
+        {
+            _lockTime = GetLockDomainTime();
+            sTickProfiler->Record(GetLockDomainSections().Wait[i], uint32(_lockTime - waitStart));
+        }
+    }
+}
+
+LockDomainGuard::~LockDomainGuard()
+{
+    uint64 holdTime = _lockTime ? GetLockDomainTime() - _lockTime : 0;
+    for (uint32 i = MAX_LOCK_DOMAINS; i-- > 0;)
+    {
+        if (!(_domains & (1 << i)))
+            continue;
+
+        lockDomainMutexes[i].release();
+        if (_lockTime)
+            sTickProfiler->Record(GetLockDomainSections().Hold[i], uint32(holdTime));
+    }
+}
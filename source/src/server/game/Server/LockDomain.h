@@ -0,0 +1,44 @@
+#ifndef _LOCK_DOMAIN_H
+#define _LOCK_DOMAIN_H
+
+#include "Define.h"
+
+/**
+ * Subsystems used by thread-unsafe opcode handlers.
+ *
+ * Handlers declaring the domains they use (see OpcodeTable::Initialize()) are
+ * run by the session update threads ahead of the serial part of
+ * World::UpdateSessions(). Handlers sharing a domain are serialized by its
+ * lock, all others run in parallel. Handlers without domains and everything
+ * else of a session update stay serial.
+ */
+enum LockDomain
+{
+    LOCK_DOMAIN_GUILD       = 0x001,                        // guilds, guild bank, guild finder and achievement updates
+    LOCK_DOMAIN_ARENA_TEAM  = 0x002,
+    LOCK_DOMAIN_AUCTION     = 0x004,
+    LOCK_DOMAIN_MAIL        = 0x008,                        // mail ids and the mail lists of online players
+    LOCK_DOMAIN_CHANNEL     = 0x010,
+    LOCK_DOMAIN_CALENDAR    = 0x020,
+    LOCK_DOMAIN_LFG         = 0x040,
+    LOCK_DOMAIN_SOCIAL      = 0x080,                        // friend and ignore lists, also read by invites, who
+    LOCK_DOMAIN_ITEM        = 0x100                         // item creation, item guids are generated unguarded
+};
+
+#define MAX_LOCK_DOMAINS 9
+
+char const* GetLockDomainName(uint32 index);
+
+// Locks the given domains in ascending order, the wait and hold times are profiled per domain
+class LockDomainGuard
+{
+    public:
+        explicit LockDomainGuard(uint32 domains);
+        ~LockDomainGuard();
+
+    private:
+        uint32 _domains;
+        uint64 _lockTime;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include <zlib.h>
+#include "PreparedPacket.h"
+#include "Log.h"
+#include "World.h"
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Message_Block.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+
+// Fresh raw deflate stream per thread, shared bodies must not reference data of earlier packets
+struct SharedCompressionStream
+{
+    SharedCompressionStream() : Initialized(false)
+    {
+        memset(&Stream, 0, sizeof(Stream));
+        int32 z_res = deflateInit2(&Stream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        if (z_res != Z_OK)
+        {
+            TC_LOG_ERROR("network.opcode", "Can't initialize shared packet compression (zlib: deflateInit2) Error code: %i (%s)", z_res, zError(z_res));
+            return;
+        }
+
+        Initialized = true;
+    }
+
+    ~SharedCompressionStream()
+    {
+        if (Initialized)
+            deflateEnd(&Stream);
+    }
+
+    z_stream Stream;
+    bool Initialized;
+};
+
+typedef ACE_TSS<SharedCompressionStream> SharedCompressionStreamTSS;
+static SharedCompressionStreamTSS sharedCompressionStream;
+
+// Queued bodies are released by the network threads
+static ACE_Lock_Adapter<ACE_Thread_Mutex> sharedBodyLock;
+
+PreparedPacket::PreparedPacket(WorldPacket const* packet) : _packet(packet), _compressedBody(NULL), _sourceBody(NULL), _compressionDone(false)
+{
+}
+
+PreparedPacket::~PreparedPacket()
+{
+    if (_compressedBody)
+        _compressedBody->release();
+
+    if (_sourceBody)
+        _sourceBody->release();
+}
+
+WorldPacket const* PreparedPacket::GetCompressedPacket()
+{
+    if (!_compressionDone)
+    {
+        _compressionDone = true;
+
+        if (_packet->size() > PACKET_COMPRESSION_THRESHOLD && sharedCompressionStream->Initialized)
+        {
+            z_stream* stream = &sharedCompressionStream->Stream;
+            deflateReset(stream);
+            _compressedPacket.Compress(stream, _packet);
+
+            if (_compressedPacket.GetOpcode() & COMPRESSED_OPCODE_MASK)
+            {
+                ACE_NEW_NORETURN(_compressedBody, ACE_Message_Block(_compressedPacket.size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL, &sharedBodyLock));
+                if (_compressedBody)
+                    _compressedBody->copy((char const*)_compressedPacket.contents(), _compressedPacket.size());
+            }
+        }
+    }
+
+    return _compressedBody ? &_compressedPacket : NULL;
+}
+
+ACE_Message_Block* PreparedPacket::GetCompressedBody()
+{
+    GetCompressedPacket();
+    return _compressedBody;
+}
+
+ACE_Message_Block* PreparedPacket::GetSourceBody()
+{
+    if (!_sourceBody && GetCompressedBody())
+    {
+        ACE_NEW_NORETURN(_sourceBody, ACE_Message_Block(_packet->size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL, &sharedBodyLock));
+        if (_sourceBody)
+            _sourceBody->copy((char const*)_packet->contents(), _packet->size());
+    }
+
+    return _sourceBody;
+}
@@ -0,0 +1,51 @@
+#ifndef TRINITY_PREPAREDPACKET_H
+#define TRINITY_PREPAREDPACKET_H
+
+#include "WorldPacket.h"
+
+class ACE_Message_Block;
+
+/// Packets above this size are sent compressed
+#define PACKET_COMPRESSION_THRESHOLD 0x400
+
+/**
+ * A packet which is sent to many sessions.
+ *
+ * Large packets are deflated only once, into a body which does not reference
+ * earlier stream data. Every socket whose compression stream is already
+ * running can append that body to its stream, sockets queue it by reference
+ * together with the uncompressed contents their stream history is updated
+ * with, and only encrypt their own header.
+ *
+ * Not thread-safe, build and send it from a single thread. Queued bodies are
+ * reference counted and may outlive the prepared packet.
+ */
+class PreparedPacket
+{
+    public:
+        explicit PreparedPacket(WorldPacket const* packet);
+        ~PreparedPacket();
+
+        WorldPacket const* GetPacket() const { return _packet; }
+
+        /// Shared compressed form, built on first use. NULL if the packet is not compressed.
+        WorldPacket const* GetCompressedPacket();
+
+        /// Shared compressed form as message block, duplicate() it to queue it
+        ACE_Message_Block* GetCompressedBody();
+
+        /// Uncompressed contents as message block, NULL if the packet is not compressed
+        ACE_Message_Block* GetSourceBody();
+
+    private:
+        PreparedPacket(PreparedPacket const&);
+        PreparedPacket& operator=(PreparedPacket const&);
+
+        WorldPacket const* _packet;
+        WorldPacket _compressedPacket;
+        ACE_Message_Block* _compressedBody;
+        ACE_Message_Block* _sourceBody;
+        bool _compressionDone;
+};
+
+#endif
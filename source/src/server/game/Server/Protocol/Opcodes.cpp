@@ -17,6 +17,7 @@
  */
 
 #include "Opcodes.h"
+#include "LockDomain.h"
 #include "WorldSession.h"
 
 OpcodeTable opcodeTable;
@@ -52,6 +53,18 @@ void OpcodeTable::ValidateAndSetOpcode<true, false>(uint16 /*opcode*/, char cons
     TC_LOG_ERROR("network.opcode", "Opcode %s got value 0", name);
 }
 
+void OpcodeTable::SetLockDomains(uint16 opcode, char const* name, uint32 domains)
+{
+    OpcodeHandler* handler = opcode < NUM_OPCODE_HANDLERS ? _internalTable[opcode] : NULL;
+    if (!handler || handler->Status != STATUS_LOGGEDIN || handler->ProcessingPlace != PROCESS_THREADUNSAFE)
+    {
+        TC_LOG_ERROR("network.opcode", "Tried to set lock domains of %s, which is not a thread-unsafe handler of logged in players", name);
+        return;
+    }
+
+    handler->LockDomains = domains;
+}
+
 /// Correspondence between opcodes and their names
 void OpcodeTable::Initialize()
 {
@@ -1701,4 +1714,142 @@ void OpcodeTable::Initialize()
   //DEFINE_OPCODE_HANDLER(SMSG_ZONE_MAP,                                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide               );
 
 #undef DEFINE_OPCODE_HANDLER
+
+    // Thread-unsafe handlers run by the session update threads, see LockDomain.h
+#define DEFINE_OPCODE_LOCK_DOMAINS(opcode, domains)                                                     \
+    SetLockDomains(opcode, #opcode, domains);
+
+    // guild information and settings, membership changes stay serial
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_ACHIEVEMENT_PROGRESS_QUERY,         LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_EVENT_LOG_QUERY,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_QUERY_NEWS,                         LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_QUERY_RANKS,                        LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_ROSTER,                             LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_REQUEST_CHALLENGE_UPDATE,           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_REQUEST_MAX_DAILY_XP,               LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_REQUEST_PARTY_STATE,                LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_SET_ACHIEVEMENT_TRACKING,           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_QUERY_GUILD_XP,                           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_INFO_TEXT,                          LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_MOTD,                               LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_PERMISSIONS,                        LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_SET_NOTE,                           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_INVITE,                             LOCK_DOMAIN_GUILD | LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_DECLINE,                            LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_ADD_RANK,                           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_DEL_RANK,                           LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_SWITCH_RANK,                        LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_SET_RANK_PERMISSIONS,               LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_ASSIGN_MEMBER_RANK,                 LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_PROMOTE,                            LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_DEMOTE,                             LOCK_DOMAIN_GUILD);
+
+    // guild bank
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANKER_ACTIVATE,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_LOG_QUERY,                     LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_MONEY_WITHDRAWN_QUERY,         LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_QUERY_TAB,                     LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_QUERY_TEXT,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_DEPOSIT_MONEY,                 LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_WITHDRAW_MONEY,                LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_SWAP_ITEMS,                    LOCK_DOMAIN_GUILD | LOCK_DOMAIN_ITEM);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_UPDATE_TAB,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GUILD_BANK_BUY_TAB,                       LOCK_DOMAIN_GUILD);
+
+    // guild finder
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_ADD_RECRUIT,                     LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_BROWSE,                          LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_DECLINE_RECRUIT,                 LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_GET_APPLICATIONS,                LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_GET_RECRUITS,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_POST_REQUEST,                    LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_REMOVE_RECRUIT,                  LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LF_GUILD_SET_GUILD_POST,                  LOCK_DOMAIN_GUILD);
+
+    // arena teams, creation and membership changes stay serial
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ARENA_TEAM_QUERY,                         LOCK_DOMAIN_ARENA_TEAM);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ARENA_TEAM_ROSTER,                        LOCK_DOMAIN_ARENA_TEAM);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ARENA_TEAM_INVITE,                        LOCK_DOMAIN_ARENA_TEAM | LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ARENA_TEAM_DECLINE,                       LOCK_DOMAIN_ARENA_TEAM);
+    DEFINE_OPCODE_LOCK_DOMAINS(MSG_INSPECT_ARENA_TEAMS,                       LOCK_DOMAIN_ARENA_TEAM);
+
+    // auction house, bids and cancels mail the previous bidder. Handlers moving money or items
+    // update achievements, which also update the guild ones and those of other online players
+    DEFINE_OPCODE_LOCK_DOMAINS(MSG_AUCTION_HELLO,                             LOCK_DOMAIN_AUCTION);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_LIST_BIDDER_ITEMS,                LOCK_DOMAIN_AUCTION);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_LIST_ITEMS,                       LOCK_DOMAIN_AUCTION);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_LIST_OWNER_ITEMS,                 LOCK_DOMAIN_AUCTION);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_LIST_PENDING_SALES,               LOCK_DOMAIN_AUCTION);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_PLACE_BID,                        LOCK_DOMAIN_AUCTION | LOCK_DOMAIN_MAIL | LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_REMOVE_ITEM,                      LOCK_DOMAIN_AUCTION | LOCK_DOMAIN_MAIL | LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_AUCTION_SELL_ITEM,                        LOCK_DOMAIN_AUCTION | LOCK_DOMAIN_ITEM | LOCK_DOMAIN_GUILD);
+
+    // mail, see the auction house for the guild domain
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_GET_MAIL_LIST,                            LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_DELETE,                              LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_MARK_AS_READ,                        LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_RETURN_TO_SENDER,                    LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_TAKE_ITEM,                           LOCK_DOMAIN_MAIL | LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_TAKE_MONEY,                          LOCK_DOMAIN_MAIL | LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(MSG_QUERY_NEXT_MAIL_TIME,                      LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_SEND_MAIL,                                LOCK_DOMAIN_MAIL | LOCK_DOMAIN_GUILD);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_MAIL_CREATE_TEXT_ITEM,                    LOCK_DOMAIN_MAIL | LOCK_DOMAIN_ITEM | LOCK_DOMAIN_GUILD);
+
+    // chat channels
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_JOIN_CHANNEL,                             LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LEAVE_CHANNEL,                            LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_ANNOUNCEMENTS,                    LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_BAN,                              LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_DISPLAY_LIST,                     LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_INVITE,                           LOCK_DOMAIN_CHANNEL | LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_KICK,                             LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_LIST,                             LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_MODERATOR,                        LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_MUTE,                             LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_OWNER,                            LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_PASSWORD,                         LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_SET_OWNER,                        LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_UNBAN,                            LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_UNMODERATOR,                      LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_UNMUTE,                           LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_VOICE_OFF,                        LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHANNEL_VOICE_ON,                         LOCK_DOMAIN_CHANNEL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_SET_CHANNEL_WATCH,                        LOCK_DOMAIN_CHANNEL);
+
+    // calendar, events read guild members and mail the invitees
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_ADD_EVENT,                       LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_COMPLAIN,                        LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_COPY_EVENT,                      LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_INVITE,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_MODERATOR_STATUS,          LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_REMOVE_INVITE,             LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_RSVP,                      LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_SIGNUP,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_EVENT_STATUS,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_GET_CALENDAR,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_GET_EVENT,                       LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_GET_NUM_PENDING,                 LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_GUILD_FILTER,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_REMOVE_EVENT,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_UPDATE_EVENT,                    LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CALENDAR_ARENA_TEAM,                      LOCK_DOMAIN_CALENDAR | LOCK_DOMAIN_GUILD | LOCK_DOMAIN_MAIL | LOCK_DOMAIN_ARENA_TEAM);
+
+    // dungeon finder queue, proposals and boots stay serial
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LFG_JOIN,                                 LOCK_DOMAIN_LFG);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LFG_LEAVE,                                LOCK_DOMAIN_LFG);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LFG_SET_ROLES,                            LOCK_DOMAIN_LFG);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_LFG_SET_COMMENT,                          LOCK_DOMAIN_LFG);
+
+    // friends, ignores and who
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ADD_FRIEND,                               LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_DEL_FRIEND,                               LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_ADD_IGNORE,                               LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_DEL_IGNORE,                               LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CONTACT_LIST,                             LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_SET_CONTACT_NOTES,                        LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_CHAT_IGNORED,                             LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_WHOIS,                                    LOCK_DOMAIN_SOCIAL);
+    DEFINE_OPCODE_LOCK_DOMAINS(CMSG_WHO,                                      LOCK_DOMAIN_SOCIAL | LOCK_DOMAIN_GUILD);
+
+#undef DEFINE_OPCODE_LOCK_DOMAINS
 };
@@ -1415,12 +1415,13 @@ struct OpcodeHandler
 {
     OpcodeHandler() {}
     OpcodeHandler(char const* _name, SessionStatus _status, PacketProcessing _processing, pOpcodeHandler _handler)
-        : Name(_name), Status(_status), ProcessingPlace(_processing), Handler(_handler) {}
+        : Name(_name), Status(_status), ProcessingPlace(_processing), Handler(_handler), LockDomains(0) {}
 
     char const* Name;
     SessionStatus Status;
     PacketProcessing ProcessingPlace;
     pOpcodeHandler Handler;
+    uint32 LockDomains;                                     // LockDomain mask, thread-unsafe handlers only
 };
 
 class OpcodeTable
@@ -1448,6 +1449,8 @@ class OpcodeTable
         template<bool isInValidRange, bool isNonZero>
         void ValidateAndSetOpcode(uint16 opcode, char const* name, SessionStatus status, PacketProcessing processing, pOpcodeHandler handler);
 
+        void SetLockDomains(uint16 opcode, char const* name, uint32 domains);
+
         // Prevent copying this structure
         OpcodeTable(OpcodeTable const&);
         OpcodeTable& operator=(OpcodeTable const&);
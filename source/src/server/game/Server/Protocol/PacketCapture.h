@@ -0,0 +1,70 @@
+#ifndef TRINITY_PACKETCAPTURE_H
+#define TRINITY_PACKETCAPTURE_H
+
+#include "Define.h"
+
+// "TCPC"
+#define PACKET_CAPTURE_MAGIC        0x43504354
+#define PACKET_CAPTURE_VERSION      1
+#define PACKET_CAPTURE_CLIENT_BUILD 15595
+// Records start and end on this boundary so a mapped file can be read in place
+#define PACKET_CAPTURE_ALIGNMENT    8
+
+/*
+ * Capture file layout:
+ *   PacketCaptureHeader
+ *   PacketCaptureRecord + payload, repeated
+ *   per session: RecordCount uint64 offsets of its records
+ *   PacketCaptureSession[SessionCount]
+ *   PacketCaptureFooter
+ *
+ * Index and footer are written when the capture is closed. Readers rebuild
+ * the index by scanning the records if the server did not shut down cleanly.
+ */
+
+#pragma pack(push, 1)
+
+struct PacketCaptureHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 Build;                                           // client build of the server
+    uint32 Reserved;
+    uint64 StartTime;                                       // unix time of the first record
+};
+
+struct PacketCaptureRecord
+{
+    uint32 Size;                                            // payload bytes following the record
+    uint32 Opcode;
+    uint32 ConnectionId;
+    uint32 AccountId;                                       // 0 until the connection authenticated
+    uint32 Time;                                            // milliseconds since StartTime
+    uint8 Direction;                                        // enum Direction
+    uint8 Reserved[3];
+};
+
+struct PacketCaptureSession
+{
+    uint32 ConnectionId;
+    uint32 AccountId;
+    uint32 RecordCount;
+    uint32 Reserved;
+    uint64 RecordOffsets;                                   // file offset of the record offset list
+};
+
+struct PacketCaptureFooter
+{
+    uint64 SessionsOffset;
+    uint32 SessionCount;
+    uint32 Magic;
+};
+
+#pragma pack(pop)
+
+inline uint32 GetPacketCaptureRecordSize(uint32 payloadSize)
+{
+    return (sizeof(PacketCaptureRecord) + payloadSize + PACKET_CAPTURE_ALIGNMENT - 1) & ~uint32(PACKET_CAPTURE_ALIGNMENT - 1);
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "PacketCaptureReader.h"
+
+PacketCaptureReader::PacketCaptureReader() : _data(NULL), _size(0), _recovered(false)
+{
+}
+
+PacketCaptureReader::~PacketCaptureReader()
+{
+    _map.close();
+}
+
+bool PacketCaptureReader::Open(std::string const& fileName)
+{
+    if (_map.map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+        return false;
+
+    _data = static_cast<uint8 const*>(_map.addr());
+    _size = _map.size();
+
+    if (_size < sizeof(PacketCaptureHeader) || GetHeader()->Magic != PACKET_CAPTURE_MAGIC || GetHeader()->Version != PACKET_CAPTURE_VERSION)
+        return false;
+
+    if (!ReadIndex())
+    {
+        _recovered = true;
+        ScanRecords();
+    }
+
+    return true;
+}
+
+PacketCaptureSessionInfo const* PacketCaptureReader::GetSession(uint32 connectionId) const
+{
+    for (std::vector<PacketCaptureSessionInfo>::const_iterator itr = _sessions.begin(); itr != _sessions.end(); ++itr)
+        if (itr->ConnectionId == connectionId)
+            return &*itr;
+
+    return NULL;
+}
+
+bool PacketCaptureReader::ReadIndex()
+{
+    if (_size < sizeof(PacketCaptureHeader) + sizeof(PacketCaptureFooter))
+        return false;
+
+    PacketCaptureFooter const* footer = reinterpret_cast<PacketCaptureFooter const*>(_data + _size - sizeof(PacketCaptureFooter));
+    if (footer->Magic != PACKET_CAPTURE_MAGIC || footer->SessionsOffset + uint64(footer->SessionCount) * sizeof(PacketCaptureSession) > _size - sizeof(PacketCaptureFooter))
+        return false;
+
+    PacketCaptureSession const* sessions = reinterpret_cast<PacketCaptureSession const*>(_data + footer->SessionsOffset);
+    _sessions.resize(footer->SessionCount);
+    for (uint32 i = 0; i < footer->SessionCount; ++i)
+    {
+        if (sessions[i].RecordOffsets + uint64(sessions[i].RecordCount) * sizeof(uint64) > footer->SessionsOffset)
+        {
+            _sessions.clear();
+            return false;
+        }
+
+        uint64 const* offsets = reinterpret_cast<uint64 const*>(_data + sessions[i].RecordOffsets);
+        _sessions[i].ConnectionId = sessions[i].ConnectionId;
+        _sessions[i].AccountId = sessions[i].AccountId;
+        _sessions[i].RecordOffsets.assign(offsets, offsets + sessions[i].RecordCount);
+    }
+
+    return true;
+}
+
+void PacketCaptureReader::ScanRecords()
+{
+    std::map<uint32, PacketCaptureSessionInfo> sessions;
+
+    uint64 offset = sizeof(PacketCaptureHeader);
+    while (offset + sizeof(PacketCaptureRecord) <= _size)
+    {
+        PacketCaptureRecord const* record = GetRecord(offset);
+        uint32 size = GetPacketCaptureRecordSize(record->Size);
+        // the last record may be cut off
+        if (offset + size > _size)
+            break;
+
+        PacketCaptureSessionInfo& session = sessions[record->ConnectionId];
+        session.ConnectionId = record->ConnectionId;
+        if (record->AccountId)
+            session.AccountId = record->AccountId;
+        session.RecordOffsets.push_back(offset);
+
+        offset += size;
+    }
+
+    for (std::map<uint32, PacketCaptureSessionInfo>::iterator itr = sessions.begin(); itr != sessions.end(); ++itr)
+        _sessions.push_back(itr->second);
+}
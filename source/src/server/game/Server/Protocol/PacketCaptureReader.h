@@ -0,0 +1,45 @@
+#ifndef TRINITY_PACKETCAPTUREREADER_H
+#define TRINITY_PACKETCAPTUREREADER_H
+
+#include "Common.h"
+#include "PacketCapture.h"
+#include <ace/Mem_Map.h>
+
+struct PacketCaptureSessionInfo
+{
+    uint32 ConnectionId;
+    uint32 AccountId;
+    std::vector<uint64> RecordOffsets;                      // in capture order
+};
+
+/// Memory mapped, read only view of a capture file written by PacketLog
+class PacketCaptureReader
+{
+    public:
+        PacketCaptureReader();
+        ~PacketCaptureReader();
+
+        bool Open(std::string const& fileName);
+
+        PacketCaptureHeader const* GetHeader() const { return reinterpret_cast<PacketCaptureHeader const*>(_data); }
+        std::vector<PacketCaptureSessionInfo> const& GetSessions() const { return _sessions; }
+        PacketCaptureSessionInfo const* GetSession(uint32 connectionId) const;
+
+        /// True if the capture was not closed and its index was rebuilt from the records
+        bool IsRecovered() const { return _recovered; }
+
+        PacketCaptureRecord const* GetRecord(uint64 offset) const { return reinterpret_cast<PacketCaptureRecord const*>(_data + offset); }
+        uint8 const* GetPayload(PacketCaptureRecord const* record) const { return reinterpret_cast<uint8 const*>(record + 1); }
+
+    private:
+        bool ReadIndex();
+        void ScanRecords();
+
+        ACE_Mem_Map _map;
+        uint8 const* _data;
+        uint64 _size;
+        bool _recovered;
+        std::vector<PacketCaptureSessionInfo> _sessions;
+};
+
+#endif
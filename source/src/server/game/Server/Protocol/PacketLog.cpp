@@ -17,20 +17,352 @@
 
 #include "PacketLog.h"
 #include "Config.h"
-#include "ByteBuffer.h"
+#include "Log.h"
+#include "PacketCapture.h"
+#include "Timer.h"
+#include "Util.h"
 #include "WorldPacket.h"
+#include <ace/Task.h>
+#include <ace/TSS_T.h>
 
-PacketLog::PacketLog() : _file(NULL)
+// Must be a power of two
+#define PACKET_CAPTURE_RING_SIZE    (4 * 1024 * 1024)
+#define MAX_PACKET_CAPTURE_RINGS    128
+// Pending file output is written once it reaches this size or the writer runs idle
+#define PACKET_CAPTURE_WRITE_SIZE   (1024 * 1024)
+#define PACKET_CAPTURE_IDLE         10
+
+// Records of one thread, written only by the owning thread and read only by the writer
+struct PacketCaptureRing
+{
+    PacketCaptureRing()
+    {
+        Head.store(0, std::memory_order_relaxed);
+        Tail.store(0, std::memory_order_relaxed);
+        InUse.store(false, std::memory_order_relaxed);
+    }
+
+    void Write(uint32 position, void const* data, uint32 size)
+    {
+        uint32 offset = position & (PACKET_CAPTURE_RING_SIZE - 1);
+        uint32 first = std::min(size, uint32(PACKET_CAPTURE_RING_SIZE) - offset);
+        memcpy(&Data[offset], data, first);
+        memcpy(&Data[0], static_cast<uint8 const*>(data) + first, size - first);
+    }
+
+    void Read(uint32 position, void* data, uint32 size) const
+    {
+        uint32 offset = position & (PACKET_CAPTURE_RING_SIZE - 1);
+        uint32 first = std::min(size, uint32(PACKET_CAPTURE_RING_SIZE) - offset);
+        memcpy(data, &Data[offset], first);
+        memcpy(static_cast<uint8*>(data) + first, &Data[0], size - first);
+    }
+
+    uint8 Data[PACKET_CAPTURE_RING_SIZE];
+    std::atomic<uint32> Head;                               // bytes written by the owner
+    std::atomic<uint32> Tail;                               // bytes consumed by the writer
+    std::atomic<bool> InUse;
+};
+
+struct PacketCaptureSessionIndex
+{
+    PacketCaptureSessionIndex() : AccountId(0) { }
+
+    uint32 AccountId;
+    std::vector<uint64> RecordOffsets;
+};
+
+class PacketCaptureWriter : protected ACE_Task_Base
+{
+    public:
+        explicit PacketCaptureWriter(FILE* file);
+        ~PacketCaptureWriter();
+
+        void Push(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId, uint32 msTime);
+
+    private:
+        int svc();
+        bool PushRecord(PacketCaptureRing& ring, PacketCaptureRecord const& record, WorldPacket const& packet);
+        bool Drain();
+        bool DrainRing(PacketCaptureRing& ring);
+        void WriteBuffer();
+        void WriteIndex();
+
+        PacketCaptureRing* AcquireRing();
+        friend struct PacketCaptureRingSlot;
+
+        FILE* _file;
+        uint32 _startTime;
+        std::atomic<bool> _stop;
+        std::atomic<uint32> _dropped;
+
+        ACE_Thread_Mutex _ringLock;
+        std::atomic<PacketCaptureRing*> _rings[MAX_PACKET_CAPTURE_RINGS];
+        std::atomic<uint32> _ringCount;
+        ACE_Thread_Mutex _fallbackLock;
+        PacketCaptureRing* _fallbackRing;
+
+        // Only touched by the writer thread
+        std::vector<uint8> _buffer;
+        uint64 _fileOffset;
+        UNORDERED_MAP<uint32, PacketCaptureSessionIndex> _sessions;
+};
+
+// The capture lives until shutdown, rings of exited threads are handed to new threads
+struct PacketCaptureRingSlot
+{
+    PacketCaptureRingSlot() : Ring(NULL), Owner(NULL) { }
+    ~PacketCaptureRingSlot()
+    {
+        if (Ring)
+            Ring->InUse.store(false, std::memory_order_release);
+    }
+
+    PacketCaptureRing* Ring;
+    PacketCaptureWriter* Owner;
+};
+
+typedef ACE_TSS<PacketCaptureRingSlot> PacketCaptureRingTSS;
+static PacketCaptureRingTSS packetCaptureRingSlot;
+
+PacketCaptureWriter::PacketCaptureWriter(FILE* file) : _file(file), _startTime(getMSTime()), _fallbackRing(new PacketCaptureRing()), _fileOffset(0)
+{
+    _stop.store(false, std::memory_order_relaxed);
+    _dropped.store(0, std::memory_order_relaxed);
+    _ringCount.store(0, std::memory_order_relaxed);
+    for (uint32 i = 0; i < MAX_PACKET_CAPTURE_RINGS; ++i)
+        _rings[i].store(NULL, std::memory_order_relaxed);
+
+    PacketCaptureHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = PACKET_CAPTURE_MAGIC;
+    header.Version = PACKET_CAPTURE_VERSION;
+    header.Build = PACKET_CAPTURE_CLIENT_BUILD;
+    header.StartTime = uint64(time(NULL));
+
+    _buffer.reserve(PACKET_CAPTURE_WRITE_SIZE + PACKET_CAPTURE_RING_SIZE);
+    _buffer.resize(sizeof(header));
+    memcpy(&_buffer[0], &header, sizeof(header));
+
+    ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
+}
+
+PacketCaptureWriter::~PacketCaptureWriter()
+{
+    _stop.store(true, std::memory_order_release);
+    wait();
+
+    WriteIndex();
+    fclose(_file);
+
+    if (uint32 dropped = _dropped.load(std::memory_order_relaxed))
+        TC_LOG_WARN("network", "Packet capture dropped %u packets, the capture rings were full", dropped);
+
+    // Rings are not released, threads which captured packets may still hold them in their slot
+}
+
+PacketCaptureRing* PacketCaptureWriter::AcquireRing()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _ringLock);
+
+    uint32 count = _ringCount.load(std::memory_order_relaxed);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        PacketCaptureRing* ring = _rings[i].load(std::memory_order_relaxed);
+        if (!ring->InUse.load(std::memory_order_acquire))
+        {
+            ring->InUse.store(true, std::memory_order_relaxed);
+            return ring;
+        }
+    }
+
+    // Threads beyond the limit share the locked fallback ring
+    if (count == MAX_PACKET_CAPTURE_RINGS)
+        return NULL;
+
+    PacketCaptureRing* ring = new PacketCaptureRing();
+    ring->InUse.store(true, std::memory_order_relaxed);
+    _rings[count].store(ring, std::memory_order_relaxed);
+    _ringCount.store(count + 1, std::memory_order_release);
+    return ring;
+}
+
+void PacketCaptureWriter::Push(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId, uint32 msTime)
+{
+    uint32 size = GetPacketCaptureRecordSize(uint32(packet.size()));
+    if (size > PACKET_CAPTURE_RING_SIZE / 2)
+    {
+        ++_dropped;
+        return;
+    }
+
+    PacketCaptureRingSlot* slot = packetCaptureRingSlot.ts_object();
+    if (slot->Owner != this)
+    {
+        slot->Ring = AcquireRing();
+        slot->Owner = this;
+    }
+
+    PacketCaptureRecord record;
+    memset(&record, 0, sizeof(record));
+    record.Size = uint32(packet.size());
+    record.Opcode = packet.GetOpcode();
+    record.ConnectionId = connectionId;
+    record.AccountId = accountId;
+    record.Time = getMSTimeDiff(_startTime, msTime);
+    record.Direction = uint8(direction);
+
+    bool pushed;
+    if (slot->Ring)
+        pushed = PushRecord(*slot->Ring, record, packet);
+    else
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _fallbackLock);
+        pushed = PushRecord(*_fallbackRing, record, packet);
+    }
+
+    if (!pushed)
+        ++_dropped;
+}
+
+bool PacketCaptureWriter::PushRecord(PacketCaptureRing& ring, PacketCaptureRecord const& record, WorldPacket const& packet)
+{
+    uint32 size = GetPacketCaptureRecordSize(record.Size);
+    uint32 head = ring.Head.load(std::memory_order_relaxed);
+    if (PACKET_CAPTURE_RING_SIZE - (head - ring.Tail.load(std::memory_order_acquire)) < size)
+        return false;
+
+    ring.Write(head, &record, sizeof(record));
+    if (record.Size)
+        ring.Write(head + sizeof(record), packet.contents(), record.Size);
+
+    ring.Head.store(head + size, std::memory_order_release);
+    return true;
+}
+
+bool PacketCaptureWriter::DrainRing(PacketCaptureRing& ring)
+{
+    uint32 tail = ring.Tail.load(std::memory_order_relaxed);
+    uint32 head = ring.Head.load(std::memory_order_acquire);
+    if (tail == head)
+        return false;
+
+    while (tail != head)
+    {
+        PacketCaptureRecord record;
+        ring.Read(tail, &record, sizeof(record));
+
+        uint32 size = GetPacketCaptureRecordSize(record.Size);
+        size_t position = _buffer.size();
+        _buffer.resize(position + size);
+        ring.Read(tail, &_buffer[position], sizeof(record) + record.Size);
+        // padding would otherwise carry stale ring contents
+        memset(&_buffer[position + sizeof(record) + record.Size], 0, size - sizeof(record) - record.Size);
+
+        PacketCaptureSessionIndex& session = _sessions[record.ConnectionId];
+        if (record.AccountId)
+            session.AccountId = record.AccountId;
+        session.RecordOffsets.push_back(_fileOffset + position);
+
+        tail += size;
+    }
+
+    ring.Tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+bool PacketCaptureWriter::Drain()
+{
+    bool drained = false;
+    uint32 count = _ringCount.load(std::memory_order_acquire);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        drained |= DrainRing(*_rings[i].load(std::memory_order_relaxed));
+        if (_buffer.size() >= PACKET_CAPTURE_WRITE_SIZE)
+            WriteBuffer();
+    }
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _fallbackLock);
+        drained |= DrainRing(*_fallbackRing);
+    }
+
+    return drained;
+}
+
+void PacketCaptureWriter::WriteBuffer()
+{
+    if (_buffer.empty())
+        return;
+
+    fwrite(&_buffer[0], 1, _buffer.size(), _file);
+    _fileOffset += _buffer.size();
+    _buffer.clear();
+}
+
+void PacketCaptureWriter::WriteIndex()
 {
+    WriteBuffer();
+
+    std::vector<PacketCaptureSession> sessions;
+    sessions.reserve(_sessions.size());
+    for (UNORDERED_MAP<uint32, PacketCaptureSessionIndex>::const_iterator itr = _sessions.begin(); itr != _sessions.end(); ++itr)
+    {
+        PacketCaptureSession session;
+        memset(&session, 0, sizeof(session));
+        session.ConnectionId = itr->first;
+        session.AccountId = itr->second.AccountId;
+        session.RecordCount = uint32(itr->second.RecordOffsets.size());
+        session.RecordOffsets = _fileOffset;
+        sessions.push_back(session);
+
+        fwrite(&itr->second.RecordOffsets[0], sizeof(uint64), itr->second.RecordOffsets.size(), _file);
+        _fileOffset += sizeof(uint64) * itr->second.RecordOffsets.size();
+    }
+
+    PacketCaptureFooter footer;
+    footer.SessionsOffset = _fileOffset;
+    footer.SessionCount = uint32(sessions.size());
+    footer.Magic = PACKET_CAPTURE_MAGIC;
+
+    if (!sessions.empty())
+        fwrite(&sessions[0], sizeof(PacketCaptureSession), sessions.size(), _file);
+    fwrite(&footer, sizeof(footer), 1, _file);
+}
+
+int PacketCaptureWriter::svc()
+{
+    while (1)
+    {
+        if (Drain())
+            continue;
+
+        WriteBuffer();
+
+        if (_stop.load(std::memory_order_acquire))
+        {
+            if (!Drain())
+                break;
+
+            continue;
+        }
+
+        ACE_OS::sleep(ACE_Time_Value(0, PACKET_CAPTURE_IDLE * 1000));
+    }
+
+    WriteBuffer();
+    return 0;
+}
+
+PacketLog::PacketLog() : _writer(NULL)
+{
+    _nextConnectionId.store(0, std::memory_order_relaxed);
     Initialize();
 }
 
 PacketLog::~PacketLog()
 {
-    if (_file)
-        fclose(_file);
-
-    _file = NULL;
+    Close();
 }
 
 void PacketLog::Initialize()
@@ -41,22 +373,33 @@ void PacketLog::Initialize()
         if ((logsDir.at(logsDir.length()-1) != '/') && (logsDir.at(logsDir.length()-1) != '\\'))
             logsDir.push_back('/');
 
+    _accounts.clear();
+    Tokenizer accounts(sConfigMgr->GetStringDefault("PacketLog.Accounts", ""), ' ');
+    for (Tokenizer::const_iterator itr = accounts.begin(); itr != accounts.end(); ++itr)
+        if (uint32 accountId = uint32(atoi(*itr)))
+            _accounts.insert(accountId);
+
     std::string logname = sConfigMgr->GetStringDefault("PacketLogFile", "");
     if (!logname.empty())
-        _file = fopen((logsDir + logname).c_str(), "wb");
+        if (FILE* file = fopen((logsDir + logname).c_str(), "wb"))
+            _writer = new PacketCaptureWriter(file);
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction)
+void PacketLog::Close()
 {
-    ByteBuffer data(4+4+4+1+packet.size());
-    data << int32(packet.GetOpcode());
-    data << int32(packet.size());
-    data << uint32(time(NULL));
-    data << uint8(direction);
+    delete _writer;
+    _writer = NULL;
+}
 
-    for (uint32 i = 0; i < packet.size(); i++)
-        data << packet[i];
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId)
+{
+    LogPacket(packet, direction, connectionId, accountId, getMSTime());
+}
+
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId, uint32 msTime)
+{
+    if (!CapturesAccount(accountId))
+        return;
 
-    fwrite(data.contents(), 1, data.size(), _file);
-    fflush(_file);
+    _writer->Push(packet, direction, connectionId, accountId, msTime);
 }
@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include <ace/Singleton.h>
+#include <atomic>
 
 enum Direction
 {
@@ -27,8 +28,16 @@ enum Direction
     SERVER_TO_CLIENT
 };
 
+class PacketCaptureWriter;
 class WorldPacket;
 
+/**
+ * Packet capture, see PacketCapture.h for the file format.
+ *
+ * Network and map threads copy packets into a ring buffer of their own,
+ * a background thread writes them to the file. Packets which do not fit
+ * into a full ring are dropped and counted instead of stalling the caller.
+ */
 class PacketLog
 {
     friend class ACE_Singleton<PacketLog, ACE_Thread_Mutex>;
@@ -39,11 +48,22 @@ class PacketLog
 
     public:
         void Initialize();
-        bool CanLogPacket() const { return (_file != NULL); }
-        void LogPacket(WorldPacket const& packet, Direction direction);
+        void Close();
+
+        bool CanLogPacket() const { return _writer != NULL; }
+        void LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId);
+        // msTime is the getMSTime() the packet was seen at, for packets held back until the account is known
+        void LogPacket(WorldPacket const& packet, Direction direction, uint32 connectionId, uint32 accountId, uint32 msTime);
+
+        bool CapturesAllAccounts() const { return _accounts.empty(); }
+        bool CapturesAccount(uint32 accountId) const { return _accounts.empty() || _accounts.find(accountId) != _accounts.end(); }
+
+        uint32 NewConnectionId() { return ++_nextConnectionId; }
 
     private:
-        FILE* _file;
+        PacketCaptureWriter* _writer;
+        std::set<uint32> _accounts;                         // empty captures all accounts
+        std::atomic<uint32> _nextConnectionId;
 };
 
 #define sPacketLog ACE_Singleton<PacketLog, ACE_Thread_Mutex>::instance()
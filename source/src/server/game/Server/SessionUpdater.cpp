@@ -0,0 +1,120 @@
+#include "SessionUpdater.h"
+#include "DatabaseEnv.h"
+#include "WorldSession.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+// Handlers may run synchronous queries, the threads need their own MySQL thread state
+class SessionThreadStartRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class SessionThreadEndRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class SessionUpdateRequest : public ACE_Method_Request
+{
+    private:
+
+        WorldSession& m_session;
+        SessionUpdater& m_updater;
+
+    public:
+
+        SessionUpdateRequest(WorldSession& s, SessionUpdater& u)
+            : m_session(s), m_updater(u)
+        {
+        }
+
+        virtual int call()
+        {
+            m_session.ProcessLockDomainPackets();
+            m_updater.update_finished();
+            return 0;
+        }
+};
+
+SessionUpdater::SessionUpdater():
+m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
+{
+}
+
+SessionUpdater::~SessionUpdater()
+{
+    deactivate();
+}
+
+int SessionUpdater::activate(size_t num_threads)
+{
+    return m_executor.start((int)num_threads, new SessionThreadStartRequest, new SessionThreadEndRequest);
+}
+
+int SessionUpdater::deactivate()
+{
+    wait();
+
+    return m_executor.deactivate();
+}
+
+int SessionUpdater::wait()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    while (pending_requests > 0)
+        m_condition.wait();
+
+    return 0;
+}
+
+int SessionUpdater::schedule_update(WorldSession& session)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    ++pending_requests;
+
+    if (m_executor.execute(new SessionUpdateRequest(session, *this)) == -1)
+    {
+        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Session Update")));
+
+        --pending_requests;
+        return -1;
+    }
+
+    return 0;
+}
+
+bool SessionUpdater::activated()
+{
+    return m_executor.activated();
+}
+
+void SessionUpdater::update_finished()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    if (pending_requests == 0)
+    {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("SessionUpdater::update_finished BUG, report to devs")));
+        return;
+    }
+
+    --pending_requests;
+
+    m_condition.broadcast();
+}
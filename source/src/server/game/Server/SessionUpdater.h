@@ -0,0 +1,41 @@
+#ifndef _SESSION_UPDATER_H_INCLUDED
+#define _SESSION_UPDATER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "DelayExecutor.h"
+
+class WorldSession;
+
+// Runs the lock domain packets of sessions in parallel, see LockDomain.h
+class SessionUpdater
+{
+    public:
+
+        SessionUpdater();
+        virtual ~SessionUpdater();
+
+        friend class SessionUpdateRequest;
+
+        int schedule_update(WorldSession& session);
+
+        int wait();
+
+        int activate(size_t num_threads);
+
+        int deactivate();
+
+        bool activated();
+
+    private:
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        size_t pending_requests;
+
+        void update_finished();
+};
+
+#endif //_SESSION_UPDATER_H_INCLUDED
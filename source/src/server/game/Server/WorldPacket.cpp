@@ -45,11 +45,12 @@ void WorldPacket::Compress(z_stream* compressionStream)
     *this << uint32(size);
     append(&storage[0], destsize);
     SetOpcode(opcode);
-    TC_LOG_INFO("network.opcode", "%s (len %u) successfully compressed to %04X (len %u)", GetOpcodeNameForLogging(uncompressedOpcode).c_str(), size, opcode, destsize);
+    TC_LOG_TRACE("network.opcode", "%s (len %u) successfully compressed to %04X (len %u)", GetOpcodeNameForLogging(uncompressedOpcode).c_str(), size, opcode, destsize);
 }
 
 //! Compresses another packet and stores it in self (source left intact)
-void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* source)
+//! streamHeader is written in front of the deflate data when starting a raw deflate stream
+void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* source, uint16 streamHeader /*= 0*/)
 {
     ASSERT(source != this);
 
@@ -65,19 +66,27 @@ void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* sourc
     uint32 destsize = compressBound(size);
 
     size_t sizePos = 0;
-    resize(destsize + sizeof(uint32));
+    size_t headerSize = streamHeader ? sizeof(uint16) : 0;
+    resize(destsize + sizeof(uint32) + headerSize);
 
     _compressionStream = compressionStream;
-    Compress(static_cast<void*>(&_storage[0] + sizeof(uint32)), &destsize, static_cast<const void*>(source->contents()), size);
+    Compress(static_cast<void*>(&_storage[0] + sizeof(uint32) + headerSize), &destsize, static_cast<const void*>(source->contents()), size);
     if (destsize == 0)
         return;
 
     put<uint32>(sizePos, size);
-    resize(destsize + sizeof(uint32));
+    if (streamHeader)
+    {
+        // zlib stream header is big endian
+        _storage[sizeof(uint32)] = uint8(streamHeader >> 8);
+        _storage[sizeof(uint32) + 1] = uint8(streamHeader & 0xFF);
+    }
+
+    resize(destsize + sizeof(uint32) + headerSize);
 
     SetOpcode(opcode);
 
-    TC_LOG_INFO("network.opcode", "%s (len %u) successfully compressed to %04X (len %u)", GetOpcodeNameForLogging(uncompressedOpcode).c_str(), size, opcode, destsize);
+    TC_LOG_TRACE("network.opcode", "%s (len %u) successfully compressed to %04X (len %u)", GetOpcodeNameForLogging(uncompressedOpcode).c_str(), size, opcode, destsize);
 }
 
 void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src_size)
@@ -51,7 +51,7 @@ class WorldPacket : public ByteBuffer
         Opcodes GetOpcode() const { return m_opcode; }
         void SetOpcode(Opcodes opcode) { m_opcode = opcode; }
         void Compress(z_stream_s* compressionStream);
-        void Compress(z_stream_s* compressionStream, WorldPacket const* source);
+        void Compress(z_stream_s* compressionStream, WorldPacket const* source, uint16 streamHeader = 0);
 
     protected:
         Opcodes m_opcode;
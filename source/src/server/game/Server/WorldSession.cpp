@@ -43,6 +43,9 @@
 #include "zlib.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
+#include "TickProfiler.h"
+#include "LockDomain.h"
+#include "PreparedPacket.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
 
@@ -96,6 +99,18 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+bool LockDomainSessionFilter::Process(WorldPacket* packet)
+{
+    Opcodes opcode = DropHighBytes(packet->GetOpcode());
+    OpcodeHandler const* opHandle = opcodeTable[opcode];
+
+    Player* player = m_pSession->GetPlayer();
+    m_matched = opHandle->LockDomains && opHandle->ProcessingPlace == PROCESS_THREADUNSAFE
+        && opHandle->Status == STATUS_LOGGEDIN && player && player->IsInWorld();
+
+    return m_matched && !m_peek;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, uint8 mute_type, LocaleConstant locale, uint32 recruiter, bool isARecruiter, uint32 account_flags):
     m_muteTime(mute_time),
@@ -103,6 +118,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_timeOutTime(0),
     _player(NULL),
     m_Socket(sock),
+    _sink(NULL),
     _security(sec),
     _accountId(id),
     m_expansion(expansion),
@@ -192,19 +208,6 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     }
 
     InitializeQueryCallbackParameters();
-
-    _compressionStream = new z_stream();
-    _compressionStream->zalloc = (alloc_func)NULL;
-    _compressionStream->zfree = (free_func)NULL;
-    _compressionStream->opaque = (voidpf)NULL;
-    _compressionStream->avail_in = 0;
-    _compressionStream->next_in = NULL;
-    int32 z_res = deflateInit(_compressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        TC_LOG_ERROR("network.opcode", "Can't initialize packet compression (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        return;
-    }
 }
 
 /// WorldSession destructor
@@ -231,12 +234,6 @@ WorldSession::~WorldSession()
         delete packet;
 
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
-
-    int32 z_res = deflateEnd(_compressionStream);
-    if (z_res != Z_OK && z_res != Z_DATA_ERROR) // Z_DATA_ERROR signals that internal state was BUSY
-        TC_LOG_ERROR("network.opcode", "Can't close packet compression stream (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-
-    delete _compressionStream;
 }
 
 std::string const & WorldSession::GetPlayerName() const
@@ -265,18 +262,48 @@ uint32 WorldSession::GetGuidLow() const
 void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
 {
     if (!m_Socket)
+    {
+        if (_sink && CheckOutgoingPacket(packet, forced))
+            _sink->OnSendPacket(*packet);
         return;
+    }
     //    TC_LOG_INFO("server.worldserver", "send opcode: %s size: (len: %u)", GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), packet->size());
 
+    if (!CheckOutgoingPacket(packet, forced))
+        return;
+
+    if (m_Socket->SendPacket(*packet) == -1)
+        m_Socket->CloseSocket();
+}
+
+/// Send a packet which is broadcast to many sessions, see PreparedPacket
+void WorldSession::SendPacket(PreparedPacket* packet)
+{
+    if (!m_Socket)
+    {
+        if (_sink && CheckOutgoingPacket(packet->GetPacket(), false))
+            _sink->OnSendPacket(*packet->GetPacket());
+        return;
+    }
+
+    if (!CheckOutgoingPacket(packet->GetPacket(), false))
+        return;
+
+    if (m_Socket->SendPacket(*packet) == -1)
+        m_Socket->CloseSocket();
+}
+
+bool WorldSession::CheckOutgoingPacket(WorldPacket const* packet, bool forced)
+{
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
     else if (packet->GetOpcode() == UNKNOWN_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to %s", GetPlayerInfo().c_str());
-        return;
+        return false;
     }
 
     if (!forced)
@@ -286,7 +313,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         {
             TC_LOG_INFO("misc", "STATUS_UNHANDLED: %s (len: %u)", GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), packet->size());
             TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), GetPlayerInfo().c_str());
-            return;
+            return false;
         }
     }
 
@@ -324,8 +351,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     }
 #endif                                                      // !TRINITY_DEBUG
 
-    if (m_Socket->SendPacket(*packet) == -1)
-        m_Socket->CloseSocket();
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -370,7 +396,7 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
     if (packet->rpos() < packet->wpos())
         TC_LOG_INFO("misc", "UNPROCESSED: %s (%u of %u)", GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), uint32(packet->rpos()), uint32(packet->wpos()));
 
-    if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE) || packet->rpos() >= packet->wpos())
+    if (!TC_LOG_ENABLED("network.opcode", LOG_LEVEL_TRACE) || packet->rpos() >= packet->wpos())
         return;
 
     TC_LOG_TRACE("network.opcode", "Unprocessed tail data (read stop at %u from %u) Opcode %s from %s",
@@ -386,7 +412,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Before we process anything:
     /// If necessary, kick the player from the character select screen
-    if (IsConnectionIdle())
+    if (IsConnectionIdle() && m_Socket)
         m_Socket->CloseSocket();
 
     const uint32 opcodeMinTime = 50;
@@ -405,11 +431,12 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! delayed packets that were re-enqueued due to improper timing. To prevent an infinite
     //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
-    while (m_Socket && !m_Socket->IsClosed() &&
+    while (IsConnected() &&
             !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
             _recvQueue.next(packet, updater))
     {
         opcodeStartTime = getMSTime();
+        ProfileScope opcodeProfile(sTickProfiler->GetOpcodeSectionId(packet->GetOpcode()));
         OpcodeHandler const* opHandle = opcodeTable[packet->GetOpcode()];
         try
         {
@@ -436,7 +463,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     }
                     else if (_player->IsInWorld())
                     {
-                        sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+                        sScriptMgr->OnPacketReceive(m_Socket, *packet);
                         (this->*opHandle->Handler)(*packet);
                         LogUnprocessedTail(packet);
                     }
@@ -449,7 +476,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else
                     {
                         // not expected _player or must checked in packet hanlder
-                        sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+                        sScriptMgr->OnPacketReceive(m_Socket, *packet);
                         (this->*opHandle->Handler)(*packet);
                         LogUnprocessedTail(packet);
                     }
@@ -461,7 +488,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         LogUnexpectedOpcode(packet, "STATUS_TRANSFER", "the player is still in world");
                     else
                     {
-                        sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+                        sScriptMgr->OnPacketReceive(m_Socket, *packet);
                         (this->*opHandle->Handler)(*packet);
                         LogUnprocessedTail(packet);
                     }
@@ -479,7 +506,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     if (packet->GetOpcode() == CMSG_CHAR_ENUM)
                         m_playerRecentlyLogout = false;
 
-                    sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
+                    sScriptMgr->OnPacketReceive(m_Socket, *packet);
                     (this->*opHandle->Handler)(*packet);
                     LogUnprocessedTail(packet);
                     break;
@@ -541,13 +568,63 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
-        if (!m_Socket)
+        if (!m_Socket && !_sink)
             return false;                                       //Will remove this session from the world session map
     }
 
     return true;
 }
 
+bool WorldSession::HasLockDomainPackets()
+{
+    WorldPacket* packet = NULL;
+    LockDomainSessionFilter filter(this, true);
+    _recvQueue.next(packet, filter);
+    return filter.Matched();
+}
+
+/// Runs in parallel with other sessions, the handlers only share state guarded by their lock domains
+void WorldSession::ProcessLockDomainPackets()
+{
+    const uint32 opcodeMinTime = 50;
+
+    WorldPacket* packet = NULL;
+    LockDomainSessionFilter filter(this);
+    while (IsConnected() && _recvQueue.next(packet, filter))
+    {
+        uint32 opcodeStartTime = getMSTime();
+        OpcodeHandler const* opHandle = opcodeTable[packet->GetOpcode()];
+        {
+            ProfileScope opcodeProfile(sTickProfiler->GetOpcodeSectionId(packet->GetOpcode()));
+            LockDomainGuard guard(opHandle->LockDomains);
+            try
+            {
+                sScriptMgr->OnPacketReceive(m_Socket, *packet);
+                (this->*opHandle->Handler)(*packet);
+                LogUnprocessedTail(packet);
+            }
+            catch(ByteBufferException &)
+            {
+                TC_LOG_INFO("misc", "EXCEPTION: %s (len: %u)", GetOpcodeNameForLogging(packet->GetOpcode()).c_str(), packet->size());
+                TC_LOG_ERROR("network.opcode", "WorldSession::ProcessLockDomainPackets ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i. Skipped packet.",
+                        packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+                packet->hexlike();
+            }
+        }
+
+        uint32 opcodeProcessTime = GetMSTimeDiffToNow(opcodeStartTime);
+        if (opcodeProcessTime >= opcodeMinTime)
+        {
+            PreparedStatement *stmt = WorldDatabase.GetPreparedStatement(WORLD_INS_SLOW_OPCODE);
+            stmt->setUInt32(0, packet->GetOpcode());
+            stmt->setUInt32(1, opcodeProcessTime);
+            WorldDatabase.Execute(stmt);
+        }
+
+        delete packet;
+    }
+}
+
 /// %Log the player out
 void WorldSession::LogoutPlayer(bool Save)
 {
@@ -683,7 +760,7 @@ void WorldSession::LogoutPlayer(bool Save)
         //! Since each account can only have one online character at any given time, ensure all characters for active account are marked as offline
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ACCOUNT_ONLINE);
         stmt->setUInt32(0, GetAccountId());
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, MAKE_DB_AFFINITY_KEY(DB_AFFINITY_ACCOUNT, GetAccountId()));
     }
 
     m_playerLogout = false;
@@ -700,6 +777,16 @@ void WorldSession::KickPlayer(const char *reason)
         m_Socket->CloseSocket();
         forceExit = true;
     }
+    else if (_sink)
+    {
+        _sink->OnClose();
+        _sink = NULL;
+    }
+}
+
+bool WorldSession::IsConnected() const
+{
+    return m_Socket ? !m_Socket->IsClosed() : _sink != NULL;
 }
 
 bool WorldSession::AntiCheatNotificationRequest()
@@ -972,10 +1059,12 @@ void WorldSession::SetAccountData(AccountDataType type, time_t tm, std::string c
 {
     uint32 id = 0;
     uint32 index = 0;
+    uint64 affinityKey = 0;
     if ((1 << type) & GLOBAL_CACHE_MASK)
     {
         id = GetAccountId();
         index = CHAR_REP_ACCOUNT_DATA;
+        affinityKey = MAKE_DB_AFFINITY_KEY(DB_AFFINITY_ACCOUNT, id);
     }
     else
     {
@@ -985,6 +1074,7 @@ void WorldSession::SetAccountData(AccountDataType type, time_t tm, std::string c
 
         id = m_GUIDLow;
         index = CHAR_REP_PLAYER_ACCOUNT_DATA;
+        affinityKey = MAKE_DB_AFFINITY_KEY(DB_AFFINITY_CHARACTER, id);
     }
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(index);
@@ -992,7 +1082,7 @@ void WorldSession::SetAccountData(AccountDataType type, time_t tm, std::string c
     stmt->setUInt8 (1, type);
     stmt->setUInt32(2, uint32(tm));
     stmt->setString(3, data);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, affinityKey);
 
     m_accountData[type].Time = tm;
     m_accountData[type].Data = data;
@@ -40,6 +40,7 @@ class Item;
 class LoginQueryHolder;
 class Object;
 class Player;
+class PreparedPacket;
 class Quest;
 class SpellCastTargets;
 class Unit;
@@ -191,6 +192,25 @@ public:
     virtual bool Process(WorldPacket* packet);
 };
 
+//filters thread-unsafe packets with lock domains from the head of the queue,
+//they are processed by the session update threads, see LockDomain.h
+class LockDomainSessionFilter : public PacketFilter
+{
+public:
+    explicit LockDomainSessionFilter(WorldSession* pSession, bool peek = false) : PacketFilter(pSession), m_peek(peek), m_matched(false) {}
+    ~LockDomainSessionFilter() {}
+
+    virtual bool Process(WorldPacket* packet);
+    virtual bool ProcessLogout() const { return false; }
+
+    //a peeking filter only records whether the packet matched and leaves it in the queue
+    bool Matched() const { return m_matched; }
+
+private:
+    bool const m_peek;
+    bool m_matched;
+};
+
 // Proxy structure to contain data passed to callback function,
 // only to prevent bloating the parameter list
 class CharacterCreateInfo
@@ -272,6 +292,18 @@ private:
     time_t m_lastLog;
 };
 
+/// Receives the output of a session without socket, used by tools which drive sessions in process
+class WorldSessionSink
+{
+    public:
+        virtual ~WorldSessionSink() { }
+
+        /// Called from every thread which sends to the session, map updates included
+        virtual void OnSendPacket(WorldPacket const& packet) = 0;
+        /// The session was kicked, it is removed from the world with its next update
+        virtual void OnClose() { }
+};
+
 /// Player session in the World
 class WorldSession
 {
@@ -283,7 +315,10 @@ class WorldSession
         bool PlayerLogout() const { return m_playerLogout; }
         bool PlayerLogoutWithSave() const { return m_playerLogout && m_playerSave; }
         bool PlayerRecentlyLoggedOut() const { return m_playerRecentlyLogout; }
-        bool PlayerDisconnected() const { return !m_Socket; }
+        bool PlayerDisconnected() const { return !m_Socket && !_sink; }
+
+        /// Attaches a session created without socket, it then stays in the world like a connected one until kicked
+        void SetSink(WorldSessionSink* sink) { _sink = sink; }
         /*
             Implementing Shadow Mute
         */
@@ -307,6 +342,7 @@ class WorldSession
         bool IsAddonRegistered(const std::string& prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(PreparedPacket* packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName *declinedName);
@@ -370,6 +406,10 @@ class WorldSession
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
 
+        /// Lock domain packets at the head of the receive queue, run by the session update threads before Update()
+        bool HasLockDomainPackets();
+        void ProcessLockDomainPackets();
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -482,8 +522,6 @@ class WorldSession
         uint32 GetRecruiterId() const { return recruiterId; }
         bool IsARecruiter() const { return isRecruiter; }
 
-        z_stream_s* GetCompressionStream() { return _compressionStream; }
-
         bool HandleMovementInfo(MovementInfo &movementInfo, const uint16 opcode, const size_t packSize, Unit *mover);
         bool CanMovementBeProcessed(uint16 opcode);
 
@@ -1207,6 +1245,7 @@ class WorldSession
         uint32 m_GUIDLow;                                   // set loggined or recently logout player (while m_playerRecentlyLogout set)
         Player* _player;
         WorldSocket* m_Socket;
+        WorldSessionSink* _sink;
         std::string m_Address;
         uint32 m_Address_Masked{ 0 };
         std::string m_OperatingSystem{ "" };
@@ -1240,6 +1279,8 @@ class WorldSession
         uint32 m_accessFlags;
         uint32 expireTime;
         bool forceExit;
+
+        bool IsConnected() const;
         bool is_requesting_new_character{ false };
         AccountPerkList m_PremiumPerks;
         
@@ -1248,7 +1289,7 @@ class WorldSession
 
         int64 _timeSyncClockDelta;
         ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
-        z_stream_s* _compressionStream;
+        bool CheckOutgoingPacket(WorldPacket const* packet, bool forced);
 
         PacketThrottler m_packetThrottler;
 };
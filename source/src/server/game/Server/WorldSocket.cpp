@@ -24,8 +24,11 @@
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
 #include <ace/OS_NS_string.h>
+#include <ace/os_include/sys/os_uio.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
+#include <zlib.h>
 
 #include "WorldSocket.h"
 #include "Common.h"
@@ -43,6 +46,7 @@
 #include "WorldSocketMgr.h"
 #include "Log.h"
 #include "PacketLog.h"
+#include "PreparedPacket.h"
 #include "ScriptMgr.h"
 #include "AccountMgr.h"
 
@@ -99,16 +103,30 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+/// Senders get an error once this much is queued or prepared and not sent yet
+#define MAX_OUTPUT_QUEUE_BYTES (8 * 1024 * 1024)
+
+/// Most buffers written by one sendmsg call
+#define MAX_OUTPUT_VECTORS 64
+
+/// Handshake packets kept for the packet log until the account is known, a handshake takes only a few
+#define MAX_CAPTURE_PENDING_PACKETS 16
+
+static std::atomic<uint64> outputSyscalls(0);
+static std::atomic<uint64> outputBytes(0);
+static std::atomic<uint64> outputPackets(0);
+static std::atomic<uint32> outputQueuedPackets(0);
+static std::atomic<uint32> outputMaxQueueDepth(0);
+
 WorldSocket::WorldSocket (void): WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof (ClientPktHeader)),
-m_OutBuffer(0), m_OutBufferSize(65536), m_OutActive(false),
-m_Seed(static_cast<uint32> (rand32())), m_forceCloseTime(0x8FFFFFFF)
+m_OutQueueSize(0), m_OutQueueBytes(0),
+m_OutBuffer(0), m_OutBufferSize(65536), m_OutPendingBytes(0), m_CompressionStream(NULL), m_CompressionStarted(false), m_OutActive(false),
+m_Seed(static_cast<uint32> (rand32())), m_forceCloseTime(0x8FFFFFFF),
+m_CaptureId(sPacketLog->NewConnectionId()), m_CaptureAccountId(0)
 {
     reference_counting_policy().value (ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
-
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
 }
 
 WorldSocket::~WorldSocket (void)
@@ -118,6 +136,20 @@ WorldSocket::~WorldSocket (void)
     if (m_OutBuffer)
         m_OutBuffer->release();
 
+    for (std::deque<ACE_Message_Block*>::const_iterator itr = m_OutChunks.begin(); itr != m_OutChunks.end(); ++itr)
+        (*itr)->release();
+
+    outputQueuedPackets -= m_OutQueueSize.load();
+
+    if (m_CompressionStream)
+    {
+        int32 z_res = deflateEnd(m_CompressionStream);
+        if (z_res != Z_OK && z_res != Z_DATA_ERROR) // Z_DATA_ERROR signals that internal state was BUSY
+            TC_LOG_ERROR("network.opcode", "Can't close packet compression stream (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
+
+        delete m_CompressionStream;
+    }
+
     closing_ = true;
 
     peer().close();
@@ -154,64 +186,242 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
 {
-    ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
+    return SendPacket(pct, NULL);
+}
 
+int WorldSocket::SendPacket(PreparedPacket& pct)
+{
+    return SendPacket(*pct.GetPacket(), &pct);
+}
+
+int WorldSocket::SendPacket(WorldPacket const& pct, PreparedPacket* prepared)
+{
     if (closing_)
         return -1;
 
     // Dump outgoing packet
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(pct, SERVER_TO_CLIENT);
+        CapturePacket(pct, SERVER_TO_CLIENT);
+
+    if (m_Session)
+        TC_LOG_TRACE("network.opcode", "S->C: %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(pct.GetOpcode()).c_str());
 
-    WorldPacket const* pkt = &pct;
+    sScriptMgr->OnPacketSend(this, pct);
 
-    // Empty buffer used in case packet should be compressed
-    WorldPacket buff;
-    if (m_Session && pkt->size() > 0x400)
+    // a peer which doesn't read keeps its output prepared, it counts as well
+    if (m_OutQueueBytes.load(std::memory_order_relaxed) + m_OutPendingBytes.load(std::memory_order_relaxed) + pct.size() > MAX_OUTPUT_QUEUE_BYTES)
     {
-        buff.Compress(m_Session->GetCompressionStream(), pkt);
-        pkt = &buff;
+        TC_LOG_ERROR("network.opcode", "WorldSocket::SendPacket output queue of %s is full", GetRemoteAddress().c_str());
+        return -1;
     }
 
-    if (m_Session)
-        TC_LOG_TRACE("network.opcode", "S->C: %s %s", m_Session->GetPlayerInfo().c_str(), GetOpcodeNameForLogging(pkt->GetOpcode()).c_str());
+    bool compress = m_Session && m_CompressionStream && pct.size() > PACKET_COMPRESSION_THRESHOLD;
 
-    sScriptMgr->OnPacketSend(this, *pkt);
+    OutgoingPacket* out;
+    // a started stream stays started, the network thread can always append the shared body
+    if (compress && prepared && m_CompressionStarted.load(std::memory_order_acquire) && prepared->GetSourceBody())
+    {
+        ACE_NEW_RETURN(out, OutgoingPacket(), -1);
+        out->Packet.SetOpcode(pct.GetOpcode());
+        out->SharedSource = prepared->GetSourceBody()->duplicate();
+        out->SharedBody = prepared->GetCompressedBody()->duplicate();
+        out->SharedOpcode = uint16(prepared->GetCompressedPacket()->GetOpcode());
+    }
+    else
+    {
+        ACE_NEW_RETURN(out, OutgoingPacket(pct), -1);
+        out->Compress = compress;
+    }
 
-    ServerPktHeader header(pkt->size()+2, pkt->GetOpcode());
-    m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
+    out->Size = pct.size();
+    m_OutQueueBytes += out->Size;
+    ++m_OutQueueSize;
+    ++outputQueuedPackets;
 
-    if (m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && msg_queue()->is_empty())
-    {
-        // Put the packet on the buffer.
-        if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
-            ACE_ASSERT (false);
+    m_OutQueue.Enqueue(out);
+    return 0;
+}
 
-        if (!pkt->empty())
-            if (m_OutBuffer->copy((char*) pkt->contents(), pkt->size()) == -1)
-                ACE_ASSERT (false);
+void WorldSocket::CapturePacket(WorldPacket const& pct, Direction direction)
+{
+    if (m_CaptureAccountId || sPacketLog->CapturesAllAccounts())
+    {
+        sPacketLog->LogPacket(pct, direction, m_CaptureId, m_CaptureAccountId);
+        return;
     }
-    else
+
+    // only the network thread sends and receives before authentication
+    if (m_CapturePending.size() >= MAX_CAPTURE_PENDING_PACKETS)
+        return;
+
+    CapturedPacket captured;
+    captured.Packet = pct;
+    captured.PacketDirection = direction;
+    captured.Time = getMSTime();
+    m_CapturePending.push_back(captured);
+}
+
+void WorldSocket::FlushCapturedPackets()
+{
+    if (sPacketLog->CanLogPacket() && sPacketLog->CapturesAccount(m_CaptureAccountId))
+        for (std::vector<CapturedPacket>::const_iterator itr = m_CapturePending.begin(); itr != m_CapturePending.end(); ++itr)
+            sPacketLog->LogPacket(itr->Packet, itr->PacketDirection, m_CaptureId, m_CaptureAccountId, itr->Time);
+
+    std::vector<CapturedPacket>().swap(m_CapturePending);
+}
+
+SocketOutputStats WorldSocket::GetOutputStats()
+{
+    SocketOutputStats stats;
+    stats.Syscalls = outputSyscalls.load(std::memory_order_relaxed);
+    stats.Bytes = outputBytes.load(std::memory_order_relaxed);
+    stats.Packets = outputPackets.load(std::memory_order_relaxed);
+    stats.QueuedPackets = outputQueuedPackets.load(std::memory_order_relaxed);
+    stats.MaxQueueDepth = outputMaxQueueDepth.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorldSocket::PrepareOutput()
+{
+    uint32 count = 0;
+    // nothing more is prepared while the peer is behind, the rest waits in the queue
+    while (m_OutPendingBytes.load(std::memory_order_relaxed) < MAX_OUTPUT_QUEUE_BYTES)
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
+        OutgoingPacket* out = m_OutQueue.Dequeue();
+        if (!out)
+            break;
 
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pkt->size() + header.getHeaderLength()), -1);
+        ++count;
+        m_OutQueueBytes -= out->Size;
 
-        mb->copy((char*) header.header, header.getHeaderLength());
+        ACE_Message_Block* body = NULL;
+        uint32 size = 0;
+        uint16 opcode = 0;
 
-        if (!pkt->empty())
-            mb->copy((const char*)pkt->contents(), pkt->size());
+        if (out->SharedBody)
+        {
+            if (AppendSharedCompressedPacket(out->SharedSource))
+            {
+                body = out->SharedBody;
+                size = uint32(body->length());
+                opcode = out->SharedOpcode;
+            }
+            else
+            {
+                // compress it on our own stream like any other packet
+                out->Packet.append((uint8 const*)out->SharedSource->rd_ptr(), out->SharedSource->length());
+                out->Compress = true;
+            }
+        }
 
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        WorldPacket const* pkt = &out->Packet;
+        // Empty buffer used in case packet should be compressed
+        WorldPacket buff;
+        if (!body)
         {
-            TC_LOG_ERROR("network.opcode", "WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
-            return -1;
+            if (out->Compress)
+            {
+                CompressPacket(pkt, buff);
+                pkt = &buff;
+            }
+
+            size = uint32(pkt->size());
+            opcode = uint16(pkt->GetOpcode());
         }
+
+        ServerPktHeader header(size + 2, opcode);
+        m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
+        AppendOutput((char const*)header.header, header.getHeaderLength());
+
+        if (body)
+            AppendOutput(body->duplicate());
+        else if (!pkt->empty())
+            AppendOutput((char const*)pkt->contents(), pkt->size());
+
+        m_OutPendingBytes += header.getHeaderLength() + size;
+
+        delete out;
     }
 
-    return 0;
+    if (!count)
+        return;
+
+    m_OutQueueSize -= count;
+    outputQueuedPackets -= count;
+    outputPackets += count;
+
+    uint32 maxDepth = outputMaxQueueDepth.load(std::memory_order_relaxed);
+    while (count > maxDepth && !outputMaxQueueDepth.compare_exchange_weak(maxDepth, count, std::memory_order_relaxed))
+        ;
+}
+
+void WorldSocket::AppendOutput(char const* data, size_t size)
+{
+    if (m_OutBuffer->space() < size)
+        m_OutBuffer->crunch();
+
+    if (m_OutBuffer->space() < size)
+    {
+        // packets larger than the buffer get a block of their own
+        if (size > m_OutBufferSize)
+        {
+            ACE_Message_Block* chunk = new ACE_Message_Block(size);
+            chunk->copy(data, size);
+            AppendOutput(chunk);
+            return;
+        }
+
+        m_OutChunks.push_back(m_OutBuffer);
+        m_OutBuffer = new ACE_Message_Block(m_OutBufferSize);
+    }
+
+    if (m_OutBuffer->copy(data, size) == -1)
+        ACE_ASSERT (false);
+}
+
+void WorldSocket::AppendOutput(ACE_Message_Block* body)
+{
+    // everything collected so far is sent first
+    if (m_OutBuffer->length())
+    {
+        m_OutChunks.push_back(m_OutBuffer);
+        m_OutBuffer = new ACE_Message_Block(m_OutBufferSize);
+    }
+
+    m_OutChunks.push_back(body);
+}
+
+void WorldSocket::CompressPacket(WorldPacket const* source, WorldPacket& dest)
+{
+    uint16 streamHeader = 0;
+    if (!m_CompressionStarted.load(std::memory_order_relaxed))
+    {
+        // same header deflateInit would write: 32K window deflate, level hint, check bits
+        int32 level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+        uint16 levelFlags = level == Z_DEFAULT_COMPRESSION ? 2 : level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+        streamHeader = (0x78 << 8) | (levelFlags << 6);
+        streamHeader += 31 - (streamHeader % 31);
+    }
+
+    dest.Compress(m_CompressionStream, source, streamHeader);
+    if (dest.GetOpcode() & COMPRESSED_OPCODE_MASK)
+        m_CompressionStarted.store(true, std::memory_order_release);
+}
+
+bool WorldSocket::AppendSharedCompressedPacket(ACE_Message_Block const* source)
+{
+    if (!m_CompressionStarted.load(std::memory_order_relaxed))
+        return false;
+
+    // the client inflates the shared body into its window, our deflate history has to match it
+    int32 z_res = deflateSetDictionary(m_CompressionStream, (Bytef const*)source->rd_ptr(), uInt(source->length()));
+    if (z_res != Z_OK)
+    {
+        TC_LOG_ERROR("network.opcode", "Can't append shared packet to compression stream (zlib: deflateSetDictionary) Error code: %i (%s)", z_res, zError(z_res));
+        return false;
+    }
+
+    return true;
 }
 
 long WorldSocket::AddReference (void)
@@ -243,6 +453,16 @@ int WorldSocket::open (void *a)
     // Allocate the buffer.
     ACE_NEW_RETURN (m_OutBuffer, ACE_Message_Block (m_OutBufferSize), -1);
 
+    // raw stream, the zlib header is written by CompressPacket
+    ACE_NEW_RETURN (m_CompressionStream, z_stream(), -1);
+    int32 z_res = deflateInit2(m_CompressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    if (z_res != Z_OK)
+    {
+        TC_LOG_ERROR("network.opcode", "Can't initialize packet compression (zlib: deflateInit2) Error code: %i (%s)", z_res, zError(z_res));
+        delete m_CompressionStream;
+        m_CompressionStream = NULL;
+    }
+
     // Store peer address.
     ACE_INET_Addr remote_addr;
 
@@ -330,104 +550,83 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
+    PrepareOutput();
 
-    if (send_len == 0)
-        return handle_output_queue(Guard);
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+    // everything waiting goes out with a single call
+    iovec iov[MAX_OUTPUT_VECTORS];
+    int count = 0;
+    size_t send_len = 0;
 
-    if (n == 0)
-        return -1;
-    else if (n == -1)
+    for (std::deque<ACE_Message_Block*>::const_iterator itr = m_OutChunks.begin(); itr != m_OutChunks.end() && count < MAX_OUTPUT_VECTORS; ++itr)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output (Guard);
-
-        return -1;
+        iov[count].iov_base = (*itr)->rd_ptr();
+        iov[count].iov_len = (*itr)->length();
+        send_len += (*itr)->length();
+        ++count;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
-
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
-    {
-        m_OutBuffer->reset();
-
-        return handle_output_queue (Guard);
-    }
-
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue (GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    if (count < MAX_OUTPUT_VECTORS && m_OutBuffer->length())
     {
-        TC_LOG_ERROR("network.opcode", "WorldSocket::handle_output_queue dequeue_head");
-        return -1;
+        iov[count].iov_base = m_OutBuffer->rd_ptr();
+        iov[count].iov_len = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++count;
     }
 
-    const size_t send_len = mblk->length();
+    if (send_len == 0)
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    ssize_t n = ACE_OS::sendmsg (get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
+    ssize_t n = peer().sendv (iov, count);
 #endif // MSG_NOSIGNAL
 
-    if (n == 0)
-    {
-        mblk->release();
+    ++outputSyscalls;
 
+    if (n == 0)
         return -1;
-    }
     else if (n == -1)
     {
         if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
-        }
+            return schedule_wakeup_output (Guard);
 
-        mblk->release();
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
-        {
-            TC_LOG_ERROR("network.opcode", "WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
-        }
+    outputBytes += uint64(n);
+    m_OutPendingBytes -= size_t(n);
 
-        return schedule_wakeup_output (g);
-    }
-    else //now n == send_len
+    // release what was sent, a partially sent block is continued next time
+    size_t sent = static_cast<size_t> (n);
+    while (!m_OutChunks.empty() && m_OutChunks.front()->length() <= sent)
     {
-        mblk->release();
+        sent -= m_OutChunks.front()->length();
+        m_OutChunks.front()->release();
+        m_OutChunks.pop_front();
+    }
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
+    if (!m_OutChunks.empty())
+        m_OutChunks.front()->rd_ptr(sent);
+    else
+    {
+        m_OutBuffer->rd_ptr(sent);
+        if (m_OutBuffer->length() == 0)
+            m_OutBuffer->reset();
     }
 
-    ACE_NOTREACHED(return -1);
+    if (n < (ssize_t)send_len)
+        return schedule_wakeup_output (Guard);
+
+    // more blocks than a single call takes
+    if (!m_OutChunks.empty() || m_OutBuffer->length())
+        return ACE_Event_Handler::WRITE_MASK;
+
+    return cancel_wakeup_output(Guard);
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
@@ -466,7 +665,7 @@ int WorldSocket::Update (void)
 
     {
         ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, 0);
-        if (m_OutBuffer->length() == 0 && msg_queue()->is_empty())
+        if (m_OutBuffer->length() == 0 && m_OutChunks.empty() && !m_OutQueueSize.load(std::memory_order_acquire))
             return 0;
     }
 
@@ -686,7 +885,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
     // Dump received packet.
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(*new_pct, CLIENT_TO_SERVER);
+        CapturePacket(*new_pct, CLIENT_TO_SERVER);
 
     std::string opcodeName = GetOpcodeNameForLogging(opcode);
     if (m_Session)
@@ -705,23 +904,23 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
                     return -1;
                 }
 
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return HandleAuthSession(*new_pct);
             case CMSG_KEEP_ALIVE:
                 TC_LOG_DEBUG("network.opcode", "%s", opcodeName.c_str());
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return 0;
             case CMSG_LOG_DISCONNECT:
                 new_pct->rfinish(); // contains uint32 disconnectReason;
                 TC_LOG_DEBUG("network.opcode", "%s", opcodeName.c_str());
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return 0;
             // not an opcode, client sends string "WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER" without opcode
             // first 4 bytes become the opcode (2 dropped)
             case MSG_VERIFY_CONNECTIVITY:
             {
                 TC_LOG_DEBUG("network.opcode", "%s", opcodeName.c_str());
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 std::string str;
                 *new_pct >> str;
                 if (str != "D OF WARCRAFT CONNECTION - CLIENT TO SERVER")
@@ -731,7 +930,7 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
             case CMSG_ENABLE_NAGLE:
             {
                 TC_LOG_DEBUG("network.opcode", "%s", opcodeName.c_str());
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return m_Session ? m_Session->HandleEnableNagleAlgorithm() : -1;
             }
             default:
@@ -1037,6 +1236,8 @@ int WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 
     // NOTE ATM the socket is single-threaded, have this in mind ...
     ACE_NEW_RETURN(m_Session, WorldSession(id, this, AccountTypes(security), expansion, mutetime, muteType, locale, recruiter, isRecruiter, accountFlags), -1);
+    m_CaptureAccountId = id;
+    FlushCapturedPackets();
 
     m_Crypt.Init(&k);
 
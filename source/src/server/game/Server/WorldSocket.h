@@ -40,10 +40,50 @@
 
 #include "Common.h"
 #include "AuthCrypt.h"
+#include "MPSCQueue.h"
+#include "PacketLog.h"
+#include "WorldPacket.h"
+
+#include <atomic>
+#include <deque>
 
-class ACE_Message_Block;
-class WorldPacket;
 class WorldSession;
+class PreparedPacket;
+struct z_stream_s;
+
+/// Packet in the output queue of a socket
+struct OutgoingPacket
+{
+    OutgoingPacket() : SharedSource(NULL), SharedBody(NULL), SharedOpcode(0), Compress(false), Size(0) { }
+    explicit OutgoingPacket(WorldPacket const& packet) : Packet(packet), SharedSource(NULL), SharedBody(NULL), SharedOpcode(0), Compress(false), Size(0) { }
+
+    ~OutgoingPacket()
+    {
+        if (SharedSource)
+            SharedSource->release();
+
+        if (SharedBody)
+            SharedBody->release();
+    }
+
+    std::atomic<OutgoingPacket*> QueueNext;
+    WorldPacket Packet;                                     // copy of the packet, only the opcode if it is shared
+    ACE_Message_Block* SharedSource;                        // uncompressed and compressed form of a PreparedPacket
+    ACE_Message_Block* SharedBody;
+    uint16 SharedOpcode;
+    bool Compress;
+    size_t Size;                                            // uncompressed size, counted in the queued bytes
+};
+
+/// Output counters of all world sockets since startup
+struct SocketOutputStats
+{
+    uint64 Syscalls;
+    uint64 Bytes;
+    uint64 Packets;
+    uint32 QueuedPackets;                                   // waiting for a network thread right now
+    uint32 MaxQueueDepth;                                   // most packets a single flush of one socket picked up
+};
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -105,11 +145,18 @@ class WorldSocket : public WorldHandler
         /// Get address of connected peer.
         const std::string& GetRemoteAddress(void) const;
 
-        /// Send A packet on the socket, this function is reentrant.
+        /// Send A packet on the socket, this function is reentrant and lock-free.
+        /// The packet is copied to the output queue, the network thread compresses,
+        /// encrypts and writes it together with the other packets of its next flush.
         /// @param pct packet to send
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet shared by many sockets, large packets are queued by reference.
+        /// @param pct packet to send
+        /// @return -1 of failure
+        int SendPacket(PreparedPacket& pct);
+
         /// Add reference to this object.
         long AddReference(void);
 
@@ -139,7 +186,25 @@ class WorldSocket : public WorldHandler
 
         uint32 m_forceCloseTime;
 
+        static SocketOutputStats GetOutputStats();
+
     private:
+        int SendPacket(const WorldPacket& pct, PreparedPacket* prepared);
+
+        /// Network thread side of the output, called with m_OutBufferLock held.
+        /// Compresses and encrypts the queued packets into the output chunks.
+        void PrepareOutput();
+        void AppendOutput(char const* data, size_t size);
+        void AppendOutput(ACE_Message_Block* body);
+
+        /// Hands a packet to the packet log, or keeps it until the account is known if only some accounts are captured.
+        void CapturePacket(WorldPacket const& pct, Direction direction);
+        void FlushCapturedPackets();
+
+        /// Packet compression, the socket stream is a raw deflate stream so shared bodies of PreparedPacket can be spliced in
+        void CompressPacket(WorldPacket const* source, WorldPacket& dest);
+        bool AppendSharedCompressedPacket(ACE_Message_Block const* source);
+
         /// Helper functions for processing incoming data.
         int handle_input_header(void);
         int handle_input_payload(void);
@@ -150,9 +215,6 @@ class WorldSocket : public WorldHandler
         int cancel_wakeup_output(GuardType& g);
         int schedule_wakeup_output(GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue(GuardType& g);
-
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
         int ProcessIncoming(WorldPacket* new_pct);
@@ -197,20 +259,50 @@ class WorldSocket : public WorldHandler
         /// Fragment of the received header.
         ACE_Message_Block m_Header;
 
+        /// Packets queued by the senders, consumed by the network thread.
+        ACE_Based::MPSCQueue<OutgoingPacket> m_OutQueue;
+
+        /// Packets and bytes in m_OutQueue.
+        std::atomic<uint32> m_OutQueueSize;
+        std::atomic<size_t> m_OutQueueBytes;
+
         /// Mutex for protecting output related data.
         LockType m_OutBufferLock;
 
-        /// Buffer used for writing output.
+        /// Buffer collecting headers and unshared packets, the last part of the output.
         ACE_Message_Block* m_OutBuffer;
 
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Output in front of m_OutBuffer in send order, full buffers and shared bodies.
+        std::deque<ACE_Message_Block*> m_OutChunks;
+
+        /// Bytes in m_OutChunks and m_OutBuffer not sent yet, counted against the output limit.
+        std::atomic<size_t> m_OutPendingBytes;
+
+        /// Compression stream, only used by the network thread.
+        z_stream_s* m_CompressionStream;
+        std::atomic<bool> m_CompressionStarted;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
         uint32 m_Seed;
 
+        /// Identify this connection and its account in packet captures
+        uint32 m_CaptureId;
+        uint32 m_CaptureAccountId;
+
+        /// Packets of the handshake, held back until the account is known. Network thread only.
+        struct CapturedPacket
+        {
+            WorldPacket Packet;
+            Direction PacketDirection;
+            uint32 Time;
+        };
+
+        std::vector<CapturedPacket> m_CapturePending;
 };
 
 #endif  /* _WORLDSOCKET_H */
@@ -826,7 +826,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetAuraModifiers();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -842,7 +845,17 @@ void AuraEffect::SetAmount(int32 amount)
     m_amount = amount;
     m_canBeRecalculated = false;
     if (GetBase())
+    {
         GetBase()->SetNeedClientUpdateForTargets();
+        InvalidateTargetAuraModifiers();
+    }
+}
+
+void AuraEffect::InvalidateTargetAuraModifiers()
+{
+    Aura::ApplicationMap const& applications = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator itr = applications.begin(); itr != applications.end(); ++itr)
+        itr->second->GetTarget()->InvalidateAuraModifierAggregate(GetAuraType());
 }
 
 void AuraEffect::HandleEffect(AuraApplication * aurApp, uint8 mode, bool apply)
@@ -113,6 +113,8 @@ class AuraEffect
         bool m_extraTick;
     private:
         bool IsPeriodicTickCrit(Unit* target, Unit const* caster) const;
+        // amount changed, drop the cached aura type aggregates of the targets
+        void InvalidateTargetAuraModifiers();
 
     public:
         // aura effect apply/remove handlers
@@ -1183,6 +1183,11 @@ void Aura::SetNeedClientUpdateForTargets() const
 {
     for (ApplicationMap::const_iterator appIter = m_applications.begin(); appIter != m_applications.end(); ++appIter)
         appIter->second->SetNeedClientUpdate();
+
+    // whatever the client has to see changed in the saved aura too
+    if (GetType() == UNIT_AURA_TYPE)
+        if (Player* player = GetUnitOwner()->ToPlayer())
+            player->m_aurasUpdated = true;
 }
 
 // trigger effects on real aura apply/remove
@@ -2073,6 +2073,27 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range);
+
+    if (targets.size() > 1 && !(m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+    {
+        // CheckEffectTarget() tests every target against the destination or the caster,
+        // cast all those rays at once, the single checks are answered by the map's cache
+        Position origin;
+        if (m_targets.HasDst() && !m_targets.HasTraj())
+            origin.Relocate(m_targets.GetDstPos());
+        else
+            origin.Relocate(m_caster);
+
+        std::vector<G3D::Vector3> targetPositions;
+        targetPositions.reserve(targets.size());
+        for (std::list<WorldObject*>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+            if ((*itr)->GetPhaseMask() == m_caster->GetPhaseMask() && *itr != m_caster)
+                targetPositions.push_back(G3D::Vector3((*itr)->GetPositionX(), (*itr)->GetPositionY(), (*itr)->GetPositionZ() + 2.0f));
+
+        std::vector<bool> inLineOfSight;
+        m_caster->GetMap()->isInLineOfSightMany(origin.GetPositionX(), origin.GetPositionY(), origin.GetPositionZ() + 2.0f,
+            targetPositions, m_caster->GetPhaseMask(), inLineOfSight);
+    }
 }
 
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, ConditionList* condList, bool isChainHeal)
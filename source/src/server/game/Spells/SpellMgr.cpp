@@ -402,7 +402,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : _spellGroupGeneration(1)
 {
 }
 
@@ -1787,6 +1787,7 @@ void SpellMgr::LoadSpellGroups()
 
     mSpellSpellGroup.clear();                                  // need for reload case
     mSpellGroupSpell.clear();
+    ++_spellGroupGeneration;
 
     //                                                0     1
     QueryResult result = WorldDatabase.Query("SELECT id, spell_id FROM spell_group");
@@ -1866,6 +1867,7 @@ void SpellMgr::LoadSpellGroupStackRules()
     uint32 oldMSTime = getMSTime();
 
     mSpellGroupStack.clear();                                  // need for reload case
+    ++_spellGroupGeneration;
 
     //                                                       0         1
     QueryResult result = WorldDatabase.Query("SELECT group_id, stack_rule FROM spell_group_stack_rules");
@@ -726,6 +726,8 @@ class SpellMgr
         // Spell Group Stack Rules table
         bool AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, int32 amount, std::map<SpellGroup, int32>& groups) const;
         SpellGroupStackRule CheckSpellGroupStackRules(SpellInfo const* spellInfo1, SpellInfo const* spellInfo2, bool checkSelf = false) const;
+        // changes whenever spell groups or their stack rules are reloaded, see Unit::GetAuraModifierAggregate
+        uint32 GetSpellGroupGeneration() const { return _spellGroupGeneration; }
 
         // Spell proc event table
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
@@ -809,6 +811,7 @@ class SpellMgr
         SpellSpellGroupMap         mSpellSpellGroup;
         SpellGroupSpellMap         mSpellGroupSpell;
         SpellGroupStackMap         mSpellGroupStack;
+        uint32                     _spellGroupGeneration;
         SpellProcEventMap          mSpellProcEventMap;
         SpellProcMap               mSpellProcMap;
         SpellBonusMap              mSpellBonusMap;
@@ -0,0 +1,256 @@
+#include "HousekeepingScheduler.h"
+#include "DatabaseEnv.h"
+#include "Errors.h"
+#include "Log.h"
+#include "TickProfiler.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+#include <algorithm>
+
+// Longest time a due job is deferred, by priority
+static uint32 const HousekeepingMaxDelay[MAX_HOUSEKEEPING_PRIORITY] = { 1 * IN_MILLISECONDS, 10 * IN_MILLISECONDS, MINUTE * IN_MILLISECONDS };
+
+// Async jobs run synchronous queries, the thread needs its own MySQL thread state
+class HousekeepingThreadStartRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class HousekeepingThreadEndRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class HousekeepingJobRequest : public ACE_Method_Request
+{
+    private:
+
+        HousekeepingScheduler& m_scheduler;
+        uint32 m_jobId;
+
+    public:
+
+        HousekeepingJobRequest(HousekeepingScheduler& scheduler, uint32 jobId)
+            : m_scheduler(scheduler), m_jobId(jobId)
+        {
+        }
+
+        virtual int call()
+        {
+            m_scheduler.execute(m_jobId);
+            return 0;
+        }
+};
+
+HousekeepingScheduler::HousekeepingScheduler():
+m_executor(), m_mutex(), m_stopped(false)
+{
+}
+
+HousekeepingScheduler::~HousekeepingScheduler()
+{
+    Stop();
+}
+
+void HousekeepingScheduler::Add(uint32 jobId, char const* name, HousekeepingPriority priority, uint32 estimatedCost, bool async, JobFunction const& function)
+{
+    if (jobId >= m_jobs.size())
+        m_jobs.resize(jobId + 1);
+
+    Job& job = m_jobs[jobId];
+    ASSERT(!job.Added && "housekeeping job added twice");
+
+    job.Name = name;
+    job.Priority = priority;
+    job.Async = async;
+    job.Function = function;
+    job.Added = true;
+    job.Due = false;
+    job.Running = false;
+    job.DueTime = 0;
+    job.EstimatedCost = estimatedCost;
+    job.Runs = 0;
+    job.Deferrals = 0;
+    job.TotalRuntime = 0;
+    job.MaxRuntime = 0;
+    job.TotalLateness = 0;
+    job.MaxLateness = 0;
+}
+
+void HousekeepingScheduler::Start()
+{
+    if (m_executor.start(1, new HousekeepingThreadStartRequest, new HousekeepingThreadEndRequest) == -1)
+    {
+        TC_LOG_ERROR("server.loading", "Can't start the housekeeping thread, database jobs run in the world thread.");
+        m_executor.deactivate();
+    }
+}
+
+void HousekeepingScheduler::Stop()
+{
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_stopped = true;
+    }
+
+    // runs the remaining requests before the thread ends
+    m_executor.deactivate();
+}
+
+void HousekeepingScheduler::Schedule(uint32 jobId)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    ASSERT(jobId < m_jobs.size() && m_jobs[jobId].Added);
+
+    Job& job = m_jobs[jobId];
+    if (job.Due)
+        return;
+
+    job.Due = true;
+    job.DueTime = getMSTime();
+}
+
+void HousekeepingScheduler::Update(uint32 tickStartTime, uint32 budget)
+{
+    std::vector<uint32> dueJobs;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+        if (m_stopped)
+            return;
+
+        for (uint32 i = 0; i < m_jobs.size(); ++i)
+            if (m_jobs[i].Added && m_jobs[i].Due && !m_jobs[i].Running)
+                dueJobs.push_back(i);
+    }
+
+    if (dueJobs.empty())
+        return;
+
+    // Due and DueTime only change in the world thread, no need to lock for them
+    std::sort(dueJobs.begin(), dueJobs.end(), [this](uint32 left, uint32 right)
+    {
+        Job const& a = m_jobs[left];
+        Job const& b = m_jobs[right];
+        if (a.Priority != b.Priority)
+            return a.Priority < b.Priority;
+        return getMSTimeDiff(a.DueTime, b.DueTime) < getMSTimeDiff(b.DueTime, a.DueTime);
+    });
+
+    bool overBudget = false;
+    for (uint32 jobId : dueJobs)
+    {
+        Job& job = m_jobs[jobId];
+        uint32 now = getMSTime();
+        uint32 lateness = getMSTimeDiff(job.DueTime, now);
+
+        if (!job.Async || !m_executor.activated())
+        {
+            uint32 estimatedCost;
+            {
+                TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+                estimatedCost = job.EstimatedCost;
+            }
+
+            if (getMSTimeDiff(tickStartTime, now) + estimatedCost > budget)
+            {
+                // a job deferred for too long runs anyway, but not together with another one over the budget
+                if (lateness < HousekeepingMaxDelay[job.Priority] || overBudget)
+                {
+                    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+                    ++job.Deferrals;
+                    continue;
+                }
+
+                overBudget = true;
+            }
+        }
+
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            job.Due = false;
+            job.Running = true;
+            ++job.Runs;
+            job.TotalLateness += lateness;
+            job.MaxLateness = std::max(job.MaxLateness, lateness);
+        }
+
+        if (job.Async && m_executor.activated())
+        {
+            if (m_executor.execute(new HousekeepingJobRequest(*this, jobId)) != -1)
+                continue;
+
+            TC_LOG_ERROR("misc", "Failed to schedule housekeeping job %s, running it in the world thread.", job.Name.c_str());
+        }
+
+        execute(jobId);
+    }
+}
+
+void HousekeepingScheduler::execute(uint32 jobId)
+{
+    Job& job = m_jobs[jobId];
+
+    uint32 startTime = getMSTime();
+    {
+        ProfileScope jobProfile(sTickProfiler->GetSectionId("Housekeeping::" + job.Name));
+        job.Function();
+    }
+
+    job_finished(jobId, GetMSTimeDiffToNow(startTime));
+}
+
+void HousekeepingScheduler::job_finished(uint32 jobId, uint32 runtime)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    Job& job = m_jobs[jobId];
+    job.Running = false;
+    job.TotalRuntime += runtime;
+    job.MaxRuntime = std::max(job.MaxRuntime, runtime);
+    job.EstimatedCost = (job.EstimatedCost * 3 + runtime) / 4;
+}
+
+std::vector<HousekeepingScheduler::JobStats> HousekeepingScheduler::GetStats() const
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    std::vector<JobStats> stats;
+    for (Job const& job : m_jobs)
+    {
+        if (!job.Added)
+            continue;
+
+        JobStats jobStats;
+        jobStats.Name = job.Name;
+        jobStats.Async = job.Async;
+        jobStats.Due = job.Due;
+        jobStats.EstimatedCost = job.EstimatedCost;
+        jobStats.Runs = job.Runs;
+        jobStats.Deferrals = job.Deferrals;
+        jobStats.TotalRuntime = job.TotalRuntime;
+        jobStats.MaxRuntime = job.MaxRuntime;
+        jobStats.TotalLateness = job.TotalLateness;
+        jobStats.MaxLateness = job.MaxLateness;
+        stats.push_back(jobStats);
+    }
+
+    return stats;
+}
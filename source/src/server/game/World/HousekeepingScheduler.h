@@ -0,0 +1,111 @@
+#ifndef _HOUSEKEEPING_SCHEDULER_H_INCLUDED
+#define _HOUSEKEEPING_SCHEDULER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+
+#include "Define.h"
+#include "DelayExecutor.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+enum HousekeepingPriority
+{
+    HOUSEKEEPING_PRIORITY_HIGH      = 0,                    // deferred up to a second
+    HOUSEKEEPING_PRIORITY_NORMAL    = 1,                    // deferred up to 10 seconds
+    HOUSEKEEPING_PRIORITY_LOW       = 2,                    // deferred up to a minute
+    MAX_HOUSEKEEPING_PRIORITY
+};
+
+/**
+ * Runs the non-gameplay jobs of World::Update() within a tick budget.
+ *
+ * The world timers only mark a job due, Update() runs due jobs by priority as
+ * long as their estimated cost still fits into the budget of the current
+ * tick. Jobs which do not fit are deferred to a later tick, once a job waited
+ * longer than its priority allows it runs anyway, but only one job per tick
+ * may exceed the budget. The estimate starts at the declared cost and follows
+ * the measured run times.
+ *
+ * Async jobs must only touch the databases, they run on a thread of the
+ * scheduler and don't count against the budget. A job which is still running
+ * is not started again.
+ */
+class HousekeepingScheduler
+{
+    public:
+
+        typedef std::function<void()> JobFunction;
+
+        struct JobStats
+        {
+            std::string Name;
+            bool Async;
+            bool Due;
+            uint32 EstimatedCost;
+            uint32 Runs;
+            uint32 Deferrals;                               // ticks the job was due but did not fit
+            uint64 TotalRuntime;
+            uint32 MaxRuntime;
+            uint64 TotalLateness;                           // ms between becoming due and starting
+            uint32 MaxLateness;
+        };
+
+        HousekeepingScheduler();
+        virtual ~HousekeepingScheduler();
+
+        friend class HousekeepingJobRequest;
+
+        // jobId is chosen by the caller, estimatedCost in ms
+        void Add(uint32 jobId, char const* name, HousekeepingPriority priority, uint32 estimatedCost, bool async, JobFunction const& function);
+
+        // starts the thread of async jobs, without it they run in Update() as well
+        void Start();
+
+        // waits for a running async job, nothing is started afterwards
+        void Stop();
+
+        // marks the job due, a job which is already due keeps its time
+        void Schedule(uint32 jobId);
+
+        // runs due jobs, tickStartTime is the getMSTime() the current world tick started at
+        void Update(uint32 tickStartTime, uint32 budget);
+
+        std::vector<JobStats> GetStats() const;
+
+    private:
+
+        struct Job
+        {
+            Job() : Added(false) { }
+
+            std::string Name;
+            HousekeepingPriority Priority;
+            bool Async;
+            JobFunction Function;
+            bool Added;
+            bool Due;
+            bool Running;
+            uint32 DueTime;
+            uint32 EstimatedCost;
+            uint32 Runs;
+            uint32 Deferrals;
+            uint64 TotalRuntime;
+            uint32 MaxRuntime;
+            uint64 TotalLateness;
+            uint32 MaxLateness;
+        };
+
+        void execute(uint32 jobId);
+
+        void job_finished(uint32 jobId, uint32 runtime);
+
+        std::vector<Job> m_jobs;
+
+        DelayExecutor m_executor;
+        mutable ACE_Thread_Mutex m_mutex;
+        bool m_stopped;
+};
+
+#endif //_HOUSEKEEPING_SCHEDULER_H_INCLUDED
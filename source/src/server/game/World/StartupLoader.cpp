@@ -0,0 +1,209 @@
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+// Pool threads run synchronous queries, they need their own MySQL thread state
+class StartupThreadStartRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_Init();
+            return 0;
+        }
+};
+
+class StartupThreadEndRequest : public ACE_Method_Request
+{
+    public:
+
+        virtual int call()
+        {
+            MySQL::Thread_End();
+            return 0;
+        }
+};
+
+class StartupTaskRequest : public ACE_Method_Request
+{
+    private:
+
+        StartupLoader& m_loader;
+        uint32 m_taskId;
+
+    public:
+
+        StartupTaskRequest(StartupLoader& loader, uint32 taskId)
+            : m_loader(loader), m_taskId(taskId)
+        {
+        }
+
+        virtual int call()
+        {
+            m_loader.execute(m_taskId);
+            m_loader.task_finished(m_taskId);
+            return 0;
+        }
+};
+
+StartupLoader::StartupLoader():
+m_startTime(0), m_executor(), m_mutex(), m_condition(m_mutex), pending_tasks(0)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    m_executor.deactivate();
+}
+
+void StartupLoader::Add(char const* name, char const* message, TaskFunction const& function, std::initializer_list<char const*> dependencies)
+{
+    ASSERT(m_taskIds.find(name) == m_taskIds.end() && "startup task added twice");
+
+    uint32 taskId = uint32(m_tasks.size());
+    m_tasks.push_back(Task());
+
+    Task& task = m_tasks.back();
+    task.Name = name;
+    task.Message = message;
+    task.Function = function;
+    task.PendingDependencies = 0;
+    task.StartTime = 0;
+    task.Duration = 0;
+
+    for (char const* dependency : dependencies)
+    {
+        UNORDERED_MAP<std::string, uint32>::const_iterator itr = m_taskIds.find(dependency);
+        if (itr == m_taskIds.end())
+        {
+            TC_LOG_FATAL("server.loading", "Startup task %s depends on %s, which is not added before it.", name, dependency);
+            ASSERT(false);
+        }
+
+        task.Dependencies.push_back(itr->second);
+        m_tasks[itr->second].Dependents.push_back(taskId);
+    }
+
+    m_taskIds[task.Name] = taskId;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    m_startTime = getMSTime();
+
+    if (threads <= 1 || m_tasks.size() <= 1)
+    {
+        threads = 1;
+        for (uint32 i = 0; i < m_tasks.size(); ++i)
+            execute(i);
+    }
+    else
+    {
+        if (m_executor.start(int(threads), new StartupThreadStartRequest, new StartupThreadEndRequest) == -1)
+        {
+            TC_LOG_ERROR("server.loading", "Can't start %u startup loading threads, loading serially.", threads);
+            m_executor.deactivate();
+            Run(1);
+            return;
+        }
+
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            pending_tasks = m_tasks.size();
+            for (uint32 i = 0; i < m_tasks.size(); ++i)
+            {
+                m_tasks[i].PendingDependencies = uint32(m_tasks[i].Dependencies.size());
+                if (!m_tasks[i].PendingDependencies)
+                    schedule(i);
+            }
+
+            while (pending_tasks > 0)
+                m_condition.wait();
+        }
+
+        m_executor.deactivate();
+    }
+
+    report(threads, GetMSTimeDiffToNow(m_startTime));
+}
+
+void StartupLoader::execute(uint32 taskId)
+{
+    Task& task = m_tasks[taskId];
+    if (task.Message)
+        TC_LOG_INFO("server.loading", "%s", task.Message);
+
+    uint32 startTime = getMSTime();
+    task.Function();
+    task.StartTime = getMSTimeDiff(m_startTime, startTime);
+    task.Duration = GetMSTimeDiffToNow(startTime);
+}
+
+void StartupLoader::schedule(uint32 taskId)
+{
+    if (m_executor.execute(new StartupTaskRequest(*this, taskId)) == -1)
+    {
+        // the pool is gone, nothing else can run the task
+        TC_LOG_FATAL("server.loading", "Failed to schedule startup task %s.", m_tasks[taskId].Name.c_str());
+        ASSERT(false);
+    }
+}
+
+void StartupLoader::task_finished(uint32 taskId)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    for (uint32 dependent : m_tasks[taskId].Dependents)
+        if (!--m_tasks[dependent].PendingDependencies)
+            schedule(dependent);
+
+    --pending_tasks;
+
+    if (pending_tasks == 0)
+        m_condition.broadcast();
+}
+
+void StartupLoader::report(uint32 threads, uint32 totalTime) const
+{
+    // earliest possible finish of every task with unlimited threads, the longest chain bounds the loading time
+    std::vector<uint32> pathTime(m_tasks.size(), 0);
+    std::vector<int32> pathPrevious(m_tasks.size(), -1);
+    uint32 lastTask = 0;
+
+    TC_LOG_INFO("server.loading", "Startup tasks (start, duration):");
+    for (uint32 i = 0; i < m_tasks.size(); ++i)
+    {
+        Task const& task = m_tasks[i];
+        for (uint32 dependency : task.Dependencies)
+        {
+            if (pathTime[dependency] > pathTime[i])
+            {
+                pathTime[i] = pathTime[dependency];
+                pathPrevious[i] = int32(dependency);
+            }
+        }
+
+        pathTime[i] += task.Duration;
+        if (pathTime[i] > pathTime[lastTask])
+            lastTask = i;
+
+        TC_LOG_INFO("server.loading", "  %-32s %7u ms %7u ms", task.Name.c_str(), task.StartTime, task.Duration);
+    }
+
+    if (m_tasks.empty())
+        return;
+
+    std::string criticalPath;
+    for (int32 i = int32(lastTask); i >= 0; i = pathPrevious[i])
+        criticalPath = m_tasks[i].Name + (criticalPath.empty() ? "" : " -> ") + criticalPath;
+
+    TC_LOG_INFO("server.loading", ">> Ran %u startup tasks on %u threads in %u ms, critical path %u ms: %s",
+        uint32(m_tasks.size()), threads, totalTime, pathTime[lastTask], criticalPath.c_str());
+}
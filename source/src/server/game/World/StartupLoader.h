@@ -0,0 +1,76 @@
+#ifndef _STARTUP_LOADER_H_INCLUDED
+#define _STARTUP_LOADER_H_INCLUDED
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "DelayExecutor.h"
+#include "UnorderedMap.h"
+
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/**
+ * Runs the startup loaders as a dependency graph.
+ *
+ * Every loader is added as named task together with the tasks it reads data of.
+ * Dependencies have to be added before the task itself, so the order of Add()
+ * is always a valid serial order and the graph can't contain cycles. With more
+ * than one thread the tasks run on a pool as soon as their dependencies are
+ * done, synchronous queries of parallel tasks use different connections of the
+ * database pools.
+ *
+ * The time of every task and the critical path are logged once all finished.
+ */
+class StartupLoader
+{
+    public:
+
+        typedef std::function<void()> TaskFunction;
+
+        StartupLoader();
+        virtual ~StartupLoader();
+
+        friend class StartupTaskRequest;
+
+        // message is logged when the task starts, may be NULL
+        void Add(char const* name, char const* message, TaskFunction const& function, std::initializer_list<char const*> dependencies = std::initializer_list<char const*>());
+
+        // runs all tasks and returns once the last one finished, up to one thread runs them in the order they were added
+        void Run(uint32 threads);
+
+    private:
+
+        struct Task
+        {
+            std::string Name;
+            char const* Message;
+            TaskFunction Function;
+            std::vector<uint32> Dependencies;
+            std::vector<uint32> Dependents;
+            uint32 PendingDependencies;
+            uint32 StartTime;                                   // ms after Run() was called
+            uint32 Duration;
+        };
+
+        void execute(uint32 taskId);
+
+        void schedule(uint32 taskId);
+
+        void task_finished(uint32 taskId);
+
+        void report(uint32 threads, uint32 totalTime) const;
+
+        std::vector<Task> m_tasks;
+        UNORDERED_MAP<std::string, uint32> m_taskIds;
+        uint32 m_startTime;
+
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        size_t pending_tasks;
+};
+
+#endif //_STARTUP_LOADER_H_INCLUDED
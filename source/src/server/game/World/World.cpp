@@ -83,10 +83,14 @@
 #include "CalendarMgr.h"
 #include "BattlefieldMgr.h"
 #include "InfoMgr.h"
-#include "PerformanceLog.h"
 #include "VerificationMgr.h"
 #include "SoloQueue.h"
 #include "ChallengeModeMgr.h"
+#include "TickProfiler.h"
+#include "PreparedPacket.h"
+#include "StartupLoader.h"
+#include "SessionUpdater.h"
+#include "HousekeepingScheduler.h"
 
 ACE_Atomic_Op<ACE_Thread_Mutex, bool> World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -113,6 +117,8 @@ World::World()
     m_startTime = m_gameTime;
     m_maxActiveSessionCount = 0;
     m_maxQueuedSessionCount = 0;
+    m_sessionUpdater = NULL;
+    m_housekeeping = NULL;
     m_PlayerCount = 0;
     m_MaxPlayerCount = 0;
     m_NextDailyQuestReset = 0;
@@ -148,6 +154,9 @@ World::~World()
     while (cliCmdQueue.next(command))
         delete command;
 
+    delete m_sessionUpdater;
+    delete m_housekeeping;
+
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 
@@ -1230,6 +1239,11 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_INFO("server.loading", "Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Snapshots are only read at startup, the directory may change at reload
+    m_snapshotPath = sConfigMgr->GetStringDefault("SnapshotDir", "");
+    if (!m_snapshotPath.empty() && m_snapshotPath.at(m_snapshotPath.length()-1) != '/' && m_snapshotPath.at(m_snapshotPath.length()-1) != '\\')
+        m_snapshotPath.push_back('/');
+
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", false);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
@@ -1273,6 +1287,12 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MAP_UPDATE_REGION_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.RegionThreads", 0);
+    m_int_configs[CONFIG_MAP_UPDATE_PRELOAD_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.PreloadThreads", 1);
+    // same limit as the synchronous connections opened for the loaders in Master
+    m_int_configs[CONFIG_STARTUP_LOAD_THREADS] = std::min(std::max(1, sConfigMgr->GetIntDefault("StartupLoad.Threads", 1)), 255);
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = sConfigMgr->GetIntDefault("SessionUpdate.Threads", 0);
+    m_int_configs[CONFIG_HOUSEKEEPING_TICK_BUDGET] = sConfigMgr->GetIntDefault("Housekeeping.TickBudget", 50);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1414,6 +1434,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_AUCTION_FLOOD_CONTROL_TYPE] = sConfigMgr->GetIntDefault("Auction.FloodControl.Type", 0);
     m_int_configs[CONFIG_AUCTION_FLOOD_CONTROL_VALUE] = sConfigMgr->GetIntDefault("Auction.FloodControl.Count", 0);
 
+    sTickProfiler->LoadConfig();
+
     if (reload)
         sScriptMgr->OnConfigLoad(reload);
 }
@@ -1505,391 +1527,195 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading spell custom attributes...");
     sSpellMgr->LoadSpellCustomAttr();
 
-    TC_LOG_INFO("server.loading", "Loading GameObject models...");
-    LoadGameObjectModelList();
-
     TC_LOG_INFO("server.loading", "Loading Script Names...");
     sObjectMgr->LoadScriptNames();
 
     TC_LOG_INFO("server.loading", "Loading Instance Template...");
     sObjectMgr->LoadInstanceTemplate();
 
-    // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    TC_LOG_INFO("server.loading", "Loading instances...");
-    sInstanceSaveMgr->LoadInstances();
-
     TC_LOG_INFO("server.loading", "Loading Broadcast texts...");
     sObjectMgr->LoadBroadcastTexts();
     sObjectMgr->LoadBroadcastTextLocales();
     sObjectMgr->LoadBroadcastTextHelpers();
     sObjectMgr->LoadBroadcastGroups();
 
-    TC_LOG_INFO("server.loading", "Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-
-
-    TC_LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
-
-    TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Phase Dbc Info...");
-    sObjectMgr->LoadSpellPhaseInfo();
-
-    TC_LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
-
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    TC_LOG_INFO("server.loading", "Loading Disables");                         // must be before loading quests and items
-    DisableMgr::LoadDisables();
-
-    TC_LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Item set names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemTemplateAddon();
-
-    TC_LOG_INFO("misc", "Loading Item Scripts...");                 // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemScriptNames();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Equipment templates...");
-    sObjectMgr->LoadEquipmentTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Creature templates...");
-    sObjectMgr->LoadCreatureTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
-
-    TC_LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Reward OnKill Data...");
-    sObjectMgr->LoadRewardOnKill();
-
-    TC_LOG_INFO("server.loading", "Loading Reputation Spillover Data...");
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
-
-    TC_LOG_INFO("server.loading", "Loading Instance Teleportations Destinations Data...");
-    sObjectMgr->LoadTeleportersDest();
-
-    TC_LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
-
-    TC_LOG_INFO("server.loading", "Loading pet levelup spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
-
-    TC_LOG_INFO("server.loading", "Loading pet default spells additional to levelup spells...");
-    sSpellMgr->LoadPetDefaultSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+    ///- Load the static and dynamic tables. Every loader runs as soon as the tasks it reads
+    ///- data of are done, dependencies have to be added before the task itself.
+    StartupLoader loader;
 
-    TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
+    loader.Add("GameObjectModels", "Loading GameObject models...", [] { LoadGameObjectModelList(); });
 
-    TC_LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
-
-    TC_LOG_INFO("server.loading", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
-
-    TC_LOG_INFO("server.loading", "Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    TC_LOG_INFO("server.loading", "Checking Quest Disables");
-    DisableMgr::CheckQuestDisables();                           // must be after loading quests
-
-    TC_LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    TC_LOG_INFO("server.loading", "Loading Quests Relations...");
-    sObjectMgr->LoadQuestRelations();                            // must be after quest load
-
-    TC_LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    TC_LOG_INFO("server.loading", "Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    TC_LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
-
-    TC_LOG_INFO("server.loading", "Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
-
-    TC_LOG_INFO("server.loading", "Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    TC_LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger script names...");
-    sObjectMgr->LoadAreaTriggerScripts();
-
-    TC_LOG_INFO("server.loading", "Loading LFG entrance positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
-
-    TC_LOG_INFO("server.loading", "Loading Dungeon boss data...");
-    sObjectMgr->LoadInstanceEncounters();
-
-    TC_LOG_INFO("server.loading", "Loading LFG rewards...");
-    sLFGMgr->LoadRewards();
-
-    TC_LOG_INFO("server.loading", "Loading Graveyard-zone links...");
-    sObjectMgr->LoadGraveyardZones();
-
-    TC_LOG_INFO("server.loading", "Loading spell pet auras...");
-    sSpellMgr->LoadSpellPetAuras();
-
-    TC_LOG_INFO("server.loading", "Loading Spell target coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
-
-    TC_LOG_INFO("server.loading", "Loading enchant custom attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
-
-    TC_LOG_INFO("server.loading", "Loading linked spells...");
-    sSpellMgr->LoadSpellLinked();
-
-    TC_LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
-
-    TC_LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-
-    TC_LOG_INFO("server.loading", "Loading the max pet number...");
-    sObjectMgr->LoadPetNumber();
-
-    TC_LOG_INFO("server.loading", "Loading pet level stats...");
-    sObjectMgr->LoadPetLevelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Player Corpses...");
-    sObjectMgr->LoadCorpses();
-
-    TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
-    sObjectMgr->LoadMailLevelRewards();
-
-    // Loot tables
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    TC_LOG_INFO("server.loading", "Loading Research Dig Sites info...");
-    sObjectMgr->LoadResearchSitesInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    // Must be called before `creature_respawn`/`gameobject_respawn` tables
+    loader.Add("Instances", "Loading instances...", [] { sInstanceSaveMgr->LoadInstances(); });
+
+    loader.Add("Locales", "Loading Localization strings...", [this]
+    {
+        uint32 oldMSTime = getMSTime();
+        sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->LoadItemLocales();
+        sObjectMgr->LoadQuestLocales();
+        sObjectMgr->LoadNpcTextLocales();
+        sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->LoadGossipMenuItemsLocales();
+        sObjectMgr->LoadPointOfInterestLocales();
+
+        sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
+        TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    });
+
+    loader.Add("PageTexts", "Loading Page Texts...", [] { sObjectMgr->LoadPageTexts(); });
+    loader.Add("GameObjectTemplates", "Loading Game Object Templates...", [] { sObjectMgr->LoadGameObjectTemplate(); }, { "PageTexts" });
+
+    // SpellMgr loaders fill shared spell data, they run one after another
+    loader.Add("SpellRanks", "Loading Spell Rank Data...", [] { sSpellMgr->LoadSpellRanks(); });
+    loader.Add("SpellRequired", "Loading Spell Required Data...", [] { sSpellMgr->LoadSpellRequired(); }, { "SpellRanks" });
+    loader.Add("SpellGroups", "Loading Spell Group types...", [] { sSpellMgr->LoadSpellGroups(); }, { "SpellRequired" });
+    loader.Add("SpellLearnSkills", "Loading Spell Learn Skills...", [] { sSpellMgr->LoadSpellLearnSkills(); }, { "SpellGroups" });
+    loader.Add("SpellLearnSpells", "Loading Spell Learn Spells...", [] { sSpellMgr->LoadSpellLearnSpells(); }, { "SpellLearnSkills" });
+    loader.Add("SpellProcEvents", "Loading Spell Proc Event conditions...", [] { sSpellMgr->LoadSpellProcEvents(); }, { "SpellLearnSpells" });
+    loader.Add("SpellProcs", "Loading Spell Proc conditions and data...", [] { sSpellMgr->LoadSpellProcs(); }, { "SpellProcEvents" });
+    loader.Add("SpellBonuses", "Loading Spell Bonus Data...", [] { sSpellMgr->LoadSpellBonusess(); }, { "SpellProcs" });
+    loader.Add("SpellThreats", "Loading Aggro Spells Definitions...", [] { sSpellMgr->LoadSpellThreats(); }, { "SpellBonuses" });
+    loader.Add("SpellGroupStackRules", "Loading Spell Group Stack Rules...", [] { sSpellMgr->LoadSpellGroupStackRules(); }, { "SpellThreats" });
+    loader.Add("SpellEnchantProcData", "Loading Enchant Spells Proc datas...", [] { sSpellMgr->LoadSpellEnchantProcData(); }, { "SpellGroupStackRules" });
+
+    loader.Add("SpellPhaseInfo", "Loading Spell Phase Dbc Info...", [] { sObjectMgr->LoadSpellPhaseInfo(); });
+    loader.Add("GossipText", "Loading NPC Texts...", [] { sObjectMgr->LoadGossipText(); });
+    loader.Add("RandomEnchantments", "Loading Item Random Enchantments Table...", [] { LoadRandomEnchantmentsTable(); });
+    loader.Add("Disables", "Loading Disables", [] { DisableMgr::LoadDisables(); });
+
+    loader.Add("ItemTemplates", "Loading Items...", [] { sObjectMgr->LoadItemTemplates(); }, { "RandomEnchantments", "PageTexts", "Disables" });
+    loader.Add("ItemTemplateAddons", "Loading Item set names...", [] { sObjectMgr->LoadItemTemplateAddon(); }, { "ItemTemplates" });
+    loader.Add("ItemScriptNames", "Loading Item Scripts...", [] { sObjectMgr->LoadItemScriptNames(); }, { "ItemTemplateAddons" });
+
+    loader.Add("CreatureModelInfo", "Loading Creature Model Based Info Data...", [] { sObjectMgr->LoadCreatureModelInfo(); });
+    loader.Add("EquipmentTemplates", "Loading Equipment templates...", [] { sObjectMgr->LoadEquipmentTemplates(); }, { "ItemTemplates" });
+    loader.Add("CreatureTemplates", "Loading Creature templates...", [] { sObjectMgr->LoadCreatureTemplates(); }, { "CreatureModelInfo", "EquipmentTemplates" });
+    loader.Add("CreatureTemplateAddons", "Loading Creature template addons...", [] { sObjectMgr->LoadCreatureTemplateAddons(); }, { "CreatureTemplates" });
+    loader.Add("ReputationRewardRate", "Loading Reputation Reward Rates...", [] { sObjectMgr->LoadReputationRewardRate(); });
+    loader.Add("RewardOnKill", "Loading Creature Reward OnKill Data...", [] { sObjectMgr->LoadRewardOnKill(); }, { "CreatureTemplates" });
+    loader.Add("ReputationSpillover", "Loading Reputation Spillover Data...", [] { sObjectMgr->LoadReputationSpilloverTemplate(); });
+    loader.Add("PointsOfInterest", "Loading Points Of Interest Data...", [] { sObjectMgr->LoadPointsOfInterest(); });
+    loader.Add("CreatureClassLevelStats", "Loading Creature Base Stats...", [] { sObjectMgr->LoadCreatureClassLevelStats(); });
+
+    // creatures, gameobjects and corpses share the cell store, they never run at the same time
+    loader.Add("Creatures", "Loading Creature Data...", [] { sObjectMgr->LoadCreatures(); }, { "CreatureTemplates", "CreatureClassLevelStats" });
+    loader.Add("TeleportersDest", "Loading Instance Teleportations Destinations Data...", [] { sObjectMgr->LoadTeleportersDest(); }, { "CreatureTemplates", "GameObjectTemplates" });
+    loader.Add("TempSummons", "Loading Temporary Summon Data...", [] { sObjectMgr->LoadTempSummons(); }, { "CreatureTemplates", "GameObjectTemplates" });
+    loader.Add("PetLevelupSpells", "Loading pet levelup spells...", [] { sSpellMgr->LoadPetLevelupSpellMap(); }, { "SpellEnchantProcData" });
+    loader.Add("PetDefaultSpells", "Loading pet default spells additional to levelup spells...", [] { sSpellMgr->LoadPetDefaultSpells(); }, { "PetLevelupSpells", "CreatureTemplates" });
+    loader.Add("CreatureAddons", "Loading Creature Addon Data...", [] { sObjectMgr->LoadCreatureAddons(); }, { "Creatures" });
+    loader.Add("Gameobjects", "Loading Gameobject Data...", [] { sObjectMgr->LoadGameobjects(); }, { "GameObjectTemplates", "Creatures" });
+    loader.Add("LinkedRespawn", "Loading Creature Linked Respawn...", [] { sObjectMgr->LoadLinkedRespawn(); }, { "Creatures", "Gameobjects" });
+    loader.Add("WeatherData", "Loading Weather Data...", [] { WeatherMgr::LoadWeatherData(); });
+
+    loader.Add("Quests", "Loading Quests...", [] { sObjectMgr->LoadQuests(); }, { "ItemTemplates", "CreatureTemplates", "GameObjectTemplates", "Creatures", "Gameobjects" });
+    loader.Add("QuestDisables", "Checking Quest Disables", [] { DisableMgr::CheckQuestDisables(); }, { "Quests" });
+    loader.Add("QuestPOI", "Loading Quest POI", [] { sObjectMgr->LoadQuestPOI(); }, { "Quests" });
+    loader.Add("SpellClickSpells", "Loading UNIT_NPC_FLAG_SPELLCLICK Data...", [] { sObjectMgr->LoadNPCSpellClickSpells(); }, { "Quests", "CreatureTemplateAddons", "RewardOnKill", "PetDefaultSpells" });
+    loader.Add("QuestRelations", "Loading Quests Relations...", [] { sObjectMgr->LoadQuestRelations(); }, { "Quests", "SpellClickSpells" });
+    loader.Add("Pools", "Loading Objects Pooling Data...", [] { sPoolMgr->LoadFromDB(); }, { "QuestRelations", "LinkedRespawn" });
+    loader.Add("GameEvents", "Loading Game Event Data...", [] { sGameEventMgr->LoadFromDB(); }, { "Pools", "SpellClickSpells" });
+    loader.Add("VehicleTemplateAccessories", "Loading Vehicle Template Accessories...", [] { sObjectMgr->LoadVehicleTemplateAccessories(); }, { "SpellClickSpells" });
+    loader.Add("VehicleAccessories", "Loading Vehicle Accessories...", [] { sObjectMgr->LoadVehicleAccessories(); }, { "SpellClickSpells", "Creatures" });
+    loader.Add("SpellAreas", "Loading SpellArea Data...", [] { sSpellMgr->LoadSpellAreas(); }, { "Quests", "PetDefaultSpells" });
+
+    loader.Add("AreaTriggerTeleports", "Loading AreaTrigger definitions...", [] { sObjectMgr->LoadAreaTriggerTeleports(); });
+    loader.Add("AccessRequirements", "Loading Access Requirements...", [] { sObjectMgr->LoadAccessRequirements(); }, { "ItemTemplates", "Quests" });
+    loader.Add("QuestAreaTriggers", "Loading Quest Area Triggers...", [] { sObjectMgr->LoadQuestAreaTriggers(); }, { "Quests" });
+    loader.Add("TavernAreaTriggers", "Loading Tavern Area Triggers...", [] { sObjectMgr->LoadTavernAreaTriggers(); });
+    loader.Add("AreaTriggerScripts", "Loading AreaTrigger script names...", [] { sObjectMgr->LoadAreaTriggerScripts(); });
+    loader.Add("LFGDungeons", "Loading LFG entrance positions...", [] { sLFGMgr->LoadLFGDungeons(); }, { "AreaTriggerTeleports" });
+    loader.Add("InstanceEncounters", "Loading Dungeon boss data...", [] { sObjectMgr->LoadInstanceEncounters(); }, { "LFGDungeons", "CreatureTemplates", "Creatures" });
+    loader.Add("LFGRewards", "Loading LFG rewards...", [] { sLFGMgr->LoadRewards(); }, { "LFGDungeons", "Quests" });
+    loader.Add("GraveyardZones", "Loading Graveyard-zone links...", [] { sObjectMgr->LoadGraveyardZones(); });
+
+    loader.Add("SpellPetAuras", "Loading spell pet auras...", [] { sSpellMgr->LoadSpellPetAuras(); }, { "SpellAreas" });
+    loader.Add("SpellTargetPositions", "Loading Spell target coordinates...", [] { sSpellMgr->LoadSpellTargetPositions(); }, { "SpellPetAuras" });
+    loader.Add("EnchantCustomAttr", "Loading enchant custom attributes...", [] { sSpellMgr->LoadEnchantCustomAttr(); }, { "SpellTargetPositions" });
+    loader.Add("SpellLinked", "Loading linked spells...", [] { sSpellMgr->LoadSpellLinked(); }, { "EnchantCustomAttr" });
+
+    loader.Add("PlayerInfo", "Loading Player Create Data...", [] { sObjectMgr->LoadPlayerInfo(); }, { "ItemTemplates" });
+    loader.Add("ExplorationBaseXP", "Loading Exploration BaseXP Data...", [] { sObjectMgr->LoadExplorationBaseXP(); });
+    loader.Add("PetNames", "Loading Pet Name Parts...", [] { sObjectMgr->LoadPetNames(); });
+
+    // character tables are read only once they are cleaned
+    loader.Add("CharacterDatabaseCleaner", NULL, [] { CharacterDatabaseCleaner::CleanDatabase(); });
+
+    loader.Add("PetNumber", "Loading the max pet number...", [] { sObjectMgr->LoadPetNumber(); }, { "CharacterDatabaseCleaner" });
+    loader.Add("PetLevelInfo", "Loading pet level stats...", [] { sObjectMgr->LoadPetLevelInfo(); }, { "CreatureTemplates" });
+    loader.Add("Corpses", "Loading Player Corpses...", [] { sObjectMgr->LoadCorpses(); }, { "CharacterDatabaseCleaner", "GameEvents" });
+    loader.Add("MailLevelRewards", "Loading Player level dependent mail rewards...", [] { sObjectMgr->LoadMailLevelRewards(); }, { "CreatureTemplates" });
+
+    loader.Add("LootTables", NULL, [] { LoadLootTables(); }, { "ItemTemplates", "CreatureTemplates", "GameObjectTemplates" });
+
+    loader.Add("SkillDiscovery", "Loading Skill Discovery Table...", [] { LoadSkillDiscoveryTable(); });
+    loader.Add("SkillExtraItems", "Loading Skill Extra Item Table...", [] { LoadSkillExtraItemTable(); });
+    loader.Add("FishingBaseSkillLevel", "Loading Skill Fishing base level requirements...", [] { sObjectMgr->LoadFishingBaseSkillLevel(); });
+    loader.Add("ResearchSitesInfo", "Loading Research Dig Sites info...", [] { sObjectMgr->LoadResearchSitesInfo(); });
+
+    loader.Add("AchievementReferenceList", "Loading Achievements...", [] { sAchievementMgr->LoadAchievementReferenceList(); });
+    loader.Add("AchievementCriteriaList", "Loading Achievement Criteria Lists...", [] { sAchievementMgr->LoadAchievementCriteriaList(); }, { "AchievementReferenceList" });
+    loader.Add("AchievementCriteriaData", "Loading Achievement Criteria Data...", [] { sAchievementMgr->LoadAchievementCriteriaData(); }, { "AchievementCriteriaList", "CreatureTemplates", "ItemTemplates" });
+    loader.Add("AchievementRewards", "Loading Achievement Rewards...", [] { sAchievementMgr->LoadRewards(); }, { "AchievementCriteriaData" });
+    loader.Add("AchievementRewardLocales", "Loading Achievement Reward Locales...", [] { sAchievementMgr->LoadRewardLocales(); }, { "AchievementRewards" });
+    loader.Add("CompletedAchievements", "Loading Completed Achievements...", [] { sAchievementMgr->LoadCompletedAchievements(); }, { "AchievementRewardLocales", "CharacterDatabaseCleaner" });
 
     // Delete expired auctions before loading
-    TC_LOG_INFO("server.loading", "Deleting expired auctions...");
-    sAuctionMgr->DeleteExpiredAuctionsAtStartup();
-
-    ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
-
-    TC_LOG_INFO("server.loading", "Loading Guild XP for level...");
-    sGuildMgr->LoadGuildXpForLevel();
-
-    TC_LOG_INFO("server.loading", "Loading Guild rewards...");
-    sGuildMgr->LoadGuildRewards();
-
-    TC_LOG_INFO("server.loading", "Loading Guilds...");
-    sGuildMgr->LoadGuilds();
-
-    sGuildFinderMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
-
-    TC_LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
-
-    TC_LOG_INFO("server.loading", "Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
-
-    TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
-
-    TC_LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
-
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    TC_LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
-
-    TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
-
-    TC_LOG_INFO("server.loading", "Loading Phase definitions...");
-    sObjectMgr->LoadPhaseDefinitions();
-
-    TC_LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
-
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
-
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sTicketMgr->LoadTickets();
-
-    TC_LOG_INFO("server.loading", "Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
-
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
+    loader.Add("ExpiredAuctions", "Deleting expired auctions...", [] { sAuctionMgr->DeleteExpiredAuctionsAtStartup(); }, { "ItemTemplates", "CharacterDatabaseCleaner" });
+    loader.Add("AuctionItems", "Loading Item Auctions...", [] { sAuctionMgr->LoadAuctionItems(); }, { "ExpiredAuctions" });
+    loader.Add("Auctions", "Loading Auctions...", [] { sAuctionMgr->LoadAuctions(); }, { "AuctionItems" });
+
+    loader.Add("GuildXpForLevel", "Loading Guild XP for level...", [] { sGuildMgr->LoadGuildXpForLevel(); });
+    loader.Add("GuildRewards", "Loading Guild rewards...", [] { sGuildMgr->LoadGuildRewards(); }, { "ItemTemplates" });
+    loader.Add("Guilds", "Loading Guilds...", [] { sGuildMgr->LoadGuilds(); }, { "GuildXpForLevel", "GuildRewards", "CompletedAchievements" });
+    loader.Add("GuildFinder", NULL, [] { sGuildFinderMgr->LoadFromDB(); }, { "Guilds" });
+    loader.Add("ArenaTeams", "Loading ArenaTeams...", [] { sArenaTeamMgr->LoadArenaTeams(); }, { "CharacterDatabaseCleaner" });
+    loader.Add("Groups", "Loading Groups...", [] { sGroupMgr->LoadGroups(); }, { "Instances", "CharacterDatabaseCleaner" });
+    loader.Add("ReservedNames", "Loading ReservedNames...", [] { sObjectMgr->LoadReservedPlayersNames(); });
+
+    loader.Add("GameObjectForQuests", "Loading GameObjects for quests...", [] { sObjectMgr->LoadGameObjectForQuests(); }, { "LootTables", "QuestRelations" });
+    loader.Add("BattleMasters", "Loading BattleMasters...", [] { sBattlegroundMgr->LoadBattleMastersEntry(); }, { "SpellClickSpells" });
+    loader.Add("GameTele", "Loading GameTeleports...", [] { sObjectMgr->LoadGameTele(); });
+    loader.Add("GossipMenu", "Loading Gossip menu...", [] { sObjectMgr->LoadGossipMenu(); }, { "GossipText" });
+    loader.Add("GossipMenuItems", "Loading Gossip menu options...", [] { sObjectMgr->LoadGossipMenuItems(); }, { "GossipMenu", "PointsOfInterest" });
+    loader.Add("Vendors", "Loading Vendors...", [] { sObjectMgr->LoadVendors(); }, { "ItemTemplates", "SpellClickSpells" });
+    loader.Add("Trainers", "Loading Trainers...", [] { sObjectMgr->LoadTrainerSpell(); }, { "SpellClickSpells" });
+    loader.Add("Waypoints", "Loading Waypoints...", [] { sWaypointMgr->Load(); });
+    loader.Add("SmartWaypoints", "Loading SmartAI Waypoints...", [] { sSmartWaypointMgr->LoadFromDB(); });
+    loader.Add("CreatureFormations", "Loading Creature Formations...", [] { sFormationMgr->LoadCreatureFormations(); }, { "Creatures" });
+
+    // must be loaded before battleground, outdoor PvP and conditions
+    loader.Add("WorldStates", "Loading World States...", [this] { LoadWorldStates(); });
+    loader.Add("PhaseDefinitions", "Loading Phase definitions...", [] { sObjectMgr->LoadPhaseDefinitions(); });
+    loader.Add("Conditions", "Loading Conditions...", [] { sConditionMgr->LoadConditions(); },
+        { "WorldStates", "PhaseDefinitions", "LootTables", "GossipMenuItems", "Vendors", "VehicleAccessories", "QuestRelations", "GameEvents", "SpellLinked", "AreaTriggerTeleports" });
+
+    loader.Add("FactionChangeAchievements", "Loading faction change achievement pairs...", [] { sObjectMgr->LoadFactionChangeAchievements(); });
+    loader.Add("FactionChangeSpells", "Loading faction change spell pairs...", [] { sObjectMgr->LoadFactionChangeSpells(); });
+    loader.Add("FactionChangeItems", "Loading faction change item pairs...", [] { sObjectMgr->LoadFactionChangeItems(); }, { "ItemTemplates" });
+    loader.Add("FactionChangeReputations", "Loading faction change reputation pairs...", [] { sObjectMgr->LoadFactionChangeReputations(); });
+    loader.Add("FactionChangeTitles", "Loading faction change title pairs...", [] { sObjectMgr->LoadFactionChangeTitles(); });
+
+    loader.Add("Tickets", "Loading GM tickets...", [] { sTicketMgr->LoadTickets(); }, { "CharacterDatabaseCleaner" });
+    loader.Add("Surveys", "Loading GM surveys...", [] { sTicketMgr->LoadSurveys(); }, { "Tickets" });
+    loader.Add("Addons", "Loading client addons...", [] { AddonMgr::LoadFromDB(); });
 
     ///- Handle outdated emails (delete/return)
-    TC_LOG_INFO("server.loading", "Returning old mails...");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
-
-    TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    LoadAutobroadcasts();
+    loader.Add("OldMails", "Returning old mails...", [] { sObjectMgr->ReturnOrDeleteOldMails(false); }, { "Auctions" });
+    loader.Add("Autobroadcasts", "Loading Autobroadcasts...", [this] { LoadAutobroadcasts(); });
 
     ///- Load and initialize scripts
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
-
-    TC_LOG_INFO("server.loading", "Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sObjectMgr->LoadDbScriptStrings();
+    loader.Add("SpellScripts", NULL, [] { sObjectMgr->LoadSpellScripts(); }, { "Quests" });
+    loader.Add("EventScripts", NULL, [] { sObjectMgr->LoadEventScripts(); }, { "SpellScripts" });
+    loader.Add("WaypointScripts", NULL, [] { sObjectMgr->LoadWaypointScripts(); }, { "EventScripts" });
+    loader.Add("DbScriptStrings", "Loading Scripts text locales...", [] { sObjectMgr->LoadDbScriptStrings(); }, { "WaypointScripts" });
+    loader.Add("SpellScriptNames", "Loading spell script names...", [] { sObjectMgr->LoadSpellScriptNames(); });
+    loader.Add("CreatureTexts", "Loading Creature Texts...", [] { sCreatureTextMgr->LoadCreatureTexts(); }, { "CreatureTemplates" });
+    loader.Add("CreatureTextLocales", "Loading Creature Text Locales...", [] { sCreatureTextMgr->LoadCreatureTextLocales(); }, { "CreatureTexts" });
 
-    TC_LOG_INFO("server.loading", "Loading spell script names...");
-    sObjectMgr->LoadSpellScriptNames();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
+    loader.Run(getIntConfig(CONFIG_STARTUP_LOAD_THREADS));
 
     TC_LOG_INFO("server.loading", "Initializing Scripts...");
     sScriptMgr->Initialize();
@@ -1931,6 +1757,8 @@ void World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_GUILDSAVE].SetInterval(getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
+    m_timers[WUPDATE_REPORTQUESTS].SetInterval(getIntConfig(CONFIG_REPORTQUEST_UPDATETIMER));
+
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
     //one second is 1000 -(tested on win system)
@@ -1947,6 +1775,41 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Starting Map System");
     sMapMgr->Initialize();
 
+    if (uint32 sessionThreads = getIntConfig(CONFIG_SESSION_UPDATE_THREADS))
+    {
+        m_sessionUpdater = new SessionUpdater();
+        if (m_sessionUpdater->activate(sessionThreads) == -1)
+        {
+            TC_LOG_ERROR("server.loading", "Can't start %u session update threads, packets are processed serially.", sessionThreads);
+            delete m_sessionUpdater;
+            m_sessionUpdater = NULL;
+        }
+    }
+
+    ///- Housekeeping jobs, the costs are first estimates in ms
+    m_housekeeping = new HousekeepingScheduler();
+    m_housekeeping->Add(HOUSEKEEPING_MAIL_RETURN, "ReturnOldMails", HOUSEKEEPING_PRIORITY_LOW, 200, false,
+        [] { sObjectMgr->ReturnOrDeleteOldMails(true); });
+    m_housekeeping->Add(HOUSEKEEPING_AUTOBROADCAST, "AutoBroadcast", HOUSEKEEPING_PRIORITY_NORMAL, 1, false,
+        [this] { SendAutoBroadcast(); });
+    m_housekeeping->Add(HOUSEKEEPING_DELETE_CHARS, "DeleteOldCharacters", HOUSEKEEPING_PRIORITY_LOW, 100, false,
+        [] { Player::DeleteOldCharacters(); });
+    // only touches the databases, the ping no longer stalls the world thread
+    m_housekeeping->Add(HOUSEKEEPING_PING_DB, "PingDB", HOUSEKEEPING_PRIORITY_LOW, 0, true, []
+    {
+        TC_LOG_DEBUG("misc", "Ping MySQL to keep connection alive");
+        CharacterDatabase.KeepAlive();
+        LoginDatabase.KeepAlive();
+        WorldDatabase.KeepAlive();
+    });
+    m_housekeeping->Add(HOUSEKEEPING_GUILD_SAVE, "SaveGuilds", HOUSEKEEPING_PRIORITY_NORMAL, 20, false,
+        [] { sGuildMgr->SaveGuilds(); });
+    m_housekeeping->Add(HOUSEKEEPING_INSTANCE_RESETS, "InstanceResets", HOUSEKEEPING_PRIORITY_HIGH, 1, false,
+        [] { sInstanceSaveMgr->Update(); });
+    m_housekeeping->Add(HOUSEKEEPING_REPORT_QUESTS, "SaveReportQuests", HOUSEKEEPING_PRIORITY_LOW, 5, false,
+        [] { sObjectMgr->SaveReportQuestData(); });
+    m_housekeeping->Start();
+
     TC_LOG_INFO("server.loading", "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2018,9 +1881,6 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("misc", "Initializing Opcodes...");
     opcodeTable.Initialize();
 
-    TC_LOG_INFO("misc", "Initializing Performance logger...");
-    sPerfLog->Initialize();
-
     TC_LOG_INFO("misc", "Initializing Info Manager...");
     sInfoMgr->Initialize();
 
@@ -2103,32 +1963,6 @@ void World::DetectDBCLang()
     TC_LOG_INFO("server.loading", "Using %s DBC Locale", localeNames[m_defaultDbcLocale]);
 }
 
-void World::RecordTimeDiff(const char *text, ...)
-{
-    if (m_updateTimeCount != 1)
-        return;
-    if (!text)
-    {
-        m_currentTime = getMSTime();
-        return;
-    }
-
-    uint32 thisTime = getMSTime();
-    uint32 diff = getMSTimeDiff(m_currentTime, thisTime);
-
-    if (diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
-    {
-        va_list ap;
-        char str[256];
-        va_start(ap, text);
-        vsnprintf(str, 256, text, ap);
-        va_end(ap);
-        TC_LOG_INFO("misc", "Difftime %s: %u.", str, diff);
-    }
-
-    m_currentTime = thisTime;
-}
-
 void World::LoadAutobroadcasts()
 {
     uint32 oldMSTime = getMSTime();
@@ -2169,6 +2003,9 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    PROFILE_SCOPE("World::Update");
+
+    uint32 tickStart = getMSTime();
     m_updateTime = diff;
 
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
@@ -2236,7 +2073,7 @@ void World::Update(uint32 diff)
         if (++mail_timer > mail_timer_expires)
         {
             mail_timer = 0;
-            sObjectMgr->ReturnOrDeleteOldMails(true);
+            m_housekeeping->Schedule(HOUSEKEEPING_MAIL_RETURN);
         }
 
         ///- Handle expired auctions
@@ -2244,9 +2081,10 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle session updates when the timer has passed
-    RecordTimeDiff(NULL);
-    UpdateSessions(diff);
-    RecordTimeDiff("UpdateSessions");
+    {
+        PROFILE_SCOPE("World::UpdateSessions");
+        UpdateSessions(diff);
+    }
 
     /// <li> Handle weather updates when the timer has passed
     if (m_timers[WUPDATE_WEATHERS].Passed())
@@ -2292,44 +2130,57 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
-    RecordTimeDiff(NULL);
-    sMapMgr->Update(diff);
-    RecordTimeDiff("UpdateMapMgr");
+    {
+        PROFILE_SCOPE("World::UpdateMapMgr");
+        sMapMgr->Update(diff);
+    }
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
         {
             m_timers[WUPDATE_AUTOBROADCAST].Reset();
-            SendAutoBroadcast();
+            m_housekeeping->Schedule(HOUSEKEEPING_AUTOBROADCAST);
         }
     }
 
-    sBattlegroundMgr->Update(diff);
-    RecordTimeDiff("UpdateBattlegroundMgr");
+    {
+        PROFILE_SCOPE("World::UpdateBattlegroundMgr");
+        sBattlegroundMgr->Update(diff);
+    }
 
-    sOutdoorPvPMgr->Update(diff);
-    RecordTimeDiff("UpdateOutdoorPvPMgr");
+    {
+        PROFILE_SCOPE("World::UpdateOutdoorPvPMgr");
+        sOutdoorPvPMgr->Update(diff);
+    }
 
-    sBattlefieldMgr->Update(diff);
-    RecordTimeDiff("BattlefieldMgr");
+    {
+        PROFILE_SCOPE("World::UpdateBattlefieldMgr");
+        sBattlefieldMgr->Update(diff);
+    }
 
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
         m_timers[WUPDATE_DELETECHARS].Reset();
-        Player::DeleteOldCharacters();
+        m_housekeeping->Schedule(HOUSEKEEPING_DELETE_CHARS);
     }
 
-    sLFGMgr->Update(diff);
-    RecordTimeDiff("UpdateLFGMgr");
+    {
+        PROFILE_SCOPE("World::UpdateLFGMgr");
+        sLFGMgr->Update(diff);
+    }
 
     // execute callbacks from sql queries that were queued recently
-    ProcessQueryCallbacks();
-    RecordTimeDiff("ProcessQueryCallbacks");
+    {
+        PROFILE_SCOPE("World::ProcessQueryCallbacks");
+        ProcessQueryCallbacks();
+    }
 
-    sSoloQueueMgr->Update(diff);
-    RecordTimeDiff("UpdateSoloQueueMgr");
+    {
+        PROFILE_SCOPE("World::UpdateSoloQueueMgr");
+        sSoloQueueMgr->Update(diff);
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -2351,29 +2202,39 @@ void World::Update(uint32 diff)
     if (m_timers[WUPDATE_PINGDB].Passed())
     {
         m_timers[WUPDATE_PINGDB].Reset();
-        TC_LOG_DEBUG("misc", "Ping MySQL to keep connection alive");
-        CharacterDatabase.KeepAlive();
-        LoginDatabase.KeepAlive();
-        WorldDatabase.KeepAlive();
+        m_housekeeping->Schedule(HOUSEKEEPING_PING_DB);
     }
 
     if (m_timers[WUPDATE_GUILDSAVE].Passed())
     {
         m_timers[WUPDATE_GUILDSAVE].Reset();
-        sGuildMgr->SaveGuilds();
+        m_housekeeping->Schedule(HOUSEKEEPING_GUILD_SAVE);
+    }
+
+    if (m_timers[WUPDATE_REPORTQUESTS].Passed())
+    {
+        m_timers[WUPDATE_REPORTQUESTS].Reset();
+        m_housekeeping->Schedule(HOUSEKEEPING_REPORT_QUESTS);
     }
 
     // update the instance reset times
-    sInstanceSaveMgr->Update();
+    m_housekeeping->Schedule(HOUSEKEEPING_INSTANCE_RESETS);
 
-    sObjectMgr->UpdateReportQuestData(diff);
+    ///- Run the due housekeeping jobs with what is left of the tick budget
+    m_housekeeping->Update(tickStart, m_int_configs[CONFIG_HOUSEKEEPING_TICK_BUDGET]);
 
     // And last, but not least handle the issued cli commands
     ProcessCliCommands();
 
     sScriptMgr->OnWorldUpdate(diff);
 
-    sPerfLog->Update(diff);
+    sTickProfiler->Update(diff);
+}
+
+void World::StopHousekeeping()
+{
+    if (m_housekeeping)
+        m_housekeeping->Stop();
 }
 
 void World::ForceGameEventUpdate()
@@ -2387,6 +2248,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    PreparedPacket prepared(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2396,7 +2258,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(&prepared);
         }
     }
 }
@@ -2429,6 +2291,7 @@ void World::SendGlobalMessageLoc(int32 id)
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    PreparedPacket prepared(packet);
     SessionMap::iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2439,7 +2302,7 @@ void World::SendGlobalGMMessage(WorldPacket* packet, WorldSession* self, uint32
             !AccountMgr::IsPlayerAccount(itr->second->GetSecurity()) &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(&prepared);
         }
     }
 }
@@ -2616,6 +2479,7 @@ void World::SendGlobalText(const char* text, WorldSession* self)
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
 void World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self, uint32 team)
 {
+    PreparedPacket prepared(packet);
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2626,7 +2490,7 @@ void World::SendZoneMessage(uint32 zone, WorldPacket* packet, WorldSession* self
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(&prepared);
         }
     }
 }
@@ -3056,6 +2920,18 @@ void World::UpdateSessions(uint32 diff)
     while (addSessQueue.next(sess))
         AddSession_ (sess);
 
+    ///- Run the lock domain packets at the head of the queues in parallel, the rest is processed below
+    if (m_sessionUpdater)
+    {
+        PROFILE_SCOPE("World::UpdateSessions::LockDomains");
+
+        for (SessionMap::iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+            if (itr->second->HasLockDomainPackets())
+                m_sessionUpdater->schedule_update(*itr->second);
+
+        m_sessionUpdater->wait();
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
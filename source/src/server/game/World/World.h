@@ -41,6 +41,8 @@ class WorldSession;
 class Player;
 class WorldSocket;
 class SystemMgr;
+class SessionUpdater;
+class HousekeepingScheduler;
 
 // ServerMessages.dbc
 enum ServerMessageType
@@ -87,9 +89,22 @@ enum WorldTimers
     WUPDATE_DELETECHARS,
     WUPDATE_PINGDB,
     WUPDATE_GUILDSAVE,
+    WUPDATE_REPORTQUESTS,
     WUPDATE_COUNT
 };
 
+/// Jobs of the housekeeping scheduler, see World::Update()
+enum WorldHousekeepingJobs
+{
+    HOUSEKEEPING_MAIL_RETURN,
+    HOUSEKEEPING_AUTOBROADCAST,
+    HOUSEKEEPING_DELETE_CHARS,
+    HOUSEKEEPING_PING_DB,
+    HOUSEKEEPING_GUILD_SAVE,
+    HOUSEKEEPING_INSTANCE_RESETS,
+    HOUSEKEEPING_REPORT_QUESTS
+};
+
 /// Configuration elements
 enum WorldBoolConfigs
 {
@@ -349,6 +364,11 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_REGION_THREADS,
+    CONFIG_MAP_UPDATE_PRELOAD_THREADS,
+    CONFIG_STARTUP_LOAD_THREADS,
+    CONFIG_SESSION_UPDATE_THREADS,
+    CONFIG_HOUSEKEEPING_TICK_BUDGET,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -712,6 +732,9 @@ class World
         /// Get the path where data (dbc, maps) are stored on disk
         std::string const& GetDataPath() const { return m_dataPath; }
 
+        /// Get the directory of the world database snapshots, empty if they are disabled
+        std::string const& GetSnapshotPath() const { return m_snapshotPath; }
+
         /// When server started?
         time_t const& GetStartTime() const { return m_startTime; }
         /// What time is it?
@@ -763,6 +786,11 @@ class World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+
+        /// Waits for a running async housekeeping job, called before the databases are closed
+        void StopHousekeeping();
+        HousekeepingScheduler const* GetHousekeeping() const { return m_housekeeping; }
+
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
@@ -856,8 +884,6 @@ class World
         void LoadDBVersion();
         char const* GetDBVersion() const { return m_DBVersion.c_str(); }
 
-        void RecordTimeDiff(const char * text, ...);
-
         void LoadAutobroadcasts();
 
         void UpdateAreaDependentAuras();
@@ -927,7 +953,6 @@ class World
         time_t mail_timer_expires;
         uint32 m_updateTime, m_updateTimeSum;
         uint32 m_updateTimeCount;
-        uint32 m_currentTime;
         uint32 m_localRealmID{ 0 };
 
         SessionMap m_sessions;
@@ -955,6 +980,7 @@ class World
         bool m_allowMovement;
         std::string m_motd;
         std::string m_dataPath;
+        std::string m_snapshotPath;
 
         // for max speed access
         static float m_MaxVisibleDistanceOnContinents;
@@ -985,6 +1011,12 @@ class World
         void AddSession_(WorldSession* s);
         ACE_Based::LockedQueue<WorldSession*, ACE_Thread_Mutex> addSessQueue;
 
+        // runs the lock domain packets of sessions in parallel, NULL if disabled
+        SessionUpdater* m_sessionUpdater;
+
+        // runs the jobs marked due by the timers within the tick budget
+        HousekeepingScheduler* m_housekeeping;
+
         // used versions
         std::string m_DBVersion;
         BattlegroundTypeId forcedBG;
@@ -146,7 +146,7 @@ public:
         strCommand = command;
 
         if (strCommand.compare("deleteall") == 0)
-            sAnticheatMgr->AnticheatDeleteCommand(0);
+            sAnticheatMgr->AnticheatDeleteCommand(NULL);
         else
         {
             normalizePlayerName(strCommand);
@@ -154,7 +154,7 @@ public:
             if (!player)
                 handler->PSendSysMessage("Player doesn't exist");
             else
-                sAnticheatMgr->AnticheatDeleteCommand(player->GetGUIDLow());
+                sAnticheatMgr->AnticheatDeleteCommand(player);
         }
 
         return true;
@@ -194,14 +194,15 @@ public:
             return true;
         }
 
-        float average = sAnticheatMgr->GetAverage(guid);
-        uint32 total_reports = sAnticheatMgr->GetTotalReports(guid);
-        uint32 speed_reports = sAnticheatMgr->GetTypeReports(guid,0);
-        uint32 fly_reports = sAnticheatMgr->GetTypeReports(guid,1);
-        uint32 jump_reports = sAnticheatMgr->GetTypeReports(guid,3);
-        uint32 waterwalk_reports = sAnticheatMgr->GetTypeReports(guid,2);
-        uint32 teleportplane_reports = sAnticheatMgr->GetTypeReports(guid,4);
-        uint32 climb_reports = sAnticheatMgr->GetTypeReports(guid,5);
+        AnticheatData const& data = player->GetAnticheatData();
+        float average = data.GetAverage();
+        uint32 total_reports = data.GetTotalReports();
+        uint32 speed_reports = data.GetTypeReports(SPEED_HACK_REPORT);
+        uint32 fly_reports = data.GetTypeReports(FLY_HACK_REPORT);
+        uint32 jump_reports = data.GetTypeReports(JUMP_HACK_REPORT);
+        uint32 waterwalk_reports = data.GetTypeReports(WALK_WATER_HACK_REPORT);
+        uint32 teleportplane_reports = data.GetTypeReports(TELEPORT_PLANE_HACK_REPORT);
+        uint32 climb_reports = data.GetTypeReports(CLIMB_HACK_REPORT);
 
         handler->PSendSysMessage("Information about player %s",player->GetName().c_str());
         handler->PSendSysMessage("Average: %f || Total Reports: %u ",average,total_reports);
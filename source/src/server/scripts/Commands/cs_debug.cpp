@@ -34,6 +34,7 @@ EndScriptData */
 #include "Language.h"
 #include "Group.h"
 #include "InfoMgr.h"
+#include "MovementCodec.h"
 
 #include <fstream>
 
@@ -96,6 +97,7 @@ public:
             { "unroot",         SEC_CONSOLE,      false, &HandleDebugUnRootCommand,          "" },
             { "combat",         SEC_CONSOLE,      false, &HandleDebugCombatCommand,          "" },
             { "mapz",           SEC_CONSOLE,      false, &HandleMapZCommand,                 "" },
+            { "movementcodecs", SEC_CONSOLE,      true,  &HandleDebugMovementCodecsCommand,  "" },
         };
         static std::vector<ChatCommand> commandTable =
         {
@@ -1501,6 +1503,22 @@ public:
         handler->PSendSysMessage("ground : %f", dz);
         return true;
     }
+
+    // Compares the compiled movement codecs with the sequence interpreter on random movement blocks
+    static bool HandleDebugMovementCodecsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 iterations = *args ? uint32(atoi(args)) : 1000;
+        if (!iterations)
+            return false;
+
+        std::string firstMismatch;
+        uint32 mismatches = CheckMovementCodecs(iterations, firstMismatch);
+        if (mismatches)
+            handler->PSendSysMessage("Movement codecs: %u mismatches in %u iterations, first in %s", mismatches, iterations, firstMismatch.c_str());
+        else
+            handler->PSendSysMessage("Movement codecs: %u iterations, all codecs match the sequences", iterations);
+        return true;
+    }
 };
 
 void AddSC_debug_commandscript()
@@ -212,6 +212,11 @@ public:
         MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
         handler->PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
+        PathCacheStats cacheStats = PathGenerator::GetCacheStats();
+        uint64 lookups = cacheStats.Hits + cacheStats.Misses;
+        handler->PSendSysMessage(" path cache: " UI64FMTD " hits, " UI64FMTD " misses (%.1f%% hit rate), " UI64FMTD " repaired paths, %u queries",
+            cacheStats.Hits, cacheStats.Misses, lookups ? float(cacheStats.Hits) * 100.0f / lookups : 0.0f, cacheStats.Repairs, cacheStats.Queries);
+
         dtNavMesh const* navmesh = manager->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
         if (!navmesh)
         {
@@ -39,7 +39,6 @@ EndScriptData */
 #include "TicketMgr.h"
 #include "WardenCheckMgr.h"
 #include "WaypointManager.h"
-#include "PerformanceLog.h"
 
 class reload_commandscript : public CommandScript
 {
@@ -155,7 +154,6 @@ public:
             { "waypoint_data",                SEC_CONSOLE, true,  &HandleReloadWpCommand,                         "" },
             { "vehicle_accessory",            SEC_CONSOLE, true,  &HandleReloadVehicleAccessoryCommand,           "" },
             { "vehicle_template_accessory",   SEC_CONSOLE, true,  &HandleReloadVehicleTemplateAccessoryCommand,   "" },
-            { "performanceconfig",            SEC_CONSOLE, true,  &HandleReloadPerfConfigCommand,                 "" },
             { "template_npc",				  SEC_CONSOLE, true,	&HandleReloadTemplateNpcCommand,				"" },
         };
         static std::vector<ChatCommand> commandTable =
@@ -1226,14 +1224,6 @@ public:
         return true;
     }
 
-    static bool HandleReloadPerfConfigCommand(ChatHandler* handler, const char* /*args*/)
-    {
-        TC_LOG_INFO("server.worldserver", "Reloading PerformanceLog config");
-        sPerfLog->LoadConfig();
-        handler->SendGlobalGMSysMessage("PerformanceLog config reloaded");
-        return true;
-    }
-
     static bool HandleReloadTemplateNpcCommand(ChatHandler* handler, const char* /*args*/)
     {
         //sLog->outInfo(LOG_FILTER_WORLDSERVER, "Reloading templates for Template NPC table...");
@@ -24,11 +24,14 @@ EndScriptData */
 
 #include "Chat.h"
 #include "Config.h"
+#include "HousekeepingScheduler.h"
 #include "Language.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
 #include "ScriptMgr.h"
 #include "SystemConfig.h"
+#include "TickProfiler.h"
+#include "WorldSocket.h"
 
 #if PLATFORM == PLATFORM_WINDOWS
 const std::string FM_CORE_SHELL = ".\\coreshell.bat ";
@@ -55,6 +58,13 @@ public:
 			{ "", SEC_CONSOLE, true, &HandleServerIdleShutDownCommand, "" },
 		};
 
+		static std::vector<ChatCommand> serverPerfCommandTable =
+		{
+			{ "dump", SEC_CONSOLE, true, &HandleServerPerfDumpCommand, "" },
+			{ "reset", SEC_CONSOLE, true, &HandleServerPerfResetCommand, "" },
+			{ "", SEC_CONSOLE, true, &HandleServerPerfCommand, "" },
+		};
+
 		static std::vector<ChatCommand> serverRestartCommandTable =
 		{
 			{ "cancel", SEC_CONSOLE, true, &HandleServerShutDownCancelCommand, "" },
@@ -86,11 +96,15 @@ public:
 		static std::vector<ChatCommand> serverCommandTable =
 		{
 			{ "corpses", SEC_CONSOLE, true, &HandleServerCorpsesCommand, "" },
+			{ "dbqueues", SEC_CONSOLE, true, &HandleServerDBQueuesCommand, "" },
 			{ "exit", SEC_CONSOLE, true, &HandleServerExitCommand, "" },
+			{ "housekeeping", SEC_CONSOLE, true, &HandleServerHousekeepingCommand, "" },
 			{ "idlerestart", SEC_CONSOLE, true, NULL, "", serverIdleRestartCommandTable },
 			{ "idleshutdown", SEC_CONSOLE, true, NULL, "", serverIdleShutdownCommandTable },
 			{ "info", SEC_CONSOLE, true, &HandleServerInfoCommand, "" },
 			{ "motd", SEC_CONSOLE, true, &HandleServerMotdCommand, "" },
+			{ "netstats", SEC_CONSOLE, true, &HandleServerNetStatsCommand, "" },
+			{ "perf", SEC_CONSOLE, true, NULL, "", serverPerfCommandTable },
 			{ "plimit", SEC_CONSOLE, true, &HandleServerPLimitCommand, "" },
 			{ "restart", SEC_CONSOLE, true, NULL, "", serverRestartCommandTable },
 			{ "shutdown", SEC_CONSOLE, true, NULL, "", serverShutdownCommandTable },
@@ -112,6 +126,30 @@ public:
 		return true;
 	}
 
+	template <class T>
+	static void SendDatabaseQueueSizes(ChatHandler* handler, DatabaseWorkerPool<T>& database)
+	{
+		std::ostringstream ss;
+		size_t total = 0;
+		for (uint8 i = 0; i < database.GetQueueCount(); ++i)
+		{
+			size_t size = database.GetQueueSize(i);
+			total += size;
+			ss << ' ' << size;
+		}
+
+		handler->PSendSysMessage("%s: %u queued in %u queues:%s", database.GetDatabaseName(), uint32(total), uint32(database.GetQueueCount()), ss.str().c_str());
+	}
+
+	// Display pending asynchronous operations per database worker queue
+	static bool HandleServerDBQueuesCommand(ChatHandler* handler, char const* /*args*/)
+	{
+		SendDatabaseQueueSizes(handler, LoginDatabase);
+		SendDatabaseQueueSizes(handler, WorldDatabase);
+		SendDatabaseQueueSizes(handler, CharacterDatabase);
+		return true;
+	}
+
 	static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
 	{
 		uint32 playersNum = sWorld->GetPlayerCount();
@@ -134,6 +172,38 @@ public:
 
 		return true;
 	}
+	// Display the output pipeline counters of the world sockets
+	static bool HandleServerNetStatsCommand(ChatHandler* handler, char const* /*args*/)
+	{
+		SocketOutputStats stats = WorldSocket::GetOutputStats();
+		uint64 syscalls = std::max<uint64>(stats.Syscalls, 1);
+
+		handler->PSendSysMessage("Sent " UI64FMTD " packets, " UI64FMTD " bytes in " UI64FMTD " sendmsg calls (%.1f packets, %.0f bytes per call)",
+			stats.Packets, stats.Bytes, stats.Syscalls, double(stats.Packets) / syscalls, double(stats.Bytes) / syscalls);
+		handler->PSendSysMessage("Queued packets: %u, deepest queue of a flush: %u", stats.QueuedPackets, stats.MaxQueueDepth);
+		return true;
+	}
+
+	// Display the run times and delays of the world housekeeping jobs
+	static bool HandleServerHousekeepingCommand(ChatHandler* handler, char const* /*args*/)
+	{
+		HousekeepingScheduler const* housekeeping = sWorld->GetHousekeeping();
+		if (!housekeeping)
+			return false;
+
+		handler->PSendSysMessage("Tick budget: %u ms", sWorld->getIntConfig(CONFIG_HOUSEKEEPING_TICK_BUDGET));
+
+		std::vector<HousekeepingScheduler::JobStats> stats = housekeeping->GetStats();
+		for (HousekeepingScheduler::JobStats const& job : stats)
+		{
+			uint32 runs = std::max<uint32>(job.Runs, 1);
+			handler->PSendSysMessage("%s%s%s: %u runs, %u deferrals, runtime avg %u max %u ms, lateness avg %u max %u ms, estimate %u ms",
+				job.Name.c_str(), job.Async ? " (async)" : "", job.Due ? " (due)" : "", job.Runs, job.Deferrals,
+				uint32(job.TotalRuntime / runs), job.MaxRuntime, uint32(job.TotalLateness / runs), job.MaxLateness, job.EstimatedCost);
+		}
+		return true;
+	}
+
 	// Display the 'Message of the day' for the realm
 	static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
 	{
@@ -335,6 +405,53 @@ public:
 		return true;
 	}
 
+	// Show the slowest profiler sections since the last reset, sorted by total time
+	static bool HandleServerPerfCommand(ChatHandler* handler, char const* args)
+	{
+		uint32 limit = 15;
+		if (*args)
+		{
+			int32 value = atoi(args);
+			if (value <= 0)
+				return false;
+
+			limit = uint32(value);
+		}
+
+		if (!sTickProfiler->IsEnabled())
+			handler->SendSysMessage("Profiler is disabled (Profiler.Enable = 0).");
+
+		ProfileSectionStatsList stats;
+		sTickProfiler->GetStats(stats);
+
+		handler->PSendSysMessage("Profiler window: %u s, %u sections (times in us)", sTickProfiler->GetWindowTime() / IN_MILLISECONDS, uint32(stats.size()));
+		for (ProfileSectionStatsList::const_iterator itr = stats.begin(); itr != stats.end() && limit; ++itr, --limit)
+			handler->PSendSysMessage("%s: count %u, total %u ms, avg %u, p50 %u, p99 %u, max %u", itr->Name.c_str(), itr->Count,
+				uint32(itr->TotalTime / IN_MILLISECONDS), uint32(itr->TotalTime / itr->Count), itr->P50, itr->P99, itr->MaxTime);
+
+		return true;
+	}
+
+	static bool HandleServerPerfResetCommand(ChatHandler* handler, char const* /*args*/)
+	{
+		sTickProfiler->Reset();
+		handler->SendSysMessage("Profiler samples reset.");
+		return true;
+	}
+
+	static bool HandleServerPerfDumpCommand(ChatHandler* handler, char const* /*args*/)
+	{
+		if (!sTickProfiler->Dump())
+		{
+			handler->SendSysMessage("Profiler dump failed, check Profiler.DumpFile.");
+			handler->SetSentErrorMessage(true);
+			return false;
+		}
+
+		handler->SendSysMessage("Profiler samples written to the dump file.");
+		return true;
+	}
+
 	/*static bool HandleServerShellUpdateCommand(ChatHandler* handler, char const* /*args*///)
 	/*{
 	if (sWorld->GetServerUpdateState() == SERVER_STATE_COMPILING)
@@ -120,6 +120,14 @@ public:
         else
             infoQueue << "Queued dps: " << sSoloQueueMgr->GetPlayerCountInQueue(TALENT_CAT_DPS) << "\n";
         infoQueue << "Queued healers: " << sSoloQueueMgr->GetPlayerCountInQueue(TALENT_CAT_HEALER) << "\n";
+
+        SoloQueueMatchStats const& matchStats = sSoloQueueMgr->GetMatchStats();
+        infoQueue << "Teams formed: " << matchStats.Matches << "\n";
+        if (matchStats.Matches)
+        {
+            infoQueue << "Average wait: " << matchStats.TotalWaitTime / (matchStats.Matches * 3) / IN_MILLISECONDS << "s, longest: " << matchStats.MaxWaitTime / IN_MILLISECONDS << "s\n";
+            infoQueue << "Average MMR spread: " << matchStats.TotalMmrSpread / matchStats.Matches << ", largest: " << matchStats.MaxMmrSpread << "\n";
+        }
         handler->SendSysMessage(infoQueue.str().c_str());
         return true;
     }
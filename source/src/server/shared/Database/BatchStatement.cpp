@@ -0,0 +1,62 @@
+#include "DatabaseEnv.h"
+#include "BatchStatement.h"
+
+BatchInsertStatement::BatchInsertStatement(SQLTransaction& trans, char const* head) :
+    _trans(trans), _head(head), _rowCount(0), _firstValue(true)
+{
+    _rows.precision(9);
+}
+
+BatchInsertStatement& BatchInsertStatement::NewRow()
+{
+    if (_rowCount)
+        _rows << ')';
+
+    if (_rowCount == MAX_BATCH_STATEMENT_ROWS)
+    {
+        _trans->Append((_head + _rows.str()).c_str());
+        _rows.str("");
+        _rowCount = 0;
+    }
+
+    _rows << (_rowCount ? ", (" : "(");
+    _firstValue = true;
+    ++_rowCount;
+    return *this;
+}
+
+void BatchInsertStatement::Flush()
+{
+    if (!_rowCount)
+        return;
+
+    _rows << ')';
+    _trans->Append((_head + _rows.str()).c_str());
+    _rows.str("");
+    _rowCount = 0;
+}
+
+BatchDeleteStatement::BatchDeleteStatement(SQLTransaction& trans, std::string const& head) :
+    _trans(trans), _head(head), _keyCount(0)
+{
+}
+
+void BatchDeleteStatement::AddKey(uint32 key)
+{
+    if (_keyCount == MAX_BATCH_STATEMENT_ROWS)
+        Flush();
+
+    _keys << (_keyCount ? ", " : "(") << key;
+    ++_keyCount;
+}
+
+void BatchDeleteStatement::Flush()
+{
+    if (!_keyCount)
+        return;
+
+    _keys << ')';
+    _trans->Append((_head + _keys.str()).c_str());
+    _keys.str("");
+    _keyCount = 0;
+}
@@ -0,0 +1,74 @@
+#ifndef _BATCHSTATEMENT_H
+#define _BATCHSTATEMENT_H
+
+#include "Define.h"
+#include "Transaction.h"
+
+#include <sstream>
+
+/// Rows per multi-row statement, keeps a single statement far below max_allowed_packet
+#define MAX_BATCH_STATEMENT_ROWS 500
+
+/*! Collects numeric rows into "INSERT ... VALUES (...), (...)" statements of a transaction. */
+class BatchInsertStatement
+{
+    public:
+        /// head: "INSERT INTO table (column, ...) VALUES "
+        BatchInsertStatement(SQLTransaction& trans, char const* head);
+
+        /// Starts a new row, its values follow with operator<<
+        BatchInsertStatement& NewRow();
+
+        BatchInsertStatement& operator<<(bool value) { return AppendValue(value ? 1 : 0); }
+        BatchInsertStatement& operator<<(uint8 value) { return AppendValue(uint32(value)); }
+        BatchInsertStatement& operator<<(int8 value) { return AppendValue(int32(value)); }
+        BatchInsertStatement& operator<<(uint16 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(int16 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(uint32 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(int32 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(uint64 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(int64 value) { return AppendValue(value); }
+        BatchInsertStatement& operator<<(float value) { return AppendValue(value); }
+
+        /// Appends the pending rows to the transaction
+        void Flush();
+
+    private:
+        template<class T>
+        BatchInsertStatement& AppendValue(T value)
+        {
+            if (!_firstValue)
+                _rows << ", ";
+
+            _rows << value;
+            _firstValue = false;
+            return *this;
+        }
+
+        SQLTransaction& _trans;
+        std::string _head;
+        std::ostringstream _rows;
+        uint32 _rowCount;
+        bool _firstValue;
+};
+
+/*! Collects keys into "DELETE ... IN (...)" statements of a transaction. */
+class BatchDeleteStatement
+{
+    public:
+        /// head: "DELETE FROM table WHERE ... AND column IN "
+        BatchDeleteStatement(SQLTransaction& trans, std::string const& head);
+
+        void AddKey(uint32 key);
+
+        /// Appends the pending keys to the transaction
+        void Flush();
+
+    private:
+        SQLTransaction& _trans;
+        std::string _head;
+        std::ostringstream _keys;
+        uint32 _keyCount;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #ifndef _DATABASEWORKERPOOL_H
 #define _DATABASEWORKERPOOL_H
 
+#include <ace/Atomic_Op.h>
 #include <ace/Thread_Mutex.h>
 
 #include "Common.h"
@@ -34,6 +35,17 @@
 #define MIN_MYSQL_SERVER_VERSION 50100u
 #define MIN_MYSQL_CLIENT_VERSION 50100u
 
+//! Owner kinds of asynchronous operations which must run in order, see DatabaseWorkerPool::Open
+enum DatabaseAffinityType
+{
+    DB_AFFINITY_CHARACTER   = 1,
+    DB_AFFINITY_GUILD       = 2,
+    DB_AFFINITY_ACCOUNT     = 3
+};
+
+//! Key 0 means no affinity
+#define MAKE_DB_AFFINITY_KEY(type, id) ((uint64(type) << 32) | uint32(id))
+
 class PingOperation : public SQLOperation
 {
     //! Operation for idle delaythreads
@@ -50,7 +62,7 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _queue(new ACE_Activation_Queue()), _nextShard(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
             _connections.resize(IDX_SIZE);
@@ -63,19 +75,29 @@ class DatabaseWorkerPool
         {
         }
 
-        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads)
+        //! With sharded queues every asynchronous connection reads its own queue. Operations enqueued with the same
+        //! affinity key always land on the same connection and are executed in the order they were enqueued,
+        //! operations without a key are spread round-robin. Otherwise all connections share one queue.
+        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads, bool shardedQueues = false)
         {
             bool res = true;
             _connectionInfo = MySQLConnectionInfo(infoString);
 
-            TC_LOG_INFO("sql.driver", "Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u.",
-                GetDatabaseName(), async_threads, synch_threads);
+            TC_LOG_INFO("sql.driver", "Opening DatabasePool '%s'. Asynchronous connections: %u%s, synchronous connections: %u.",
+                GetDatabaseName(), async_threads, shardedQueues ? " (sharded queues)" : "", synch_threads);
+
+            if (shardedQueues)
+            {
+                _shardQueues.resize(async_threads);
+                for (uint8 i = 0; i < async_threads; ++i)
+                    _shardQueues[i] = new ACE_Activation_Queue();
+            }
 
             //! Open asynchronous connections (delayed operations)
             _connections[IDX_ASYNC].resize(async_threads);
             for (uint8 i = 0; i < async_threads; ++i)
             {
-                T* t = new T(_queue, _connectionInfo);
+                T* t = new T(_shardQueues.empty() ? _queue : _shardQueues[i], _connectionInfo);
                 res &= t->Open();
                 if (res) // only check mysql version if connection is valid
                     WPFatal(mysql_get_server_version(t->GetHandle()) >= MIN_MYSQL_SERVER_VERSION, "TrinityCore does not support MySQL versions below 5.1");
@@ -110,6 +132,8 @@ class DatabaseWorkerPool
             //! The next dequeue attempt in the worker thread tasks will result in an error,
             //! ultimately ending the worker thread task.
             _queue->queue()->close();
+            for (size_t i = 0; i < _shardQueues.size(); ++i)
+                _shardQueues[i]->queue()->close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -132,6 +156,9 @@ class DatabaseWorkerPool
 
             //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
             delete _queue;
+            for (size_t i = 0; i < _shardQueues.size(); ++i)
+                delete _shardQueues[i];
+            _shardQueues.clear();
 
             TC_LOG_INFO("sql.driver", "All connections on DatabasePool '%s' closed.", GetDatabaseName());
         }
@@ -169,10 +196,10 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement* stmt)
+        void Execute(PreparedStatement* stmt, uint64 affinityKey = 0)
         {
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
-            Enqueue(task);
+            Enqueue(task, affinityKey);
         }
 
         /**
@@ -322,11 +349,11 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt)
+        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, uint64 affinityKey = 0)
         {
             PreparedQueryResultFuture res;
             PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
-            Enqueue(task);
+            Enqueue(task, affinityKey);
             return res;
         }
 
@@ -334,11 +361,11 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, uint64 affinityKey = 0)
         {
             QueryResultHolderFuture res;
             SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-            Enqueue(task);
+            Enqueue(task, affinityKey);
             return res;     //! Fool compiler, has no use yet
         }
 
@@ -354,7 +381,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction transaction)
+        void CommitTransaction(SQLTransaction transaction, uint64 affinityKey = 0)
         {
             #ifdef TRINITY_DEBUG
             //! Only analyze transaction weaknesses in Debug mode.
@@ -373,10 +400,36 @@ class DatabaseWorkerPool
             }
             #endif // TRINITY_DEBUG
 
-            Enqueue(new TransactionTask(transaction));
+            Enqueue(new TransactionTask(transaction), affinityKey);
         }
 
-        SQLTransactionFuture CommitTransactionWithFuture(SQLTransaction transaction)
+        //! Enqueues a transaction ordered with the operations of two affinity keys: it is executed after everything
+        //! enqueued before it under either key and before everything enqueued after it. With sharded queues the
+        //! connection of the second key is held until the transaction is executed on the connection of the first.
+        void CommitTransaction(SQLTransaction transaction, uint64 affinityKey, uint64 secondAffinityKey)
+        {
+            if (_shardQueues.empty())
+            {
+                _queue->enqueue(new TransactionTask(transaction));
+                return;
+            }
+
+            ACE_Activation_Queue* transactionQueue = _shardQueues[size_t(affinityKey % _shardQueues.size())];
+            ACE_Activation_Queue* barrierQueue = _shardQueues[size_t(secondAffinityKey % _shardQueues.size())];
+            if (transactionQueue == barrierQueue)
+            {
+                transactionQueue->enqueue(new TransactionTask(transaction));
+                return;
+            }
+
+            //! Pairs are enqueued one at a time, two barriers can never wait on each other's queue
+            TransactionBarrier barrier(new TransactionBarrierState(transactionQueue, barrierQueue));
+            TRINITY_GUARD(ACE_Thread_Mutex, _barrierLock);
+            barrierQueue->enqueue(new TransactionBarrierTask(barrier));
+            transactionQueue->enqueue(new TransactionTaskWithBarrier(transaction, barrier));
+        }
+
+        SQLTransactionFuture CommitTransactionWithFuture(SQLTransaction transaction, uint64 affinityKey = 0)
         {
             #ifdef TRINITY_DEBUG
             //! Only analyze transaction weaknesses in Debug mode.
@@ -402,7 +455,7 @@ class DatabaseWorkerPool
             TransactionTaskWithFuture* task = new TransactionTaskWithFuture(transaction);
             // Store future result before enqueueing - task might get already processed and deleted before returning from this method
             SQLTransactionFuture result = task->GetFuture();
-            Enqueue(task);
+            Enqueue(task, affinityKey);
             return result;
         }
 
@@ -437,10 +490,10 @@ class DatabaseWorkerPool
 
         //! Method used to execute prepared statements in a diverse context.
         //! Will be wrapped in a transaction if valid object is present, otherwise executed standalone.
-        void ExecuteOrAppend(SQLTransaction& trans, PreparedStatement* stmt)
+        void ExecuteOrAppend(SQLTransaction& trans, PreparedStatement* stmt, uint64 affinityKey = 0)
         {
             if (trans.null())
-                Execute(stmt);
+                Execute(stmt, affinityKey);
             else
                 trans->Append(stmt);
         }
@@ -496,10 +549,34 @@ class DatabaseWorkerPool
             //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
             //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
             //! as the sole purpose is to prevent connections from idling.
+            if (!_shardQueues.empty())
+            {
+                for (size_t i = 0; i < _shardQueues.size(); ++i)
+                    _shardQueues[i]->enqueue(new PingOperation);
+                return;
+            }
+
             for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
                 Enqueue(new PingOperation);
         }
 
+        //! Number of queues feeding the asynchronous connections, 1 unless queues are sharded
+        uint8 GetQueueCount() const
+        {
+            return _shardQueues.empty() ? 1 : uint8(_shardQueues.size());
+        }
+
+        //! Operations waiting in the given queue, not counting the ones being executed
+        size_t GetQueueSize(uint8 index) const
+        {
+            return _shardQueues.empty() ? _queue->method_count() : _shardQueues[index]->method_count();
+        }
+
+        char const* GetDatabaseName() const
+        {
+            return _connectionInfo.database.c_str();
+        }
+
     private:
         unsigned long EscapeString(char *to, const char *from, unsigned long length)
         {
@@ -509,9 +586,16 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
-        void Enqueue(SQLOperation* op)
+        void Enqueue(SQLOperation* op, uint64 affinityKey = 0)
         {
-            _queue->enqueue(op);
+            if (_shardQueues.empty())
+            {
+                _queue->enqueue(op);
+                return;
+            }
+
+            size_t shard = affinityKey ? size_t(affinityKey % _shardQueues.size()) : size_t(uint32(++_nextShard) % _shardQueues.size());
+            _shardQueues[shard]->enqueue(op);
         }
 
         //! Gets a free connection in the synchronous connection pool.
@@ -533,11 +617,6 @@ class DatabaseWorkerPool
             return NULL;
         }
 
-        char const* GetDatabaseName() const
-        {
-            return _connectionInfo.database.c_str();
-        }
-
     private:
         enum _internalIndex
         {
@@ -547,6 +626,9 @@ class DatabaseWorkerPool
         };
 
         ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        std::vector<ACE_Activation_Queue*> _shardQueues;    //! Per async connection queues, empty unless sharded.
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _nextShard; //! Round-robin counter for operations without affinity key.
+        ACE_Thread_Mutex                _barrierLock;       //! Serializes enqueueing transactions ordered on two shards.
         std::vector< std::vector<T*> >  _connections;
         uint32                          _connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
@@ -725,4 +725,11 @@ void CharacterDatabaseConnection::DoPrepareStatements()
 
     //Item services
     PrepareStatement(CHAR_SEL_ITEM_INSTANCE_LOOKUP_ALL_OF_PLAYER, "SELECT  `guid`,  `itemEntry`,  `owner_guid`,  `creatorGuid`,  `giftCreatorGuid`,  `count`,  `duration`,  `charges`,  `flags`, LEFT(`enchantments`, 256),  `randomPropertyId`,  `durability`,  `playedTime`, LEFT(`text`, 256) FROM item_instance_buyback iib WHERE iib.itemEntry IN (?) AND iib.owner_guid IN (?) UNION SELECT  `guid`,  `itemEntry`,  `owner_guid`,  `creatorGuid`,  `giftCreatorGuid`,  `count`,  `duration`,  `charges`,  `flags`, LEFT(`enchantments`, 256), `randomPropertyId`,  `durability`,  `playedTime`, LEFT(`text`, 256) FROM item_instance ii WHERE ii.itemEntry IN(? ) AND ii.owner_guid IN(? ); ", CONNECTION_SYNCH);
+
+    // Anticheat reports
+    PrepareStatement(CHAR_SEL_DAILY_PLAYERS_REPORT, "SELECT guid FROM daily_players_reports WHERE guid = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_DAILY_PLAYERS_REPORT, "REPLACE INTO daily_players_reports (guid, average, total_reports, speed_reports, fly_reports, jump_reports, waterwalk_reports, teleportplane_reports, climb_reports, creation_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_PLAYERS_REPORTS_STATUS, "REPLACE INTO players_reports_status (guid, average, total_reports, speed_reports, fly_reports, jump_reports, waterwalk_reports, teleportplane_reports, climb_reports, creation_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_PLAYERS_REPORTS_STATUS, "DELETE FROM players_reports_status WHERE guid = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_ALL_PLAYERS_REPORTS_STATUS, "DELETE FROM players_reports_status", CONNECTION_ASYNC);
 }
@@ -655,6 +655,12 @@ enum CharacterDatabaseStatements
 
     CHAR_SEL_ITEM_INSTANCE_LOOKUP_ALL_OF_PLAYER,
 
+    CHAR_SEL_DAILY_PLAYERS_REPORT,
+    CHAR_REP_DAILY_PLAYERS_REPORT,
+    CHAR_REP_PLAYERS_REPORTS_STATUS,
+    CHAR_DEL_PLAYERS_REPORTS_STATUS,
+    CHAR_DEL_ALL_PLAYERS_REPORTS_STATUS,
+
     MAX_CHARACTERDATABASE_STATEMENTS
 };
 
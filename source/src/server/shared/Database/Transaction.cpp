@@ -97,3 +97,33 @@ bool TransactionTaskWithFuture::Execute()
     _result.set_value(result);
     return result;
 }
+
+void TransactionBarrierState::Signal(bool TransactionBarrierState::* flag)
+{
+    std::lock_guard<std::mutex> guard(Lock);
+    this->*flag = true;
+    Condition.notify_all();
+}
+
+void TransactionBarrierState::Wait(bool TransactionBarrierState::* flag, ACE_Activation_Queue* otherQueue)
+{
+    // Closing the pool drops everything still queued, don't wait for a task that will never run
+    std::unique_lock<std::mutex> guard(Lock);
+    while (!(this->*flag) && !otherQueue->queue()->deactivated())
+        Condition.wait_for(guard, std::chrono::seconds(1));
+}
+
+bool TransactionTaskWithBarrier::Execute()
+{
+    _barrier->Wait(&TransactionBarrierState::Reached, _barrier->BarrierQueue);
+    bool result = TransactionTask::Execute();
+    _barrier->Signal(&TransactionBarrierState::Done);
+    return result;
+}
+
+bool TransactionBarrierTask::Execute()
+{
+    _barrier->Signal(&TransactionBarrierState::Reached);
+    _barrier->Wait(&TransactionBarrierState::Done, _barrier->TransactionQueue);
+    return true;
+}
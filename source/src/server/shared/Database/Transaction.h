@@ -20,7 +20,10 @@
 
 #include "SQLOperation.h"
 
+#include <condition_variable>
 #include <future>
+#include <memory>
+#include <mutex>
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -86,4 +89,46 @@ class TransactionTaskWithFuture : public TransactionTask
         SQLTransactionPromise _result;
 };
 
+/*! Shared by a transaction and the barrier holding the connection of a second affinity key until it is executed */
+struct TransactionBarrierState
+{
+    TransactionBarrierState(ACE_Activation_Queue* transactionQueue, ACE_Activation_Queue* barrierQueue) :
+        Reached(false), Done(false), TransactionQueue(transactionQueue), BarrierQueue(barrierQueue) { }
+
+    void Signal(bool TransactionBarrierState::* flag);
+    void Wait(bool TransactionBarrierState::* flag, ACE_Activation_Queue* otherQueue);
+
+    std::mutex Lock;
+    std::condition_variable Condition;
+    bool Reached;                                           // everything enqueued before on the barrier queue is executed
+    bool Done;                                              // the transaction is executed
+    ACE_Activation_Queue* TransactionQueue;
+    ACE_Activation_Queue* BarrierQueue;
+};
+typedef std::shared_ptr<TransactionBarrierState> TransactionBarrier;
+
+class TransactionTaskWithBarrier : public TransactionTask
+{
+    public:
+        TransactionTaskWithBarrier(SQLTransaction trans, TransactionBarrier barrier) : TransactionTask(trans), _barrier(barrier) { }
+
+    protected:
+        bool Execute() override;
+
+    private:
+        TransactionBarrier _barrier;
+};
+
+class TransactionBarrierTask : public SQLOperation
+{
+    public:
+        TransactionBarrierTask(TransactionBarrier barrier) : _barrier(barrier) { }
+
+    protected:
+        bool Execute() override;
+
+    private:
+        TransactionBarrier _barrier;
+};
+
 #endif
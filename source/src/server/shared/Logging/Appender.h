@@ -92,6 +92,8 @@ class Appender
 
         void setLogLevel(LogLevel);
         void write(LogMessage& message);
+        /// Writes out buffered messages, called by the async log worker when it runs idle
+        virtual void flush() { }
         static const char* getLogLevelString(LogLevel level);
 
     private:
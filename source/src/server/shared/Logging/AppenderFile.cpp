@@ -17,18 +17,21 @@
 
 #include "AppenderFile.h"
 #include "Common.h"
+#include "Timer.h"
 
 #if PLATFORM == PLATFORM_WINDOWS
 # include <Windows.h>
 #endif
 
-AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, const char* _filename, const char* _logDir, const char* _mode, AppenderFlags _flags, uint64 fileSize):
+AppenderFile::AppenderFile(uint8 id, std::string const& name, LogLevel level, const char* _filename, const char* _logDir, const char* _mode, AppenderFlags _flags, uint64 fileSize, uint32 _flushInterval):
     Appender(id, name, APPENDER_FILE, level, _flags),
     logfile(NULL),
     filename(_filename),
     logDir(_logDir),
     mode(_mode),
     maxFileSize(fileSize),
+    flushInterval(_flushInterval),
+    lastFlushTime(getMSTime()),
     fileSize(0)
 {
     dynamicName = std::string::npos != filename.find("%s");
@@ -67,9 +70,21 @@ void AppenderFile::_write(LogMessage const& message)
     if (!logfile)
         return;
 
-    fprintf(logfile, "%s%s", message.prefix.c_str(), message.text.c_str());
-    fflush(logfile);
+    fwrite(message.prefix.c_str(), 1, message.prefix.size(), logfile);
+    fwrite(message.text.c_str(), 1, message.text.size(), logfile);
     fileSize += uint64(message.Size());
+
+    if (!flushInterval || getMSTimeDiff(lastFlushTime, getMSTime()) >= flushInterval)
+        flush();
+}
+
+void AppenderFile::flush()
+{
+    if (!logfile)
+        return;
+
+    fflush(logfile);
+    lastFlushTime = getMSTime();
 }
 
 FILE* AppenderFile::OpenFile(std::string const &filename, std::string const &mode, bool backup)
@@ -24,9 +24,10 @@
 class AppenderFile: public Appender
 {
     public:
-        AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags, uint64 maxSize);
+        AppenderFile(uint8 _id, std::string const& _name, LogLevel level, const char* filename, const char* logDir, const char* mode, AppenderFlags flags, uint64 maxSize, uint32 flushInterval = 0);
         ~AppenderFile();
         FILE* OpenFile(std::string const& _name, std::string const& _mode, bool _backup);
+        void flush();
 
     private:
         void CloseFile();
@@ -38,6 +39,8 @@ class AppenderFile: public Appender
         bool dynamicName;
         bool backup;
         uint64 maxFileSize;
+        uint32 flushInterval;                               // 0 flushes every message
+        uint32 lastFlushTime;
         ACE_Atomic_Op<ACE_Thread_Mutex, uint64> fileSize;
 };
 
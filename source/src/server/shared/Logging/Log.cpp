@@ -29,8 +29,9 @@
 #include <cstdio>
 #include <sstream>
 
-Log::Log() : worker(NULL)
+Log::Log() : AppenderId(0), flushInterval(0), worker(NULL)
 {
+    generation.store(1, std::memory_order_relaxed);
     m_logsTimestamp = "_" + GetTimestampStr();
     LoadFromConfig();
 }
@@ -142,7 +143,8 @@ void Log::CreateAppenderFromConfig(std::string const& appenderName)
                 maxFileSize = atoi(*iter++);
 
             uint8 id = NextAppenderId();
-            appenders[id] = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags, maxFileSize);
+            // Batched writes only when the worker flushes the rest once it runs idle
+            appenders[id] = new AppenderFile(id, name, level, filename.c_str(), m_logsDir.c_str(), mode.c_str(), flags, maxFileSize, flushInterval);
             //fprintf(stdout, "Log::CreateAppenderFromConfig: Created Appender %s (%u), Type FILE, Mask %u, File %s, Mode %s\n", name.c_str(), id, level, filename.c_str(), mode.c_str());
             break;
         }
@@ -264,12 +266,24 @@ void Log::vlog(std::string const& filter, LogLevel level, char const* str, va_li
 {
     char text[MAX_QUERY_LEN];
     vsnprintf(text, MAX_QUERY_LEN, str, argptr);
-    write(new LogMessage(level, filter, text));
+    write(new LogMessage(level, filter, text), GetLoggerByType(filter));
 }
 
-void Log::write(LogMessage* msg)
+void Log::vlog(LogFilter const& filter, LogLevel level, char const* str, va_list argptr)
 {
-    Logger const* logger = GetLoggerByType(msg->type);
+    char text[MAX_QUERY_LEN];
+    vsnprintf(text, MAX_QUERY_LEN, str, argptr);
+    write(new LogMessage(level, filter.Name, text), filter.Target.load(std::memory_order_relaxed));
+}
+
+void Log::write(LogMessage* msg, Logger const* logger)
+{
+    if (!logger)
+    {
+        delete msg;
+        return;
+    }
+
     msg->text.append("\n");
 
     if (worker)
@@ -281,6 +295,15 @@ void Log::write(LogMessage* msg)
     }
 }
 
+void Log::ResolveFilter(LogFilter& filter)
+{
+    uint32 current = generation.load(std::memory_order_acquire);
+    Logger const* logger = GetLoggerByType(filter.Name);
+    filter.Target.store(logger, std::memory_order_relaxed);
+    filter.Level.store(uint8(logger ? logger->getLogLevel() : LOG_LEVEL_DISABLED), std::memory_order_relaxed);
+    filter.Generation.store(current, std::memory_order_release);
+}
+
 std::string Log::GetTimestampStr()
 {
     time_t t = time(NULL);
@@ -313,6 +336,7 @@ bool Log::SetLogLevel(std::string const& name, const char* newLevelc, bool isLog
             return false;
 
         it->second.setLogLevel(newLevel);
+        ++generation;
     }
     else
     {
@@ -341,7 +365,7 @@ void Log::outCharDump(char const* str, uint32 accountId, uint32 guid, char const
 
     msg->param1 = param.str();
 
-    write(msg);
+    write(msg, GetLoggerByType(msg->type));
 }
 
 void Log::outCommand(uint32 account, const char * str, ...)
@@ -361,7 +385,7 @@ void Log::outCommand(uint32 account, const char * str, ...)
     ss << account;
     msg->param1 = ss.str();
 
-    write(msg);
+    write(msg, GetLoggerByType(msg->type));
 }
 
 void Log::SetRealmId(uint32 id)
@@ -375,8 +399,12 @@ void Log::Close()
 {
     delete worker;
     worker = NULL;
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(cachedLoggersLock);
+        cachedLoggers.clear();
+    }
     loggers.clear();
-    cachedLoggers.clear();
+    ++generation;
     for (AppenderMap::iterator it = appenders.begin(); it != appenders.end(); ++it)
     {
         delete it->second;
@@ -389,8 +417,8 @@ void Log::LoadFromConfig()
 {
     Close();
 
-    if (sConfigMgr->GetBoolDefault("Log.Async.Enable", false))
-        worker = new LogWorker();
+    bool async = sConfigMgr->GetBoolDefault("Log.Async.Enable", false);
+    flushInterval = async ? uint32(sConfigMgr->GetIntDefault("Log.Async.FlushInterval", 1000)) : 0;
 
     AppenderId = 0;
     m_logsDir = sConfigMgr->GetStringDefault("LogsDir", "");
@@ -400,4 +428,11 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+
+    // filters resolved while the loggers were read are stale
+    ++generation;
+
+    // the worker thread reads the appenders, it starts once they are complete
+    if (async)
+        worker = new LogWorker(appenders);
 }
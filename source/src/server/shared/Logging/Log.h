@@ -24,12 +24,35 @@
 #include "Logger.h"
 #include "LogWorker.h"
 
+#include <atomic>
 #include <unordered_map>
 #include <string>
 #include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
 
 #define LOGGER_ROOT "root"
 
+// Messages below this level are compiled out
+#ifndef TRINITY_LOG_MIN_LEVEL
+#define TRINITY_LOG_MIN_LEVEL LOG_LEVEL_TRACE
+#endif
+
+/// Logger handle of one call site, resolved on first use and again after the log configuration changed
+struct LogFilter
+{
+    explicit LogFilter(char const* name) : Name(name)
+    {
+        Generation.store(0, std::memory_order_relaxed);
+        Level.store(LOG_LEVEL_DISABLED, std::memory_order_relaxed);
+        Target.store(NULL, std::memory_order_relaxed);
+    }
+
+    char const* Name;
+    std::atomic<uint32> Generation;
+    std::atomic<uint8> Level;
+    std::atomic<Logger const*> Target;
+};
+
 class Log
 {
     friend class ACE_Singleton<Log, ACE_Thread_Mutex>;
@@ -45,9 +68,11 @@ class Log
         void LoadFromConfig();
         void Close();
         bool ShouldLog(std::string const& type, LogLevel level);
+        bool ShouldLog(LogFilter& filter, LogLevel level);
         bool SetLogLevel(std::string const& name, char const* level, bool isLogger = true);
 
         void outMessage(std::string const& f, LogLevel level, char const* str, ...) ATTR_PRINTF(4, 5);
+        void outMessage(LogFilter const& filter, LogLevel level, char const* str, ...) ATTR_PRINTF(4, 5);
 
         void outCommand(uint32 account, const char * str, ...) ATTR_PRINTF(3, 4);
         void outCharDump(char const* str, uint32 account_id, uint32 guid, char const* name);
@@ -57,7 +82,9 @@ class Log
     private:
         static std::string GetTimestampStr();
         void vlog(std::string const& f, LogLevel level, char const* str, va_list argptr);
-        void write(LogMessage* msg);
+        void vlog(LogFilter const& filter, LogLevel level, char const* str, va_list argptr);
+        void write(LogMessage* msg, Logger const* logger);
+        void ResolveFilter(LogFilter& filter);
 
         Logger const* GetLoggerByType(std::string const& type);
         Appender* GetAppenderByName(std::string const& name);
@@ -70,7 +97,10 @@ class Log
         AppenderMap appenders;
         LoggerMap loggers;
         CachedLoggerContainer cachedLoggers;
+        ACE_Thread_Mutex cachedLoggersLock;
+        std::atomic<uint32> generation;                     // bumped whenever resolved filters may be stale
         uint8 AppenderId;
+        uint32 flushInterval;                               // 0 without the async worker
 
         std::string m_logsDir;
         std::string m_logsTimestamp;
@@ -80,6 +110,8 @@ class Log
 
 inline Logger const* Log::GetLoggerByType(std::string const& originalType)
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(cachedLoggersLock);
+
     // Check if already cached
     CachedLoggerContainer::const_iterator itCached = cachedLoggers.find(originalType);
     if (itCached != cachedLoggers.end())
@@ -117,6 +149,15 @@ inline bool Log::ShouldLog(std::string const& type, LogLevel level)
     return logLevel != LOG_LEVEL_DISABLED && logLevel <= level;
 }
 
+inline bool Log::ShouldLog(LogFilter& filter, LogLevel level)
+{
+    if (filter.Generation.load(std::memory_order_acquire) != generation.load(std::memory_order_relaxed))
+        ResolveFilter(filter);
+
+    uint8 logLevel = filter.Level.load(std::memory_order_relaxed);
+    return logLevel != LOG_LEVEL_DISABLED && logLevel <= level;
+}
+
 inline void Log::outMessage(std::string const& filter, LogLevel level, const char * str, ...)
 {
     va_list ap;
@@ -127,21 +168,47 @@ inline void Log::outMessage(std::string const& filter, LogLevel level, const cha
     va_end(ap);
 }
 
+inline void Log::outMessage(LogFilter const& filter, LogLevel level, const char * str, ...)
+{
+    va_list ap;
+    va_start(ap, str);
+
+    vlog(filter, level, str, ap);
+
+    va_end(ap);
+}
+
 #define sLog ACE_Singleton<Log, ACE_Thread_Mutex>::instance()
 
+// Static handle of the calling site, filterType__ must be a constant string
+#define TC_LOG_FILTER(filterType__) \
+        ([]() -> LogFilter& { static LogFilter filter__(filterType__); return filter__; }())
+
+// Guards expensive preparation of log output
+#define TC_LOG_ENABLED(filterType__, level__) \
+        ((level__) >= TRINITY_LOG_MIN_LEVEL && sLog->ShouldLog(TC_LOG_FILTER(filterType__), level__))
+
 #if PLATFORM != PLATFORM_WINDOWS
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                sLog->outMessage(filterType__, level__, __VA_ARGS__);   \
+            if ((level__) >= TRINITY_LOG_MIN_LEVEL)                     \
+            {                                                           \
+                LogFilter& logFilter__ = TC_LOG_FILTER(filterType__);   \
+                if (sLog->ShouldLog(logFilter__, level__))              \
+                    sLog->outMessage(logFilter__, level__, __VA_ARGS__); \
+            }                                                           \
         } while (0)
 #else
 #define TC_LOG_MESSAGE_BODY(filterType__, level__, ...)                 \
         __pragma(warning(push))                                         \
         __pragma(warning(disable:4127))                                 \
         do {                                                            \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                sLog->outMessage(filterType__, level__, __VA_ARGS__);   \
+            if ((level__) >= TRINITY_LOG_MIN_LEVEL)                     \
+            {                                                           \
+                LogFilter& logFilter__ = TC_LOG_FILTER(filterType__);   \
+                if (sLog->ShouldLog(logFilter__, level__))              \
+                    sLog->outMessage(logFilter__, level__, __VA_ARGS__); \
+            }                                                           \
         } while (0)                                                     \
         __pragma(warning(pop))
 #endif
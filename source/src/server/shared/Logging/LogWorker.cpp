@@ -16,35 +16,188 @@
  */
 
 #include "LogWorker.h"
+#include "Common.h"
 
-LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+#include <ace/TSS_T.h>
+
+// Rings outlive the worker, threads keep their ring over log reloads and hand it back on exit
+class LogRingRegistry
+{
+    public:
+        LogRingRegistry() : m_ringCount(0)
+        {
+            for (uint32 i = 0; i < MAX_LOG_RINGS; ++i)
+                m_rings[i].store(NULL, std::memory_order_relaxed);
+        }
+
+        LogRing* Acquire()
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_lock);
+
+            uint32 count = m_ringCount.load(std::memory_order_relaxed);
+            for (uint32 i = 0; i < count; ++i)
+            {
+                LogRing* ring = m_rings[i].load(std::memory_order_relaxed);
+                if (!ring->InUse.load(std::memory_order_acquire))
+                {
+                    ring->InUse.store(true, std::memory_order_relaxed);
+                    return ring;
+                }
+            }
+
+            // Threads beyond the limit share the locked fallback path
+            if (count == MAX_LOG_RINGS)
+                return NULL;
+
+            LogRing* ring = new LogRing();
+            ring->InUse.store(true, std::memory_order_relaxed);
+            m_rings[count].store(ring, std::memory_order_relaxed);
+            m_ringCount.store(count + 1, std::memory_order_release);
+            return ring;
+        }
+
+        uint32 GetRingCount() const { return m_ringCount.load(std::memory_order_acquire); }
+        LogRing* GetRing(uint32 index) const { return m_rings[index].load(std::memory_order_relaxed); }
+
+        ACE_Thread_Mutex& GetFallbackLock() { return m_fallbackLock; }
+        LogRing& GetFallbackRing() { return m_fallbackRing; }
+
+    private:
+        ACE_Thread_Mutex m_lock;
+        std::atomic<LogRing*> m_rings[MAX_LOG_RINGS];
+        std::atomic<uint32> m_ringCount;
+
+        ACE_Thread_Mutex m_fallbackLock;
+        LogRing m_fallbackRing;
+};
+
+static LogRingRegistry logRings;
+
+struct LogRingSlot
+{
+    LogRingSlot() : Ring(logRings.Acquire()) { }
+    ~LogRingSlot()
+    {
+        if (Ring)
+            Ring->InUse.store(false, std::memory_order_release);
+    }
+
+    LogRing* Ring;
+};
+
+typedef ACE_TSS<LogRingSlot> LogRingTSS;
+static LogRingTSS logRingSlot;
+
+LogRing::LogRing()
+{
+    memset(Operations, 0, sizeof(Operations));
+    Head.store(0, std::memory_order_relaxed);
+    Tail.store(0, std::memory_order_relaxed);
+    InUse.store(false, std::memory_order_relaxed);
+}
+
+static void PushToRing(LogRing& ring, LogOperation* op)
+{
+    uint32 head = ring.Head.load(std::memory_order_relaxed);
+
+    // Full, wait for the worker instead of dropping messages
+    while (head - ring.Tail.load(std::memory_order_acquire) >= LOG_RING_SIZE)
+        ACE_OS::thr_yield();
+
+    ring.Operations[head & (LOG_RING_SIZE - 1)] = op;
+    ring.Head.store(head + 1, std::memory_order_release);
+}
+
+LogWorker::LogWorker(AppenderMap const& appenders)
+    : m_appenders(appenders)
 {
+    m_stop.store(false, std::memory_order_relaxed);
     ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
 }
 
 LogWorker::~LogWorker()
 {
-    m_queue.deactivate();
+    m_stop.store(true, std::memory_order_release);
     wait();
 }
 
 int LogWorker::enqueue(LogOperation* op)
 {
-    return m_queue.enqueue(op);
+    if (LogRing* ring = logRingSlot->Ring)
+    {
+        PushToRing(*ring, op);
+        return 0;
+    }
+
+    TRINITY_GUARD(ACE_Thread_Mutex, logRings.GetFallbackLock());
+    PushToRing(logRings.GetFallbackRing(), op);
+    return 0;
+}
+
+bool LogWorker::Drain()
+{
+    bool drained = false;
+    uint32 count = logRings.GetRingCount();
+    for (uint32 i = 0; i <= count; ++i)
+    {
+        LogRing& ring = i < count ? *logRings.GetRing(i) : logRings.GetFallbackRing();
+        uint32 tail = ring.Tail.load(std::memory_order_relaxed);
+        uint32 head = ring.Head.load(std::memory_order_acquire);
+        if (tail == head)
+            continue;
+
+        for (; tail != head; ++tail)
+        {
+            LogOperation*& op = ring.Operations[tail & (LOG_RING_SIZE - 1)];
+            op->call();
+            delete op;
+            op = NULL;
+        }
+
+        ring.Tail.store(tail, std::memory_order_release);
+        drained = true;
+    }
+
+    return drained;
+}
+
+void LogWorker::FlushAppenders()
+{
+    for (AppenderMap::const_iterator itr = m_appenders.begin(); itr != m_appenders.end(); ++itr)
+        if (itr->second)
+            itr->second->flush();
 }
 
 int LogWorker::svc()
 {
+    bool pendingFlush = false;
     while (1)
     {
-        LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
-            break;
+        if (Drain())
+        {
+            pendingFlush = true;
+            continue;
+        }
+
+        // Idle, write out whatever the appenders still buffer
+        if (pendingFlush)
+        {
+            FlushAppenders();
+            pendingFlush = false;
+        }
+
+        if (m_stop.load(std::memory_order_acquire))
+        {
+            if (!Drain())
+                break;
+
+            pendingFlush = true;
+            continue;
+        }
 
-        request->call();
-        delete request;
+        ACE_OS::sleep(ACE_Time_Value(0, LOG_WORKER_IDLE * 1000));
     }
 
+    FlushAppenders();
     return 0;
 }
@@ -18,30 +18,44 @@
 #ifndef LOGWORKER_H
 #define LOGWORKER_H
 
+#include "Appender.h"
 #include "LogOperation.h"
 
 #include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include <atomic>
+
+// Must be a power of two
+#define LOG_RING_SIZE       4096
+#define MAX_LOG_RINGS       256
+// Time the worker sleeps when all rings are empty
+#define LOG_WORKER_IDLE     10
+
+// Operations of one thread, written only by the owning thread and read only by the worker
+struct LogRing
+{
+    LogRing();
+
+    LogOperation* Operations[LOG_RING_SIZE];
+    std::atomic<uint32> Head;                               // next slot written by the owner
+    std::atomic<uint32> Tail;                               // next slot read by the worker
+    std::atomic<bool> InUse;
+};
 
 class LogWorker: protected ACE_Task_Base
 {
     public:
-        LogWorker();
+        explicit LogWorker(AppenderMap const& appenders);
         ~LogWorker();
 
-        typedef ACE_Message_Queue_Ex<LogOperation, ACE_MT_SYNCH> LogMessageQueueType;
-
-        enum
-        {
-            HIGH_WATERMARK = 8 * 1024 * 1024,
-            LOW_WATERMARK  = 8 * 1024 * 1024
-        };
-
         int enqueue(LogOperation *op);
 
     private:
         virtual int svc();
-        LogMessageQueueType m_queue;
+        bool Drain();
+        void FlushAppenders();
+
+        AppenderMap const& m_appenders;
+        std::atomic<bool> m_stop;
 };
 
 #endif
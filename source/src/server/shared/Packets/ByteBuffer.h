@@ -640,7 +640,7 @@ class ByteBuffer
 
         void print_storage() const
         {
-            if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
+            if (!TC_LOG_ENABLED("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
                 return;
 
             std::ostringstream o;
@@ -654,7 +654,7 @@ class ByteBuffer
 
         void textlike() const
         {
-            if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
+            if (!TC_LOG_ENABLED("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
                 return;
 
             std::ostringstream o;
@@ -671,7 +671,7 @@ class ByteBuffer
 
         void hexlike() const
         {
-            if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
+            if (!TC_LOG_ENABLED("network.opcode", LOG_LEVEL_TRACE)) // optimize disabled debug output
                 return;
 
             uint32 j = 1, k = 1;
@@ -0,0 +1,88 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+
+namespace ACE_Based
+{
+    /**
+     * Unbounded lock-free queue for many producers and a single consumer.
+     *
+     * Intrusive, T needs a default constructor and a std::atomic<T*> QueueNext
+     * member. A producer only exchanges the head, the consumer may find an
+     * element of a producer which has not linked it yet and then sees the
+     * queue as empty until the next Dequeue(). Elements still queued are
+     * deleted with the queue.
+     */
+    template <class T>
+        class MPSCQueue
+    {
+        public:
+
+            MPSCQueue() : _head(&_stub), _tail(&_stub)
+            {
+                _stub.QueueNext.store(NULL, std::memory_order_relaxed);
+            }
+
+            ~MPSCQueue()
+            {
+                while (T* element = Dequeue())
+                    delete element;
+            }
+
+            //! Adds an element, safe from any thread.
+            void Enqueue(T* element)
+            {
+                element->QueueNext.store(NULL, std::memory_order_relaxed);
+                T* previous = _head.exchange(element, std::memory_order_acq_rel);
+                previous->QueueNext.store(element, std::memory_order_release);
+            }
+
+            //! Removes the oldest element, NULL if there is none. Consumer thread only.
+            T* Dequeue()
+            {
+                T* tail = _tail;
+                T* next = tail->QueueNext.load(std::memory_order_acquire);
+
+                if (tail == &_stub)
+                {
+                    if (!next)
+                        return NULL;
+
+                    _tail = next;
+                    tail = next;
+                    next = next->QueueNext.load(std::memory_order_acquire);
+                }
+
+                if (next)
+                {
+                    _tail = next;
+                    return tail;
+                }
+
+                // tail is the last element, unless a producer is linking a new one
+                if (tail != _head.load(std::memory_order_acquire))
+                    return NULL;
+
+                // the stub takes the place of the last element so it can be handed out
+                Enqueue(&_stub);
+
+                next = tail->QueueNext.load(std::memory_order_acquire);
+                if (!next)
+                    return NULL;
+
+                _tail = next;
+                return tail;
+            }
+
+        private:
+
+            MPSCQueue(MPSCQueue const&);
+            MPSCQueue& operator=(MPSCQueue const&);
+
+            std::atomic<T*> _head;                          // last enqueued element
+            T* _tail;                                       // next element to dequeue, consumer only
+            T _stub;
+    };
+}
+#endif
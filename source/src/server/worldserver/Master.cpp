@@ -36,6 +36,7 @@
 #include "CliRunnable.h"
 #include "Log.h"
 #include "Master.h"
+#include "PacketLog.h"
 #include "RARunnable.h"
 #include "TCSoap.h"
 #include "Timer.h"
@@ -273,6 +274,9 @@ int Master::Run()
     world_thread.wait();
     rar_thread.wait();
 
+    // network is down, write the capture index
+    sPacketLog->Close();
+
     if (soap_thread)
     {
         soap_thread->wait();
@@ -356,6 +360,9 @@ bool Master::_StartDB()
     std::string dbstring;
     uint8 async_threads, synch_threads;
 
+    // every parallel startup loader queries on its own synchronous connection
+    uint8 startup_threads = uint8(std::min(std::max(1, sConfigMgr->GetIntDefault("StartupLoad.Threads", 1)), 255));
+
     dbstring = sConfigMgr->GetStringDefault("WorldDatabaseInfo", "");
     if (dbstring.empty())
     {
@@ -371,9 +378,9 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = uint8(sConfigMgr->GetIntDefault("WorldDatabase.SynchThreads", 1));
+    synch_threads = std::max(uint8(sConfigMgr->GetIntDefault("WorldDatabase.SynchThreads", 1)), startup_threads);
     ///- Initialise the world database
-    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads, sConfigMgr->GetBoolDefault("WorldDatabase.ShardedQueues", false)))
     {
         TC_LOG_ERROR("server.worldserver", "Cannot connect to world database %s", dbstring.c_str());
         return false;
@@ -395,10 +402,10 @@ bool Master::_StartDB()
         return false;
     }
 
-    synch_threads = uint8(sConfigMgr->GetIntDefault("CharacterDatabase.SynchThreads", 2));
+    synch_threads = std::max(uint8(sConfigMgr->GetIntDefault("CharacterDatabase.SynchThreads", 2)), startup_threads);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads, sConfigMgr->GetBoolDefault("CharacterDatabase.ShardedQueues", false)))
     {
         TC_LOG_ERROR("server.worldserver", "Cannot connect to Character database %s", dbstring.c_str());
         return false;
@@ -422,7 +429,7 @@ bool Master::_StartDB()
 
     synch_threads = uint8(sConfigMgr->GetIntDefault("LoginDatabase.SynchThreads", 1));
     ///- Initialise the login database
-    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads, sConfigMgr->GetBoolDefault("LoginDatabase.ShardedQueues", false)))
     {
         TC_LOG_ERROR("server.worldserver", "Cannot connect to login database %s", dbstring.c_str());
         return false;
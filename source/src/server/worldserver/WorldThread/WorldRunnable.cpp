@@ -96,6 +96,8 @@ void WorldRunnable::run()
 
     sScriptMgr->OnShutdown();
 
+    sWorld->StopHousekeeping();                              // no database ping once the databases are closed
+
     sWorld->KickAll();                                       // save and kick all players
     sWorld->UpdateSessions( 1 );                             // real players unload required UpdateSessions call
 
@@ -0,0 +1,139 @@
+#include "HeadlessWorld.h"
+#include "Common.h"
+#include "Timer.h"
+#include "AccountMgr.h"
+#include "BattlegroundMgr.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "InfoMgr.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "ObjectAccessor.h"
+#include "OutdoorPvPMgr.h"
+#include "ScriptMgr.h"
+#include "World.h"
+#include "WorldSession.h"
+
+WorldDatabaseWorkerPool WorldDatabase;                      ///< Accessor to the world database
+CharacterDatabaseWorkerPool CharacterDatabase;              ///< Accessor to the character database
+LoginDatabaseWorkerPool LoginDatabase;                      ///< Accessor to the realm/login database
+
+uint32 realmID;                                             ///< Id of the realm
+
+HeadlessWorld::HeadlessWorld() : _dbStarted(false), _worldStarted(false)
+{
+}
+
+HeadlessWorld::~HeadlessWorld()
+{
+    Stop();
+}
+
+template <class T>
+static bool OpenDatabase(DatabaseWorkerPool<T>& database, char const* name)
+{
+    std::string base(name);
+    std::string dbstring = sConfigMgr->GetStringDefault((base + "DatabaseInfo").c_str(), "");
+    if (dbstring.empty())
+    {
+        TC_LOG_ERROR("server.worldserver", "%s database not specified in configuration file", name);
+        return false;
+    }
+
+    uint8 asyncThreads = uint8(std::max(1, std::min(32, sConfigMgr->GetIntDefault((base + "Database.WorkerThreads").c_str(), 1))));
+    uint8 synchThreads = uint8(std::max(1, sConfigMgr->GetIntDefault((base + "Database.SynchThreads").c_str(), 1)));
+    if (!database.Open(dbstring, asyncThreads, synchThreads, sConfigMgr->GetBoolDefault((base + "Database.ShardedQueues").c_str(), false)))
+    {
+        TC_LOG_ERROR("server.worldserver", "Cannot connect to %s database %s", name, dbstring.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool HeadlessWorld::StartDB()
+{
+    MySQL::Library_Init();
+    _dbStarted = true;
+
+    if (!OpenDatabase(WorldDatabase, "World") || !OpenDatabase(CharacterDatabase, "Character") || !OpenDatabase(LoginDatabase, "Login"))
+        return false;
+
+    realmID = sConfigMgr->GetIntDefault("RealmID", 0);
+    if (!realmID)
+    {
+        TC_LOG_ERROR("server.worldserver", "Realm ID not defined in configuration file");
+        return false;
+    }
+
+    sWorld->setRealmID(realmID);
+    sWorld->LoadDBVersion();
+    return true;
+}
+
+void HeadlessWorld::StopDB()
+{
+    if (!_dbStarted)
+        return;
+
+    CharacterDatabase.Close();
+    WorldDatabase.Close();
+    LoginDatabase.Close();
+
+    MySQL::Library_End();
+    _dbStarted = false;
+}
+
+bool HeadlessWorld::Start()
+{
+    if (!StartDB())
+    {
+        StopDB();
+        return false;
+    }
+
+    // The realm stays as it is, nothing can connect to this world
+    sWorld->SetInitialWorldSettings();
+    sScriptMgr->OnStartup();
+    _worldStarted = true;
+    return true;
+}
+
+void HeadlessWorld::Update(uint32 diff)
+{
+    ++World::m_worldLoopCounter;
+    sWorld->Update(diff);
+}
+
+void HeadlessWorld::Stop()
+{
+    if (_worldStarted)
+    {
+        sScriptMgr->OnShutdown();
+
+        sWorld->KickAll();                                  // save and kick all players
+        sWorld->UpdateSessions(1);                          // real players unload required UpdateSessions call
+
+        sBattlegroundMgr->DeleteAllBattlegrounds();
+
+        sMapMgr->UnloadAll();
+        sObjectAccessor->UnloadAll();
+        sScriptMgr->Unload();
+        sOutdoorPvPMgr->Die();
+        sInfoMgr->UnloadAll();
+        _worldStarted = false;
+    }
+
+    StopDB();
+}
+
+WorldSession* HeadlessWorld::CreateSession(uint32 accountId, WorldSessionSink* sink)
+{
+    AccountTypes security = AccountTypes(AccountMgr::GetSecurity(accountId, realmID));
+    uint8 expansion = uint8(sWorld->getIntConfig(CONFIG_EXPANSION));
+
+    WorldSession* session = new WorldSession(accountId, NULL, security, expansion, 0, 0, LOCALE_enUS, 0, false, 0);
+    session->SetSink(sink);
+    sWorld->AddSession(session);
+    return session;
+}
@@ -0,0 +1,67 @@
+#ifndef _HEADLESSWORLD_H
+#define _HEADLESSWORLD_H
+
+#include "Define.h"
+#include "WorldSession.h"
+#include <atomic>
+
+/// Runs the world from the configured databases without network, for tools which drive sessions in process
+class HeadlessWorld
+{
+    public:
+        HeadlessWorld();
+        ~HeadlessWorld();
+
+        /// The configuration must be loaded already
+        bool Start();
+        void Update(uint32 diff);
+        void Stop();
+
+        /// The session is owned by the world and deleted some updates after it was kicked
+        WorldSession* CreateSession(uint32 accountId, WorldSessionSink* sink);
+
+    private:
+        bool StartDB();
+        void StopDB();
+
+        bool _dbStarted;
+        bool _worldStarted;
+};
+
+/// Counts the packets the world sends to a socketless session
+class CountingSessionSink : public WorldSessionSink
+{
+    public:
+        CountingSessionSink()
+        {
+            _packets.store(0, std::memory_order_relaxed);
+            _bytes.store(0, std::memory_order_relaxed);
+            _closed.store(false, std::memory_order_relaxed);
+        }
+
+        void OnSendPacket(WorldPacket const& packet)
+        {
+            _packets.fetch_add(1, std::memory_order_relaxed);
+            _bytes.fetch_add(packet.size(), std::memory_order_relaxed);
+        }
+
+        void OnClose() { _closed.store(true, std::memory_order_release); }
+
+        uint32 GetPackets() const { return _packets.load(std::memory_order_relaxed); }
+        uint64 GetBytes() const { return _bytes.load(std::memory_order_relaxed); }
+        bool IsClosed() const { return _closed.load(std::memory_order_acquire); }
+
+        /// Starts a new measurement, the closed state is kept
+        void ResetCounters()
+        {
+            _packets.store(0, std::memory_order_relaxed);
+            _bytes.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint32> _packets;
+        std::atomic<uint64> _bytes;
+        std::atomic<bool> _closed;
+};
+
+#endif
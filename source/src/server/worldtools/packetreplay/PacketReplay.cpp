@@ -0,0 +1,251 @@
+/// \file
+/// Feeds client packet streams of a capture (see PacketLog) back into world sessions
+
+#include "Common.h"
+#include "Config.h"
+#include "HeadlessWorld.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "PacketCaptureReader.h"
+#include "PacketLog.h"
+#include "Threading.h"
+#include "Timer.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+
+#ifndef _TRINITY_CORE_CONFIG
+# define _TRINITY_CORE_CONFIG  "worldserver.conf"
+#endif
+
+// Same tick length as the world thread
+#define REPLAY_SLEEP_CONST 50
+
+struct ReplayStream
+{
+    ReplayStream() : Session(NULL), Info(NULL), NextRecord(0), Replayed(0), Skipped(0) { }
+
+    WorldSession* Session;
+    CountingSessionSink Sink;
+    PacketCaptureSessionInfo const* Info;
+    size_t NextRecord;
+    uint32 Replayed;
+    uint32 Skipped;
+};
+
+void usage(char const* prog)
+{
+    printf("Usage:\n");
+    printf(" %s [<options>] <capture file>\n", prog);
+    printf("    -c config_file           use config_file as configuration file\n");
+    printf("    --list                   list the sessions of the capture and exit\n");
+    printf("    --connection id          replay only this connection, can be repeated\n");
+    printf("    --speed factor           replay faster (> 1) or slower (< 1) than captured, default 1\n");
+    printf("    --linger seconds         keep the world running after the last packet, default 10\n");
+    printf("The world database and characters must match the server the capture was taken on.\n");
+}
+
+// Opcodes the socket handles itself, they never reach WorldSession
+static bool IsReplayable(uint32 rawOpcode)
+{
+    Opcodes opcode = PacketFilter::DropHighBytes(Opcodes(rawOpcode));
+    switch (opcode)
+    {
+        case CMSG_PING:
+        case CMSG_AUTH_SESSION:
+        case CMSG_KEEP_ALIVE:
+        case CMSG_LOG_DISCONNECT:
+        case MSG_VERIFY_CONNECTIVITY:
+        case CMSG_ENABLE_NAGLE:
+            return false;
+        default:
+            break;
+    }
+
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return false;
+
+    OpcodeHandler const* handler = opcodeTable[opcode];
+    return handler && handler->Status != STATUS_UNHANDLED && handler->Status != STATUS_NEVER;
+}
+
+static void ListSessions(PacketCaptureReader const& reader)
+{
+    PacketCaptureHeader const* header = reader.GetHeader();
+    printf("Capture of build %u started at %s, %u sessions%s\n", header->Build, TimeToTimestampStr(time_t(header->StartTime)).c_str(),
+        uint32(reader.GetSessions().size()), reader.IsRecovered() ? " (not closed, index rebuilt)" : "");
+
+    for (std::vector<PacketCaptureSessionInfo>::const_iterator itr = reader.GetSessions().begin(); itr != reader.GetSessions().end(); ++itr)
+    {
+        uint32 clientPackets = 0;
+        uint32 first = 0;
+        uint32 last = 0;
+        for (size_t i = 0; i < itr->RecordOffsets.size(); ++i)
+        {
+            PacketCaptureRecord const* record = reader.GetRecord(itr->RecordOffsets[i]);
+            if (record->Direction == CLIENT_TO_SERVER)
+                ++clientPackets;
+
+            if (!i)
+                first = record->Time;
+            last = record->Time;
+        }
+
+        printf("connection %u: account %u, %u packets (%u from client), %u s\n", itr->ConnectionId, itr->AccountId,
+            uint32(itr->RecordOffsets.size()), clientPackets, (last - first) / IN_MILLISECONDS);
+    }
+}
+
+extern int main(int argc, char** argv)
+{
+    char const* configFile = _TRINITY_CORE_CONFIG;
+    char const* captureFile = NULL;
+    bool list = false;
+    float speed = 1.0f;
+    uint32 linger = 10 * IN_MILLISECONDS;
+    std::set<uint32> connections;
+
+    for (int c = 1; c < argc; ++c)
+    {
+        bool hasValue = c + 1 < argc;
+        if (!strcmp(argv[c], "-c") && hasValue)
+            configFile = argv[++c];
+        else if (!strcmp(argv[c], "--list"))
+            list = true;
+        else if (!strcmp(argv[c], "--connection") && hasValue)
+            connections.insert(uint32(atoi(argv[++c])));
+        else if (!strcmp(argv[c], "--speed") && hasValue)
+            speed = float(atof(argv[++c]));
+        else if (!strcmp(argv[c], "--linger") && hasValue)
+            linger = uint32(atoi(argv[++c])) * IN_MILLISECONDS;
+        else if (argv[c][0] != '-' && !captureFile)
+            captureFile = argv[c];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!captureFile || speed <= 0.0f)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    PacketCaptureReader reader;
+    if (!reader.Open(captureFile))
+    {
+        printf("Cannot read capture %s\n", captureFile);
+        return 1;
+    }
+
+    if (list)
+    {
+        ListSessions(reader);
+        return 0;
+    }
+
+    if (!sConfigMgr->LoadInitial(configFile))
+    {
+        printf("Invalid or missing configuration file : %s\n", configFile);
+        return 1;
+    }
+
+    // The replayed sessions are keyed by account in the world, one stream per account
+    // Sinks are referenced by the sessions, streams must not move
+    std::list<ReplayStream> streams;
+    std::set<uint32> accounts;
+    for (std::vector<PacketCaptureSessionInfo>::const_iterator itr = reader.GetSessions().begin(); itr != reader.GetSessions().end(); ++itr)
+    {
+        if (!itr->AccountId || (!connections.empty() && !connections.count(itr->ConnectionId)))
+            continue;
+
+        if (!accounts.insert(itr->AccountId).second)
+        {
+            TC_LOG_WARN("server.worldserver", "Skipping connection %u, account %u is already replayed by another connection", itr->ConnectionId, itr->AccountId);
+            continue;
+        }
+
+        streams.emplace_back();
+        streams.back().Info = &*itr;
+    }
+
+    if (streams.empty())
+    {
+        printf("Nothing to replay\n");
+        return 1;
+    }
+
+    HeadlessWorld world;
+    if (!world.Start())
+        return 1;
+
+    // Streams keep their relative timing, the first replayed packet is sent right away
+    uint32 captureStart = std::numeric_limits<uint32>::max();
+    for (std::list<ReplayStream>::iterator itr = streams.begin(); itr != streams.end(); ++itr)
+    {
+        itr->Session = world.CreateSession(itr->Info->AccountId, &itr->Sink);
+        if (!itr->Info->RecordOffsets.empty())
+            captureStart = std::min(captureStart, reader.GetRecord(itr->Info->RecordOffsets[0])->Time);
+    }
+
+    TC_LOG_INFO("server.worldserver", "Replaying %u sessions of %s", uint32(streams.size()), captureFile);
+
+    double replayTime = 0.0;                                // kept fractional, slow replays advance by less than 1 ms per tick
+    uint32 idleTime = 0;
+    uint32 prevTime = getMSTime();
+    while (idleTime < linger)
+    {
+        uint32 currTime = getMSTime();
+        uint32 diff = getMSTimeDiff(prevTime, currTime);
+        prevTime = currTime;
+
+        replayTime += double(diff) * speed;
+
+        bool pending = false;
+        for (std::list<ReplayStream>::iterator itr = streams.begin(); itr != streams.end(); ++itr)
+        {
+            std::vector<uint64> const& records = itr->Info->RecordOffsets;
+            for (; itr->NextRecord < records.size() && !itr->Sink.IsClosed(); ++itr->NextRecord)
+            {
+                PacketCaptureRecord const* record = reader.GetRecord(records[itr->NextRecord]);
+                if (double(record->Time - captureStart) > replayTime)
+                    break;
+
+                if (record->Direction != CLIENT_TO_SERVER)
+                    continue;
+
+                if (!IsReplayable(record->Opcode))
+                {
+                    ++itr->Skipped;
+                    continue;
+                }
+
+                WorldPacket* packet = new WorldPacket(PacketFilter::DropHighBytes(Opcodes(record->Opcode)), record->Size);
+                if (record->Size)
+                    packet->append(reader.GetPayload(record), record->Size);
+
+                itr->Session->QueuePacket(packet);
+                ++itr->Replayed;
+            }
+
+            if (itr->NextRecord < records.size() && !itr->Sink.IsClosed())
+                pending = true;
+        }
+
+        idleTime = pending ? 0 : idleTime + diff;
+
+        world.Update(diff);
+
+        uint32 updateTime = getMSTimeDiff(currTime, getMSTime());
+        if (updateTime < REPLAY_SLEEP_CONST)
+            ACE_Based::Thread::Sleep(REPLAY_SLEEP_CONST - updateTime);
+    }
+
+    for (std::list<ReplayStream>::const_iterator itr = streams.begin(); itr != streams.end(); ++itr)
+        TC_LOG_INFO("server.worldserver", "connection %u (account %u): %u packets replayed, %u skipped, %u packets (" UI64FMTD " bytes) sent by the server%s",
+            itr->Info->ConnectionId, itr->Info->AccountId, itr->Replayed, itr->Skipped, itr->Sink.GetPackets(), itr->Sink.GetBytes(), itr->Sink.IsClosed() ? ", kicked" : "");
+
+    world.Stop();
+    return 0;
+}
@@ -0,0 +1,604 @@
+/// \file
+/// Logs in characters through socketless sessions, drives them with scripted client traffic
+/// and reports opcode handler latency, world tick time and traffic per player
+
+#include "Common.h"
+#include "Config.h"
+#include "Creature.h"
+#include "DatabaseEnv.h"
+#include "HeadlessWorld.h"
+#include "Log.h"
+#include "MovementInfo.h"
+#include "Opcodes.h"
+#include "Player.h"
+#include "SpellInfo.h"
+#include "SpellMgr.h"
+#include "TemporarySummon.h"
+#include "Threading.h"
+#include "TickProfiler.h"
+#include "Timer.h"
+#include "WorldPacket.h"
+#include <chrono>
+
+#ifndef _TRINITY_CORE_CONFIG
+# define _TRINITY_CORE_CONFIG  "worldserver.conf"
+#endif
+
+// Same tick length as the world thread
+#define BENCH_SLEEP_CONST 50
+
+// Clients walk in a circle around their login position, staying in reach of their auctioneer
+#define BENCH_MOVE_RADIUS 3.0f
+#define BENCH_MOVE_SPEED  7.0f
+
+// Default auctioneer, it takes the faction of the player it is summoned for
+#define BENCH_AUCTIONEER_ENTRY 8719
+
+enum BenchClientState
+{
+    BENCH_CLIENT_CHAR_ENUM,                                 // waiting for SMSG_CHAR_ENUM, logging in before is refused
+    BENCH_CLIENT_LOGIN,                                     // waiting for the player to be added to the map
+    BENCH_CLIENT_IN_WORLD,
+    BENCH_CLIENT_FAILED
+};
+
+class BenchSink : public CountingSessionSink
+{
+    public:
+        BenchSink() { _charEnum.store(false, std::memory_order_relaxed); }
+
+        void OnSendPacket(WorldPacket const& packet)
+        {
+            CountingSessionSink::OnSendPacket(packet);
+            if (packet.GetOpcode() == SMSG_CHAR_ENUM)
+                _charEnum.store(true, std::memory_order_release);
+        }
+
+        bool HasCharEnum() const { return _charEnum.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<bool> _charEnum;
+};
+
+struct BenchOptions
+{
+    BenchOptions() : FirstAccount(0), Players(10), Warmup(10 * IN_MILLISECONDS), Duration(60 * IN_MILLISECONDS), LoginTimeout(60 * IN_MILLISECONDS),
+        MoveInterval(500), CastInterval(5 * IN_MILLISECONDS), ChatInterval(10 * IN_MILLISECONDS), AuctionInterval(15 * IN_MILLISECONDS),
+        SpellId(0), AuctioneerEntry(BENCH_AUCTIONEER_ENTRY), CsvFile(NULL) { }
+
+    uint32 FirstAccount;
+    uint32 Players;
+    uint32 Warmup;
+    uint32 Duration;
+    uint32 LoginTimeout;
+    uint32 MoveInterval;                                    // intervals of the scripted actions, 0 disables the action
+    uint32 CastInterval;
+    uint32 ChatInterval;
+    uint32 AuctionInterval;
+    uint32 SpellId;
+    uint32 AuctioneerEntry;
+    char const* CsvFile;
+};
+
+struct BenchClient
+{
+    BenchClient() : AccountId(0), CharacterGuid(0), Session(NULL), State(BENCH_CLIENT_CHAR_ENUM), LoginStart(0), LoginTime(0),
+        SpellId(0), CastCount(0), AuctioneerGuid(0), Angle(0.0f), MoveStarted(false), MoveTimer(0), CastTimer(0), ChatTimer(0), AuctionTimer(0),
+        QueuedPackets(0) { }
+
+    uint32 AccountId;
+    uint32 CharacterGuid;
+    WorldSession* Session;
+    BenchSink Sink;
+    BenchClientState State;
+    uint32 LoginStart;
+    uint32 LoginTime;
+
+    uint32 SpellId;
+    uint8 CastCount;
+    uint64 AuctioneerGuid;
+    Position Center;
+    float Angle;
+    bool MoveStarted;
+
+    int32 MoveTimer;
+    int32 CastTimer;
+    int32 ChatTimer;
+    int32 AuctionTimer;
+    uint32 QueuedPackets;
+};
+
+typedef std::list<BenchClient> BenchClientList;
+
+void usage(char const* prog)
+{
+    printf("Usage:\n");
+    printf(" %s [<options>] --first-account id\n", prog);
+    printf("    -c config_file           use config_file as configuration file\n");
+    printf("    --first-account id       first account to log in, the following accounts are used for the other players\n");
+    printf("    --players count          number of players, default 10\n");
+    printf("    --warmup seconds         time between the last login and the measurement, default 10\n");
+    printf("    --duration seconds       measured time, default 60\n");
+    printf("    --move ms                movement heartbeat interval, default 500\n");
+    printf("    --cast ms                spell cast interval, default 5000\n");
+    printf("    --chat ms                say interval, default 10000\n");
+    printf("    --auction ms             auction house browse interval, default 15000\n");
+    printf("    --spell id               spell to cast, default is the first positive spell of the spellbook\n");
+    printf("    --auctioneer entry       creature summoned next to each player for browsing, default %u\n", BENCH_AUCTIONEER_ENTRY);
+    printf("    --csv file               write the section stats as csv\n");
+    printf("An interval of 0 disables the action. The first character of each account is logged in and saved\n");
+    printf("on exit, run it against a copy of the character database.\n");
+}
+
+static uint32 GetFirstCharacter(uint32 accountId)
+{
+    QueryResult result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE account = %u AND deleteInfos_Account IS NULL ORDER BY guid LIMIT 1", accountId);
+    return result ? (*result)[0].GetUInt32() : 0;
+}
+
+static void SendPacket(BenchClient& client, WorldPacket* packet)
+{
+    client.Session->QueuePacket(packet);
+    ++client.QueuedPackets;
+}
+
+static void SendPlayerLogin(BenchClient& client)
+{
+    ObjectGuid guid = MAKE_NEW_GUID(client.CharacterGuid, 0, HIGHGUID_PLAYER);
+
+    WorldPacket* packet = new WorldPacket(CMSG_PLAYER_LOGIN, 9);
+    packet->WriteBit(guid[2]);
+    packet->WriteBit(guid[3]);
+    packet->WriteBit(guid[0]);
+    packet->WriteBit(guid[6]);
+    packet->WriteBit(guid[4]);
+    packet->WriteBit(guid[5]);
+    packet->WriteBit(guid[1]);
+    packet->WriteBit(guid[7]);
+    packet->FlushBits();
+
+    packet->WriteByteSeq(guid[2]);
+    packet->WriteByteSeq(guid[7]);
+    packet->WriteByteSeq(guid[0]);
+    packet->WriteByteSeq(guid[3]);
+    packet->WriteByteSeq(guid[5]);
+    packet->WriteByteSeq(guid[6]);
+    packet->WriteByteSeq(guid[1]);
+    packet->WriteByteSeq(guid[4]);
+
+    SendPacket(client, packet);
+}
+
+static uint32 SelectSpell(Player* player, uint32 spellId)
+{
+    if (spellId)
+        return player->HasActiveSpell(spellId) ? spellId : 0;
+
+    for (PlayerSpellMap::const_iterator itr = player->GetSpellMap().begin(); itr != player->GetSpellMap().end(); ++itr)
+    {
+        if (itr->second->state == PLAYERSPELL_REMOVED || !itr->second->active || itr->second->disabled)
+            continue;
+
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(itr->first);
+        if (spellInfo && !spellInfo->IsPassive() && spellInfo->IsPositive() && !spellInfo->NeedsExplicitUnitTarget())
+            return itr->first;
+    }
+
+    return 0;
+}
+
+// Spreads the actions of the clients over their intervals
+static int32 GetStartTimer(uint32 interval)
+{
+    return interval ? int32(urand(0, interval)) : 0;
+}
+
+static void EnterWorld(BenchClient& client, Player* player, BenchOptions const& options)
+{
+    client.State = BENCH_CLIENT_IN_WORLD;
+    client.LoginTime = getMSTimeDiff(client.LoginStart, getMSTime());
+    client.Center.Relocate(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation());
+
+    if (options.CastInterval)
+    {
+        client.SpellId = SelectSpell(player, options.SpellId);
+        if (!client.SpellId)
+            TC_LOG_WARN("server.worldserver", "Account %u: %s has no spell to cast", client.AccountId, player->GetName().c_str());
+    }
+
+    if (options.AuctionInterval)
+    {
+        if (TempSummon* auctioneer = player->SummonCreature(options.AuctioneerEntry, client.Center, TEMPSUMMON_MANUAL_DESPAWN))
+        {
+            auctioneer->setFaction(player->getFaction());
+            client.AuctioneerGuid = auctioneer->GetGUID();
+        }
+        else
+            TC_LOG_WARN("server.worldserver", "Account %u: cannot summon auctioneer %u", client.AccountId, options.AuctioneerEntry);
+    }
+
+    client.MoveTimer = GetStartTimer(options.MoveInterval);
+    client.CastTimer = GetStartTimer(options.CastInterval);
+    client.ChatTimer = GetStartTimer(options.ChatInterval);
+    client.AuctionTimer = GetStartTimer(options.AuctionInterval);
+}
+
+static void SendMovement(BenchClient& client, Player* player, uint32 interval)
+{
+    Opcodes opcode = MSG_MOVE_HEARTBEAT;
+    if (!client.MoveStarted)
+    {
+        opcode = MSG_MOVE_START_FORWARD;
+        client.MoveStarted = true;
+    }
+    else
+        client.Angle = Position::NormalizeOrientation(client.Angle + BENCH_MOVE_SPEED * interval / IN_MILLISECONDS / BENCH_MOVE_RADIUS);
+
+    MovementInfo movementInfo;
+    movementInfo.guid = player->GetGUID();
+    movementInfo.flags = MOVEMENTFLAG_FORWARD;
+    movementInfo.time = getMSTime();
+    movementInfo.pos.Relocate(client.Center.GetPositionX() + BENCH_MOVE_RADIUS * std::cos(client.Angle),
+        client.Center.GetPositionY() + BENCH_MOVE_RADIUS * std::sin(client.Angle), client.Center.GetPositionZ(),
+        Position::NormalizeOrientation(client.Angle + float(M_PI) / 2));
+
+    WorldPacket* packet = new WorldPacket(opcode, 64);
+    movementInfo.WriteToPacket(*packet);
+    SendPacket(client, packet);
+}
+
+static void SendCast(BenchClient& client)
+{
+    WorldPacket* packet = new WorldPacket(CMSG_CAST_SPELL, 14);
+    *packet << uint8(++client.CastCount);
+    *packet << uint32(client.SpellId);
+    *packet << uint32(0);                                   // glyph index
+    *packet << uint8(0);                                    // cast flags
+    *packet << uint32(TARGET_FLAG_NONE);                    // self
+    SendPacket(client, packet);
+}
+
+static void SendChat(BenchClient& client, Player* player)
+{
+    std::string text = "worldbench";
+
+    WorldPacket* packet = new WorldPacket(CMSG_MESSAGECHAT_SAY, 4 + 2 + text.length());
+    *packet << uint32(player->GetTeam() == ALLIANCE ? LANG_COMMON : LANG_ORCISH);
+    packet->WriteBits(text.length(), 9);
+    packet->FlushBits();
+    packet->WriteString(text);
+    SendPacket(client, packet);
+}
+
+static void SendAuctionBrowse(BenchClient& client)
+{
+    WorldPacket* packet = new WorldPacket(CMSG_AUCTION_LIST_ITEMS, 40);
+    *packet << uint64(client.AuctioneerGuid);
+    *packet << uint32(0);                                   // list from
+    *packet << std::string();                               // name
+    *packet << uint8(0) << uint8(0);                        // level range
+    *packet << uint32(0xFFFFFFFF);                          // inventory type, class and subclass: any
+    *packet << uint32(0xFFFFFFFF);
+    *packet << uint32(0xFFFFFFFF);
+    *packet << uint32(0xFFFFFFFF);                          // quality: any
+    *packet << uint8(0);                                    // usable
+    *packet << uint8(0);                                    // get all
+    *packet << uint8(0);
+    *packet << uint8(1);                                    // sort entries + 1
+    *packet << uint8(0);
+    *packet << uint8(0);
+    SendPacket(client, packet);
+}
+
+static bool RunTimer(int32& timer, uint32 interval, uint32 diff)
+{
+    if (!interval)
+        return false;
+
+    timer -= int32(diff);
+    if (timer > 0)
+        return false;
+
+    timer += int32(interval);
+    if (timer <= 0)                                         // the world fell behind, do not send bursts
+        timer = int32(interval);
+    return true;
+}
+
+static void UpdateClient(BenchClient& client, BenchOptions const& options, uint32 diff)
+{
+    if (client.State == BENCH_CLIENT_FAILED)
+        return;
+
+    if (client.Sink.IsClosed())
+    {
+        TC_LOG_ERROR("server.worldserver", "Account %u was kicked", client.AccountId);
+        client.State = BENCH_CLIENT_FAILED;
+        return;
+    }
+
+    Player* player = client.Session->GetPlayer();
+    switch (client.State)
+    {
+        case BENCH_CLIENT_CHAR_ENUM:
+            if (client.Sink.HasCharEnum())
+            {
+                SendPlayerLogin(client);
+                client.State = BENCH_CLIENT_LOGIN;
+            }
+            break;
+        case BENCH_CLIENT_LOGIN:
+            if (player && player->IsInWorld())
+                EnterWorld(client, player, options);
+            break;
+        case BENCH_CLIENT_IN_WORLD:
+            if (!player || !player->IsInWorld() || player->IsBeingTeleported())
+                break;
+
+            if (RunTimer(client.MoveTimer, options.MoveInterval, diff))
+                SendMovement(client, player, options.MoveInterval);
+            if (client.SpellId && RunTimer(client.CastTimer, options.CastInterval, diff))
+                SendCast(client);
+            if (RunTimer(client.ChatTimer, options.ChatInterval, diff))
+                SendChat(client, player);
+            if (client.AuctioneerGuid && RunTimer(client.AuctionTimer, options.AuctionInterval, diff))
+                SendAuctionBrowse(client);
+            break;
+        default:
+            break;
+    }
+
+    if (client.State < BENCH_CLIENT_IN_WORLD && getMSTimeDiff(client.LoginStart, getMSTime()) > options.LoginTimeout)
+    {
+        TC_LOG_ERROR("server.worldserver", "Account %u: character %u did not enter the world", client.AccountId, client.CharacterGuid);
+        client.State = BENCH_CLIENT_FAILED;
+    }
+}
+
+static uint32 GetPercentile(std::vector<uint32> const& sorted, uint32 percentile)
+{
+    if (sorted.empty())
+        return 0;
+
+    return sorted[std::min<size_t>(sorted.size() - 1, sorted.size() * percentile / 100)];
+}
+
+static void Report(BenchClientList const& clients, std::vector<uint32>& tickTimes, uint32 measuredTime, BenchOptions const& options)
+{
+    uint32 inWorld = 0;
+    uint32 maxLoginTime = 0;
+    uint64 totalLoginTime = 0;
+    for (BenchClientList::const_iterator itr = clients.begin(); itr != clients.end(); ++itr)
+    {
+        if (itr->State != BENCH_CLIENT_IN_WORLD)
+            continue;
+
+        ++inWorld;
+        totalLoginTime += itr->LoginTime;
+        maxLoginTime = std::max(maxLoginTime, itr->LoginTime);
+    }
+
+    printf("Players: %u of %u in world, measured %u s\n", inWorld, uint32(clients.size()), measuredTime / IN_MILLISECONDS);
+    if (inWorld)
+        printf("Login: avg %u ms, max %u ms\n", uint32(totalLoginTime / inWorld), maxLoginTime);
+
+    std::sort(tickTimes.begin(), tickTimes.end());
+    uint64 totalTickTime = 0;
+    uint32 overBudget = 0;
+    for (std::vector<uint32>::const_iterator itr = tickTimes.begin(); itr != tickTimes.end(); ++itr)
+    {
+        totalTickTime += *itr;
+        if (*itr > BENCH_SLEEP_CONST * IN_MILLISECONDS)
+            ++overBudget;
+    }
+
+    if (!tickTimes.empty())
+        printf("Tick (us): %u ticks, avg %u, p50 %u, p95 %u, p99 %u, max %u, %u over %u ms\n", uint32(tickTimes.size()), uint32(totalTickTime / tickTimes.size()),
+            GetPercentile(tickTimes, 50), GetPercentile(tickTimes, 95), GetPercentile(tickTimes, 99), tickTimes.back(), overBudget, BENCH_SLEEP_CONST);
+
+    // traffic of the measured window only, counters are taken at its start
+    if (inWorld && measuredTime)
+    {
+        uint64 sentPackets = 0;
+        uint64 sentBytes = 0;
+        uint64 receivedPackets = 0;
+        for (BenchClientList::const_iterator itr = clients.begin(); itr != clients.end(); ++itr)
+        {
+            if (itr->State != BENCH_CLIENT_IN_WORLD)
+                continue;
+
+            sentPackets += itr->QueuedPackets;
+            receivedPackets += itr->Sink.GetPackets();
+            sentBytes += itr->Sink.GetBytes();
+        }
+
+        float seconds = float(measuredTime) / IN_MILLISECONDS;
+        printf("Per player: %.1f client packets/s, %.1f server packets/s, %.0f server bytes/s\n",
+            sentPackets / seconds / inWorld, receivedPackets / seconds / inWorld, sentBytes / seconds / inWorld);
+    }
+
+    ProfileSectionStatsList stats;
+    sTickProfiler->GetStats(stats);
+
+    printf("%-60s %10s %12s %8s %8s %8s %8s\n", "Section (us)", "count", "total", "avg", "p50", "p99", "max");
+    for (ProfileSectionStatsList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+        printf("%-60s %10u %12" UI64FMTD " %8u %8u %8u %8u\n", itr->Name.c_str(), itr->Count, itr->TotalTime, uint32(itr->TotalTime / itr->Count), itr->P50, itr->P99, itr->MaxTime);
+
+    if (!options.CsvFile)
+        return;
+
+    FILE* csv = fopen(options.CsvFile, "w");
+    if (!csv)
+    {
+        TC_LOG_ERROR("server.worldserver", "Cannot write %s", options.CsvFile);
+        return;
+    }
+
+    fprintf(csv, "section,count,total_us,p50_us,p99_us,max_us\n");
+    if (!tickTimes.empty())
+        fprintf(csv, "\"World tick\",%u," UI64FMTD ",%u,%u,%u\n", uint32(tickTimes.size()), totalTickTime, GetPercentile(tickTimes, 50), GetPercentile(tickTimes, 99), tickTimes.back());
+
+    for (ProfileSectionStatsList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+        fprintf(csv, "\"%s\",%u," UI64FMTD ",%u,%u,%u\n", itr->Name.c_str(), itr->Count, itr->TotalTime, itr->P50, itr->P99, itr->MaxTime);
+
+    fclose(csv);
+}
+
+extern int main(int argc, char** argv)
+{
+    char const* configFile = _TRINITY_CORE_CONFIG;
+    BenchOptions options;
+
+    for (int c = 1; c < argc; ++c)
+    {
+        bool hasValue = c + 1 < argc;
+        if (!strcmp(argv[c], "-c") && hasValue)
+            configFile = argv[++c];
+        else if (!strcmp(argv[c], "--first-account") && hasValue)
+            options.FirstAccount = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--players") && hasValue)
+            options.Players = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--warmup") && hasValue)
+            options.Warmup = uint32(atoi(argv[++c])) * IN_MILLISECONDS;
+        else if (!strcmp(argv[c], "--duration") && hasValue)
+            options.Duration = uint32(atoi(argv[++c])) * IN_MILLISECONDS;
+        else if (!strcmp(argv[c], "--move") && hasValue)
+            options.MoveInterval = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--cast") && hasValue)
+            options.CastInterval = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--chat") && hasValue)
+            options.ChatInterval = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--auction") && hasValue)
+            options.AuctionInterval = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--spell") && hasValue)
+            options.SpellId = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--auctioneer") && hasValue)
+            options.AuctioneerEntry = uint32(atoi(argv[++c]));
+        else if (!strcmp(argv[c], "--csv") && hasValue)
+            options.CsvFile = argv[++c];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!options.FirstAccount || !options.Players || !options.Duration)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!sConfigMgr->LoadInitial(configFile))
+    {
+        printf("Invalid or missing configuration file : %s\n", configFile);
+        return 1;
+    }
+
+    HeadlessWorld world;
+    if (!world.Start())
+        return 1;
+
+    // Samples are collected over the whole measurement instead of the configured dump window
+    sTickProfiler->SetEnabled(true);
+    sTickProfiler->SetDumpInterval(0);
+
+    // Sinks are referenced by the sessions, clients must not move
+    BenchClientList clients;
+    for (uint32 accountId = options.FirstAccount; accountId < options.FirstAccount + options.Players; ++accountId)
+    {
+        uint32 characterGuid = GetFirstCharacter(accountId);
+        if (!characterGuid)
+        {
+            TC_LOG_WARN("server.worldserver", "Account %u has no character, skipped", accountId);
+            continue;
+        }
+
+        clients.emplace_back();
+        BenchClient& client = clients.back();
+        client.AccountId = accountId;
+        client.CharacterGuid = characterGuid;
+        client.LoginStart = getMSTime();
+        client.Session = world.CreateSession(accountId, &client.Sink);
+
+        // fills the characters the session may log in
+        SendPacket(client, new WorldPacket(CMSG_CHAR_ENUM, 0));
+    }
+
+    if (clients.empty())
+    {
+        printf("No character to log in\n");
+        world.Stop();
+        return 1;
+    }
+
+    TC_LOG_INFO("server.worldserver", "Logging in %u players", uint32(clients.size()));
+
+    std::vector<uint32> tickTimes;
+    uint32 loginEnd = 0;                                    // time all clients are in world or failed
+    uint32 measureStart = 0;
+    uint32 measureTime = 0;
+    uint32 prevTime = getMSTime();
+    while (!measureStart || measureTime < options.Duration)
+    {
+        uint32 currTime = getMSTime();
+        uint32 diff = getMSTimeDiff(prevTime, currTime);
+        prevTime = currTime;
+
+        bool loggingIn = false;
+        for (BenchClientList::iterator itr = clients.begin(); itr != clients.end(); ++itr)
+        {
+            UpdateClient(*itr, options, diff);
+            if (itr->State < BENCH_CLIENT_IN_WORLD)
+                loggingIn = true;
+        }
+
+        if (!loggingIn && !loginEnd)
+        {
+            bool inWorld = false;
+            for (BenchClientList::const_iterator itr = clients.begin(); itr != clients.end() && !inWorld; ++itr)
+                inWorld = itr->State == BENCH_CLIENT_IN_WORLD;
+
+            if (!inWorld)
+            {
+                printf("No player entered the world\n");
+                break;
+            }
+
+            loginEnd = currTime;
+            TC_LOG_INFO("server.worldserver", "Login done, warming up for %u s", options.Warmup / IN_MILLISECONDS);
+        }
+
+        if (loginEnd && !measureStart && getMSTimeDiff(loginEnd, currTime) >= options.Warmup)
+        {
+            measureStart = currTime;
+            sTickProfiler->Reset();
+            for (BenchClientList::iterator itr = clients.begin(); itr != clients.end(); ++itr)
+            {
+                itr->QueuedPackets = 0;
+                itr->Sink.ResetCounters();
+            }
+
+            TC_LOG_INFO("server.worldserver", "Measuring for %u s", options.Duration / IN_MILLISECONDS);
+        }
+
+        std::chrono::steady_clock::time_point tickStart = std::chrono::steady_clock::now();
+        world.Update(diff);
+        uint32 tickTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count());
+
+        if (measureStart)
+        {
+            tickTimes.push_back(tickTime);
+            measureTime = getMSTimeDiff(measureStart, getMSTime());
+        }
+
+        uint32 updateTime = getMSTimeDiff(currTime, getMSTime());
+        if (updateTime < BENCH_SLEEP_CONST)
+            ACE_Based::Thread::Sleep(BENCH_SLEEP_CONST - updateTime);
+    }
+
+    Report(clients, tickTimes, measureTime, options);
+
+    world.Stop();
+    return 0;
+}